@@ -0,0 +1,900 @@
+/* ****************************************************************************
+ * ****************************************************************************
+ * TAD ÁREAS
+ * ..................................................................
+ *
+ * División de un grafo compacto en áreas para calcular caminos mínimos
+ * en forma jerárquica, al modo de las áreas de OSPF (Dijkstra de varios
+ * niveles).
+ *
+ * Las distancias se calculan en tres pasos: desde el origen dentro de su
+ * área hacia los bordes de esta; desde allí, sobre el grafo superpuesto,
+ * hacia los bordes de las demás áreas; y finalmente, dentro de cada área
+ * que se expande, desde sus bordes de entrada (y el origen, si está en
+ * ella) hacia los demás vértices. Todo camino mínimo entra por última vez
+ * al área de su destino por un borde de entrada, por lo que las
+ * distancias obtenidas son exactas.
+ *
+ * Los atajos de un área se calculan recién cuando el recorrido del grafo
+ * superpuesto llega a alguno de sus bordes de entrada, y se conservan
+ * para los cálculos siguientes. El recorrido se detiene al fijar los
+ * bordes de entrada de las áreas de los destinos y superar la distancia
+ * del más lejano de ellos, ya que ningún camino hacia un destino pasa por
+ * un vértice más lejano. Así, sólo se calculan los atajos de las áreas
+ * cercanas a los caminos pedidos.
+ *
+ * Los previos se eligen luego, recorriendo cada camino desde su destino:
+ * el previo de cada vértice es, entre los vecinos que lo alcanzan por
+ * camino mínimo, el primero que marcaría Dijkstra (menor distancia y,
+ * ante igual distancia, el elegido por el criterio de selección). Los
+ * vecinos de otra área son bordes de salida, cuya distancia se conoce
+ * por el grafo superpuesto, y cada área a la que pasa el camino se
+ * expande al llegar a ella.
+ *
+ * ****************************************************************************
+ * ***************************************************************************/
+
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include "areas.h"
+#include "estadisticas.h"
+
+
+
+/* ****************************************************************************
+ * CONSTANTES
+ * ***************************************************************************/
+
+// Distancia de los vértices que no son alcanzables desde el origen
+#define INFINITO UINT32_MAX
+
+// Área de los vértices que aún no fueron asignados a ninguna
+#define SIN_AREA UINT32_MAX
+
+// Marcas de los vértices que son bordes de su área
+#define BORDE_ENTRADA 1
+#define BORDE_SALIDA 2
+
+
+
+/* ****************************************************************************
+ * DEFINICIÓN DE LOS TIPOS DE DATOS
+ * ***************************************************************************/
+
+// Tipo que representa un vértice encolado junto con su distancia.
+typedef struct {
+	uint32_t distancia;					// Distancia al encolarlo
+	uint32_t vertice;					// Vértice
+} areas_elemento_t;
+
+// Tipo que representa un montículo de vértices por distancia. Un vértice
+// se encola cada vez que mejora su distancia, y al desencolarlo se
+// descartan los elementos con una distancia que ya no es la vigente.
+typedef struct {
+	areas_elemento_t *elementos;		// Elementos del montículo
+	size_t cantidad;					// Cantidad de elementos
+	size_t capacidad;					// Capacidad del arreglo
+} areas_monticulo_t;
+
+// Tipo que representa las áreas de un grafo.
+struct _areas_t {
+	grafo_compacto_t *grafo;			// Grafo dividido
+	uint32_t n;							// Cantidad de vértices
+	const uint32_t *inicio;				// Arreglos del grafo compacto
+	const uint32_t *destinos;
+	const uint16_t *pesos16;
+	const uint32_t *pesos32;
+	uint32_t *inicio_entrantes;			// Aristas que llegan a cada
+	uint32_t *origenes_entrantes;		// vértice, en formato CSR
+	uint32_t *pesos_entrantes;
+	bool pesos_nulos;					// Indica si hay aristas de peso 0
+	uint32_t cantidad;					// Cantidad de áreas
+	uint32_t *area;						// Área de cada vértice
+	uint32_t *inicio_area;				// Vértices de cada área, en las
+	uint32_t *vertices;					// posiciones [inicio_area[a],
+										// inicio_area[a + 1]) de 'vertices'
+	unsigned char *borde;				// Marcas de borde de cada vértice
+	uint32_t bordes;					// Cantidad de bordes
+	uint32_t *inicio_entradas;			// Bordes de entrada de cada área
+	uint32_t *entradas;
+	uint32_t *inicio_salidas;			// Bordes de salida de cada área
+	uint32_t *salidas;
+	uint32_t *indice_entrada;			// Posición de cada borde de entrada
+										// entre los de su área
+	size_t *inicio_atajos;				// Atajos de cada área: la distancia
+	uint32_t *atajos;					// de su i-ésima entrada a su j-ésima
+										// salida ocupa la posición
+										// inicio_atajos[a] + i * salidas + j
+	bool *con_atajos;					// Indica si ya se calcularon los
+										// atajos de cada área
+	uint32_t calculadas;				// Áreas con los atajos calculados
+	uint32_t *auxiliares;				// Distancias para calcular atajos,
+										// INFINITO fuera de ese cálculo
+	areas_monticulo_t monticulo;		// Montículo para calcular atajos
+	uint32_t expandidas;				// Áreas expandidas en el último
+										// cálculo de caminos
+};
+
+
+
+/* ****************************************************************************
+ * FUNCIONES AUXILIARES
+ * ***************************************************************************/
+
+// Devuelve el peso de una arista.
+// PRE: 'areas' son áreas existentes; 'e' es una arista del grafo.
+static inline uint32_t areas_peso(const areas_t *areas, uint32_t e) {
+	return areas->pesos16 ? areas->pesos16[e] : areas->pesos32[e];
+}
+
+// Indica si un vértice precede a otro en el orden en que los marcaría
+// Dijkstra.
+// PRE: 'areas' son áreas existentes; 'distancias' son las distancias
+// desde el origen; 'criterio()' es el criterio de selección; 'u' es un
+// vértice alcanzable; 'p' es un vértice o GRAFO_COMPACTO_SIN_VERTICE.
+// POST: devuelve true si 'p' no es un vértice o si 'u' tiene menor
+// distancia, o igual distancia y lo elige el criterio (o, si este no
+// decide, tiene menor índice).
+static bool areas_precede(const areas_t *areas, const uint32_t *distancias,
+	int criterio(lista_dato_t, lista_dato_t), uint32_t u, uint32_t p) {
+	if(p == GRAFO_COMPACTO_SIN_VERTICE) return true;
+	if(distancias[u] != distancias[p]) return distancias[u] < distancias[p];
+
+	int c = criterio(grafo_compacto_obtener_dato(areas->grafo, u),
+		grafo_compacto_obtener_dato(areas->grafo, p));
+	return c ? c < 0 : u < p;
+}
+
+// Encola un vértice en un montículo.
+// PRE: 'm' es un montículo; 'distancia' es la distancia del vértice 'v'.
+// POST: devuelve false si no hubo memoria suficiente o true en caso
+// contrario.
+static bool areas_encolar(areas_monticulo_t *m, uint32_t distancia,
+	uint32_t v) {
+	size_t i, padre;
+
+	if(m->cantidad == m->capacidad) {
+		size_t capacidad = m->capacidad ? 2 * m->capacidad : 64;
+		areas_elemento_t *elementos = (areas_elemento_t*)
+			estadisticas_realloc(SUBSISTEMA_AREAS, m->elementos,
+			capacidad * sizeof(areas_elemento_t));
+		if(!elementos) return false;
+
+		m->elementos = elementos;
+		m->capacidad = capacidad;
+	}
+
+	// Subimos el elemento mientras su padre tenga una distancia mayor
+	for(i = m->cantidad++; i; i = padre) {
+		padre = (i - 1) / 2;
+		if(m->elementos[padre].distancia <= distancia) break;
+		m->elementos[i] = m->elementos[padre];
+	}
+
+	m->elementos[i].distancia = distancia;
+	m->elementos[i].vertice = v;
+	return true;
+}
+
+// Desencola el elemento de menor distancia de un montículo.
+// PRE: 'm' es un montículo no vacío.
+// POST: devuelve el elemento, que se quitó del montículo.
+static areas_elemento_t areas_desencolar(areas_monticulo_t *m) {
+	areas_elemento_t minimo = m->elementos[0];
+	areas_elemento_t ultimo = m->elementos[--m->cantidad];
+	size_t i = 0, hijo;
+
+	// Bajamos el último elemento mientras algún hijo tenga menor distancia
+	while((hijo = 2 * i + 1) < m->cantidad) {
+		if(hijo + 1 < m->cantidad &&
+			m->elementos[hijo + 1].distancia < m->elementos[hijo].distancia)
+			hijo++;
+		if(ultimo.distancia <= m->elementos[hijo].distancia) break;
+
+		m->elementos[i] = m->elementos[hijo];
+		i = hijo;
+	}
+
+	if(m->cantidad) m->elementos[i] = ultimo;
+	return minimo;
+}
+
+// Recorre un área desde los vértices encolados, sin salir de ella.
+// PRE: 'areas' son áreas existentes; 'a' es un área; 'distancias' tiene
+// la distancia provisoria de cada vértice; 'm' tiene encolados los
+// vértices de partida con su distancia.
+// POST: las distancias de los vértices del área son las mínimas por
+// caminos dentro del área desde los vértices de partida, y el montículo
+// quedó vacío. Devuelve false si no hubo memoria suficiente.
+static bool areas_recorrer(const areas_t *areas, uint32_t a,
+	uint32_t *distancias, areas_monticulo_t *m) {
+	uint32_t e, v;
+	uint64_t distancia;
+
+	while(m->cantidad) {
+		areas_elemento_t actual = areas_desencolar(m);
+		if(actual.distancia != distancias[actual.vertice]) continue;
+
+		for(e = areas->inicio[actual.vertice];
+			e < areas->inicio[actual.vertice + 1]; e++) {
+			v = areas->destinos[e];
+			if(areas->area[v] != a) continue;
+
+			// Las sumas que alcanzan INFINITO nunca mejoran una distancia
+			distancia = (uint64_t) actual.distancia + areas_peso(areas, e);
+			if(distancia >= distancias[v]) continue;
+
+			distancias[v] = distancia;
+			if(!areas_encolar(m, distancia, v)) return false;
+		}
+	}
+
+	return true;
+}
+
+// Expande un área, calculando la distancia desde el origen de cada uno de
+// sus vértices.
+// PRE: 'areas' son áreas existentes; 'a' es un área; 'o' es el origen;
+// 'distancias' tiene las distancias desde el origen de los bordes de
+// entrada de todas las áreas, y 0 para el origen.
+// POST: las distancias de los vértices del área son las mínimas desde el
+// origen. Devuelve false si no hubo memoria suficiente.
+static bool areas_expandir(areas_t *areas, uint32_t a, uint32_t o,
+	uint32_t *distancias, areas_monticulo_t *m) {
+	uint32_t i, v;
+
+	for(i = areas->inicio_area[a]; i < areas->inicio_area[a + 1]; i++) {
+		v = areas->vertices[i];
+
+		if(v != o && !(areas->borde[v] & BORDE_ENTRADA))
+			distancias[v] = INFINITO;
+		else if(distancias[v] != INFINITO &&
+			!areas_encolar(m, distancias[v], v))
+			return false;
+	}
+
+	areas->expandidas++;
+	return areas_recorrer(areas, a, distancias, m);
+}
+
+// Divide los vértices de un grafo en áreas de vértices cercanos.
+// PRE: 'areas' son áreas con las aristas entrantes ya calculadas;
+// 'cantidad' es la cantidad de áreas deseada (al menos 1).
+// POST: se cargó el área de cada vértice y la cantidad de áreas. Devuelve
+// false si no hubo memoria suficiente.
+static bool areas_particionar(areas_t *areas, uint32_t cantidad) {
+	uint32_t v, s, e, w, u, primero, ultimo, asignados;
+	uint32_t tamano = areas->n / cantidad + (areas->n % cantidad != 0);
+
+	uint32_t *cola = (uint32_t*) estadisticas_malloc(SUBSISTEMA_AREAS,
+		(areas->n + 1) * sizeof(uint32_t));
+	if(!cola) return false;
+
+	for(v = 0; v < areas->n; v++) areas->area[v] = SIN_AREA;
+	areas->cantidad = 0;
+
+	// Cada área crece en anchura desde el primer vértice sin asignar hasta
+	// alcanzar el tamaño pedido, siguiendo las aristas en ambos sentidos
+	for(s = 0; s < areas->n; s++) {
+		if(areas->area[s] != SIN_AREA) continue;
+
+		areas->area[s] = areas->cantidad;
+		cola[0] = s;
+		primero = 0;
+		ultimo = asignados = 1;
+
+		while(primero < ultimo && asignados < tamano) {
+			u = cola[primero++];
+
+			for(e = areas->inicio[u]; e < areas->inicio[u + 1] &&
+				asignados < tamano; e++) {
+				w = areas->destinos[e];
+				if(areas->area[w] != SIN_AREA) continue;
+				areas->area[w] = areas->cantidad;
+				cola[ultimo++] = w;
+				asignados++;
+			}
+
+			for(e = areas->inicio_entrantes[u]; e < areas->inicio_entrantes[u
+				+ 1] && asignados < tamano; e++) {
+				w = areas->origenes_entrantes[e];
+				if(areas->area[w] != SIN_AREA) continue;
+				areas->area[w] = areas->cantidad;
+				cola[ultimo++] = w;
+				asignados++;
+			}
+		}
+
+		areas->cantidad++;
+	}
+
+	estadisticas_free(SUBSISTEMA_AREAS, cola);
+	return true;
+}
+
+// Agrupa en un arreglo los vértices que cumplen una condición, por área.
+// PRE: 'areas' son áreas con el área de cada vértice ya cargada; 'marca'
+// es la marca de borde que deben tener los vértices, o 0 para agruparlos
+// a todos; 'inicio' tiene lugar para un elemento más que la cantidad de
+// áreas y 'vertices' para todos los vértices agrupados.
+// POST: los vértices del área a ocupan, en orden de índice, las
+// posiciones [inicio[a], inicio[a + 1]) de 'vertices'.
+static void areas_agrupar(const areas_t *areas, unsigned char marca,
+	uint32_t *inicio, uint32_t *vertices) {
+	uint32_t a, v, acumulado = 0, cantidad;
+
+	for(a = 0; a <= areas->cantidad; a++) inicio[a] = 0;
+
+	for(v = 0; v < areas->n; v++)
+		if(!marca || (areas->borde[v] & marca)) inicio[areas->area[v]]++;
+
+	for(a = 0; a <= areas->cantidad; a++) {
+		cantidad = inicio[a];
+		inicio[a] = acumulado;
+		acumulado += cantidad;
+	}
+
+	// Cada área avanza su inicio al ubicar sus vértices; luego se lo
+	// recupera del área anterior
+	for(v = 0; v < areas->n; v++)
+		if(!marca || (areas->borde[v] & marca))
+			vertices[inicio[areas->area[v]]++] = v;
+
+	for(a = areas->cantidad; a > 0; a--) inicio[a] = inicio[a - 1];
+	inicio[0] = 0;
+}
+
+// Calcula las aristas que llegan a cada vértice.
+// PRE: 'areas' son áreas con los arreglos del grafo ya cargados; 'm' es
+// la cantidad de aristas.
+// POST: se cargaron las aristas entrantes. Devuelve false si no hubo
+// memoria suficiente.
+static bool areas_calcular_entrantes(areas_t *areas, uint32_t m) {
+	uint32_t u, v, e, acumulado = 0, cantidad;
+
+	areas->inicio_entrantes = (uint32_t*) estadisticas_malloc(
+		SUBSISTEMA_AREAS, (areas->n + 1) * sizeof(uint32_t));
+	areas->origenes_entrantes = (uint32_t*) estadisticas_malloc(
+		SUBSISTEMA_AREAS, (m + 1) * sizeof(uint32_t));
+	areas->pesos_entrantes = (uint32_t*) estadisticas_malloc(
+		SUBSISTEMA_AREAS, (m + 1) * sizeof(uint32_t));
+	if(!areas->inicio_entrantes || !areas->origenes_entrantes ||
+		!areas->pesos_entrantes)
+		return false;
+
+	for(v = 0; v <= areas->n; v++) areas->inicio_entrantes[v] = 0;
+	for(e = 0; e < m; e++) areas->inicio_entrantes[areas->destinos[e]]++;
+
+	for(v = 0; v <= areas->n; v++) {
+		cantidad = areas->inicio_entrantes[v];
+		areas->inicio_entrantes[v] = acumulado;
+		acumulado += cantidad;
+	}
+
+	for(u = 0; u < areas->n; u++)
+		for(e = areas->inicio[u]; e < areas->inicio[u + 1]; e++) {
+			uint32_t i = areas->inicio_entrantes[areas->destinos[e]]++;
+			areas->origenes_entrantes[i] = u;
+			areas->pesos_entrantes[i] = areas_peso(areas, e);
+		}
+
+	for(v = areas->n; v > 0; v--)
+		areas->inicio_entrantes[v] = areas->inicio_entrantes[v - 1];
+	areas->inicio_entrantes[0] = 0;
+
+	return true;
+}
+
+// Reserva el lugar de los atajos de todas las áreas, sin calcularlos.
+// PRE: 'areas' son áreas con sus bordes ya agrupados.
+// POST: se reservaron los atajos, marcados como no calculados. Devuelve
+// false si no hubo memoria suficiente.
+static bool areas_reservar_atajos(areas_t *areas) {
+	uint32_t a, v;
+	size_t total = 0;
+
+	areas->inicio_atajos = (size_t*) estadisticas_malloc(SUBSISTEMA_AREAS,
+		(areas->cantidad + 1) * sizeof(size_t));
+	areas->con_atajos = (bool*) estadisticas_malloc(SUBSISTEMA_AREAS,
+		(areas->cantidad + 1) * sizeof(bool));
+	areas->auxiliares = (uint32_t*) estadisticas_malloc(SUBSISTEMA_AREAS,
+		(areas->n + 1) * sizeof(uint32_t));
+	if(!areas->inicio_atajos || !areas->con_atajos || !areas->auxiliares)
+		return false;
+
+	for(a = 0; a < areas->cantidad; a++) {
+		areas->inicio_atajos[a] = total;
+		areas->con_atajos[a] = false;
+		total += (size_t) (areas->inicio_entradas[a + 1] -
+			areas->inicio_entradas[a]) * (areas->inicio_salidas[a + 1] -
+			areas->inicio_salidas[a]);
+	}
+
+	areas->inicio_atajos[areas->cantidad] = total;
+
+	for(v = 0; v < areas->n; v++) areas->auxiliares[v] = INFINITO;
+
+	areas->atajos = (uint32_t*) estadisticas_malloc(SUBSISTEMA_AREAS,
+		(total + 1) * sizeof(uint32_t));
+	return areas->atajos != NULL;
+}
+
+// Calcula, dentro de un área, la distancia desde cada borde de entrada
+// hacia cada borde de salida.
+// PRE: 'areas' son áreas con los atajos ya reservados; 'a' es un área
+// cuyos atajos aún no se calcularon.
+// POST: se cargaron los atajos del área. Devuelve false si no hubo
+// memoria suficiente.
+static bool areas_calcular_atajos(areas_t *areas, uint32_t a) {
+	uint32_t i, j, v;
+	uint32_t entradas = areas->inicio_entradas[a + 1] -
+		areas->inicio_entradas[a];
+	uint32_t salidas = areas->inicio_salidas[a + 1] -
+		areas->inicio_salidas[a];
+	uint32_t *distancias = areas->auxiliares;
+
+	for(i = 0; salidas && i < entradas; i++) {
+		uint32_t *fila = areas->atajos + areas->inicio_atajos[a] +
+			(size_t) i * salidas;
+
+		v = areas->entradas[areas->inicio_entradas[a] + i];
+		distancias[v] = 0;
+		if(!areas_encolar(&areas->monticulo, 0, v) ||
+			!areas_recorrer(areas, a, distancias, &areas->monticulo))
+			return false;
+
+		for(j = 0; j < salidas; j++)
+			fila[j] = distancias[areas->salidas[areas->inicio_salidas[a] + j]];
+
+		// Dejamos el área como estaba para el siguiente recorrido
+		for(j = areas->inicio_area[a]; j < areas->inicio_area[a + 1]; j++)
+			distancias[areas->vertices[j]] = INFINITO;
+	}
+
+	areas->con_atajos[a] = true;
+	areas->calculadas++;
+	return true;
+}
+
+// Inicia el recorrido del grafo superpuesto desde un origen, recorriendo
+// su área.
+// PRE: 'areas' son áreas existentes; 'o' es el origen; 'distancias' vale
+// INFINITO para todos los vértices; 'm' es un montículo vacío.
+// POST: se cargó la distancia dentro de su área hacia los bordes de
+// esta, que quedaron encolados en el montículo, y 0 para el origen.
+// Devuelve false si no hubo memoria suficiente.
+static bool areas_iniciar_superpuesto(areas_t *areas, uint32_t o,
+	uint32_t *distancias, areas_monticulo_t *m) {
+	uint32_t i, v, a = areas->area[o];
+
+	// Recorremos el área del origen en un arreglo aparte, ya que sólo
+	// interesan las distancias a sus bordes
+	uint32_t *locales = (uint32_t*) estadisticas_malloc(SUBSISTEMA_AREAS,
+		areas->n * sizeof(uint32_t));
+	if(!locales) return false;
+
+	for(i = areas->inicio_area[a]; i < areas->inicio_area[a + 1]; i++)
+		locales[areas->vertices[i]] = INFINITO;
+
+	locales[o] = 0;
+	if(!areas_encolar(m, 0, o) || !areas_recorrer(areas, a, locales, m)) {
+		estadisticas_free(SUBSISTEMA_AREAS, locales);
+		return false;
+	}
+
+	distancias[o] = 0;
+
+	for(i = areas->inicio_area[a]; i < areas->inicio_area[a + 1]; i++) {
+		v = areas->vertices[i];
+		if(!areas->borde[v] || locales[v] == INFINITO) continue;
+
+		distancias[v] = locales[v];
+		if(!areas_encolar(m, locales[v], v)) {
+			estadisticas_free(SUBSISTEMA_AREAS, locales);
+			return false;
+		}
+	}
+
+	estadisticas_free(SUBSISTEMA_AREAS, locales);
+	return true;
+}
+
+// Avanza el recorrido del grafo superpuesto, fijando la distancia desde
+// el origen de los bordes en orden creciente.
+// PRE: 'areas' son áreas existentes; 'distancias' y 'm' son las del
+// recorrido iniciado con areas_iniciar_superpuesto(); 'destino' indica
+// las áreas de los destinos; 'pendientes' es la cantidad de bordes de
+// entrada de esas áreas aún sin fijar, o NULL para no considerarlos;
+// 'limite' es la mayor distancia que interesa fijar.
+// POST: se fijaron los bordes hasta fijar todos los pendientes o superar
+// el límite, o hasta agotar el recorrido. Los bordes aún sin fijar tienen
+// una distancia mayor que la de los fijados. Se calcularon los atajos de
+// las áreas a cuyos bordes de entrada se llegó. Devuelve false si no hubo
+// memoria suficiente.
+static bool areas_avanzar_superpuesto(areas_t *areas, uint32_t *distancias,
+	areas_monticulo_t *m, const bool *destino, uint32_t *pendientes,
+	uint32_t limite) {
+	uint32_t j, e, u, v, a, salidas;
+	uint64_t distancia;
+
+	// Los bordes de salida continúan por las aristas hacia otras áreas, y
+	// los de entrada por los atajos hacia las salidas de su área
+	while(m->cantidad && (!pendientes || *pendientes)) {
+		if(m->elementos[0].distancia > limite) break;
+
+		areas_elemento_t actual = areas_desencolar(m);
+		u = actual.vertice;
+		if(actual.distancia != distancias[u]) continue;
+
+		if(areas->borde[u] & BORDE_SALIDA)
+			for(e = areas->inicio[u]; e < areas->inicio[u + 1]; e++) {
+				v = areas->destinos[e];
+				if(areas->area[v] == areas->area[u]) continue;
+
+				distancia = (uint64_t) actual.distancia + areas_peso(areas, e);
+				if(distancia >= distancias[v]) continue;
+
+				distancias[v] = distancia;
+				if(!areas_encolar(m, distancia, v)) return false;
+			}
+
+		if(areas->borde[u] & BORDE_ENTRADA) {
+			a = areas->area[u];
+			if(pendientes && destino[a]) (*pendientes)--;
+			if(!areas->con_atajos[a] && !areas_calcular_atajos(areas, a))
+				return false;
+
+			salidas = areas->inicio_salidas[a + 1] - areas->inicio_salidas[a];
+			const uint32_t *fila = areas->atajos + areas->inicio_atajos[a] +
+				(size_t) areas->indice_entrada[u] * salidas;
+
+			for(j = 0; j < salidas; j++) {
+				if(fila[j] == INFINITO) continue;
+				v = areas->salidas[areas->inicio_salidas[a] + j];
+
+				distancia = (uint64_t) actual.distancia + fila[j];
+				if(distancia >= distancias[v]) continue;
+
+				distancias[v] = distancia;
+				if(!areas_encolar(m, distancia, v)) return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+
+
+/* ****************************************************************************
+ * PRIMITIVAS DE LAS ÁREAS
+ * ***************************************************************************/
+
+// Divide un grafo compacto en áreas.
+// PRE: 'grafo' es un grafo compacto; 'area' es el número de área de cada
+// vértice, de 0 a 'cantidad' - 1, o NULL para que las áreas se armen en
+// forma automática; 'cantidad' es la cantidad de áreas (al menos 1).
+// POST: devuelve las áreas del grafo, sin atajos calculados, o NULL si no
+// hubo memoria suficiente. Las áreas automáticas se arman por recorrido
+// en anchura (sin considerar el sentido de las aristas), de a grupos de
+// vértices cercanos de igual tamaño, por lo que pueden resultar algunas
+// más que las pedidas. El grafo debe existir mientras se utilicen las
+// áreas.
+areas_t* areas_crear(grafo_compacto_t *grafo, const uint32_t *area,
+	uint32_t cantidad) {
+	uint32_t u, v, e, i, m = grafo_compacto_cantidad_aristas(grafo);
+
+	areas_t *areas = (areas_t*) estadisticas_malloc(SUBSISTEMA_AREAS,
+		sizeof(areas_t));
+	if(!areas) return NULL;
+
+	areas->grafo = grafo;
+	areas->n = grafo_compacto_cantidad_vertices(grafo);
+	grafo_compacto_obtener_arreglos(grafo, &areas->inicio, &areas->destinos,
+		&areas->pesos16, &areas->pesos32);
+	areas->inicio_entrantes = areas->origenes_entrantes = NULL;
+	areas->pesos_entrantes = NULL;
+	areas->cantidad = cantidad ? cantidad : 1;
+	areas->inicio_area = areas->vertices = NULL;
+	areas->borde = NULL;
+	areas->bordes = 0;
+	areas->inicio_entradas = areas->entradas = NULL;
+	areas->inicio_salidas = areas->salidas = NULL;
+	areas->indice_entrada = NULL;
+	areas->inicio_atajos = NULL;
+	areas->atajos = NULL;
+	areas->con_atajos = NULL;
+	areas->calculadas = 0;
+	areas->auxiliares = NULL;
+	areas->monticulo.elementos = NULL;
+	areas->monticulo.cantidad = areas->monticulo.capacidad = 0;
+	areas->expandidas = 0;
+
+	areas->pesos_nulos = false;
+	for(e = 0; e < m; e++)
+		if(!areas_peso(areas, e)) areas->pesos_nulos = true;
+
+	areas->area = (uint32_t*) estadisticas_malloc(SUBSISTEMA_AREAS,
+		(areas->n + 1) * sizeof(uint32_t));
+	if(!areas->area || !areas_calcular_entrantes(areas, m)) {
+		areas_destruir(areas);
+		return NULL;
+	}
+
+	if(area)
+		for(v = 0; v < areas->n; v++) areas->area[v] = area[v];
+	else if(!areas_particionar(areas, areas->cantidad)) {
+		areas_destruir(areas);
+		return NULL;
+	}
+
+	areas->borde = (unsigned char*) estadisticas_malloc(SUBSISTEMA_AREAS,
+		areas->n + 1);
+	areas->indice_entrada = (uint32_t*) estadisticas_malloc(
+		SUBSISTEMA_AREAS, (areas->n + 1) * sizeof(uint32_t));
+	areas->inicio_area = (uint32_t*) estadisticas_malloc(SUBSISTEMA_AREAS,
+		(areas->cantidad + 1) * sizeof(uint32_t));
+	areas->vertices = (uint32_t*) estadisticas_malloc(SUBSISTEMA_AREAS,
+		(areas->n + 1) * sizeof(uint32_t));
+	areas->inicio_entradas = (uint32_t*) estadisticas_malloc(
+		SUBSISTEMA_AREAS, (areas->cantidad + 1) * sizeof(uint32_t));
+	areas->inicio_salidas = (uint32_t*) estadisticas_malloc(
+		SUBSISTEMA_AREAS, (areas->cantidad + 1) * sizeof(uint32_t));
+	if(!areas->borde || !areas->indice_entrada || !areas->inicio_area ||
+		!areas->vertices || !areas->inicio_entradas ||
+		!areas->inicio_salidas) {
+		areas_destruir(areas);
+		return NULL;
+	}
+
+	// Marcamos los extremos de las aristas entre áreas distintas
+	for(v = 0; v < areas->n; v++) areas->borde[v] = 0;
+
+	for(u = 0; u < areas->n; u++)
+		for(e = areas->inicio[u]; e < areas->inicio[u + 1]; e++) {
+			v = areas->destinos[e];
+			if(areas->area[u] == areas->area[v]) continue;
+			areas->borde[u] |= BORDE_SALIDA;
+			areas->borde[v] |= BORDE_ENTRADA;
+		}
+
+	for(v = 0; v < areas->n; v++) if(areas->borde[v]) areas->bordes++;
+
+	areas_agrupar(areas, 0, areas->inicio_area, areas->vertices);
+
+	areas->entradas = (uint32_t*) estadisticas_malloc(SUBSISTEMA_AREAS,
+		(areas->n + 1) * sizeof(uint32_t));
+	areas->salidas = (uint32_t*) estadisticas_malloc(SUBSISTEMA_AREAS,
+		(areas->n + 1) * sizeof(uint32_t));
+	if(!areas->entradas || !areas->salidas) {
+		areas_destruir(areas);
+		return NULL;
+	}
+
+	areas_agrupar(areas, BORDE_ENTRADA, areas->inicio_entradas,
+		areas->entradas);
+	areas_agrupar(areas, BORDE_SALIDA, areas->inicio_salidas,
+		areas->salidas);
+
+	for(u = 0; u < areas->cantidad; u++)
+		for(i = areas->inicio_entradas[u]; i < areas->inicio_entradas[u + 1];
+			i++)
+			areas->indice_entrada[areas->entradas[i]] =
+				i - areas->inicio_entradas[u];
+
+	// Con aristas de peso nulo los caminos se calculan con Dijkstra, por lo
+	// que no se necesitan los atajos
+	if(!areas->pesos_nulos && !areas_reservar_atajos(areas)) {
+		areas_destruir(areas);
+		return NULL;
+	}
+
+	return areas;
+}
+
+// Destruye las áreas de un grafo.
+// PRE: 'areas' son áreas existentes.
+// POST: se liberó la memoria ocupada por las áreas, mas no así la del
+// grafo.
+void areas_destruir(areas_t *areas) {
+	estadisticas_free(SUBSISTEMA_AREAS, areas->inicio_entrantes);
+	estadisticas_free(SUBSISTEMA_AREAS, areas->origenes_entrantes);
+	estadisticas_free(SUBSISTEMA_AREAS, areas->pesos_entrantes);
+	estadisticas_free(SUBSISTEMA_AREAS, areas->area);
+	estadisticas_free(SUBSISTEMA_AREAS, areas->inicio_area);
+	estadisticas_free(SUBSISTEMA_AREAS, areas->vertices);
+	estadisticas_free(SUBSISTEMA_AREAS, areas->borde);
+	estadisticas_free(SUBSISTEMA_AREAS, areas->inicio_entradas);
+	estadisticas_free(SUBSISTEMA_AREAS, areas->entradas);
+	estadisticas_free(SUBSISTEMA_AREAS, areas->inicio_salidas);
+	estadisticas_free(SUBSISTEMA_AREAS, areas->salidas);
+	estadisticas_free(SUBSISTEMA_AREAS, areas->indice_entrada);
+	estadisticas_free(SUBSISTEMA_AREAS, areas->inicio_atajos);
+	estadisticas_free(SUBSISTEMA_AREAS, areas->atajos);
+	estadisticas_free(SUBSISTEMA_AREAS, areas->con_atajos);
+	estadisticas_free(SUBSISTEMA_AREAS, areas->auxiliares);
+	estadisticas_free(SUBSISTEMA_AREAS, areas->monticulo.elementos);
+	estadisticas_free(SUBSISTEMA_AREAS, areas);
+}
+
+// Devuelve la cantidad de áreas.
+// PRE: 'areas' son áreas existentes.
+uint32_t areas_cantidad(const areas_t *areas) {
+	return areas->cantidad;
+}
+
+// Devuelve la cantidad de vértices que son bordes de alguna área.
+// PRE: 'areas' son áreas existentes.
+uint32_t areas_cantidad_bordes(const areas_t *areas) {
+	return areas->bordes;
+}
+
+// Devuelve la cantidad de áreas que expandió el último cálculo de caminos.
+// PRE: 'areas' son áreas existentes.
+uint32_t areas_cantidad_expandidas(const areas_t *areas) {
+	return areas->expandidas;
+}
+
+// Devuelve la cantidad de áreas cuyos atajos ya fueron calculados.
+// PRE: 'areas' son áreas existentes.
+uint32_t areas_cantidad_con_atajos(const areas_t *areas) {
+	return areas->calculadas;
+}
+
+// Calcula los caminos mínimos desde un origen hacia un conjunto de
+// destinos, utilizando las áreas.
+// PRE: 'areas' son las áreas de un grafo; 'origen' y 'criterio_seleccion()'
+// cumplen lo mismo que en dijkstra_caminos_minimos(); 'destinos' son los
+// datos de 'cantidad' vértices destino.
+// POST: devuelve resultados cuyos caminos hacia cada destino son los
+// mismos que los de dijkstra_caminos_minimos(), o NULL si 'origen' no es
+// un vértice del grafo o no hubo memoria suficiente. Los caminos hacia
+// los demás vértices no son válidos. Si el grafo tiene aristas de peso
+// nulo, el orden en que se eligen los previos depende del orden de
+// marcado de Dijkstra, por lo que se utiliza dijkstra_caminos_minimos().
+dijkstra_resultados_t* areas_caminos_minimos(areas_t *areas,
+	lista_dato_t origen, int criterio_seleccion(lista_dato_t, lista_dato_t),
+	const lista_dato_t *destinos, size_t cantidad) {
+	uint32_t v, u, p, e, a, j, pendientes = 0, limite = 0;
+	size_t i;
+	areas_monticulo_t m = { NULL, 0, 0 }, expansion = { NULL, 0, 0 };
+	bool correcto = true;
+
+	uint32_t o = grafo_compacto_buscar_vertice(areas->grafo, origen);
+	if(o == GRAFO_COMPACTO_SIN_VERTICE) return NULL;
+
+	if(areas->pesos_nulos)
+		return dijkstra_caminos_minimos(areas->grafo, origen,
+			criterio_seleccion);
+
+	uint32_t *distancias = (uint32_t*) estadisticas_malloc(
+		SUBSISTEMA_DIJKSTRA, areas->n * sizeof(uint32_t));
+	uint32_t *previos = (uint32_t*) estadisticas_malloc(SUBSISTEMA_DIJKSTRA,
+		areas->n * sizeof(uint32_t));
+	bool *expandida = (bool*) estadisticas_malloc(SUBSISTEMA_AREAS,
+		areas->cantidad * sizeof(bool));
+	bool *destino = (bool*) estadisticas_malloc(SUBSISTEMA_AREAS,
+		areas->cantidad * sizeof(bool));
+
+	if(!distancias || !previos || !expandida || !destino) {
+		estadisticas_free(SUBSISTEMA_DIJKSTRA, distancias);
+		estadisticas_free(SUBSISTEMA_DIJKSTRA, previos);
+		estadisticas_free(SUBSISTEMA_AREAS, expandida);
+		estadisticas_free(SUBSISTEMA_AREAS, destino);
+		return NULL;
+	}
+
+	// Los contadores de Dijkstra no aplican a esta ejecución
+	dijkstra_reiniciar_contadores();
+
+	for(v = 0; v < areas->n; v++) {
+		distancias[v] = INFINITO;
+		previos[v] = GRAFO_COMPACTO_SIN_VERTICE;
+	}
+
+	for(a = 0; a < areas->cantidad; a++) expandida[a] = destino[a] = false;
+	areas->expandidas = 0;
+
+	// Marcamos las áreas de los destinos y contamos sus bordes de entrada
+	for(i = 0; i < cantidad; i++) {
+		v = grafo_compacto_buscar_vertice(areas->grafo, destinos[i]);
+		if(v == GRAFO_COMPACTO_SIN_VERTICE || destino[areas->area[v]])
+			continue;
+
+		a = areas->area[v];
+		destino[a] = true;
+		pendientes += areas->inicio_entradas[a + 1] -
+			areas->inicio_entradas[a];
+	}
+
+	// Recorremos el grafo superpuesto hasta fijar esos bordes, y con ellos
+	// expandimos las áreas de los destinos. Sus bordes de salida vuelven a
+	// encolarse con la distancia obtenida, que puede ser menor que la que
+	// les asignó el grafo superpuesto si aún no estaban fijados.
+	correcto = areas_iniciar_superpuesto(areas, o, distancias, &m) &&
+		areas_avanzar_superpuesto(areas, distancias, &m, destino,
+		&pendientes, INFINITO);
+
+	for(a = 0; correcto && a < areas->cantidad; a++) {
+		if(!destino[a]) continue;
+
+		expandida[a] = true;
+		correcto = areas_expandir(areas, a, o, distancias, &expansion);
+
+		for(j = areas->inicio_salidas[a]; correcto &&
+			j < areas->inicio_salidas[a + 1]; j++) {
+			v = areas->salidas[j];
+			if(distancias[v] != INFINITO)
+				correcto = areas_encolar(&m, distancias[v], v);
+		}
+	}
+
+	// Ningún camino hacia un destino pasa por un vértice más lejano que el
+	// destino más lejano, por lo que el recorrido se detiene al superarlo
+	for(i = 0; correcto && i < cantidad; i++) {
+		v = grafo_compacto_buscar_vertice(areas->grafo, destinos[i]);
+		if(v != GRAFO_COMPACTO_SIN_VERTICE && distancias[v] != INFINITO &&
+			distancias[v] > limite)
+			limite = distancias[v];
+	}
+
+	correcto = correcto && areas_avanzar_superpuesto(areas, distancias, &m,
+		destino, NULL, limite);
+
+	// Recorremos el camino hacia cada destino desde su final, expandiendo
+	// las áreas a medida que se llega a ellas. Un camino termina al llegar
+	// al origen o a un vértice cuyo previo ya se eligió.
+	for(i = 0; correcto && i < cantidad; i++) {
+		v = grafo_compacto_buscar_vertice(areas->grafo, destinos[i]);
+		if(v == GRAFO_COMPACTO_SIN_VERTICE) continue;
+
+		if(!expandida[areas->area[v]]) {
+			expandida[areas->area[v]] = true;
+			correcto = areas_expandir(areas, areas->area[v], o, distancias,
+				&expansion);
+		}
+
+		if(distancias[v] == INFINITO) continue;
+
+		while(correcto && v != o && previos[v] == GRAFO_COMPACTO_SIN_VERTICE) {
+			p = GRAFO_COMPACTO_SIN_VERTICE;
+
+			for(e = areas->inicio_entrantes[v];
+				e < areas->inicio_entrantes[v + 1]; e++) {
+				u = areas->origenes_entrantes[e];
+				if(distancias[u] == INFINITO || (uint64_t) distancias[u] +
+					areas->pesos_entrantes[e] != distancias[v])
+					continue;
+
+				// Nos quedamos con el vecino que precede a los demás
+				if(areas_precede(areas, distancias, criterio_seleccion, u, p))
+					p = u;
+			}
+
+			if(p == GRAFO_COMPACTO_SIN_VERTICE) break;
+			previos[v] = p;
+
+			if(!expandida[areas->area[p]]) {
+				expandida[areas->area[p]] = true;
+				correcto = areas_expandir(areas, areas->area[p], o,
+					distancias, &expansion);
+			}
+
+			v = p;
+		}
+	}
+
+	estadisticas_free(SUBSISTEMA_AREAS, m.elementos);
+	estadisticas_free(SUBSISTEMA_AREAS, expansion.elementos);
+	estadisticas_free(SUBSISTEMA_AREAS, expandida);
+	estadisticas_free(SUBSISTEMA_AREAS, destino);
+
+	if(!correcto) {
+		estadisticas_free(SUBSISTEMA_DIJKSTRA, distancias);
+		estadisticas_free(SUBSISTEMA_DIJKSTRA, previos);
+		return NULL;
+	}
+
+	return dijkstra_crear_resultados(areas->grafo, distancias, previos);
+}
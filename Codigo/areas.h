@@ -0,0 +1,98 @@
+/* ****************************************************************************
+ * ****************************************************************************
+ * TAD ÁREAS
+ * ..................................................................
+ *
+ * División de un grafo compacto en áreas para calcular caminos mínimos
+ * en forma jerárquica, al modo de las áreas de OSPF (Dijkstra de varios
+ * niveles).
+ *
+ * Los vértices con alguna arista hacia otra área son bordes de salida, y
+ * los vértices con alguna arista desde otra área son bordes de entrada.
+ * Dentro de cada área se calcula la distancia desde cada borde de entrada
+ * hacia cada borde de salida. Esos atajos, junto con las aristas entre
+ * áreas, forman un grafo superpuesto que sólo tiene a los bordes como
+ * vértices. Los atajos de un área se calculan la primera vez que un
+ * cálculo de caminos llega a ella, y se reutilizan en los siguientes.
+ *
+ * Para calcular los caminos desde un origen se recorre su área, luego el
+ * grafo superpuesto hasta superar la distancia de los destinos pedidos,
+ * y finalmente se expanden sólo las áreas de esos destinos y las que
+ * atraviesan sus caminos.
+ *
+ * ****************************************************************************
+ * ***************************************************************************/
+
+
+#ifndef AREAS_H
+#define AREAS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "dijkstra.h"
+
+
+
+/* ****************************************************************************
+ * DECLARACIÓN DE LOS TIPOS DE DATOS
+ * ***************************************************************************/
+
+typedef struct _areas_t areas_t;
+
+
+
+/* ****************************************************************************
+ * PRIMITIVAS DE LAS ÁREAS
+ * ***************************************************************************/
+
+// Divide un grafo compacto en áreas.
+// PRE: 'grafo' es un grafo compacto; 'area' es el número de área de cada
+// vértice, de 0 a 'cantidad' - 1, o NULL para que las áreas se armen en
+// forma automática; 'cantidad' es la cantidad de áreas (al menos 1).
+// POST: devuelve las áreas del grafo, sin atajos calculados, o NULL si no
+// hubo memoria suficiente. Las áreas automáticas se arman por recorrido
+// en anchura (sin considerar el sentido de las aristas), de a grupos de
+// vértices cercanos de igual tamaño, por lo que pueden resultar algunas
+// más que las pedidas. El grafo debe existir mientras se utilicen las
+// áreas.
+areas_t* areas_crear(grafo_compacto_t *grafo, const uint32_t *area,
+	uint32_t cantidad);
+
+// Destruye las áreas de un grafo.
+// PRE: 'areas' son áreas existentes.
+// POST: se liberó la memoria ocupada por las áreas, mas no así la del
+// grafo.
+void areas_destruir(areas_t *areas);
+
+// Devuelve la cantidad de áreas.
+// PRE: 'areas' son áreas existentes.
+uint32_t areas_cantidad(const areas_t *areas);
+
+// Devuelve la cantidad de vértices que son bordes de alguna área.
+// PRE: 'areas' son áreas existentes.
+uint32_t areas_cantidad_bordes(const areas_t *areas);
+
+// Devuelve la cantidad de áreas que expandió el último cálculo de caminos.
+// PRE: 'areas' son áreas existentes.
+uint32_t areas_cantidad_expandidas(const areas_t *areas);
+
+// Devuelve la cantidad de áreas cuyos atajos ya fueron calculados.
+// PRE: 'areas' son áreas existentes.
+uint32_t areas_cantidad_con_atajos(const areas_t *areas);
+
+// Calcula los caminos mínimos desde un origen hacia un conjunto de
+// destinos, utilizando las áreas.
+// PRE: 'areas' son las áreas de un grafo; 'origen' y 'criterio_seleccion()'
+// cumplen lo mismo que en dijkstra_caminos_minimos(); 'destinos' son los
+// datos de 'cantidad' vértices destino.
+// POST: devuelve resultados cuyos caminos hacia cada destino son los
+// mismos que los de dijkstra_caminos_minimos(), o NULL si 'origen' no es
+// un vértice del grafo o no hubo memoria suficiente. Los caminos hacia
+// los demás vértices no son válidos. Si el grafo tiene aristas de peso
+// nulo, el orden en que se eligen los previos depende del orden de
+// marcado de Dijkstra, por lo que se utiliza dijkstra_caminos_minimos().
+dijkstra_resultados_t* areas_caminos_minimos(areas_t *areas,
+	lista_dato_t origen, int criterio_seleccion(lista_dato_t, lista_dato_t),
+	const lista_dato_t *destinos, size_t cantidad);
+
+#endif
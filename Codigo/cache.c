@@ -0,0 +1,317 @@
+/* ****************************************************************************
+ * ****************************************************************************
+ * TAD CACHÉ DE ÁRBOLES DE CAMINOS MÍNIMOS
+ * ..................................................................
+ *
+ * Implementación de una caché de los árboles de caminos mínimos (las
+ * distancias y los vértices previos) calculados desde cada origen, para
+ * no volver a calcularlos sobre un grafo que ya se recorrió. Cada árbol
+ * se identifica por el vértice origen y la versión del grafo sobre el que
+ * se calculó (ver grafo_obtener_version()): al modificarse el grafo los
+ * árboles anteriores dejan de encontrarse, y vuelven a encontrarse si
+ * las modificaciones se deshacen.
+ *
+ * La caché tiene un presupuesto de memoria: al guardar un árbol que no
+ * entra se descartan los usados hace más tiempo (LRU). Los árboles se
+ * ubican por una tabla de hash y se ordenan por uso en una lista
+ * doblemente enlazada. La caché no admite ser utilizada desde varios
+ * hilos a la vez.
+ *
+ * ****************************************************************************
+ * ***************************************************************************/
+
+
+#include <stdlib.h>
+#include <string.h>
+#include "cache.h"
+#include "estadisticas.h"
+
+
+
+/* ****************************************************************************
+ * CONSTANTES
+ * ***************************************************************************/
+
+// Cantidad inicial de baldes de la tabla de hash
+#define BALDES_INICIALES 16
+
+
+
+/* ****************************************************************************
+ * DEFINICIÓN DE LOS TIPOS DE DATOS
+ * ***************************************************************************/
+
+// Tipo que representa un árbol almacenado en la caché.
+typedef struct _cache_arbol_t {
+	uint32_t origen;					// Vértice origen
+	uint64_t version;					// Versión del grafo
+	uint32_t *distancias;				// Distancia a cada vértice
+	uint32_t *previos;					// Previo de cada vértice
+	size_t tamano;						// Bytes que ocupa el árbol
+	struct _cache_arbol_t *anterior;	// Árbol usado más recientemente
+	struct _cache_arbol_t *siguiente;	// Árbol usado hace más tiempo
+	struct _cache_arbol_t *siguiente_balde;	// Siguiente árbol del balde
+} cache_arbol_t;
+
+// Tipo que representa una caché de árboles.
+struct _cache_t {
+	size_t presupuesto;					// Máximo de bytes de los árboles
+	size_t ocupado;						// Bytes que ocupan los árboles
+	cache_arbol_t **baldes;				// Tabla de hash de los árboles
+	size_t cantidad_baldes;				// Cantidad de baldes (potencia de 2)
+	size_t cantidad;					// Cantidad de árboles
+	cache_arbol_t *primero;				// Árbol usado más recientemente
+	cache_arbol_t *ultimo;				// Árbol usado hace más tiempo
+	cache_contadores_t contadores;		// Contadores de uso
+};
+
+
+
+/* ****************************************************************************
+ * FUNCIONES AUXILIARES
+ * ***************************************************************************/
+
+// Calcula el balde de un origen y una versión.
+// PRE: 'cache' es una caché existente.
+static size_t cache_balde(const cache_t *cache, uint32_t origen,
+	uint64_t version) {
+	uint64_t x = version * 0x9E3779B97F4A7C15ull ^ origen;
+
+	x ^= x >> 29;
+	x *= 0xBF58476D1CE4E5B9ull;
+	x ^= x >> 32;
+	return x & (cache->cantidad_baldes - 1);
+}
+
+// Destruye un árbol.
+// PRE: 'arbol' es un árbol que no pertenece a ninguna caché.
+static void cache_arbol_destruir(cache_arbol_t *arbol) {
+	estadisticas_free(SUBSISTEMA_CACHE, arbol->distancias);
+	estadisticas_free(SUBSISTEMA_CACHE, arbol->previos);
+	estadisticas_free(SUBSISTEMA_CACHE, arbol);
+}
+
+// Quita un árbol de la lista de uso.
+// PRE: 'arbol' es un árbol de la lista de uso de 'cache'.
+static void cache_desenlazar(cache_t *cache, cache_arbol_t *arbol) {
+	if(arbol->anterior) arbol->anterior->siguiente = arbol->siguiente;
+	else cache->primero = arbol->siguiente;
+
+	if(arbol->siguiente) arbol->siguiente->anterior = arbol->anterior;
+	else cache->ultimo = arbol->anterior;
+}
+
+// Ubica un árbol al principio de la lista de uso.
+// PRE: 'arbol' es un árbol de 'cache' que no está en la lista de uso.
+static void cache_enlazar(cache_t *cache, cache_arbol_t *arbol) {
+	arbol->anterior = NULL;
+	arbol->siguiente = cache->primero;
+
+	if(cache->primero) cache->primero->anterior = arbol;
+	else cache->ultimo = arbol;
+
+	cache->primero = arbol;
+}
+
+// Busca el puntero que referencia a un árbol en su balde.
+// PRE: 'cache' es una caché existente.
+// POST: devuelve la posición que apunta al árbol del origen y la versión
+// dados, o a NULL (al final del balde) si no está.
+static cache_arbol_t** cache_ubicar(cache_t *cache, uint32_t origen,
+	uint64_t version) {
+	cache_arbol_t **actual = &cache->baldes[cache_balde(cache, origen,
+		version)];
+
+	while(*actual && ((*actual)->origen != origen ||
+		(*actual)->version != version))
+		actual = &(*actual)->siguiente_balde;
+
+	return actual;
+}
+
+// Quita un árbol de la caché y lo destruye.
+// PRE: 'posicion' es la posición que apunta al árbol en su balde.
+static void cache_quitar(cache_t *cache, cache_arbol_t **posicion) {
+	cache_arbol_t *arbol = *posicion;
+
+	*posicion = arbol->siguiente_balde;
+	cache_desenlazar(cache, arbol);
+	cache->ocupado -= arbol->tamano;
+	cache->cantidad--;
+	cache_arbol_destruir(arbol);
+}
+
+// Duplica la cantidad de baldes de la tabla de hash.
+// PRE: 'cache' es una caché existente.
+// POST: se redistribuyeron los árboles en la tabla nueva. Si no hubo
+// memoria suficiente, se conserva la tabla anterior.
+static void cache_redimensionar(cache_t *cache) {
+	size_t i, cantidad = cache->cantidad_baldes;
+	cache_arbol_t *arbol, *siguiente;
+
+	cache_arbol_t **baldes = (cache_arbol_t**) estadisticas_malloc(
+		SUBSISTEMA_CACHE, 2 * cantidad * sizeof(cache_arbol_t*));
+	if(!baldes) return;
+
+	for(i = 0; i < 2 * cantidad; i++) baldes[i] = NULL;
+
+	cache_arbol_t **anteriores = cache->baldes;
+	cache->baldes = baldes;
+	cache->cantidad_baldes = 2 * cantidad;
+
+	for(i = 0; i < cantidad; i++)
+		for(arbol = anteriores[i]; arbol; arbol = siguiente) {
+			siguiente = arbol->siguiente_balde;
+			size_t b = cache_balde(cache, arbol->origen, arbol->version);
+			arbol->siguiente_balde = baldes[b];
+			baldes[b] = arbol;
+		}
+
+	estadisticas_free(SUBSISTEMA_CACHE, anteriores);
+}
+
+
+
+/* ****************************************************************************
+ * PRIMITIVAS DE LA CACHÉ
+ * ***************************************************************************/
+
+// Crea una caché vacía.
+// PRE: 'presupuesto' es la máxima cantidad de bytes que pueden ocupar los
+// árboles almacenados.
+// POST: devuelve una nueva caché o NULL si no se ha podido llevar a cabo
+// la creación de la misma.
+cache_t* cache_crear(size_t presupuesto) {
+	size_t i;
+
+	cache_t *cache = (cache_t*) estadisticas_malloc(SUBSISTEMA_CACHE,
+		sizeof(cache_t));
+	if(!cache) return NULL;
+
+	cache->baldes = (cache_arbol_t**) estadisticas_malloc(SUBSISTEMA_CACHE,
+		BALDES_INICIALES * sizeof(cache_arbol_t*));
+	if(!cache->baldes) {
+		estadisticas_free(SUBSISTEMA_CACHE, cache);
+		return NULL;
+	}
+
+	for(i = 0; i < BALDES_INICIALES; i++) cache->baldes[i] = NULL;
+
+	cache->cantidad_baldes = BALDES_INICIALES;
+	cache->presupuesto = presupuesto;
+	cache->ocupado = 0;
+	cache->cantidad = 0;
+	cache->primero = cache->ultimo = NULL;
+	cache->contadores.aciertos = 0;
+	cache->contadores.fallos = 0;
+	cache->contadores.desalojos = 0;
+
+	return cache;
+}
+
+// Destruye una caché junto con los árboles que almacena.
+// PRE: 'cache' es una caché existente.
+// POST: se liberó la memoria ocupada por la caché.
+void cache_destruir(cache_t *cache) {
+	cache_arbol_t *arbol, *siguiente;
+
+	for(arbol = cache->primero; arbol; arbol = siguiente) {
+		siguiente = arbol->siguiente;
+		cache_arbol_destruir(arbol);
+	}
+
+	estadisticas_free(SUBSISTEMA_CACHE, cache->baldes);
+	estadisticas_free(SUBSISTEMA_CACHE, cache);
+}
+
+// Busca el árbol de un origen sobre una versión del grafo.
+// PRE: 'cache' es una caché existente; 'origen' es el índice del vértice
+// origen; 'version' es la versión del grafo.
+// POST: si la caché tiene el árbol, devuelve true, carga en 'distancias'
+// y 'previos' sus arreglos y lo registra como el usado más recientemente.
+// Los arreglos pertenecen a la caché y son válidos hasta el próximo
+// cache_guardar(). En caso contrario devuelve false.
+bool cache_buscar(cache_t *cache, uint32_t origen, uint64_t version,
+	const uint32_t **distancias, const uint32_t **previos) {
+	cache_arbol_t *arbol = *cache_ubicar(cache, origen, version);
+
+	if(!arbol) {
+		cache->contadores.fallos++;
+		return false;
+	}
+
+	cache_desenlazar(cache, arbol);
+	cache_enlazar(cache, arbol);
+	cache->contadores.aciertos++;
+
+	*distancias = arbol->distancias;
+	*previos = arbol->previos;
+	return true;
+}
+
+// Guarda una copia del árbol de un origen sobre una versión del grafo.
+// PRE: 'cache' es una caché existente; 'origen' es el índice del vértice
+// origen; 'version' es la versión del grafo; 'distancias' y 'previos' son
+// arreglos de 'n' elementos.
+// POST: devuelve true si se guardó el árbol, reemplazando al que hubiera
+// del mismo origen y versión y descartando los usados hace más tiempo
+// hasta que entre en el presupuesto, o false si el árbol solo lo supera o
+// no hubo memoria suficiente (en cuyo caso la caché no se modifica).
+bool cache_guardar(cache_t *cache, uint32_t origen, uint64_t version,
+	uint32_t n, const uint32_t *distancias, const uint32_t *previos) {
+	size_t bytes = (size_t) n * sizeof(uint32_t);
+	size_t tamano = sizeof(cache_arbol_t) + 2 * bytes;
+	cache_arbol_t **posicion;
+
+	if(tamano > cache->presupuesto) return false;
+
+	// Copiamos el árbol antes de modificar la caché
+	cache_arbol_t *arbol = (cache_arbol_t*) estadisticas_malloc(
+		SUBSISTEMA_CACHE, sizeof(cache_arbol_t));
+	if(!arbol) return false;
+
+	arbol->distancias = (uint32_t*) estadisticas_malloc(SUBSISTEMA_CACHE,
+		bytes + 1);
+	arbol->previos = (uint32_t*) estadisticas_malloc(SUBSISTEMA_CACHE,
+		bytes + 1);
+	if(!arbol->distancias || !arbol->previos) {
+		cache_arbol_destruir(arbol);
+		return false;
+	}
+
+	memcpy(arbol->distancias, distancias, bytes);
+	memcpy(arbol->previos, previos, bytes);
+	arbol->origen = origen;
+	arbol->version = version;
+	arbol->tamano = tamano;
+
+	// Reemplazamos el árbol anterior y hacemos lugar para el nuevo
+	posicion = cache_ubicar(cache, origen, version);
+	if(*posicion) cache_quitar(cache, posicion);
+
+	while(cache->ocupado + tamano > cache->presupuesto) {
+		cache_arbol_t *viejo = cache->ultimo;
+		cache_quitar(cache, cache_ubicar(cache, viejo->origen,
+			viejo->version));
+		cache->contadores.desalojos++;
+	}
+
+	if(cache->cantidad >= cache->cantidad_baldes) cache_redimensionar(cache);
+
+	posicion = &cache->baldes[cache_balde(cache, origen, version)];
+	arbol->siguiente_balde = *posicion;
+	*posicion = arbol;
+	cache_enlazar(cache, arbol);
+	cache->ocupado += tamano;
+	cache->cantidad++;
+
+	return true;
+}
+
+// Obtiene los contadores de uso de una caché.
+// PRE: 'cache' es una caché existente; 'resultado' es un puntero a la
+// variable que recibirá los contadores.
+void cache_obtener_contadores(const cache_t *cache,
+	cache_contadores_t *resultado) {
+	*resultado = cache->contadores;
+}
@@ -0,0 +1,91 @@
+/* ****************************************************************************
+ * ****************************************************************************
+ * TAD CACHÉ DE ÁRBOLES DE CAMINOS MÍNIMOS
+ * ..................................................................
+ *
+ * Implementación de una caché de los árboles de caminos mínimos (las
+ * distancias y los vértices previos) calculados desde cada origen, para
+ * no volver a calcularlos sobre un grafo que ya se recorrió. Cada árbol
+ * se identifica por el vértice origen y la versión del grafo sobre el que
+ * se calculó (ver grafo_obtener_version()): al modificarse el grafo los
+ * árboles anteriores dejan de encontrarse, y vuelven a encontrarse si
+ * las modificaciones se deshacen.
+ *
+ * La caché tiene un presupuesto de memoria: al guardar un árbol que no
+ * entra se descartan los usados hace más tiempo (LRU). Los árboles se
+ * ubican por una tabla de hash y se ordenan por uso en una lista
+ * doblemente enlazada. La caché no admite ser utilizada desde varios
+ * hilos a la vez.
+ *
+ * ****************************************************************************
+ * ***************************************************************************/
+
+
+#ifndef CACHE_H
+#define CACHE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+
+
+/* ****************************************************************************
+ * DECLARACIÓN DE LOS TIPOS DE DATOS
+ * ***************************************************************************/
+
+typedef struct _cache_t cache_t;
+
+// Tipo que representa los contadores de uso de una caché.
+typedef struct {
+	size_t aciertos;				// Búsquedas que encontraron el árbol
+	size_t fallos;					// Búsquedas que no lo encontraron
+	size_t desalojos;				// Árboles descartados por falta de lugar
+} cache_contadores_t;
+
+
+
+/* ****************************************************************************
+ * PRIMITIVAS DE LA CACHÉ
+ * ***************************************************************************/
+
+// Crea una caché vacía.
+// PRE: 'presupuesto' es la máxima cantidad de bytes que pueden ocupar los
+// árboles almacenados.
+// POST: devuelve una nueva caché o NULL si no se ha podido llevar a cabo
+// la creación de la misma.
+cache_t* cache_crear(size_t presupuesto);
+
+// Destruye una caché junto con los árboles que almacena.
+// PRE: 'cache' es una caché existente.
+// POST: se liberó la memoria ocupada por la caché.
+void cache_destruir(cache_t *cache);
+
+// Busca el árbol de un origen sobre una versión del grafo.
+// PRE: 'cache' es una caché existente; 'origen' es el índice del vértice
+// origen; 'version' es la versión del grafo.
+// POST: si la caché tiene el árbol, devuelve true, carga en 'distancias'
+// y 'previos' sus arreglos y lo registra como el usado más recientemente.
+// Los arreglos pertenecen a la caché y son válidos hasta el próximo
+// cache_guardar(). En caso contrario devuelve false.
+bool cache_buscar(cache_t *cache, uint32_t origen, uint64_t version,
+	const uint32_t **distancias, const uint32_t **previos);
+
+// Guarda una copia del árbol de un origen sobre una versión del grafo.
+// PRE: 'cache' es una caché existente; 'origen' es el índice del vértice
+// origen; 'version' es la versión del grafo; 'distancias' y 'previos' son
+// arreglos de 'n' elementos.
+// POST: devuelve true si se guardó el árbol, reemplazando al que hubiera
+// del mismo origen y versión y descartando los usados hace más tiempo
+// hasta que entre en el presupuesto, o false si el árbol solo lo supera o
+// no hubo memoria suficiente (en cuyo caso la caché no se modifica).
+bool cache_guardar(cache_t *cache, uint32_t origen, uint64_t version,
+	uint32_t n, const uint32_t *distancias, const uint32_t *previos);
+
+// Obtiene los contadores de uso de una caché.
+// PRE: 'cache' es una caché existente; 'resultado' es un puntero a la
+// variable que recibirá los contadores.
+void cache_obtener_contadores(const cache_t *cache,
+	cache_contadores_t *resultado);
+
+#endif
@@ -0,0 +1,290 @@
+/* ****************************************************************************
+ * ****************************************************************************
+ * TAD CONJUNTO DE CADENAS
+ * ..................................................................
+ *
+ * Implementación de un conjunto de cadenas internadas: cada cadena
+ * distinta se almacena una única vez, en bloques contiguos de memoria, y
+ * se la identifica por un número de 32 bits. Dos cadenas son iguales si y
+ * sólo si sus identificadores lo son. La búsqueda de una cadena se
+ * realiza mediante una tabla de hash.
+ *
+ * ****************************************************************************
+ * ***************************************************************************/
+
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include "cadenas.h"
+#include "estadisticas.h"
+
+
+
+/* ****************************************************************************
+ * CONSTANTES
+ * ***************************************************************************/
+
+// Tamaño mínimo de los bloques en los que se almacenan las cadenas
+#define TAM_BLOQUE 65536
+
+// Capacidad inicial de la tabla de hash (potencia de 2)
+#define CAPACIDAD_INICIAL 64
+
+
+
+/* ****************************************************************************
+ * DEFINICIÓN DE LOS TIPOS DE DATOS
+ * ***************************************************************************/
+
+// Tipo que representa un bloque de cadenas. Las cadenas nunca se mueven
+// de su bloque, por lo que los punteros a ellas se mantienen válidos.
+typedef struct _bloque_t {
+	struct _bloque_t *anterior;			// Bloque llenado previamente
+	size_t usado;						// Bytes ocupados del bloque
+	size_t tamanio;						// Bytes disponibles en el bloque
+	char datos[];						// Cadenas, terminadas en '\0'
+} bloque_t;
+
+// Tipo que representa un conjunto de cadenas.
+struct _cadenas_t {
+	bloque_t *bloque;					// Bloque en el que se agregan las
+										// cadenas nuevas
+	const char **textos;				// Cadena de cada identificador
+	uint32_t *largos;					// Largo de cada cadena
+	uint32_t *hashes;					// Hash de cada cadena
+	uint32_t cantidad;					// Cantidad de cadenas
+	uint32_t capacidad;					// Capacidad de los arreglos y de
+										// la tabla de hash
+	uint32_t *tabla;					// Tabla de hash (identificador + 1;
+										// 0 si la posición está libre)
+};
+
+
+
+/* ****************************************************************************
+ * FUNCIONES AUXILIARES
+ * ***************************************************************************/
+
+// Función de hash de las cadenas (FNV-1a).
+// PRE: 'cadena' es un arreglo de 'largo' caracteres.
+static uint32_t cadenas_hash(const char *cadena, size_t largo) {
+	uint32_t h = 2166136261u;
+	size_t i;
+
+	for(i = 0; i < largo; i++) {
+		h ^= (unsigned char) cadena[i];
+		h *= 16777619u;
+	}
+
+	return h;
+}
+
+// Busca la posición de una cadena en la tabla de hash.
+// PRE: 'cadenas' es un conjunto existente; 'h' es el hash de 'cadena'.
+// POST: devuelve la posición en la que se encuentra la cadena o, si no
+// está, la posición libre en la que debe insertarse.
+static uint32_t cadenas_posicion(const cadenas_t *cadenas, const char *cadena,
+	size_t largo, uint32_t h) {
+	uint32_t mascara = cadenas->capacidad - 1;
+	uint32_t i = h & mascara, id;
+
+	while(cadenas->tabla[i]) {
+		id = cadenas->tabla[i] - 1;
+		if(cadenas->hashes[id] == h && cadenas->largos[id] == largo &&
+			!memcmp(cadenas->textos[id], cadena, largo))
+			break;
+		i = (i + 1) & mascara;
+	}
+
+	return i;
+}
+
+// Duplica la capacidad del conjunto, rearmando la tabla de hash.
+// PRE: 'cadenas' es un conjunto existente.
+// POST: devuelve true si se pudo ampliar o false si no hubo memoria.
+static bool cadenas_ampliar(cadenas_t *cadenas) {
+	uint32_t capacidad = cadenas->capacidad * 2, mascara = capacidad - 1;
+	uint32_t id, i;
+
+	const char **textos = (const char**) estadisticas_realloc(
+		SUBSISTEMA_CADENAS, cadenas->textos, capacidad * sizeof(char*));
+	if(!textos) return false;
+	cadenas->textos = textos;
+
+	uint32_t *largos = (uint32_t*) estadisticas_realloc(SUBSISTEMA_CADENAS,
+		cadenas->largos, capacidad * sizeof(uint32_t));
+	if(!largos) return false;
+	cadenas->largos = largos;
+
+	uint32_t *hashes = (uint32_t*) estadisticas_realloc(SUBSISTEMA_CADENAS,
+		cadenas->hashes, capacidad * sizeof(uint32_t));
+	if(!hashes) return false;
+	cadenas->hashes = hashes;
+
+	uint32_t *tabla = (uint32_t*) estadisticas_malloc(SUBSISTEMA_CADENAS,
+		capacidad * sizeof(uint32_t));
+	if(!tabla) return false;
+	memset(tabla, 0, capacidad * sizeof(uint32_t));
+
+	// Reubicamos cada cadena a partir de su hash
+	for(id = 0; id < cadenas->cantidad; id++) {
+		i = cadenas->hashes[id] & mascara;
+		while(tabla[i]) i = (i + 1) & mascara;
+		tabla[i] = id + 1;
+	}
+
+	estadisticas_free(SUBSISTEMA_CADENAS, cadenas->tabla);
+	cadenas->tabla = tabla;
+	cadenas->capacidad = capacidad;
+
+	return true;
+}
+
+// Copia una cadena en el bloque actual, creando uno nuevo si no entra.
+// PRE: 'cadenas' es un conjunto existente; 'cadena' es un arreglo de
+// 'largo' caracteres.
+// POST: devuelve la copia, terminada en '\0', o NULL si no hubo memoria.
+static const char* cadenas_copiar(cadenas_t *cadenas, const char *cadena,
+	size_t largo) {
+	bloque_t *bloque = cadenas->bloque;
+
+	if(!bloque || bloque->tamanio - bloque->usado < largo + 1) {
+		size_t tamanio = largo + 1 > TAM_BLOQUE ? largo + 1 : TAM_BLOQUE;
+
+		bloque = (bloque_t*) estadisticas_malloc(SUBSISTEMA_CADENAS,
+			sizeof(bloque_t) + tamanio);
+		if(!bloque) return NULL;
+
+		bloque->anterior = cadenas->bloque;
+		bloque->usado = 0;
+		bloque->tamanio = tamanio;
+		cadenas->bloque = bloque;
+	}
+
+	char *copia = bloque->datos + bloque->usado;
+	memcpy(copia, cadena, largo);
+	copia[largo] = '\0';
+	bloque->usado += largo + 1;
+
+	return copia;
+}
+
+
+
+/* ****************************************************************************
+ * PRIMITIVAS DEL CONJUNTO DE CADENAS
+ * ***************************************************************************/
+
+// Crea un conjunto de cadenas.
+// POST: devuelve un nuevo conjunto vacío o NULL si no se ha podido llevar
+// a cabo la creación del mismo.
+cadenas_t* cadenas_crear() {
+	cadenas_t *cadenas = (cadenas_t*) estadisticas_malloc(SUBSISTEMA_CADENAS,
+		sizeof(cadenas_t));
+	if(!cadenas) return NULL;
+
+	cadenas->bloque = NULL;
+	cadenas->textos = NULL;
+	cadenas->largos = NULL;
+	cadenas->hashes = NULL;
+	cadenas->tabla = NULL;
+	cadenas->cantidad = 0;
+	cadenas->capacidad = CAPACIDAD_INICIAL / 2;
+
+	if(!cadenas_ampliar(cadenas)) {
+		cadenas_destruir(cadenas);
+		return NULL;
+	}
+
+	return cadenas;
+}
+
+// Destruye un conjunto de cadenas.
+// PRE: 'cadenas' es un conjunto existente.
+// POST: se liberó la memoria ocupada por el conjunto y por sus cadenas.
+void cadenas_destruir(cadenas_t *cadenas) {
+	bloque_t *bloque;
+
+	while((bloque = cadenas->bloque)) {
+		cadenas->bloque = bloque->anterior;
+		estadisticas_free(SUBSISTEMA_CADENAS, bloque);
+	}
+
+	estadisticas_free(SUBSISTEMA_CADENAS, cadenas->textos);
+	estadisticas_free(SUBSISTEMA_CADENAS, cadenas->largos);
+	estadisticas_free(SUBSISTEMA_CADENAS, cadenas->hashes);
+	estadisticas_free(SUBSISTEMA_CADENAS, cadenas->tabla);
+	estadisticas_free(SUBSISTEMA_CADENAS, cadenas);
+}
+
+// Interna una cadena en el conjunto.
+// PRE: 'cadenas' es un conjunto existente; 'cadena' es un arreglo de
+// 'largo' caracteres, no necesariamente terminado en '\0'.
+// POST: devuelve el identificador de la cadena, agregándola al conjunto
+// si no se encontraba en él, o CADENAS_SIN_ID si no hubo memoria
+// suficiente. Los identificadores se asignan en forma consecutiva a
+// partir de 0.
+uint32_t cadenas_internar(cadenas_t *cadenas, const char *cadena,
+	size_t largo) {
+	uint32_t h = cadenas_hash(cadena, largo);
+	uint32_t i = cadenas_posicion(cadenas, cadena, largo, h);
+
+	// Si la cadena ya estaba, devolvemos su identificador
+	if(cadenas->tabla[i]) return cadenas->tabla[i] - 1;
+
+	// Mantenemos la tabla a lo sumo medio llena
+	if(2 * (cadenas->cantidad + 1) > cadenas->capacidad) {
+		if(cadenas->capacidad == CADENAS_SIN_ID / 2 + 1 ||
+			!cadenas_ampliar(cadenas))
+			return CADENAS_SIN_ID;
+		i = cadenas_posicion(cadenas, cadena, largo, h);
+	}
+
+	const char *copia = cadenas_copiar(cadenas, cadena, largo);
+	if(!copia) return CADENAS_SIN_ID;
+
+	uint32_t id = cadenas->cantidad++;
+	cadenas->textos[id] = copia;
+	cadenas->largos[id] = largo;
+	cadenas->hashes[id] = h;
+	cadenas->tabla[i] = id + 1;
+
+	return id;
+}
+
+// Busca una cadena en el conjunto.
+// PRE: 'cadenas' es un conjunto existente; 'cadena' es un arreglo de
+// 'largo' caracteres, no necesariamente terminado en '\0'.
+// POST: devuelve el identificador de la cadena o CADENAS_SIN_ID si no
+// se encuentra en el conjunto.
+uint32_t cadenas_buscar(const cadenas_t *cadenas, const char *cadena,
+	size_t largo) {
+	uint32_t i = cadenas_posicion(cadenas, cadena, largo,
+		cadenas_hash(cadena, largo));
+
+	return cadenas->tabla[i] ? cadenas->tabla[i] - 1 : CADENAS_SIN_ID;
+}
+
+// Devuelve una cadena del conjunto.
+// PRE: 'cadenas' es un conjunto existente; 'id' es el identificador de
+// una cadena del conjunto.
+// POST: devuelve la cadena, terminada en '\0'. El puntero es válido
+// mientras exista el conjunto.
+const char* cadenas_obtener(const cadenas_t *cadenas, uint32_t id) {
+	return cadenas->textos[id];
+}
+
+// Devuelve el largo de una cadena del conjunto.
+// PRE: 'cadenas' es un conjunto existente; 'id' es el identificador de
+// una cadena del conjunto.
+size_t cadenas_largo(const cadenas_t *cadenas, uint32_t id) {
+	return cadenas->largos[id];
+}
+
+// Devuelve la cantidad de cadenas distintas del conjunto.
+// PRE: 'cadenas' es un conjunto existente.
+// POST: todos los identificadores son menores a este valor.
+uint32_t cadenas_cantidad(const cadenas_t *cadenas) {
+	return cadenas->cantidad;
+}
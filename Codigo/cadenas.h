@@ -0,0 +1,84 @@
+/* ****************************************************************************
+ * ****************************************************************************
+ * TAD CONJUNTO DE CADENAS
+ * ..................................................................
+ *
+ * Implementación de un conjunto de cadenas internadas: cada cadena
+ * distinta se almacena una única vez, en bloques contiguos de memoria, y
+ * se la identifica por un número de 32 bits. Dos cadenas son iguales si y
+ * sólo si sus identificadores lo son. La búsqueda de una cadena se
+ * realiza mediante una tabla de hash.
+ *
+ * ****************************************************************************
+ * ***************************************************************************/
+
+
+#ifndef CADENAS_H
+#define CADENAS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+
+/* ****************************************************************************
+ * DECLARACIÓN DE LOS TIPOS DE DATOS
+ * ***************************************************************************/
+
+typedef struct _cadenas_t cadenas_t;
+
+// Identificador que indica la ausencia de una cadena
+#define CADENAS_SIN_ID UINT32_MAX
+
+
+
+/* ****************************************************************************
+ * PRIMITIVAS DEL CONJUNTO DE CADENAS
+ * ***************************************************************************/
+
+// Crea un conjunto de cadenas.
+// POST: devuelve un nuevo conjunto vacío o NULL si no se ha podido llevar
+// a cabo la creación del mismo.
+cadenas_t* cadenas_crear();
+
+// Destruye un conjunto de cadenas.
+// PRE: 'cadenas' es un conjunto existente.
+// POST: se liberó la memoria ocupada por el conjunto y por sus cadenas.
+void cadenas_destruir(cadenas_t *cadenas);
+
+// Interna una cadena en el conjunto.
+// PRE: 'cadenas' es un conjunto existente; 'cadena' es un arreglo de
+// 'largo' caracteres, no necesariamente terminado en '\0'.
+// POST: devuelve el identificador de la cadena, agregándola al conjunto
+// si no se encontraba en él, o CADENAS_SIN_ID si no hubo memoria
+// suficiente. Los identificadores se asignan en forma consecutiva a
+// partir de 0.
+uint32_t cadenas_internar(cadenas_t *cadenas, const char *cadena,
+	size_t largo);
+
+// Busca una cadena en el conjunto.
+// PRE: 'cadenas' es un conjunto existente; 'cadena' es un arreglo de
+// 'largo' caracteres, no necesariamente terminado en '\0'.
+// POST: devuelve el identificador de la cadena o CADENAS_SIN_ID si no
+// se encuentra en el conjunto.
+uint32_t cadenas_buscar(const cadenas_t *cadenas, const char *cadena,
+	size_t largo);
+
+// Devuelve una cadena del conjunto.
+// PRE: 'cadenas' es un conjunto existente; 'id' es el identificador de
+// una cadena del conjunto.
+// POST: devuelve la cadena, terminada en '\0'. El puntero es válido
+// mientras exista el conjunto.
+const char* cadenas_obtener(const cadenas_t *cadenas, uint32_t id);
+
+// Devuelve el largo de una cadena del conjunto.
+// PRE: 'cadenas' es un conjunto existente; 'id' es el identificador de
+// una cadena del conjunto.
+size_t cadenas_largo(const cadenas_t *cadenas, uint32_t id);
+
+// Devuelve la cantidad de cadenas distintas del conjunto.
+// PRE: 'cadenas' es un conjunto existente.
+// POST: todos los identificadores son menores a este valor.
+uint32_t cadenas_cantidad(const cadenas_t *cadenas);
+
+#endif
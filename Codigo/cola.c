@@ -12,6 +12,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include "cola.h"
+#include "estadisticas.h"
 
 
 
@@ -41,7 +42,8 @@ struct _cola_t {
 // llevar a cabo la creación de la misma.
 cola_t* cola_crear() {
 	// Solicitamos espacio en memoria
-	cola_t* cola = (cola_t*) malloc(sizeof(cola_t));
+	cola_t* cola = (cola_t*) estadisticas_malloc(SUBSISTEMA_COLA,
+		sizeof(cola_t));
 	if(!cola) return NULL;
 
 	// Seteamos valores iniciales de la cola
@@ -64,14 +66,14 @@ void cola_destruir(cola_t *cola) {
 		// Eliminación de los nodos uno a uno.
 		while(nodo_actual->sig) {
 			nodo = nodo_actual->sig;
-			free(nodo_actual);
+			estadisticas_free(SUBSISTEMA_COLA, nodo_actual);
 			nodo_actual = nodo;
 		}
 
-		free(nodo_actual);
+		estadisticas_free(SUBSISTEMA_COLA, nodo_actual);
 	}
 
-	free(cola);
+	estadisticas_free(SUBSISTEMA_COLA, cola);
 }
 
 // Verifica si una cola tiene o no elementos.
@@ -88,7 +90,8 @@ bool cola_esta_vacia(const cola_t *cola) {
 // en caso de error.
 bool cola_encolar(cola_t *cola, const cola_dato_t valor) {
 	// Solicitamos espacio en memoria para el nuevo nodo.
-	nodo_cola_t* nodo = (nodo_cola_t*) malloc(sizeof(nodo_cola_t));
+	nodo_cola_t* nodo = (nodo_cola_t*) estadisticas_malloc(SUBSISTEMA_COLA,
+		sizeof(nodo_cola_t));
 	if(!nodo) return false;
 
 	// Guardamos valor en el nodo.
@@ -138,7 +141,7 @@ bool cola_desencolar(cola_t *cola, cola_dato_t *valor) {
 	else
 		cola->primero = cola->ultimo = NULL;
 
-	free(nodo);
+	estadisticas_free(SUBSISTEMA_COLA, nodo);
 
 	return true;
 }
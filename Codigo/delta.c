@@ -0,0 +1,466 @@
+/* ****************************************************************************
+ * ****************************************************************************
+ * DELTA-STEPPING - LIBRERÍA DE FUNCIONES
+ * ****************************************************************************
+ * ****************************************************************************
+ *
+ * Librería de funciones que calcula los caminos mínimos desde un origen
+ * con el algoritmo delta-stepping, repartiendo las relajaciones entre
+ * varios hilos. Los vértices se agrupan en baldes de distancias de un
+ * ancho dado; las aristas livianas (de peso menor al ancho) de los
+ * vértices de un balde se relajan en rondas paralelas hasta que el balde
+ * queda vacío, y luego se relajan en paralelo sus aristas pesadas.
+ *
+ * Las distancias se actualizan con operaciones atómicas. Cada hilo anota
+ * los vértices que mejoró, y entre ronda y ronda el hilo principal los
+ * reparte en los baldes. Los previos se eligen al final, en paralelo: el
+ * previo de cada vértice es, entre los vecinos que lo alcanzan por camino
+ * mínimo, el primero que marcaría Dijkstra (menor distancia y, ante igual
+ * distancia, el elegido por el criterio de selección).
+ */
+
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include "delta.h"
+#include "estadisticas.h"
+
+
+
+/* ****************************************************************************
+ * CONSTANTES
+ * ***************************************************************************/
+
+// Distancia de los vértices que no son alcanzables desde el origen
+#define INFINITO UINT32_MAX
+
+// Máxima cantidad de baldes que pueden contener vértices a la vez
+#define MAX_BALDES 65536
+
+// Cantidad de vértices por hilo a partir de la cual una ronda se reparte
+// entre los hilos; las rondas más chicas las ejecuta sólo el principal
+#define MIN_VERTICES_POR_HILO 256
+
+
+
+/* ****************************************************************************
+ * DEFINICIÓN DE LOS TIPOS DE DATOS
+ * ***************************************************************************/
+
+// Tipo que representa un vector de vértices que crece según se necesite.
+typedef struct {
+	uint32_t *vertices;					// Vértices
+	size_t cantidad;					// Cantidad de vértices
+	size_t capacidad;					// Capacidad del arreglo
+} delta_vector_t;
+
+// Tipo que representa el estado compartido por los hilos.
+typedef struct {
+	grafo_compacto_t *grafo;			// Grafo procesado
+	const uint32_t *inicio;				// Arreglos del grafo compacto
+	const uint32_t *destinos;
+	const uint16_t *pesos16;
+	const uint32_t *pesos32;
+	uint32_t *distancias;				// Distancias provisorias
+	uint32_t *previos;					// Vértices previos
+	uint32_t origen;					// Vértice origen
+	uint32_t ancho;						// Ancho de los baldes
+	int (*criterio)(lista_dato_t, lista_dato_t);	// Criterio de selección
+	const uint32_t *ronda;				// Vértices de la ronda en curso
+	size_t cantidad;					// Cantidad de vértices de la ronda
+	size_t partes;						// Hilos entre los que se reparte
+	bool livianas;						// Indica si se relajan las aristas
+										// livianas o las pesadas
+	delta_vector_t *mejorados;			// Vértices mejorados por cada hilo
+	bool sin_memoria;					// Indica si algún hilo se quedó sin
+										// memoria
+} delta_t;
+
+
+
+/* ****************************************************************************
+ * FUNCIONES AUXILIARES
+ * ***************************************************************************/
+
+// Agrega un vértice a un vector.
+// PRE: 'vector' es un vector; 'v' es un vértice.
+// POST: devuelve false si no hubo memoria suficiente o true en caso
+// contrario.
+static bool delta_vector_agregar(delta_vector_t *vector, uint32_t v) {
+	if(vector->cantidad == vector->capacidad) {
+		size_t capacidad = vector->capacidad ? 2 * vector->capacidad : 64;
+		uint32_t *vertices = (uint32_t*) estadisticas_realloc(
+			SUBSISTEMA_DIJKSTRA, vector->vertices,
+			capacidad * sizeof(uint32_t));
+		if(!vertices) return false;
+
+		vector->vertices = vertices;
+		vector->capacidad = capacidad;
+	}
+
+	vector->vertices[vector->cantidad++] = v;
+	return true;
+}
+
+// Devuelve el peso de una arista.
+// PRE: 'd' es el estado; 'e' es una arista del grafo.
+static inline uint32_t delta_peso(const delta_t *d, uint32_t e) {
+	return d->pesos16 ? d->pesos16[e] : d->pesos32[e];
+}
+
+// Calcula la porción de la ronda que le corresponde a un hilo.
+// PRE: 'd' es el estado; 'hilo' es el número de hilo; 'total' es la
+// cantidad de elementos a repartir.
+// POST: se cargó en 'desde' y 'hasta' el rango de elementos del hilo,
+// vacío si el hilo no participa de la ronda.
+static void delta_porcion(const delta_t *d, size_t hilo, size_t total,
+	size_t *desde, size_t *hasta) {
+	if(hilo >= d->partes) {
+		*desde = *hasta = 0;
+		return;
+	}
+
+	*desde = total * hilo / d->partes;
+	*hasta = total * (hilo + 1) / d->partes;
+}
+
+// Reduce en forma atómica la distancia de un vértice.
+// PRE: 'distancia' apunta a la distancia de un vértice; 'nueva' es una
+// distancia menor a INFINITO.
+// POST: devuelve true si 'nueva' era menor y se la almacenó.
+static inline bool delta_reducir(uint32_t *distancia, uint32_t nueva) {
+	uint32_t actual = __atomic_load_n(distancia, __ATOMIC_RELAXED);
+
+	while(nueva < actual)
+		if(__atomic_compare_exchange_n(distancia, &actual, nueva, true,
+			__ATOMIC_RELAXED, __ATOMIC_RELAXED))
+			return true;
+
+	return false;
+}
+
+// Tarea que relaja las aristas livianas o pesadas de los vértices de la
+// ronda que le corresponden a un hilo, anotando los vértices mejorados.
+// PRE: 'contexto' es el estado (delta_t).
+static void delta_relajar(size_t hilo, void *contexto) {
+	delta_t *d = (delta_t*) contexto;
+	size_t i, desde, hasta;
+	uint32_t e, u, v, peso;
+	uint64_t nueva;
+
+	delta_porcion(d, hilo, d->cantidad, &desde, &hasta);
+
+	for(i = desde; i < hasta; i++) {
+		u = d->ronda[i];
+		uint64_t du = __atomic_load_n(&d->distancias[u], __ATOMIC_RELAXED);
+
+		for(e = d->inicio[u]; e < d->inicio[u + 1]; e++) {
+			peso = delta_peso(d, e);
+			if((peso < d->ancho) != d->livianas) continue;
+
+			v = d->destinos[e];
+			nueva = du + peso;
+
+			if(nueva < INFINITO && delta_reducir(&d->distancias[v],
+				(uint32_t) nueva) &&
+				!delta_vector_agregar(&d->mejorados[hilo], v))
+				__atomic_store_n(&d->sin_memoria, true, __ATOMIC_RELAXED);
+		}
+	}
+}
+
+// Indica si un vértice lo marcaría Dijkstra antes que otro.
+// PRE: 'd' es el estado con las distancias definitivas; 'u' es un vértice
+// alcanzable; 'p' es un vértice o GRAFO_COMPACTO_SIN_VERTICE.
+// POST: ante igual distancia decide el criterio de selección, y si este
+// no distingue a los vértices, el de menor índice.
+static bool delta_precede(const delta_t *d, uint32_t u, uint32_t p) {
+	if(p == GRAFO_COMPACTO_SIN_VERTICE) return true;
+	if(d->distancias[u] != d->distancias[p])
+		return d->distancias[u] < d->distancias[p];
+
+	int c = d->criterio(grafo_compacto_obtener_dato(d->grafo, u),
+		grafo_compacto_obtener_dato(d->grafo, p));
+	return c ? c < 0 : u < p;
+}
+
+// Tarea que, para los vértices que le corresponden a un hilo, los propone
+// como previos de los vecinos a los que llegan por camino mínimo.
+// PRE: 'contexto' es el estado (delta_t), con las distancias definitivas.
+static void delta_elegir_previos(size_t hilo, void *contexto) {
+	delta_t *d = (delta_t*) contexto;
+	size_t u, desde, hasta;
+	uint32_t e, v, actual;
+
+	delta_porcion(d, hilo, d->cantidad, &desde, &hasta);
+
+	for(u = desde; u < hasta; u++) {
+		if(d->distancias[u] == INFINITO) continue;
+
+		for(e = d->inicio[u]; e < d->inicio[u + 1]; e++) {
+			v = d->destinos[e];
+			if(v == d->origen || d->distancias[v] == INFINITO ||
+				(uint64_t) d->distancias[u] + delta_peso(d, e) !=
+				d->distancias[v])
+				continue;
+
+			// Nos quedamos con el previo que precede a los demás
+			actual = __atomic_load_n(&d->previos[v], __ATOMIC_RELAXED);
+
+			while(delta_precede(d, u, actual) &&
+				!__atomic_compare_exchange_n(&d->previos[v], &actual, u, true,
+					__ATOMIC_RELAXED, __ATOMIC_RELAXED));
+		}
+	}
+}
+
+// Ejecuta una tarea sobre una ronda de vértices.
+// PRE: 'd' es el estado; 'hilos' el conjunto de hilos; 'ronda' es un
+// arreglo de 'cantidad' vértices (o NULL si la tarea recorre todos los
+// vértices del grafo, siendo 'cantidad' la cantidad de estos).
+// POST: se ejecutó la tarea, repartiendo la ronda entre los hilos si es
+// suficientemente grande.
+static void delta_ejecutar(delta_t *d, hilos_t *hilos, hilos_tarea_t tarea,
+	const uint32_t *ronda, size_t cantidad) {
+	d->ronda = ronda;
+	d->cantidad = cantidad;
+	d->partes = cantidad / MIN_VERTICES_POR_HILO;
+	if(d->partes > hilos_cantidad(hilos)) d->partes = hilos_cantidad(hilos);
+
+	if(d->partes <= 1) {
+		d->partes = 1;
+		tarea(0, d);
+	}
+	else
+		hilos_ejecutar(hilos, tarea, d);
+}
+
+
+
+/* ****************************************************************************
+ * FUNCIONES DE LA LIBRERIA
+ * ***************************************************************************/
+
+// Función que calcula los caminos mínimos de un grafo, partiendo de un
+// origen hacia los demás vértices, utilizando el algoritmo delta-stepping.
+// PRE: 'grafo', 'origen' y 'criterio_seleccion()' cumplen lo mismo que
+// en dijkstra_caminos_minimos(), y 'criterio_seleccion()' puede invocarse
+// desde varios hilos a la vez; 'hilos' es el conjunto de hilos que
+// realiza las relajaciones; 'ancho' es el ancho de los baldes o
+// DELTA_ANCHO_AUTOMATICO.
+// POST: devuelve los mismos resultados que dijkstra_caminos_minimos(), o
+// NULL si 'origen' no es un vértice del grafo o no hubo memoria
+// suficiente. Si el grafo tiene aristas de peso nulo, el orden en que se
+// eligen los previos depende del orden de marcado de Dijkstra, por lo que
+// se utiliza dijkstra_caminos_minimos(). Si con el ancho pedido hubiera
+// demasiados baldes simultáneos, se utiliza uno mayor.
+dijkstra_resultados_t* delta_caminos_minimos(grafo_compacto_t *grafo,
+	lista_dato_t origen, int criterio_seleccion(lista_dato_t, lista_dato_t),
+	hilos_t *hilos, uint32_t ancho) {
+	uint32_t n = grafo_compacto_cantidad_vertices(grafo);
+	uint32_t m = grafo_compacto_cantidad_aristas(grafo);
+	uint32_t v, e, minimo = UINT32_MAX, maximo = 0, peso;
+	size_t i, h, cantidad_hilos = hilos_cantidad(hilos);
+	delta_t d;
+
+	uint32_t o = grafo_compacto_buscar_vertice(grafo, origen);
+	if(o == GRAFO_COMPACTO_SIN_VERTICE) return NULL;
+
+	d.grafo = grafo;
+	d.origen = o;
+	d.criterio = criterio_seleccion;
+	d.sin_memoria = false;
+	grafo_compacto_obtener_arreglos(grafo, &d.inicio, &d.destinos,
+		&d.pesos16, &d.pesos32);
+
+	for(e = 0; e < m; e++) {
+		peso = delta_peso(&d, e);
+		if(peso < minimo) minimo = peso;
+		if(peso > maximo) maximo = peso;
+	}
+
+	if(m && !minimo)
+		return dijkstra_caminos_minimos(grafo, origen, criterio_seleccion);
+
+	// Por defecto, el ancho es el peso máximo dividido el grado medio
+	if(ancho == DELTA_ANCHO_AUTOMATICO)
+		ancho = maximo / (n && m > n ? m / n : 1);
+	if(!ancho) ancho = 1;
+
+	// Las distancias pendientes nunca superan a la del balde actual en más
+	// del peso máximo, por lo que alcanza con un arreglo circular de baldes
+	if(maximo / ancho + 2 > MAX_BALDES) ancho = maximo / (MAX_BALDES - 2) + 1;
+	uint32_t cantidad_baldes = maximo / ancho + 2;
+	d.ancho = ancho;
+
+	d.distancias = (uint32_t*) estadisticas_malloc(SUBSISTEMA_DIJKSTRA,
+		n * sizeof(uint32_t));
+	d.previos = (uint32_t*) estadisticas_malloc(SUBSISTEMA_DIJKSTRA,
+		n * sizeof(uint32_t));
+	uint32_t *marca = (uint32_t*) estadisticas_malloc(SUBSISTEMA_DIJKSTRA,
+		n * sizeof(uint32_t));
+	bool *en_ronda = (bool*) estadisticas_malloc(SUBSISTEMA_DIJKSTRA,
+		n * sizeof(bool));
+	delta_vector_t *baldes = (delta_vector_t*) estadisticas_malloc(
+		SUBSISTEMA_DIJKSTRA, cantidad_baldes * sizeof(delta_vector_t));
+	d.mejorados = (delta_vector_t*) estadisticas_malloc(SUBSISTEMA_DIJKSTRA,
+		cantidad_hilos * sizeof(delta_vector_t));
+	delta_vector_t ronda = { NULL, 0, 0 }, siguiente = { NULL, 0, 0 };
+	delta_vector_t marcados = { NULL, 0, 0 };
+
+	if(!d.distancias || !d.previos || !marca || !en_ronda || !baldes ||
+		!d.mejorados) {
+		estadisticas_free(SUBSISTEMA_DIJKSTRA, d.distancias);
+		estadisticas_free(SUBSISTEMA_DIJKSTRA, d.previos);
+		estadisticas_free(SUBSISTEMA_DIJKSTRA, marca);
+		estadisticas_free(SUBSISTEMA_DIJKSTRA, en_ronda);
+		estadisticas_free(SUBSISTEMA_DIJKSTRA, baldes);
+		estadisticas_free(SUBSISTEMA_DIJKSTRA, d.mejorados);
+		return NULL;
+	}
+
+	// Los contadores de Dijkstra no aplican a esta ejecución
+	dijkstra_reiniciar_contadores();
+
+	for(v = 0; v < n; v++) {
+		d.distancias[v] = INFINITO;
+		d.previos[v] = GRAFO_COMPACTO_SIN_VERTICE;
+		marca[v] = INFINITO;
+		en_ronda[v] = false;
+	}
+
+	for(i = 0; i < cantidad_baldes; i++) {
+		baldes[i].vertices = NULL;
+		baldes[i].cantidad = baldes[i].capacidad = 0;
+	}
+
+	for(h = 0; h < cantidad_hilos; h++) {
+		d.mejorados[h].vertices = NULL;
+		d.mejorados[h].cantidad = d.mejorados[h].capacidad = 0;
+	}
+
+	// Partimos del origen, en el primer balde
+	d.distancias[o] = 0;
+	size_t pendientes = 1;
+	uint32_t actual = 0;
+	if(!delta_vector_agregar(&baldes[0], o)) d.sin_memoria = true;
+
+	while(pendientes && !d.sin_memoria) {
+		// Avanzamos hasta el próximo balde no vacío
+		delta_vector_t *balde = &baldes[actual % cantidad_baldes];
+
+		while(!balde->cantidad) {
+			actual++;
+			balde = &baldes[actual % cantidad_baldes];
+		}
+
+		// Tomamos los vértices del balde que siguen perteneciendo a él
+		ronda.cantidad = 0;
+		pendientes -= balde->cantidad;
+
+		for(i = 0; i < balde->cantidad; i++) {
+			v = balde->vertices[i];
+			if(d.distancias[v] / ancho != actual || en_ronda[v]) continue;
+
+			en_ronda[v] = true;
+			if(!delta_vector_agregar(&ronda, v)) d.sin_memoria = true;
+		}
+
+		balde->cantidad = 0;
+
+		// Relajamos las aristas livianas hasta que el balde quede vacío,
+		// recordando los vértices marcados en él
+		d.livianas = true;
+
+		while(ronda.cantidad && !d.sin_memoria) {
+			for(i = 0; i < ronda.cantidad; i++) {
+				v = ronda.vertices[i];
+				en_ronda[v] = false;
+
+				if(marca[v] != actual) {
+					marca[v] = actual;
+					if(!delta_vector_agregar(&marcados, v))
+						d.sin_memoria = true;
+				}
+			}
+
+			delta_ejecutar(&d, hilos, delta_relajar, ronda.vertices,
+				ronda.cantidad);
+
+			// Repartimos los vértices mejorados: los del balde actual
+			// forman la próxima ronda y los demás van a su balde
+			siguiente.cantidad = 0;
+
+			for(h = 0; h < cantidad_hilos; h++) {
+				for(i = 0; i < d.mejorados[h].cantidad; i++) {
+					v = d.mejorados[h].vertices[i];
+					uint32_t b = d.distancias[v] / ancho;
+
+					if(b == actual) {
+						if(en_ronda[v]) continue;
+						en_ronda[v] = true;
+						if(!delta_vector_agregar(&siguiente, v))
+							d.sin_memoria = true;
+					}
+					else {
+						pendientes++;
+						if(!delta_vector_agregar(&baldes[b % cantidad_baldes],
+							v))
+							d.sin_memoria = true;
+					}
+				}
+
+				d.mejorados[h].cantidad = 0;
+			}
+
+			delta_vector_t auxiliar = ronda;
+			ronda = siguiente;
+			siguiente = auxiliar;
+		}
+
+		// Relajamos las aristas pesadas de los vértices marcados, que sólo
+		// pueden mejorar vértices de baldes posteriores
+		d.livianas = false;
+		delta_ejecutar(&d, hilos, delta_relajar, marcados.vertices,
+			marcados.cantidad);
+		marcados.cantidad = 0;
+
+		for(h = 0; h < cantidad_hilos; h++) {
+			for(i = 0; i < d.mejorados[h].cantidad; i++) {
+				v = d.mejorados[h].vertices[i];
+				pendientes++;
+				if(!delta_vector_agregar(&baldes[(d.distancias[v] / ancho) %
+					cantidad_baldes], v))
+					d.sin_memoria = true;
+			}
+
+			d.mejorados[h].cantidad = 0;
+		}
+
+		actual++;
+	}
+
+	// Elegimos los previos con las distancias definitivas
+	if(!d.sin_memoria)
+		delta_ejecutar(&d, hilos, delta_elegir_previos, NULL, n);
+
+	for(i = 0; i < cantidad_baldes; i++)
+		estadisticas_free(SUBSISTEMA_DIJKSTRA, baldes[i].vertices);
+	for(h = 0; h < cantidad_hilos; h++)
+		estadisticas_free(SUBSISTEMA_DIJKSTRA, d.mejorados[h].vertices);
+	estadisticas_free(SUBSISTEMA_DIJKSTRA, ronda.vertices);
+	estadisticas_free(SUBSISTEMA_DIJKSTRA, siguiente.vertices);
+	estadisticas_free(SUBSISTEMA_DIJKSTRA, marcados.vertices);
+	estadisticas_free(SUBSISTEMA_DIJKSTRA, baldes);
+	estadisticas_free(SUBSISTEMA_DIJKSTRA, d.mejorados);
+	estadisticas_free(SUBSISTEMA_DIJKSTRA, marca);
+	estadisticas_free(SUBSISTEMA_DIJKSTRA, en_ronda);
+
+	if(d.sin_memoria) {
+		estadisticas_free(SUBSISTEMA_DIJKSTRA, d.distancias);
+		estadisticas_free(SUBSISTEMA_DIJKSTRA, d.previos);
+		return NULL;
+	}
+
+	return dijkstra_crear_resultados(grafo, d.distancias, d.previos);
+}
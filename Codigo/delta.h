@@ -0,0 +1,60 @@
+/* ****************************************************************************
+ * ****************************************************************************
+ * DELTA-STEPPING - LIBRERÍA DE FUNCIONES
+ * ****************************************************************************
+ * ****************************************************************************
+ *
+ * Librería de funciones que calcula los caminos mínimos desde un origen
+ * con el algoritmo delta-stepping, repartiendo las relajaciones entre
+ * varios hilos. Los vértices se agrupan en baldes de distancias de un
+ * ancho dado; las aristas livianas (de peso menor al ancho) de los
+ * vértices de un balde se relajan en rondas paralelas hasta que el balde
+ * queda vacío, y luego se relajan en paralelo sus aristas pesadas.
+ *
+ * Las distancias obtenidas son las mismas que las de
+ * dijkstra_caminos_minimos(), y el vértice previo de cada vértice se
+ * elige con el mismo criterio de selección, por lo que los caminos
+ * también coinciden.
+ */
+
+
+#ifndef DELTA_H
+#define DELTA_H
+
+#include <stdint.h>
+#include "dijkstra.h"
+#include "hilos.h"
+
+
+
+/* ****************************************************************************
+ * CONSTANTES
+ * ***************************************************************************/
+
+// Ancho de los baldes que indica elegirlo a partir de los pesos del grafo
+#define DELTA_ANCHO_AUTOMATICO 0
+
+
+
+/* ****************************************************************************
+ * FUNCIONES DE LA LIBRERIA
+ * ***************************************************************************/
+
+// Función que calcula los caminos mínimos de un grafo, partiendo de un
+// origen hacia los demás vértices, utilizando el algoritmo delta-stepping.
+// PRE: 'grafo', 'origen' y 'criterio_seleccion()' cumplen lo mismo que
+// en dijkstra_caminos_minimos(), y 'criterio_seleccion()' puede invocarse
+// desde varios hilos a la vez; 'hilos' es el conjunto de hilos que
+// realiza las relajaciones; 'ancho' es el ancho de los baldes o
+// DELTA_ANCHO_AUTOMATICO.
+// POST: devuelve los mismos resultados que dijkstra_caminos_minimos(), o
+// NULL si 'origen' no es un vértice del grafo o no hubo memoria
+// suficiente. Si el grafo tiene aristas de peso nulo, el orden en que se
+// eligen los previos depende del orden de marcado de Dijkstra, por lo que
+// se utiliza dijkstra_caminos_minimos(). Si con el ancho pedido hubiera
+// demasiados baldes simultáneos, se utiliza uno mayor.
+dijkstra_resultados_t* delta_caminos_minimos(grafo_compacto_t *grafo,
+	lista_dato_t origen, int criterio_seleccion(lista_dato_t, lista_dato_t),
+	hilos_t *hilos, uint32_t ancho);
+
+#endif
@@ -0,0 +1,425 @@
+/* ****************************************************************************
+ * ****************************************************************************
+ * TAD DESCOMPRESOR DE ENTRADA
+ * ..................................................................
+ *
+ * Implementación de la lectura de una especificación comprimida. El hilo
+ * de descompresión lee el flujo original por bloques de
+ * DESCOMPRESOR_BLOQUE bytes y escribe lo descomprimido en una tubería,
+ * cuyo extremo de lectura es el flujo que recibe el intérprete. Al
+ * terminar, el hilo cierra el extremo de escritura, con lo que el
+ * intérprete encuentra el fin del flujo.
+ *
+ * Para reconocer el formato se consumen los primeros bytes del flujo
+ * original. Si resultan no ser una firma conocida y no pueden devolverse
+ * al flujo, el hilo copia el contenido tal cual, comenzando por ellos.
+ *
+ * ****************************************************************************
+ * ***************************************************************************/
+
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "descompresor.h"
+#include "estadisticas.h"
+
+#ifdef DESCOMPRESOR_CON_GZIP
+#include <zlib.h>
+#endif
+
+#ifdef DESCOMPRESOR_CON_ZSTD
+#include <zstd.h>
+#endif
+
+
+
+/* ****************************************************************************
+ * CONSTANTES
+ * ***************************************************************************/
+
+// Tamaño de los bloques que lee y escribe el hilo de descompresión
+#define DESCOMPRESOR_BLOQUE 65536
+
+// Firmas de los formatos comprimidos
+static const unsigned char FIRMA_GZIP[] = { 0x1F, 0x8B };
+static const unsigned char FIRMA_ZSTD[] = { 0x28, 0xB5, 0x2F, 0xFD };
+
+// Máximo largo de una firma
+#define DESCOMPRESOR_FIRMA 4
+
+// Nombres de los formatos
+static const char *NOMBRES_FORMATOS[] = { "plano", "gzip", "zstd" };
+
+
+
+/* ****************************************************************************
+ * DEFINICIÓN DE LOS TIPOS DE DATOS
+ * ***************************************************************************/
+
+// Tipo que representa un descompresor.
+struct _descompresor_t {
+	FILE *origen;						// Flujo original
+	FILE *flujo;						// Flujo del contenido descomprimido
+	int escritura;						// Extremo de escritura de la
+										// tubería, o -1
+	descompresor_formato_t formato;		// Formato del flujo original
+	unsigned char firma[DESCOMPRESOR_FIRMA];	// Bytes consumidos al
+	size_t largo_firma;					// reconocer el formato
+	unsigned char *entrada;				// Bloque leído del original
+	unsigned char *salida;				// Bloque a escribir en la tubería
+	bool hilo;							// Indica si se lanzó el hilo
+	pthread_t trabajador;				// Hilo de descompresión
+	bool ok;							// Resultado del hilo
+};
+
+
+
+/* ****************************************************************************
+ * FUNCIONES AUXILIARES
+ * ***************************************************************************/
+
+// Reconoce el formato de un flujo por sus primeros bytes.
+// PRE: 'descompresor' es un descompresor cuyo flujo original aún no fue
+// leído.
+// POST: devuelve el formato del flujo y deja en 'firma' los bytes que se
+// consumieron del flujo original para reconocerlo.
+static descompresor_formato_t descompresor_detectar(
+	descompresor_t *descompresor) {
+	const unsigned char *firma;
+	size_t largo;
+	descompresor_formato_t formato;
+	int c = getc(descompresor->origen);
+
+	descompresor->largo_firma = 0;
+
+	if(c == FIRMA_GZIP[0]) {
+		firma = FIRMA_GZIP;
+		largo = sizeof(FIRMA_GZIP);
+		formato = DESCOMPRESOR_GZIP;
+	}
+	else if(c == FIRMA_ZSTD[0]) {
+		firma = FIRMA_ZSTD;
+		largo = sizeof(FIRMA_ZSTD);
+		formato = DESCOMPRESOR_ZSTD;
+	}
+	else {
+		// Un único byte siempre puede devolverse al flujo
+		if(c != EOF) ungetc(c, descompresor->origen);
+		return DESCOMPRESOR_PLANO;
+	}
+
+	descompresor->firma[descompresor->largo_firma++] = c;
+
+	while(descompresor->largo_firma < largo &&
+		(c = getc(descompresor->origen)) != EOF) {
+		descompresor->firma[descompresor->largo_firma++] = c;
+		if(c != firma[descompresor->largo_firma - 1])
+			return DESCOMPRESOR_PLANO;
+	}
+
+	if(descompresor->largo_firma == largo) return formato;
+
+	// El flujo terminó antes de completar la firma
+	if(descompresor->largo_firma == 1) {
+		ungetc(descompresor->firma[0], descompresor->origen);
+		descompresor->largo_firma = 0;
+	}
+
+	return DESCOMPRESOR_PLANO;
+}
+
+// Lee el siguiente bloque del flujo original.
+// PRE: 'descompresor' es un descompresor con su bloque de entrada.
+// POST: carga el bloque en 'entrada', comenzando por los bytes consumidos
+// al reconocer el formato si aún no se entregaron, y devuelve su largo,
+// que es 0 al llegar al fin del flujo o ante un error de lectura.
+static size_t descompresor_leer(descompresor_t *descompresor) {
+	size_t largo = descompresor->largo_firma;
+
+	memcpy(descompresor->entrada, descompresor->firma, largo);
+	descompresor->largo_firma = 0;
+
+	return largo + fread(descompresor->entrada + largo, 1,
+		DESCOMPRESOR_BLOQUE - largo, descompresor->origen);
+}
+
+// Escribe un bloque en la tubería.
+// PRE: 'descompresor' es un descompresor con su hilo lanzado; 'datos' es
+// el bloque y 'largo' su cantidad de bytes.
+// POST: devuelve true si se escribió el bloque completo, o false en caso
+// contrario.
+static bool descompresor_escribir(descompresor_t *descompresor,
+	const unsigned char *datos, size_t largo) {
+	while(largo) {
+		ssize_t escritos = write(descompresor->escritura, datos, largo);
+		if(escritos <= 0) return false;
+
+		datos += escritos;
+		largo -= escritos;
+	}
+
+	return true;
+}
+
+// Copia el flujo original sin modificarlo.
+// PRE: 'descompresor' es un descompresor con su hilo lanzado.
+// POST: devuelve true si se copió el flujo completo, o false en caso
+// contrario.
+static bool descompresor_copiar(descompresor_t *descompresor) {
+	size_t largo;
+
+	while((largo = descompresor_leer(descompresor)))
+		if(!descompresor_escribir(descompresor, descompresor->entrada, largo))
+			return false;
+
+	return true;
+}
+
+#ifdef DESCOMPRESOR_CON_GZIP
+// Descomprime un flujo en formato gzip, que puede constar de varios
+// miembros consecutivos.
+// PRE: 'descompresor' es un descompresor con su hilo lanzado.
+// POST: devuelve true si se descomprimió el flujo completo, o false si
+// está dañado o incompleto, o no pudo escribirse.
+static bool descompresor_gzip(descompresor_t *descompresor) {
+	z_stream z;
+	int estado = Z_OK;
+	bool ok, pendiente = false;
+
+	memset(&z, 0, sizeof(z));
+
+	// Ventana máxima, sólo con cabecera gzip
+	if(inflateInit2(&z, MAX_WBITS + 16) != Z_OK) return false;
+
+	for(ok = true; ok;) {
+		// Mientras quede salida pendiente no se lee más entrada
+		if(!z.avail_in && !pendiente) {
+			z.next_in = descompresor->entrada;
+			z.avail_in = descompresor_leer(descompresor);
+			if(!z.avail_in) break;
+		}
+
+		// Tras un miembro completo, lo que sigue es el próximo miembro
+		if(estado == Z_STREAM_END) ok = inflateReset(&z) == Z_OK;
+
+		z.next_out = descompresor->salida;
+		z.avail_out = DESCOMPRESOR_BLOQUE;
+		estado = inflate(&z, Z_NO_FLUSH);
+
+		ok = ok && (estado == Z_OK || estado == Z_STREAM_END ||
+			estado == Z_BUF_ERROR) && descompresor_escribir(descompresor,
+			descompresor->salida, DESCOMPRESOR_BLOQUE - z.avail_out);
+		pendiente = estado == Z_OK && !z.avail_out;
+	}
+
+	inflateEnd(&z);
+	return ok && estado == Z_STREAM_END;
+}
+#endif
+
+#ifdef DESCOMPRESOR_CON_ZSTD
+// Descomprime un flujo en formato zstd, que puede constar de varios
+// cuadros consecutivos.
+// PRE: 'descompresor' es un descompresor con su hilo lanzado.
+// POST: devuelve true si se descomprimió el flujo completo, o false si
+// está dañado o incompleto, o no pudo escribirse.
+static bool descompresor_zstd(descompresor_t *descompresor) {
+	ZSTD_inBuffer entrada = { descompresor->entrada, 0, 0 };
+	ZSTD_outBuffer salida;
+	size_t resto = 1;
+	bool ok, pendiente = false;
+
+	ZSTD_DStream *z = ZSTD_createDStream();
+	if(!z) return false;
+
+	for(ok = true; ok;) {
+		// Mientras quede salida pendiente no se lee más entrada
+		if(entrada.pos == entrada.size && !pendiente) {
+			entrada.pos = 0;
+			entrada.size = descompresor_leer(descompresor);
+			if(!entrada.size) break;
+		}
+
+		salida.dst = descompresor->salida;
+		salida.size = DESCOMPRESOR_BLOQUE;
+		salida.pos = 0;
+
+		// Devuelve 0 al completar un cuadro
+		resto = ZSTD_decompressStream(z, &salida, &entrada);
+
+		ok = !ZSTD_isError(resto) && descompresor_escribir(descompresor,
+			descompresor->salida, salida.pos);
+		pendiente = salida.pos == salida.size;
+	}
+
+	ZSTD_freeDStream(z);
+	return ok && !resto;
+}
+#endif
+
+// Función que ejecuta el hilo de descompresión.
+// PRE: 'contexto' es el descompresor, con su tubería abierta.
+// POST: se escribió en la tubería el contenido descomprimido, se cargó
+// en 'ok' si se lo hizo en forma completa y se cerró el extremo de
+// escritura.
+static void* descompresor_trabajar(void *contexto) {
+	descompresor_t *descompresor = (descompresor_t*) contexto;
+
+	switch(descompresor->formato) {
+#ifdef DESCOMPRESOR_CON_GZIP
+		case DESCOMPRESOR_GZIP:
+			descompresor->ok = descompresor_gzip(descompresor);
+			break;
+#endif
+#ifdef DESCOMPRESOR_CON_ZSTD
+		case DESCOMPRESOR_ZSTD:
+			descompresor->ok = descompresor_zstd(descompresor);
+			break;
+#endif
+		default:
+			descompresor->ok = descompresor_copiar(descompresor);
+			break;
+	}
+
+	descompresor->ok = descompresor->ok && !ferror(descompresor->origen);
+
+	close(descompresor->escritura);
+	descompresor->escritura = -1;
+	return NULL;
+}
+
+// Abre la tubería y lanza el hilo de descompresión.
+// PRE: 'descompresor' es un descompresor sin hilo.
+// POST: devuelve true si se lanzó el hilo, o false en caso contrario
+// (los recursos obtenidos quedan en el descompresor para liberarlos).
+static bool descompresor_lanzar(descompresor_t *descompresor) {
+	int tuberia[2];
+
+	descompresor->entrada = (unsigned char*) estadisticas_malloc(
+		SUBSISTEMA_DESCOMPRESOR, 2 * DESCOMPRESOR_BLOQUE);
+	if(!descompresor->entrada || pipe(tuberia)) return false;
+
+	descompresor->salida = descompresor->entrada + DESCOMPRESOR_BLOQUE;
+	descompresor->escritura = tuberia[1];
+	descompresor->flujo = fdopen(tuberia[0], "r");
+
+	if(!descompresor->flujo) {
+		close(tuberia[0]);
+		return false;
+	}
+
+	descompresor->hilo = !pthread_create(&descompresor->trabajador, NULL,
+		descompresor_trabajar, descompresor);
+	return descompresor->hilo;
+}
+
+// Libera los recursos de un descompresor.
+// PRE: 'descompresor' es un descompresor cuyo hilo, si se lanzó, ya
+// finalizó.
+// POST: se cerró la tubería y se liberó la memoria del descompresor.
+static void descompresor_liberar(descompresor_t *descompresor) {
+	if(descompresor->flujo && descompresor->flujo != descompresor->origen)
+		fclose(descompresor->flujo);
+	if(descompresor->escritura >= 0) close(descompresor->escritura);
+
+	estadisticas_free(SUBSISTEMA_DESCOMPRESOR, descompresor->entrada);
+	estadisticas_free(SUBSISTEMA_DESCOMPRESOR, descompresor);
+}
+
+
+
+/* ****************************************************************************
+ * PRIMITIVAS DEL DESCOMPRESOR
+ * ***************************************************************************/
+
+// Abre la lectura del contenido descomprimido de un flujo.
+// PRE: 'fp' es un flujo abierto para lectura del que aún no se leyó nada;
+// 'formato' es donde se almacena el formato reconocido.
+// POST: carga en 'formato' el formato del flujo y devuelve el
+// descompresor, cuyo texto se lee con descompresor_flujo(), o NULL si el
+// formato no fue incluido al compilar o no hubo recursos suficientes.
+// El flujo 'fp' debe existir mientras se utilice el descompresor.
+descompresor_t* descompresor_abrir(FILE *fp, descompresor_formato_t *formato) {
+	descompresor_t *descompresor = (descompresor_t*) estadisticas_malloc(
+		SUBSISTEMA_DESCOMPRESOR, sizeof(descompresor_t));
+	if(!descompresor) return NULL;
+
+	descompresor->origen = fp;
+	descompresor->flujo = fp;
+	descompresor->escritura = -1;
+	descompresor->entrada = NULL;
+	descompresor->hilo = false;
+	descompresor->ok = true;
+	descompresor->formato = *formato = descompresor_detectar(descompresor);
+
+	// Un flujo plano intacto se lee directamente
+	if(descompresor->formato == DESCOMPRESOR_PLANO &&
+		!descompresor->largo_firma)
+		return descompresor;
+
+	if(!descompresor_incluido(descompresor->formato) ||
+		!descompresor_lanzar(descompresor)) {
+		descompresor_liberar(descompresor);
+		return NULL;
+	}
+
+	return descompresor;
+}
+
+// Devuelve el flujo del que se lee el contenido descomprimido.
+// PRE: 'descompresor' es un descompresor abierto.
+// POST: devuelve un flujo para lectura, que es el original si éste no
+// estaba comprimido.
+FILE* descompresor_flujo(descompresor_t *descompresor) {
+	return descompresor->flujo;
+}
+
+// Cierra un descompresor.
+// PRE: 'descompresor' es un descompresor abierto.
+// POST: se descartó lo que restaba leer, se finalizó el hilo de
+// descompresión y se liberaron los recursos del descompresor, mas no el
+// flujo original. Devuelve false si el contenido comprimido estaba dañado
+// o incompleto, o si no pudo leerse, y true en caso contrario.
+bool descompresor_cerrar(descompresor_t *descompresor) {
+	char descarte[BUFSIZ];
+	bool ok = !ferror(descompresor->flujo);
+
+	if(descompresor->hilo) {
+		// Vaciamos la tubería para que el hilo no quede esperando escribir
+		while(fread(descarte, 1, sizeof(descarte), descompresor->flujo));
+
+		pthread_join(descompresor->trabajador, NULL);
+		ok = ok && descompresor->ok;
+	}
+
+	descompresor_liberar(descompresor);
+	return ok;
+}
+
+// Devuelve el nombre de un formato.
+// PRE: 'formato' es un formato de entrada.
+// POST: devuelve el nombre del formato, en minúsculas.
+const char* descompresor_nombre(descompresor_formato_t formato) {
+	return NOMBRES_FORMATOS[formato];
+}
+
+// Indica si un formato fue incluido al compilar.
+// PRE: 'formato' es un formato de entrada.
+// POST: devuelve true si el formato puede leerse, o false en caso
+// contrario.
+bool descompresor_incluido(descompresor_formato_t formato) {
+	switch(formato) {
+		case DESCOMPRESOR_PLANO:	return true;
+#ifdef DESCOMPRESOR_CON_GZIP
+		case DESCOMPRESOR_GZIP:		return true;
+#endif
+#ifdef DESCOMPRESOR_CON_ZSTD
+		case DESCOMPRESOR_ZSTD:		return true;
+#endif
+		default:					return false;
+	}
+}
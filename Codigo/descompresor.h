@@ -0,0 +1,85 @@
+/* ****************************************************************************
+ * ****************************************************************************
+ * TAD DESCOMPRESOR DE ENTRADA
+ * ..................................................................
+ *
+ * Lectura de una especificación comprimida sin descomprimirla antes en
+ * disco. El formato se reconoce por los primeros bytes del flujo (gzip o
+ * zstd); si no es ninguno de ellos, el flujo se lee tal cual.
+ *
+ * La descompresión se realiza en un hilo propio, que lee el flujo
+ * comprimido por bloques y escribe el texto en una tubería de la que lee
+ * el intérprete. Así, descomprimir se superpone con interpretar la
+ * especificación, y la tubería limita lo que el hilo puede adelantarse,
+ * sin que el texto completo resida en memoria.
+ *
+ * Cada formato se incluye al compilar (ver las opciones 'gzip' y 'zstd'
+ * del Makefile; gzip se incluye por omisión); uno no incluido se
+ * reconoce igual, pero se rechaza.
+ *
+ * ****************************************************************************
+ * ***************************************************************************/
+
+
+#ifndef DESCOMPRESOR_H
+#define DESCOMPRESOR_H
+
+#include <stdio.h>
+#include <stdbool.h>
+
+
+
+/* ****************************************************************************
+ * DECLARACIÓN DE LOS TIPOS DE DATOS
+ * ***************************************************************************/
+
+typedef struct _descompresor_t descompresor_t;
+
+// Formatos que se reconocen en la entrada
+typedef enum {
+	DESCOMPRESOR_PLANO,
+	DESCOMPRESOR_GZIP,
+	DESCOMPRESOR_ZSTD
+} descompresor_formato_t;
+
+
+
+/* ****************************************************************************
+ * PRIMITIVAS DEL DESCOMPRESOR
+ * ***************************************************************************/
+
+// Abre la lectura del contenido descomprimido de un flujo.
+// PRE: 'fp' es un flujo abierto para lectura del que aún no se leyó nada;
+// 'formato' es donde se almacena el formato reconocido.
+// POST: carga en 'formato' el formato del flujo y devuelve el
+// descompresor, cuyo texto se lee con descompresor_flujo(), o NULL si el
+// formato no fue incluido al compilar o no hubo recursos suficientes.
+// El flujo 'fp' debe existir mientras se utilice el descompresor.
+descompresor_t* descompresor_abrir(FILE *fp, descompresor_formato_t *formato);
+
+// Devuelve el flujo del que se lee el contenido descomprimido.
+// PRE: 'descompresor' es un descompresor abierto.
+// POST: devuelve un flujo para lectura, que es el original si éste no
+// estaba comprimido.
+FILE* descompresor_flujo(descompresor_t *descompresor);
+
+// Cierra un descompresor.
+// PRE: 'descompresor' es un descompresor abierto.
+// POST: se descartó lo que restaba leer, se finalizó el hilo de
+// descompresión y se liberaron los recursos del descompresor, mas no el
+// flujo original. Devuelve false si el contenido comprimido estaba dañado
+// o incompleto, o si no pudo leerse, y true en caso contrario.
+bool descompresor_cerrar(descompresor_t *descompresor);
+
+// Devuelve el nombre de un formato.
+// PRE: 'formato' es un formato de entrada.
+// POST: devuelve el nombre del formato, en minúsculas.
+const char* descompresor_nombre(descompresor_formato_t formato);
+
+// Indica si un formato fue incluido al compilar.
+// PRE: 'formato' es un formato de entrada.
+// POST: devuelve true si el formato puede leerse, o false en caso
+// contrario.
+bool descompresor_incluido(descompresor_formato_t formato);
+
+#endif
@@ -11,7 +11,10 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
 #include "dijkstra.h"
+#include "estadisticas.h"
 
 
 
@@ -19,250 +22,933 @@
  * CONSTANTES
  * ***************************************************************************/
 
-// Entero considerado infinito utilizado para el algoritmo de Dijkstra
-const int INFINITO = 1e9;
+// Distancia de los vértices que no son alcanzables desde el origen
+#define INFINITO UINT32_MAX
 
 
 
 /* ****************************************************************************
- * DECLARACIÓN DE LOS TIPOS DE DATOS
+ * CONTADORES DE EJECUCIÓN
  * ***************************************************************************/
 
-typedef struct _dijkstra_nodo_t dijkstra_nodo_t;
+// Los contadores sólo se compilan si se define DIJKSTRA_CONTADORES. En caso
+// contrario DIJKSTRA_CONTAR() no genera código alguno. Se incrementan en
+// forma atómica porque los caminos pueden extraerse desde varios hilos.
+#ifdef DIJKSTRA_CONTADORES
+static dijkstra_contadores_t contadores;
+#define DIJKSTRA_CONTAR(campo) \
+	((void) __atomic_fetch_add(&contadores.campo, 1, __ATOMIC_RELAXED))
+#else
+#define DIJKSTRA_CONTAR(campo) ((void) 0)
+#endif
 
 
 
 /* ****************************************************************************
- * INCLUSIÓN DE LIBRERIAS Y TADS EXTERNOS
+ * DEFINICIÓN DE LOS TIPOS DE DATOS
  * ***************************************************************************/
 
-// TAD Cola
-#define COLA_DATO_T
-typedef dijkstra_nodo_t* cola_dato_t;
-#include "cola.h"
+// Tipo que representa los resultados del algoritmo de Dijkstra.
+struct _dijkstra_resultados_t {
+	grafo_compacto_t *grafo;			// Grafo procesado
+	uint32_t *distancias;				// Peso mínimo del camino hasta
+										// llegar a cada vértice
+	uint32_t *previos;					// Vértice previo para llegar a
+										// cada vértice por camino mínimo
+};
+
+// Tipo que representa el montículo binario de vértices no marcados,
+// ordenado por distancia y, ante igual distancia, por el criterio de
+// selección.
+typedef struct {
+	uint32_t *vertices;					// Vértices del montículo
+	uint32_t *posiciones;				// Posición de cada vértice en el
+										// montículo (INFINITO si no está)
+	uint32_t cantidad;					// Cantidad de vértices en el
+										// montículo
+	const uint32_t *distancias;			// Distancias provisorias
+	grafo_compacto_t *grafo;			// Grafo procesado
+	int (*criterio)(lista_dato_t, lista_dato_t);	// Criterio de selección
+} dijkstra_monticulo_t;
+
+// Tipo que representa un camino del algoritmo de Yen.
+typedef struct {
+	uint32_t *vertices;					// Vértices desde el origen
+	uint64_t *costos;					// Costo hasta cada vértice
+	uint32_t largo;						// Cantidad de vértices
+} dijkstra_camino_t;
+
+// Tipo que representa el estado de las búsquedas de desvíos del algoritmo
+// de Yen, que se reutiliza entre búsquedas.
+typedef struct {
+	dijkstra_monticulo_t m;				// Montículo de la búsqueda
+	uint32_t *distancias;				// Distancias desde el desvío
+	uint32_t *previos;					// Previos desde el desvío
+	uint32_t *tocados;					// Vértices alcanzados por la
+										// búsqueda, a reiniciar
+	uint32_t cantidad_tocados;			// Cantidad de vértices alcanzados
+	unsigned char *vertice_bloqueado;	// Vértices que no se atraviesan
+	unsigned char *arista_bloqueada;	// Aristas que no se atraviesan
+	uint32_t *hasta_destino;			// Distancia de cada vértice al
+										// destino, sin bloqueos
+	uint32_t *siguientes;				// Siguiente vértice hacia el
+										// destino, sin bloqueos
+	uint32_t *prioridades;				// Distancia más la cota hasta el
+										// destino, que ordena el montículo
+	uint32_t *espuela;					// Vértices del último desvío
+	uint64_t *espuela_costos;			// Costo hasta cada uno desde el
+										// vértice de desvío
+	const uint32_t *inicio;				// Arreglos del grafo compacto
+	const uint32_t *destinos;
+	const uint16_t *pesos16;
+	const uint32_t *pesos32;
+} dijkstra_yen_t;
 
 
 
 /* ****************************************************************************
- * DEFINICIÓN DE LOS TIPOS DE DATOS
+ * FUNCIONES AUXILIARES
  * ***************************************************************************/
 
-// Tipo que representa un nodo en el algoritmo de Dijkstra.
-struct _dijkstra_nodo_t {
-	lista_dato_t dato;					// Puntero al dato del vértice
-	dijkstra_nodo_t *nodo_previo;		// Puntero al dato del vértice 
-										// previo para llegar al vértice  
-										// actual por camino mínimo
-	int peso_camino;					// Peso mínimo del camino hasta 
-										// llegar
-};
+// Compara dos vértices del montículo.
+// PRE: 'm' es un montículo; 'u' y 'v' son vértices del grafo.
+// POST: devuelve true si 'u' debe marcarse antes que 'v'.
+static bool dijkstra_precede(const dijkstra_monticulo_t *m, uint32_t u,
+	uint32_t v) {
+	if(m->distancias[u] != m->distancias[v])
+		return m->distancias[u] < m->distancias[v];
+
+	// Ante igual distancia decide el criterio del usuario
+	DIJKSTRA_CONTAR(desempates);
+	return m->criterio(grafo_compacto_obtener_dato(m->grafo, u),
+		grafo_compacto_obtener_dato(m->grafo, v)) < 0;
+}
 
+// Ubica un vértice en una posición del montículo.
+// PRE: 'm' es un montículo; 'i' es una posición válida; 'v' un vértice.
+static void dijkstra_ubicar(dijkstra_monticulo_t *m, uint32_t i, uint32_t v) {
+	m->vertices[i] = v;
+	m->posiciones[v] = i;
+}
 
+// Sube un vértice en el montículo hasta restablecer el orden.
+// PRE: 'm' es un montículo; 'i' es la posición del vértice.
+static void dijkstra_subir(dijkstra_monticulo_t *m, uint32_t i) {
+	uint32_t v = m->vertices[i];
 
-/* ****************************************************************************
- * FUNCIONES DE LA LIBRERÍA
- * ***************************************************************************/
+	while(i > 0 && dijkstra_precede(m, v, m->vertices[(i - 1) / 2])) {
+		dijkstra_ubicar(m, i, m->vertices[(i - 1) / 2]);
+		i = (i - 1) / 2;
+	}
 
+	dijkstra_ubicar(m, i, v);
+}
 
-// Función que calcula los caminos mínimos de un grafo, partiendo de un
-// origen hacia los demás vérticies, utilizando el algoritmo de Dijkstra.
-// PRE: 'grafo' es un grafo cargado con nodos no aislados; 'origen' es
-// el nodo desde el cual se desean calcular los caminos mínimos (debe ser
-// del tipo de datos cargado en el grafo, pero al pasarse a esta función
-// debe ser casteado al tipo lista_dato_t para evitar conflictos de tipo
-// en las listas); 'criterio_seleccion()' es una función que se encarga 
-// de definir el criterio de selección ante dos caminos que poseen la 
-// misma distancia desde el nodo origen. Por parámetro recibe los dos
-// nodos del grafo. La función debe devolver un valor entero < 0 si se
-// debe elegir el nodo del primer parámetro ó un entero > 0 si se debe
-// elegir el nodo del segundo parámetro.
-// POST: se devuelve una lista donde se almacenan los resultados de 
-// procesamiento. Estos no son directamente procesables por el usuario.
-// Esta lista es utilizada por otras funciones de la librería para poder
-// brindar resultados personalizados de acuerdo a lo que se necesite.
-lista_t* dijkstra_caminos_minimos(grafo_t *grafo, lista_dato_t origen, 
-	int criterio_seleccion(lista_dato_t, lista_dato_t)) {
-	// Variables auxiliares de procesamiento
-	dijkstra_nodo_t *a = NULL, *Vi;
-	int menor_peso = INFINITO;
-
-	// Lista de nodos marcados
-	lista_t* M = lista_crear();
-	// Cola de nodos no marcados
-	cola_t* NM = cola_crear();
-	// Cola auxiliar
-	cola_t* CA = cola_crear();
-
-
-	// Obtenemos los vértices del grafo
-	int i, kCantidadVertices = grafo_cantidad_vertices(grafo);
-	grafo_dato_t arregloDeVertices[kCantidadVertices];
-	grafo_obtener_vertices(grafo, arregloDeVertices);
-
-	// Iteramos sobre el arreglo de vértices
-	for(i = 0; i < kCantidadVertices; i++) {
-		// Creamos un nodo para cada vértice
-		dijkstra_nodo_t* nodo = (dijkstra_nodo_t*) 
-									malloc(sizeof(dijkstra_nodo_t));
-		if(!nodo) return NULL;
-
-		// Seteamos datos iniciales del nodo
-		nodo->dato = arregloDeVertices[i];
-		nodo->nodo_previo = NULL;
-		nodo->peso_camino = INFINITO;
-
-		// Enviamos a la cola de no marcados (NM) a los nodos
-		// de los vértices que no son el origen
-		if(arregloDeVertices[i] != origen)
-			cola_encolar(NM, nodo);
-		else {
-			nodo->peso_camino = 0;
-			a = nodo;
-		}
+// Extrae el primer vértice del montículo.
+// PRE: 'm' es un montículo no vacío.
+// POST: devuelve el vértice de menor distancia (desempatando con el
+// criterio de selección) y lo quita del montículo.
+static uint32_t dijkstra_extraer(dijkstra_monticulo_t *m) {
+	uint32_t primero = m->vertices[0], i = 0, hijo;
+	uint32_t v = m->vertices[--m->cantidad];
+
+	m->posiciones[primero] = INFINITO;
+	DIJKSTRA_CONTAR(desencolados);
+	if(!m->cantidad) return primero;
+
+	// Bajamos el último vértice desde la raíz
+	while((hijo = 2 * i + 1) < m->cantidad) {
+		if(hijo + 1 < m->cantidad &&
+			dijkstra_precede(m, m->vertices[hijo + 1], m->vertices[hijo]))
+			hijo++;
+		if(!dijkstra_precede(m, m->vertices[hijo], v)) break;
+		dijkstra_ubicar(m, i, m->vertices[hijo]);
+		i = hijo;
 	}
 
-	// Iteramos hasta marcar todos los nodos
-	while(!cola_esta_vacia(NM)) {
-		// Iteramos hasta completar una vuelta de procesamiento de
-		// nodos no marcados
-		while(!cola_esta_vacia(NM)) {
-			cola_desencolar(NM, &Vi);
-
-			// Si son adyacentes, comparamos distancias
-			if(grafo_son_adyacentes(grafo, a->dato, Vi->dato)) {
-				// Calculamos el peso del camino llegando desde nodo actual 'a'
-				int peso_camino = a->peso_camino + 
-					grafo_obtener_peso_arista(grafo, a->dato, Vi->dato);
-
-				// Si el camino llegando desde 'a' es mas corto que el que
-				// se tenía registrado, cambiamos el punto de llegada de Vi
-				// para que provenga desde 'a'
-				if(Vi->peso_camino > peso_camino) {
-					Vi->peso_camino = peso_camino;
-					Vi->nodo_previo = a;
-				}
-			}
+	dijkstra_ubicar(m, i, v);
+	return primero;
+}
 
-			// Encolamos el nodo procesado en la cola auxiliar
-			cola_encolar(CA, Vi);
-		}
-		
-		// Marcamos el nodo actual 'a' enviándolo a la lista de marcados.
-		// Lo insertamos primero para que quede en orden decreciente, es decir,
-		// que comienze por el destino y termine en el origen.
-		lista_insertar_primero(M, a);
-		// Reseteamos variables de procesamiento
-		a = Vi = NULL;
-		menor_peso = INFINITO;
-
-		// Iteramos hasta pasar todos los nodos de CA a NM excepto
-		// aquel que posee la menor distancia, el cual pasa a ser
-		// el nuevo nodo actual 'a'
-		while(!cola_esta_vacia(CA)) {
-			cola_desencolar(CA, &Vi);
-
-			// Caso para cuando aparece un nodo con menor
-			// distancia
-			if(menor_peso > Vi->peso_camino) {
-				if(a) cola_encolar(NM, a);
-				a = Vi;
-				menor_peso = Vi->peso_camino;
-				continue;
-			}
-			// Caso para cuando las distancias de los nodos son iguales
-			else if (menor_peso == Vi->peso_camino) {
-				// Elegimos uno de acuerdo al criterio de selección definido
-				// por el usuario
-				if(criterio_seleccion(Vi->dato, a->dato) < 0) {
-					cola_encolar(NM, a);
-					a = Vi;
-					menor_peso = Vi->peso_camino;
-				}
-				else
-					cola_encolar(NM, Vi);
+// Intenta mejorar el camino hacia un vértice llegando desde otro.
+// PRE: 'm' es un montículo; 'previos' es el arreglo de vértices previos;
+// 'u' es el vértice desde el que se llega; 'v' el vértice destino;
+// 'peso' el peso del camino llegando desde 'u'.
+// POST: si el camino es estrictamente más corto, se actualizó la
+// distancia y el previo de 'v' y se lo ubicó en el montículo.
+static inline void dijkstra_mejorar(dijkstra_monticulo_t *m,
+	uint32_t *distancias, uint32_t *previos, uint32_t u, uint32_t v,
+	uint64_t peso) {
+	DIJKSTRA_CONTAR(relajaciones);
+	if(peso >= distancias[v]) return;
+
+	distancias[v] = (uint32_t) peso;
+	previos[v] = u;
+	DIJKSTRA_CONTAR(relajaciones_exitosas);
+
+	// Los vértices alcanzados por primera vez ingresan al montículo
+	if(m->posiciones[v] == INFINITO) {
+		m->posiciones[v] = m->cantidad++;
+		m->vertices[m->posiciones[v]] = v;
+		DIJKSTRA_CONTAR(encolados);
+	}
+
+	dijkstra_subir(m, m->posiciones[v]);
+}
+
+// Relaja las aristas que parten de un vértice, con pesos de 16 bits.
+// PRE: 'm' es un montículo; 'u' es un vértice recién marcado; 'inicio',
+// 'destinos' y 'pesos' son los arreglos del grafo compacto.
+static void dijkstra_relajar_16(dijkstra_monticulo_t *m, uint32_t *distancias,
+	uint32_t *previos, uint32_t u, const uint32_t *inicio,
+	const uint32_t *destinos, const uint16_t *pesos) {
+	uint64_t d = distancias[u];
+	uint32_t e, fin = inicio[u + 1];
+
+	for(e = inicio[u]; e < fin; e++)
+		dijkstra_mejorar(m, distancias, previos, u, destinos[e], d + pesos[e]);
+}
+
+// Relaja las aristas que parten de un vértice, con pesos de 32 bits.
+// PRE: 'm' es un montículo; 'u' es un vértice recién marcado; 'inicio',
+// 'destinos' y 'pesos' son los arreglos del grafo compacto.
+static void dijkstra_relajar_32(dijkstra_monticulo_t *m, uint32_t *distancias,
+	uint32_t *previos, uint32_t u, const uint32_t *inicio,
+	const uint32_t *destinos, const uint32_t *pesos) {
+	uint64_t d = distancias[u];
+	uint32_t e, fin = inicio[u + 1];
+
+	for(e = inicio[u]; e < fin; e++)
+		dijkstra_mejorar(m, distancias, previos, u, destinos[e], d + pesos[e]);
+}
+
+
+// Devuelve el peso de una arista.
+// PRE: 'y' es el estado de una búsqueda; 'e' es una arista del grafo.
+static inline uint32_t dijkstra_yen_peso(const dijkstra_yen_t *y, uint32_t e) {
+	return y->pesos32 ? y->pesos32[e] : y->pesos16[e];
+}
+
+// Devuelve el menor peso de las aristas entre dos vértices.
+// PRE: 'y' es el estado de una búsqueda; hay al menos una arista de 'u' a
+// 'v'.
+static uint32_t dijkstra_yen_peso_minimo(const dijkstra_yen_t *y, uint32_t u,
+	uint32_t v) {
+	uint32_t e, minimo = INFINITO;
+
+	for(e = y->inicio[u]; e < y->inicio[u + 1]; e++)
+		if(y->destinos[e] == v && dijkstra_yen_peso(y, e) < minimo)
+			minimo = dijkstra_yen_peso(y, e);
+
+	return minimo;
+}
 
+// Bloquea o desbloquea las aristas entre dos vértices.
+// PRE: 'y' es el estado de una búsqueda; 'u' y 'v' son vértices.
+// POST: las aristas de 'u' a 'v' quedan bloqueadas si 'bloquear' es true,
+// o desbloqueadas en caso contrario.
+static void dijkstra_yen_bloquear_aristas(dijkstra_yen_t *y, uint32_t u,
+	uint32_t v, bool bloquear) {
+	uint32_t e;
+
+	for(e = y->inicio[u]; e < y->inicio[u + 1]; e++)
+		if(y->destinos[e] == v) y->arista_bloqueada[e] = bloquear;
+}
+
+// Busca el camino mínimo entre dos vértices sin atravesar los vértices ni
+// las aristas bloqueados.
+// PRE: 'y' es el estado de una búsqueda con el árbol inverso calculado;
+// 'desvio' y 'destino' son vértices, con 'desvio' sin bloquear.
+// POST: devuelve true si 'destino' es alcanzable, en cuyo caso su
+// distancia y sus previos hasta 'desvio' quedan en el estado, o false en
+// caso contrario. La búsqueda termina al marcar el destino y sólo
+// reinicia los vértices que alcanzó la anterior.
+static bool dijkstra_yen_buscar(dijkstra_yen_t *y, uint32_t desvio,
+	uint32_t destino) {
+	uint32_t i, e, u, v;
+	uint64_t distancia, prioridad;
+
+	for(i = 0; i < y->cantidad_tocados; i++) {
+		v = y->tocados[i];
+		y->distancias[v] = INFINITO;
+		y->previos[v] = GRAFO_COMPACTO_SIN_VERTICE;
+		y->m.posiciones[v] = INFINITO;
+	}
+
+	y->m.cantidad = 0;
+	y->distancias[desvio] = 0;
+	y->prioridades[desvio] = y->hasta_destino[desvio];
+	y->tocados[0] = desvio;
+	y->cantidad_tocados = 1;
+	dijkstra_ubicar(&y->m, y->m.cantidad++, desvio);
+
+	// Los bloqueos sólo alargan los caminos, por lo que la distancia sin
+	// bloqueos hasta el destino es una cota consistente (A*): se marcan
+	// primero los vértices que van hacia el destino, y se descartan los
+	// que no lo alcanzan
+	while(y->m.cantidad) {
+		u = dijkstra_extraer(&y->m);
+		if(u == destino) return true;
+
+		for(e = y->inicio[u]; e < y->inicio[u + 1]; e++) {
+			v = y->destinos[e];
+			if(y->arista_bloqueada[e] || y->vertice_bloqueado[v] ||
+				y->hasta_destino[v] == INFINITO)
 				continue;
+
+			distancia = (uint64_t) y->distancias[u] + dijkstra_yen_peso(y, e);
+			DIJKSTRA_CONTAR(relajaciones);
+			if(distancia >= y->distancias[v]) continue;
+
+			if(y->distancias[v] == INFINITO)
+				y->tocados[y->cantidad_tocados++] = v;
+
+			prioridad = distancia + y->hasta_destino[v];
+			y->distancias[v] = (uint32_t) distancia;
+			y->prioridades[v] = prioridad < INFINITO ? prioridad : INFINITO - 1;
+			y->previos[v] = u;
+			DIJKSTRA_CONTAR(relajaciones_exitosas);
+
+			if(y->m.posiciones[v] == INFINITO) {
+				dijkstra_ubicar(&y->m, y->m.cantidad++, v);
+				DIJKSTRA_CONTAR(encolados);
 			}
-			
-			// Si la distancia del nodo es mayor, directamente encolamos
-			// en la cola de no marcados nuevamente
-			cola_encolar(NM, Vi);
+
+			dijkstra_subir(&y->m, y->m.posiciones[v]);
+		}
+	}
+
+	return false;
+}
+
+// Calcula el árbol de caminos mínimos hacia el destino, recorriendo las
+// aristas en sentido inverso.
+// PRE: 'y' es el estado de una búsqueda sin bloqueos y con el montículo
+// vacío; 'n' y 'm' son la cantidad de vértices y aristas del grafo;
+// 'destino' es un vértice.
+// POST: devuelve true si se cargó en el estado la distancia de cada
+// vértice al destino y el siguiente vértice de su camino, o false si no
+// hubo memoria suficiente. El montículo queda vacío.
+static bool dijkstra_yen_arbol_inverso(dijkstra_yen_t *y, uint32_t n,
+	uint32_t m, uint32_t destino) {
+	uint32_t u, v, e, f;
+
+	// Aristas que llegan a cada vértice, en formato CSR
+	uint32_t *inicio = (uint32_t*) estadisticas_malloc(SUBSISTEMA_DIJKSTRA,
+		(n + 2) * sizeof(uint32_t));
+	uint32_t *origenes = (uint32_t*) estadisticas_malloc(SUBSISTEMA_DIJKSTRA,
+		(m + 1) * sizeof(uint32_t));
+	uint32_t *pesos = (uint32_t*) estadisticas_malloc(SUBSISTEMA_DIJKSTRA,
+		(m + 1) * sizeof(uint32_t));
+
+	if(!inicio || !origenes || !pesos) {
+		estadisticas_free(SUBSISTEMA_DIJKSTRA, inicio);
+		estadisticas_free(SUBSISTEMA_DIJKSTRA, origenes);
+		estadisticas_free(SUBSISTEMA_DIJKSTRA, pesos);
+		return false;
+	}
+
+	memset(inicio, 0, (n + 2) * sizeof(uint32_t));
+	for(e = 0; e < m; e++) inicio[y->destinos[e] + 2]++;
+	for(v = 0; v < n; v++) inicio[v + 2] += inicio[v + 1];
+
+	for(u = 0; u < n; u++)
+		for(e = y->inicio[u]; e < y->inicio[u + 1]; e++) {
+			f = inicio[y->destinos[e] + 1]++;
+			origenes[f] = u;
+			pesos[f] = dijkstra_yen_peso(y, e);
+		}
+
+	// Dijkstra desde el destino sobre las aristas invertidas
+	dijkstra_monticulo_t inverso = y->m;
+	inverso.distancias = y->hasta_destino;
+
+	for(v = 0; v < n; v++) {
+		y->hasta_destino[v] = INFINITO;
+		y->siguientes[v] = GRAFO_COMPACTO_SIN_VERTICE;
+	}
+
+	y->hasta_destino[destino] = 0;
+	dijkstra_ubicar(&inverso, inverso.cantidad++, destino);
+
+	while(inverso.cantidad) {
+		v = dijkstra_extraer(&inverso);
+
+		for(f = inicio[v]; f < inicio[v + 1]; f++)
+			dijkstra_mejorar(&inverso, y->hasta_destino, y->siguientes, v,
+				origenes[f], (uint64_t) y->hasta_destino[v] + pesos[f]);
+	}
+
+	estadisticas_free(SUBSISTEMA_DIJKSTRA, inicio);
+	estadisticas_free(SUBSISTEMA_DIJKSTRA, origenes);
+	estadisticas_free(SUBSISTEMA_DIJKSTRA, pesos);
+	return true;
+}
+
+// Indica si el camino sin bloqueos desde un vértice hasta el destino
+// evita a los vértices bloqueados y al vértice de desvío.
+// PRE: 'y' es el estado de una búsqueda con el árbol inverso calculado;
+// 'v' es un vértice que alcanza al destino; 'desvio' es un vértice.
+static bool dijkstra_yen_libre(const dijkstra_yen_t *y, uint32_t v,
+	uint32_t desvio) {
+	for(; v != GRAFO_COMPACTO_SIN_VERTICE; v = y->siguientes[v])
+		if(v == desvio || y->vertice_bloqueado[v]) return false;
+
+	return true;
+}
+
+// Calcula el desvío mínimo desde un vértice hasta el destino, sin
+// atravesar los vértices ni las aristas bloqueados.
+// PRE: 'y' es el estado de una búsqueda con el árbol inverso calculado;
+// 'desvio' es un vértice sin bloquear distinto de 'destino'. Sólo hay
+// aristas bloqueadas entre las que parten de 'desvio'.
+// POST: devuelve la cantidad de vértices del desvío, cargados junto con
+// su costo desde 'desvio' en el estado, o 0 si no hay desvío. Si una
+// arista de costo mínimo continúa por el árbol inverso sin cruzar
+// bloqueos, el desvío se arma sin recorrer el grafo; en caso contrario
+// se lo busca con Dijkstra.
+static uint32_t dijkstra_yen_desviar(dijkstra_yen_t *y, uint32_t desvio,
+	uint32_t destino) {
+	uint32_t e, v, s;
+	uint64_t costo, minimo = UINT64_MAX;
+
+	// Cota inferior: ninguna arista libre seguida del camino sin bloqueos
+	// puede mejorarse
+	for(e = y->inicio[desvio]; e < y->inicio[desvio + 1]; e++) {
+		v = y->destinos[e];
+		if(y->arista_bloqueada[e] || y->vertice_bloqueado[v] ||
+			y->hasta_destino[v] == INFINITO)
+			continue;
+
+		costo = (uint64_t) dijkstra_yen_peso(y, e) + y->hasta_destino[v];
+		if(costo < minimo) minimo = costo;
+	}
+
+	if(minimo == UINT64_MAX) return 0;
+
+	for(e = y->inicio[desvio]; e < y->inicio[desvio + 1]; e++) {
+		v = y->destinos[e];
+		if(y->arista_bloqueada[e] || y->vertice_bloqueado[v] ||
+			y->hasta_destino[v] == INFINITO ||
+			(uint64_t) dijkstra_yen_peso(y, e) + y->hasta_destino[v] !=
+			minimo || !dijkstra_yen_libre(y, v, desvio))
+			continue;
+
+		// La cota se alcanza, por lo que el desvío es mínimo
+		y->espuela[0] = desvio;
+		y->espuela_costos[0] = 0;
+
+		for(s = 1; v != GRAFO_COMPACTO_SIN_VERTICE; s++) {
+			y->espuela[s] = v;
+			y->espuela_costos[s] = minimo - y->hasta_destino[v];
+			v = y->siguientes[v];
 		}
+
+		return s;
+	}
+
+	if(!dijkstra_yen_buscar(y, desvio, destino)) return 0;
+
+	for(s = 1, v = destino; v != desvio; s++) v = y->previos[v];
+
+	for(e = s, v = destino; e-- > 0; v = y->previos[v]) {
+		y->espuela[e] = v;
+		y->espuela_costos[e] = y->distancias[v];
+	}
+
+	return s;
+}
+
+// Libera un camino del algoritmo de Yen.
+static void dijkstra_camino_liberar(dijkstra_camino_t *camino) {
+	estadisticas_free(SUBSISTEMA_DIJKSTRA, camino->vertices);
+	estadisticas_free(SUBSISTEMA_DIJKSTRA, camino->costos);
+}
+
+// Reserva un camino del algoritmo de Yen.
+// PRE: 'camino' es donde se almacena; 'largo' es su cantidad de vértices.
+// POST: devuelve true si se reservaron los arreglos o false si no hubo
+// memoria suficiente.
+static bool dijkstra_camino_reservar(dijkstra_camino_t *camino,
+	uint32_t largo) {
+	camino->largo = largo;
+	camino->vertices = (uint32_t*) estadisticas_malloc(SUBSISTEMA_DIJKSTRA,
+		largo * sizeof(uint32_t));
+	camino->costos = (uint64_t*) estadisticas_malloc(SUBSISTEMA_DIJKSTRA,
+		largo * sizeof(uint64_t));
+	if(camino->vertices && camino->costos) return true;
+
+	dijkstra_camino_liberar(camino);
+	return false;
+}
+
+// Indica si dos caminos comienzan con los mismos vértices.
+// PRE: 'a' y 'b' son caminos; 'largo' es la cantidad de vértices a
+// comparar, a lo sumo el largo de 'b'.
+static bool dijkstra_camino_comienza(const dijkstra_camino_t *a,
+	const dijkstra_camino_t *b, uint32_t largo) {
+	uint32_t i;
+
+	if(a->largo < largo) return false;
+	for(i = 0; i < largo; i++)
+		if(a->vertices[i] != b->vertices[i]) return false;
+
+	return true;
+}
+
+
+
+/* ****************************************************************************
+ * FUNCIONES DE LA LIBRERÍA
+ * ***************************************************************************/
+
+
+// Función que calcula los caminos mínimos de un grafo, partiendo de un
+// origen hacia los demás vérticies, utilizando el algoritmo de Dijkstra.
+// PRE: 'grafo' es un grafo compacto cuyas aristas tienen pesos no
+// negativos; 'origen' es el dato del vértice desde el cual se desean
+// calcular los caminos mínimos (debe ser del tipo de datos cargado en el
+// grafo, pero al pasarse a esta función debe ser casteado al tipo
+// lista_dato_t para evitar conflictos de tipo en las listas);
+// 'criterio_seleccion()' es una función que se encarga de definir el
+// criterio de selección ante dos caminos que poseen la misma distancia
+// desde el nodo origen. Por parámetro recibe los dos nodos del grafo. La
+// función debe devolver un valor entero < 0 si se debe elegir el nodo del
+// primer parámetro ó un entero > 0 si se debe elegir el nodo del segundo
+// parámetro.
+// POST: se devuelven los resultados del procesamiento, o NULL si 'origen'
+// no es un vértice del grafo o no hubo memoria suficiente. Estos no son
+// directamente procesables por el usuario, sino que son utilizados por
+// otras funciones de la librería para poder brindar resultados
+// personalizados de acuerdo a lo que se necesite. El grafo debe existir
+// mientras se utilicen los resultados.
+dijkstra_resultados_t* dijkstra_caminos_minimos(grafo_compacto_t *grafo,
+	lista_dato_t origen, int criterio_seleccion(lista_dato_t, lista_dato_t)) {
+	uint32_t v, n = grafo_compacto_cantidad_vertices(grafo);
+	const uint32_t *inicio, *destinos, *pesos32;
+	const uint16_t *pesos16;
+
+	// Los contadores informan sobre la última ejecución
+	dijkstra_reiniciar_contadores();
+
+	uint32_t o = grafo_compacto_buscar_vertice(grafo, origen);
+	if(o == GRAFO_COMPACTO_SIN_VERTICE) return NULL;
+
+	dijkstra_resultados_t *r = (dijkstra_resultados_t*) estadisticas_malloc(
+		SUBSISTEMA_DIJKSTRA, sizeof(dijkstra_resultados_t));
+	if(!r) return NULL;
+
+	r->grafo = grafo;
+	r->distancias = (uint32_t*) estadisticas_malloc(SUBSISTEMA_DIJKSTRA,
+		n * sizeof(uint32_t));
+	r->previos = (uint32_t*) estadisticas_malloc(SUBSISTEMA_DIJKSTRA,
+		n * sizeof(uint32_t));
+
+	// Montículo de vértices alcanzados y aún no marcados
+	dijkstra_monticulo_t m;
+	m.vertices = (uint32_t*) estadisticas_malloc(SUBSISTEMA_DIJKSTRA,
+		n * sizeof(uint32_t));
+	m.posiciones = (uint32_t*) estadisticas_malloc(SUBSISTEMA_DIJKSTRA,
+		n * sizeof(uint32_t));
+	m.cantidad = 0;
+	m.distancias = r->distancias;
+	m.grafo = grafo;
+	m.criterio = criterio_seleccion;
+
+	if(!r->distancias || !r->previos || !m.vertices || !m.posiciones) {
+		estadisticas_free(SUBSISTEMA_DIJKSTRA, m.vertices);
+		estadisticas_free(SUBSISTEMA_DIJKSTRA, m.posiciones);
+		dijkstra_destruir_resultados(r);
+		return NULL;
 	}
 
-	// Si no quedan mas nodos sin marcar, enviamos el último nodo actual 'a' 
-	// a la lista de marcados. Lo insertamos primero para que quede en orden
-	// decreciente, es decir, que comienze por el destino y termine en el
-	// origen
-	lista_insertar_primero(M, a);
+	for(v = 0; v < n; v++) {
+		r->distancias[v] = INFINITO;
+		r->previos[v] = GRAFO_COMPACTO_SIN_VERTICE;
+		m.posiciones[v] = INFINITO;
+	}
+
+	// Partimos del origen
+	r->distancias[o] = 0;
+	dijkstra_ubicar(&m, m.cantidad++, o);
+	DIJKSTRA_CONTAR(encolados);
+
+	grafo_compacto_obtener_arreglos(grafo, &inicio, &destinos, &pesos16,
+		&pesos32);
+
+	// Marcamos los vértices en orden de distancia, relajando las aristas
+	// que parten de cada uno con el recorrido acorde al ancho de los pesos
+	while(m.cantidad) {
+		uint32_t u = dijkstra_extraer(&m);
+		DIJKSTRA_CONTAR(vertices_marcados);
+
+		if(pesos32)
+			dijkstra_relajar_32(&m, r->distancias, r->previos, u, inicio,
+				destinos, pesos32);
+		else
+			dijkstra_relajar_16(&m, r->distancias, r->previos, u, inicio,
+				destinos, pesos16);
+	}
 
-	cola_destruir(NM);
-	cola_destruir(CA);
+	estadisticas_free(SUBSISTEMA_DIJKSTRA, m.vertices);
+	estadisticas_free(SUBSISTEMA_DIJKSTRA, m.posiciones);
 
-	return M;
+	return r;
 }
 
 
-// Función que destruye la lista de resultados del algoritmo de Dijkstra.
-// PRE: 'lista_resultados' es una lista que contiene los resultados derivados
-// de la función dijkstra_caminos_minimos().
+// Función que destruye los resultados del algoritmo de Dijkstra.
+// PRE: 'resultados' son los resultados derivados de la función
+// dijkstra_caminos_minimos().
 // POST: Los resultados son destruidos.
-void dijkstra_destruir_resultados(lista_t* lista_resultados) {
-	// Destruimos la lista y los nodos que contiene dentro
-	lista_destruir(lista_resultados, free);
+void dijkstra_destruir_resultados(dijkstra_resultados_t *resultados) {
+	estadisticas_free(SUBSISTEMA_DIJKSTRA, resultados->distancias);
+	estadisticas_free(SUBSISTEMA_DIJKSTRA, resultados->previos);
+	estadisticas_free(SUBSISTEMA_DIJKSTRA, resultados);
+}
+
+
+// Función que arma los resultados del algoritmo a partir de las distancias
+// y los vértices previos calculados por otro algoritmo de caminos mínimos
+// (ver delta.h), para poder utilizarlos con el resto de la librería.
+// PRE: 'grafo' es el grafo compacto procesado; 'distancias' y 'previos'
+// son arreglos obtenidos con estadisticas_malloc() en el subsistema de
+// Dijkstra, con un elemento por vértice: la distancia mínima desde el
+// origen (UINT32_MAX si no es alcanzable) y el vértice previo en el
+// camino mínimo (GRAFO_COMPACTO_SIN_VERTICE para el origen y los
+// vértices inalcanzables).
+// POST: devuelve los resultados, que toman posesión de los arreglos, o
+// NULL si no hubo memoria suficiente (en cuyo caso se liberan).
+dijkstra_resultados_t* dijkstra_crear_resultados(grafo_compacto_t *grafo,
+	uint32_t *distancias, uint32_t *previos) {
+	dijkstra_resultados_t *r = (dijkstra_resultados_t*) estadisticas_malloc(
+		SUBSISTEMA_DIJKSTRA, sizeof(dijkstra_resultados_t));
+
+	if(!r) {
+		estadisticas_free(SUBSISTEMA_DIJKSTRA, distancias);
+		estadisticas_free(SUBSISTEMA_DIJKSTRA, previos);
+		return NULL;
+	}
+
+	r->grafo = grafo;
+	r->distancias = distancias;
+	r->previos = previos;
+	return r;
+}
+
+
+// Función que devuelve las distancias y los vértices previos calculados,
+// por ejemplo para almacenarlos y luego volver a armar los resultados con
+// dijkstra_crear_resultados().
+// PRE: 'resultados' son resultados de algún algoritmo de caminos mínimos.
+// POST: se cargó en 'distancias' y 'previos' los arreglos de los
+// resultados, con un elemento por vértice y en el formato que describe
+// dijkstra_crear_resultados(). Los arreglos pertenecen a los resultados.
+void dijkstra_obtener_arreglos(const dijkstra_resultados_t *resultados,
+	const uint32_t **distancias, const uint32_t **previos) {
+	*distancias = resultados->distancias;
+	*previos = resultados->previos;
 }
 
 
 // Función que construye una lista con el camino desde el vértice origen
 // hasta un vértice destino.
-// PRE: 'lista_resultados' es una lista que contiene los resultados derivados
-// de la función dijkstra_caminos_minimos(); 'destino' es el destino al que
-// se desea llegar (debe ser del mismo tipo que el dato almacenado en el grafo
+// PRE: 'resultados' son los resultados derivados de la función
+// dijkstra_caminos_minimos(); 'destino' es el destino al que se desea
+// llegar (debe ser del mismo tipo que el dato almacenado en el grafo
 // que se procesó en la función que genera los resultados, pero debe ser 
 // pasado a esta función con un casteo previo a lista_dato_t).
 // POST: devuelve una lista donde el primer elemento es el origen, elúltimo 
 // es el destino y los elementos intermedios determinan el camino a seguir. 
+// Si el destino no es alcanzable, la lista contiene únicamente al destino.
 // Al sacar los elementos de la lista deben ser casteados al tipo del dato
 // insertado en el grafo, el cual se procesó en la función generadora de 
 // resultados.
-lista_t* dijkstra_obtener_camino(lista_t* lista_resultados, 
-	lista_dato_t *destino) {
+lista_t* dijkstra_obtener_camino(dijkstra_resultados_t *resultados,
+	lista_dato_t destino) {
 	// Creamos lista del camino
 	lista_t* camino = lista_crear();
 	if(!camino) return NULL;
 
-	// Establecemos el nodo destino como el nodo inicial de proceso, el cual
-	// se encuentra como primer elemento en la lista de resultados
-	lista_dato_t previo = destino;
-	lista_insertar_primero(camino, previo);
+	lista_insertar_primero(camino, destino);
 
 	// Rastreamos camino desde el destino hacia el nodo origen
-	while(previo) {
-		lista_iter_t* iter = lista_iter_crear(lista_resultados);
-		lista_dato_t aux;
-
-		while(!lista_iter_al_final(iter)) {
-			lista_iter_ver_actual(iter, &aux);
-			
-			// Buscamos en la lista el nodo previo
-			if(((dijkstra_nodo_t*)aux)->dato == previo) {
-				// Terminamos si se llegó al origen
-				if(!(((dijkstra_nodo_t*)aux)->nodo_previo)) {
-					previo = NULL;
-					break;
-				}
+	uint32_t v = grafo_compacto_buscar_vertice(resultados->grafo, destino);
+	if(v == GRAFO_COMPACTO_SIN_VERTICE) return camino;
+
+	while(resultados->previos[v] != GRAFO_COMPACTO_SIN_VERTICE) {
+		v = resultados->previos[v];
+		lista_insertar_primero(camino,
+			grafo_compacto_obtener_dato(resultados->grafo, v));
+		DIJKSTRA_CONTAR(pasos_extraccion);
+	}
 
-				previo = (((dijkstra_nodo_t*)aux)->nodo_previo)->dato;
-				lista_insertar_primero(camino, previo);
-				break;
-			};
+	// Devolvemos la lista del camino
+	return camino;
+}
 
-			lista_iter_avanzar(iter);
+
+// Función que calcula los k caminos mínimos sin ciclos desde el origen de
+// unos resultados hacia un destino, con el algoritmo de Yen.
+// PRE: 'resultados' son resultados cuyo camino hacia 'destino' es válido,
+// obtenidos con el criterio 'criterio_seleccion()' (ver
+// dijkstra_caminos_minimos()); 'destino' es el dato del vértice destino,
+// casteado a lista_dato_t; 'k' es la cantidad de caminos deseados;
+// 'caminos' y 'costos' son arreglos de al menos 'k' elementos.
+// POST: devuelve la cantidad de caminos obtenidos: a lo sumo 'k', menos si
+// no hay tantos caminos sin ciclos o no hubo memoria suficiente, y 0 si
+// el destino no es alcanzable. Se cargaron en 'caminos' listas en el
+// formato de dijkstra_obtener_camino(), de menor a mayor costo (ante
+// igual costo, de menos a más pasos), y en 'costos' el costo de cada
+// una. El primer camino es el de los resultados. Los desvíos se calculan
+// con búsquedas de Dijkstra que ignoran los vértices y aristas
+// bloqueados, sin modificar el grafo. Las listas deben ser destruidas
+// por el usuario. Puede invocarse desde varios hilos a la vez.
+size_t dijkstra_k_caminos_minimos(dijkstra_resultados_t *resultados,
+	lista_dato_t destino, int criterio_seleccion(lista_dato_t, lista_dato_t),
+	size_t k, lista_t **caminos, uint64_t *costos) {
+	grafo_compacto_t *grafo = resultados->grafo;
+	uint32_t n = grafo_compacto_cantidad_vertices(grafo);
+	uint32_t m = grafo_compacto_cantidad_aristas(grafo);
+	uint32_t v, largo, i, j, r, s;
+	size_t obtenidos = 0, p, c, candidatos = 0, capacidad = 0;
+	dijkstra_camino_t *elegidos, *cola = NULL, camino;
+	dijkstra_yen_t y;
+	bool ok;
+
+	uint32_t t = grafo_compacto_buscar_vertice(grafo, destino);
+	if(!k || t == GRAFO_COMPACTO_SIN_VERTICE ||
+		resultados->distancias[t] == INFINITO)
+		return 0;
+
+	elegidos = (dijkstra_camino_t*) estadisticas_malloc(SUBSISTEMA_DIJKSTRA,
+		k * sizeof(dijkstra_camino_t));
+
+	// Estado de las búsquedas de desvíos, con todo sin bloquear
+	y.distancias = (uint32_t*) estadisticas_malloc(SUBSISTEMA_DIJKSTRA,
+		(n + 1) * sizeof(uint32_t));
+	y.previos = (uint32_t*) estadisticas_malloc(SUBSISTEMA_DIJKSTRA,
+		(n + 1) * sizeof(uint32_t));
+	y.tocados = (uint32_t*) estadisticas_malloc(SUBSISTEMA_DIJKSTRA,
+		(n + 1) * sizeof(uint32_t));
+	y.vertice_bloqueado = (unsigned char*) estadisticas_malloc(
+		SUBSISTEMA_DIJKSTRA, n + 1);
+	y.arista_bloqueada = (unsigned char*) estadisticas_malloc(
+		SUBSISTEMA_DIJKSTRA, m + 1);
+	y.m.vertices = (uint32_t*) estadisticas_malloc(SUBSISTEMA_DIJKSTRA,
+		(n + 1) * sizeof(uint32_t));
+	y.m.posiciones = (uint32_t*) estadisticas_malloc(SUBSISTEMA_DIJKSTRA,
+		(n + 1) * sizeof(uint32_t));
+	y.hasta_destino = (uint32_t*) estadisticas_malloc(SUBSISTEMA_DIJKSTRA,
+		(n + 1) * sizeof(uint32_t));
+	y.siguientes = (uint32_t*) estadisticas_malloc(SUBSISTEMA_DIJKSTRA,
+		(n + 1) * sizeof(uint32_t));
+	y.prioridades = (uint32_t*) estadisticas_malloc(SUBSISTEMA_DIJKSTRA,
+		(n + 1) * sizeof(uint32_t));
+	y.espuela = (uint32_t*) estadisticas_malloc(SUBSISTEMA_DIJKSTRA,
+		(n + 1) * sizeof(uint32_t));
+	y.espuela_costos = (uint64_t*) estadisticas_malloc(SUBSISTEMA_DIJKSTRA,
+		(n + 1) * sizeof(uint64_t));
+	y.m.cantidad = 0;
+	y.m.distancias = y.prioridades;
+	y.m.grafo = grafo;
+	y.m.criterio = criterio_seleccion;
+	y.cantidad_tocados = 0;
+	grafo_compacto_obtener_arreglos(grafo, &y.inicio, &y.destinos,
+		&y.pesos16, &y.pesos32);
+
+	ok = elegidos && y.distancias && y.previos && y.tocados &&
+		y.vertice_bloqueado && y.arista_bloqueada && y.m.vertices &&
+		y.m.posiciones && y.hasta_destino && y.siguientes && y.prioridades &&
+		y.espuela && y.espuela_costos;
+
+	if(ok) {
+		for(v = 0; v < n; v++) {
+			y.distancias[v] = INFINITO;
+			y.previos[v] = GRAFO_COMPACTO_SIN_VERTICE;
+			y.m.posiciones[v] = INFINITO;
 		}
-		
-		lista_iter_destruir(iter);
+
+		memset(y.vertice_bloqueado, 0, n);
+		memset(y.arista_bloqueada, 0, m);
+
+		// Las distancias hacia el destino permiten armar la mayoría de los
+		// desvíos sin recorrer el grafo
+		ok = k == 1 || dijkstra_yen_arbol_inverso(&y, n, m, t);
 	}
 
-	// Devolvemos la lista del camino
-	return camino;
+	if(ok) {
+		// El primer camino es el del árbol de los resultados
+		for(largo = 1, v = t; resultados->previos[v] !=
+			GRAFO_COMPACTO_SIN_VERTICE; largo++)
+			v = resultados->previos[v];
+
+		ok = dijkstra_camino_reservar(&elegidos[0], largo);
+	}
+
+	if(ok) {
+		for(i = largo, v = t; i-- > 0; v = resultados->previos[v])
+			elegidos[0].vertices[i] = v;
+
+		elegidos[0].costos[0] = 0;
+		for(i = 1; i < largo; i++)
+			elegidos[0].costos[i] = elegidos[0].costos[i - 1] +
+				dijkstra_yen_peso_minimo(&y, elegidos[0].vertices[i - 1],
+				elegidos[0].vertices[i]);
+
+		obtenidos = 1;
+	}
+
+	// Cada camino nuevo es el mejor de los candidatos obtenidos al
+	// desviarse en cada vértice de alguno de los anteriores
+	while(ok && obtenidos < k) {
+		const dijkstra_camino_t *anterior = &elegidos[obtenidos - 1];
+
+		for(j = 0; ok && j + 1 < anterior->largo; j++) {
+			uint32_t desvio = anterior->vertices[j];
+
+			// El desvío no puede volver a la raíz ni seguir por donde
+			// siguen los caminos ya elegidos con la misma raíz
+			for(r = 0; r < j; r++)
+				y.vertice_bloqueado[anterior->vertices[r]] = true;
+			for(p = 0; p < obtenidos; p++)
+				if(elegidos[p].largo > j + 1 &&
+					dijkstra_camino_comienza(&elegidos[p], anterior, j + 1))
+					dijkstra_yen_bloquear_aristas(&y, desvio,
+						elegidos[p].vertices[j + 1], true);
+
+			if((s = dijkstra_yen_desviar(&y, desvio, t))) {
+				if((ok = dijkstra_camino_reservar(&camino, j + s))) {
+					memcpy(camino.vertices, anterior->vertices,
+						j * sizeof(uint32_t));
+					memcpy(camino.costos, anterior->costos,
+						j * sizeof(uint64_t));
+
+					for(i = 0; i < s; i++) {
+						camino.vertices[j + i] = y.espuela[i];
+						camino.costos[j + i] = anterior->costos[j] +
+							y.espuela_costos[i];
+					}
+
+					// Descartamos los candidatos repetidos
+					for(c = 0; c < candidatos; c++)
+						if(cola[c].largo == camino.largo &&
+							dijkstra_camino_comienza(&cola[c], &camino,
+							camino.largo))
+							break;
+
+					if(c < candidatos)
+						dijkstra_camino_liberar(&camino);
+					else {
+						if(candidatos == capacidad) {
+							size_t nueva = capacidad ? 2 * capacidad : 16;
+							dijkstra_camino_t *ampliada = (dijkstra_camino_t*)
+								estadisticas_malloc(SUBSISTEMA_DIJKSTRA,
+								nueva * sizeof(dijkstra_camino_t));
+
+							if((ok = ampliada != NULL)) {
+								if(candidatos)
+									memcpy(ampliada, cola, candidatos *
+										sizeof(dijkstra_camino_t));
+								estadisticas_free(SUBSISTEMA_DIJKSTRA, cola);
+								cola = ampliada;
+								capacidad = nueva;
+							}
+						}
+
+						if(ok) cola[candidatos++] = camino;
+						else dijkstra_camino_liberar(&camino);
+					}
+				}
+			}
+
+			for(r = 0; r < j; r++)
+				y.vertice_bloqueado[anterior->vertices[r]] = false;
+			for(p = 0; p < obtenidos; p++)
+				if(elegidos[p].largo > j + 1 &&
+					dijkstra_camino_comienza(&elegidos[p], anterior, j + 1))
+					dijkstra_yen_bloquear_aristas(&y, desvio,
+						elegidos[p].vertices[j + 1], false);
+		}
+
+		if(!ok || !candidatos) break;
+
+		// Elegimos el candidato de menor costo y, ante igual costo, el de
+		// menos pasos y luego el primero obtenido
+		for(c = 1, p = 0; c < candidatos; c++)
+			if(cola[c].costos[cola[c].largo - 1] <
+				cola[p].costos[cola[p].largo - 1] ||
+				(cola[c].costos[cola[c].largo - 1] ==
+				cola[p].costos[cola[p].largo - 1] &&
+				cola[c].largo < cola[p].largo))
+				p = c;
+
+		elegidos[obtenidos++] = cola[p];
+		memmove(&cola[p], &cola[p + 1],
+			(candidatos - p - 1) * sizeof(dijkstra_camino_t));
+		candidatos--;
+	}
+
+	// Armamos las listas de los caminos elegidos
+	for(p = 0; p < obtenidos; p++) {
+		caminos[p] = lista_crear();
+		costos[p] = elegidos[p].costos[elegidos[p].largo - 1];
+
+		for(i = 0; caminos[p] && i < elegidos[p].largo; i++)
+			lista_insertar_ultimo(caminos[p], grafo_compacto_obtener_dato(
+				grafo, elegidos[p].vertices[i]));
+
+		dijkstra_camino_liberar(&elegidos[p]);
+		if(!caminos[p]) break;
+	}
+
+	// Si no se pudo armar alguna lista, se devuelven las anteriores
+	for(c = p + (p < obtenidos); c < obtenidos; c++)
+		dijkstra_camino_liberar(&elegidos[c]);
+	if(p < obtenidos) obtenidos = p;
+
+	for(c = 0; c < candidatos; c++) dijkstra_camino_liberar(&cola[c]);
+	estadisticas_free(SUBSISTEMA_DIJKSTRA, cola);
+	estadisticas_free(SUBSISTEMA_DIJKSTRA, elegidos);
+	estadisticas_free(SUBSISTEMA_DIJKSTRA, y.distancias);
+	estadisticas_free(SUBSISTEMA_DIJKSTRA, y.previos);
+	estadisticas_free(SUBSISTEMA_DIJKSTRA, y.tocados);
+	estadisticas_free(SUBSISTEMA_DIJKSTRA, y.vertice_bloqueado);
+	estadisticas_free(SUBSISTEMA_DIJKSTRA, y.arista_bloqueada);
+	estadisticas_free(SUBSISTEMA_DIJKSTRA, y.m.vertices);
+	estadisticas_free(SUBSISTEMA_DIJKSTRA, y.m.posiciones);
+	estadisticas_free(SUBSISTEMA_DIJKSTRA, y.hasta_destino);
+	estadisticas_free(SUBSISTEMA_DIJKSTRA, y.siguientes);
+	estadisticas_free(SUBSISTEMA_DIJKSTRA, y.prioridades);
+	estadisticas_free(SUBSISTEMA_DIJKSTRA, y.espuela);
+	estadisticas_free(SUBSISTEMA_DIJKSTRA, y.espuela_costos);
+
+	return obtenidos;
+}
+
+
+// Reinicia los contadores de ejecución.
+// POST: todos los contadores valen 0. Si no se compilaron los contadores,
+// no tiene efecto.
+void dijkstra_reiniciar_contadores() {
+#ifdef DIJKSTRA_CONTADORES
+	dijkstra_contadores_t vacios = { 0, 0, 0, 0, 0, 0, 0 };
+	contadores = vacios;
+#endif
+}
+
+
+// Obtiene los contadores de la última ejecución del algoritmo, incluyendo
+// los pasos de extracción de los caminos obtenidos desde entonces.
+// PRE: 'resultado' es un puntero a la variable que recibirá los contadores.
+// POST: devuelve true si se copiaron los contadores en 'resultado' o false
+// si estos no fueron compilados (ver DIJKSTRA_CONTADORES).
+bool dijkstra_obtener_contadores(dijkstra_contadores_t *resultado) {
+#ifdef DIJKSTRA_CONTADORES
+	*resultado = contadores;
+	return true;
+#else
+	(void) resultado;
+	return false;
+#endif
 }
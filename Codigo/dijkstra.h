@@ -18,8 +18,34 @@
  * INCLUSIÓN DE LIBRERIAS Y TADS EXTERNOS
  * ***************************************************************************/
 
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 #include "lista.h"
 #include "grafo.h"
+#include "grafo_compacto.h"
+
+
+
+/* ****************************************************************************
+ * DECLARACIÓN DE LOS TIPOS DE DATOS
+ * ***************************************************************************/
+
+typedef struct _dijkstra_resultados_t dijkstra_resultados_t;
+
+// Tipo que representa los contadores de una ejecución del algoritmo. Sólo
+// se registran si se compila con DIJKSTRA_CONTADORES definido; en caso
+// contrario no tienen costo alguno.
+typedef struct {
+	size_t vertices_marcados;		// Vértices cuyo camino mínimo se fijó
+	size_t relajaciones;			// Aristas evaluadas
+	size_t relajaciones_exitosas;	// Aristas que mejoraron un camino
+	size_t encolados;				// Inserciones en colas de trabajo
+	size_t desencolados;			// Extracciones de colas de trabajo
+	size_t desempates;				// Empates de distancia resueltos por el
+									// criterio de selección
+	size_t pasos_extraccion;		// Vértices recorridos al obtener caminos
+} dijkstra_contadores_t;
 
 
 
@@ -30,45 +56,110 @@
 
 // Función que calcula los caminos mínimos de un grafo, partiendo de un
 // origen hacia los demás vérticies, utilizando el algoritmo de Dijkstra.
-// PRE: 'grafo' es un grafo cargado con nodos no aislados; 'origen' es
-// el nodo desde el cual se desean calcular los caminos mínimos (debe ser
-// del tipo de datos cargado en el grafo, pero al pasarse a esta función
-// debe ser casteado al tipo lista_dato_t para evitar conflictos de tipo
-// en las listas); 'criterio_seleccion()' es una función que se encarga 
-// de definir el criterio de selección ante dos caminos que poseen la 
-// misma distancia desde el nodo origen. Por parámetro recibe los dos
-// nodos del grafo. La función debe devolver un valor entero < 0 si se
-// debe elegir el nodo del primer parámetro ó un entero > 0 si se debe
-// elegir el nodo del segundo parámetro.
-// POST: se devuelve una lista donde se almacenan los resultados de 
-// procesamiento. Estos no son directamente procesables por el usuario.
-// Esta lista es utilizada por otras funciones de la librería para poder
-// brindar resultados personalizados de acuerdo a lo que se necesite.
-lista_t* dijkstra_caminos_minimos(grafo_t *grafo, lista_dato_t origen, 
-	int criterio_seleccion(lista_dato_t, lista_dato_t));
-
-
-// Función que destruye la lista de resultados del algoritmo de Dijkstra.
-// PRE: 'lista_resultados' es una lista que contiene los resultados derivados
-// de la función dijkstra_caminos_minimos().
+// PRE: 'grafo' es un grafo compacto cuyas aristas tienen pesos no
+// negativos; 'origen' es el dato del vértice desde el cual se desean
+// calcular los caminos mínimos (debe ser del tipo de datos cargado en el
+// grafo, pero al pasarse a esta función debe ser casteado al tipo
+// lista_dato_t para evitar conflictos de tipo en las listas);
+// 'criterio_seleccion()' es una función que se encarga de definir el
+// criterio de selección ante dos caminos que poseen la misma distancia
+// desde el nodo origen. Por parámetro recibe los dos nodos del grafo. La
+// función debe devolver un valor entero < 0 si se debe elegir el nodo del
+// primer parámetro ó un entero > 0 si se debe elegir el nodo del segundo
+// parámetro.
+// POST: se devuelven los resultados del procesamiento, o NULL si 'origen'
+// no es un vértice del grafo o no hubo memoria suficiente. Estos no son
+// directamente procesables por el usuario, sino que son utilizados por
+// otras funciones de la librería para poder brindar resultados
+// personalizados de acuerdo a lo que se necesite. El grafo debe existir
+// mientras se utilicen los resultados.
+dijkstra_resultados_t* dijkstra_caminos_minimos(grafo_compacto_t *grafo,
+	lista_dato_t origen, int criterio_seleccion(lista_dato_t, lista_dato_t));
+
+
+// Función que destruye los resultados del algoritmo de Dijkstra.
+// PRE: 'resultados' son los resultados derivados de la función
+// dijkstra_caminos_minimos().
 // POST: Los resultados son destruidos.
-void dijkstra_destruir_resultados(lista_t* lista_resultados);
+void dijkstra_destruir_resultados(dijkstra_resultados_t *resultados);
+
+
+// Función que arma los resultados del algoritmo a partir de las distancias
+// y los vértices previos calculados por otro algoritmo de caminos mínimos
+// (ver delta.h), para poder utilizarlos con el resto de la librería.
+// PRE: 'grafo' es el grafo compacto procesado; 'distancias' y 'previos'
+// son arreglos obtenidos con estadisticas_malloc() en el subsistema de
+// Dijkstra, con un elemento por vértice: la distancia mínima desde el
+// origen (UINT32_MAX si no es alcanzable) y el vértice previo en el
+// camino mínimo (GRAFO_COMPACTO_SIN_VERTICE para el origen y los
+// vértices inalcanzables).
+// POST: devuelve los resultados, que toman posesión de los arreglos, o
+// NULL si no hubo memoria suficiente (en cuyo caso se liberan).
+dijkstra_resultados_t* dijkstra_crear_resultados(grafo_compacto_t *grafo,
+	uint32_t *distancias, uint32_t *previos);
+
+
+// Función que devuelve las distancias y los vértices previos calculados,
+// por ejemplo para almacenarlos y luego volver a armar los resultados con
+// dijkstra_crear_resultados().
+// PRE: 'resultados' son resultados de algún algoritmo de caminos mínimos.
+// POST: se cargó en 'distancias' y 'previos' los arreglos de los
+// resultados, con un elemento por vértice y en el formato que describe
+// dijkstra_crear_resultados(). Los arreglos pertenecen a los resultados.
+void dijkstra_obtener_arreglos(const dijkstra_resultados_t *resultados,
+	const uint32_t **distancias, const uint32_t **previos);
 
 
 // Función que construye una lista con el camino desde el vértice origen
 // hasta un vértice destino.
-// PRE: 'lista_resultados' es una lista que contiene los resultados derivados
-// de la función dijkstra_caminos_minimos(); 'destino' es el destino al que
-// se desea llegar (debe ser del mismo tipo que el dato almacenado en el grafo
+// PRE: 'resultados' son los resultados derivados de la función
+// dijkstra_caminos_minimos(); 'destino' es el destino al que se desea
+// llegar (debe ser del mismo tipo que el dato almacenado en el grafo
 // que se procesó en la función que genera los resultados, pero debe ser 
 // pasado a esta función con un casteo previo a lista_dato_t).
 // POST: devuelve una lista donde el primer elemento es el origen, elúltimo 
 // es el destino y los elementos intermedios determinan el camino a seguir. 
+// Si el destino no es alcanzable, la lista contiene únicamente al destino.
 // Al sacar los elementos de la lista deben ser casteados al tipo del dato
 // insertado en el grafo, el cual se procesó en la función generadora de 
 // resultados.
-lista_t* dijkstra_obtener_camino(lista_t* lista_resultados, 
-	lista_dato_t *destino);
+lista_t* dijkstra_obtener_camino(dijkstra_resultados_t *resultados,
+	lista_dato_t destino);
+
+
+// Función que calcula los k caminos mínimos sin ciclos desde el origen de
+// unos resultados hacia un destino, con el algoritmo de Yen.
+// PRE: 'resultados' son resultados cuyo camino hacia 'destino' es válido,
+// obtenidos con el criterio 'criterio_seleccion()' (ver
+// dijkstra_caminos_minimos()); 'destino' es el dato del vértice destino,
+// casteado a lista_dato_t; 'k' es la cantidad de caminos deseados;
+// 'caminos' y 'costos' son arreglos de al menos 'k' elementos.
+// POST: devuelve la cantidad de caminos obtenidos: a lo sumo 'k', menos si
+// no hay tantos caminos sin ciclos o no hubo memoria suficiente, y 0 si
+// el destino no es alcanzable. Se cargaron en 'caminos' listas en el
+// formato de dijkstra_obtener_camino(), de menor a mayor costo (ante
+// igual costo, de menos a más pasos), y en 'costos' el costo de cada
+// una. El primer camino es el de los resultados. Los desvíos se calculan
+// con búsquedas de Dijkstra que ignoran los vértices y aristas
+// bloqueados, sin modificar el grafo. Las listas deben ser destruidas
+// por el usuario. Puede invocarse desde varios hilos a la vez.
+size_t dijkstra_k_caminos_minimos(dijkstra_resultados_t *resultados,
+	lista_dato_t destino, int criterio_seleccion(lista_dato_t, lista_dato_t),
+	size_t k, lista_t **caminos, uint64_t *costos);
+
+
+// Reinicia los contadores de ejecución.
+// POST: todos los contadores valen 0. Si no se compilaron los contadores,
+// no tiene efecto.
+void dijkstra_reiniciar_contadores();
+
+
+// Obtiene los contadores de la última ejecución del algoritmo, incluyendo
+// los pasos de extracción de los caminos obtenidos desde entonces.
+// PRE: 'resultado' es un puntero a la variable que recibirá los contadores.
+// POST: devuelve true si se copiaron los contadores en 'resultado' o false
+// si estos no fueron compilados (ver DIJKSTRA_CONTADORES).
+bool dijkstra_obtener_contadores(dijkstra_contadores_t *resultado);
 
 
 #endif
@@ -0,0 +1,234 @@
+/* ****************************************************************************
+ * ****************************************************************************
+ * TAD VERSIONES POR ÉPOCAS
+ * ..................................................................
+ *
+ * Implementación de una referencia a la versión vigente de un dato
+ * inmutable, que los lectores consultan sin tomar bloqueos mientras un
+ * escritor publica versiones nuevas (esquema de lectura-copia-
+ * actualización con reclamación por épocas).
+ *
+ * Cada lector tiene un número de lector propio. Para leer, fija la
+ * versión vigente anunciando la época global en la que comenzó, y la
+ * suelta al terminar. El escritor arma la versión nueva por su cuenta y
+ * la publica reemplazando la referencia en forma atómica; la versión
+ * reemplazada se retira con la época de su reemplazo, y se destruye
+ * recién cuando ningún lector anuncia una época anterior o igual, es
+ * decir, cuando ningún lector puede seguir utilizándola.
+ *
+ * ****************************************************************************
+ * ***************************************************************************/
+
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "epocas.h"
+#include "estadisticas.h"
+
+
+
+/* ****************************************************************************
+ * CONSTANTES
+ * ***************************************************************************/
+
+// Época que anuncia un lector que no tiene una versión fijada
+#define EPOCAS_INACTIVO UINT64_MAX
+
+
+
+/* ****************************************************************************
+ * DEFINICIÓN DE LOS TIPOS DE DATOS
+ * ***************************************************************************/
+
+// Tipo que representa el anuncio de un lector.
+typedef struct {
+	uint64_t epoca;						// Época en que fijó su versión, o
+										// EPOCAS_INACTIVO
+	char relleno[56];					// Separa los anuncios en líneas de
+										// caché distintas
+} epocas_anuncio_t;
+
+// Tipo que representa una versión retirada, pendiente de destrucción.
+typedef struct _epocas_retirada_t {
+	void *dato;							// Versión retirada
+	uint64_t epoca;						// Época en la que se la retiró
+	struct _epocas_retirada_t *siguiente;	// Siguiente versión retirada
+} epocas_retirada_t;
+
+// Tipo que representa una referencia versionada.
+struct _epocas_t {
+	void *vigente;						// Versión vigente
+	uint64_t epoca;						// Época global
+	epocas_anuncio_t *anuncios;			// Anuncio de cada lector
+	size_t lectores;					// Cantidad de lectores
+	epocas_destruir_dato_t destruir_dato;	// Destructor de versiones
+	pthread_mutex_t mutex;				// Serializa a los escritores
+	epocas_retirada_t *retiradas;		// Versiones retiradas
+	size_t cantidad_retiradas;			// Cantidad de versiones retiradas
+};
+
+
+
+/* ****************************************************************************
+ * FUNCIONES AUXILIARES
+ * ***************************************************************************/
+
+// Destruye las versiones retiradas antes de una época.
+// PRE: 'epocas' es una referencia cuyo mutex tiene tomado el llamador;
+// 'limite' es una época.
+// POST: se destruyeron las versiones retiradas en épocas menores a
+// 'limite'.
+static void epocas_destruir_retiradas(epocas_t *epocas, uint64_t limite) {
+	epocas_retirada_t **actual = &epocas->retiradas;
+
+	while(*actual) {
+		epocas_retirada_t *retirada = *actual;
+
+		if(retirada->epoca >= limite) {
+			actual = &retirada->siguiente;
+			continue;
+		}
+
+		*actual = retirada->siguiente;
+		if(epocas->destruir_dato) epocas->destruir_dato(retirada->dato);
+		estadisticas_free(SUBSISTEMA_EPOCAS, retirada);
+		epocas->cantidad_retiradas--;
+	}
+}
+
+
+
+/* ****************************************************************************
+ * PRIMITIVAS DE LAS VERSIONES POR ÉPOCAS
+ * ***************************************************************************/
+
+// Crea una referencia versionada.
+// PRE: 'lectores' es la cantidad de lectores (al menos 1); 'dato' es la
+// versión inicial; 'destruir_dato' es la función que destruye las
+// versiones retiradas, o NULL si no se deben destruir.
+// POST: devuelve una nueva referencia cuya versión vigente es 'dato', o
+// NULL si no se ha podido llevar a cabo la creación de la misma.
+epocas_t* epocas_crear(size_t lectores, void *dato,
+	epocas_destruir_dato_t destruir_dato) {
+	size_t i;
+
+	epocas_t *epocas = (epocas_t*) estadisticas_malloc(SUBSISTEMA_EPOCAS,
+		sizeof(epocas_t));
+	if(!epocas) return NULL;
+
+	epocas->lectores = lectores ? lectores : 1;
+	epocas->anuncios = (epocas_anuncio_t*) estadisticas_malloc(
+		SUBSISTEMA_EPOCAS, epocas->lectores * sizeof(epocas_anuncio_t));
+	if(!epocas->anuncios) {
+		estadisticas_free(SUBSISTEMA_EPOCAS, epocas);
+		return NULL;
+	}
+
+	for(i = 0; i < epocas->lectores; i++)
+		epocas->anuncios[i].epoca = EPOCAS_INACTIVO;
+
+	epocas->vigente = dato;
+	epocas->epoca = 0;
+	epocas->destruir_dato = destruir_dato;
+	epocas->retiradas = NULL;
+	epocas->cantidad_retiradas = 0;
+	pthread_mutex_init(&epocas->mutex, NULL);
+
+	return epocas;
+}
+
+// Destruye una referencia versionada junto con todas sus versiones.
+// PRE: 'epocas' es una referencia existente que ningún lector tiene
+// fijada.
+// POST: se destruyeron la versión vigente y las retiradas.
+void epocas_destruir(epocas_t *epocas) {
+	epocas_destruir_retiradas(epocas, EPOCAS_INACTIVO);
+	if(epocas->destruir_dato) epocas->destruir_dato(epocas->vigente);
+
+	pthread_mutex_destroy(&epocas->mutex);
+	estadisticas_free(SUBSISTEMA_EPOCAS, epocas->anuncios);
+	estadisticas_free(SUBSISTEMA_EPOCAS, epocas);
+}
+
+// Fija la versión vigente para un lector.
+// PRE: 'epocas' es una referencia existente; 'lector' es un número de
+// lector, de 0 a la cantidad de lectores menos uno, que no tiene una
+// versión fijada.
+// POST: devuelve la versión vigente, que no se destruirá hasta que el
+// lector la suelte. No toma bloqueos.
+void* epocas_fijar(epocas_t *epocas, size_t lector) {
+	// El anuncio debe ser visible antes de leer la referencia: si el
+	// lector obtiene una versión que luego se reemplaza, la época con la
+	// que se la retira no será menor a la anunciada
+	uint64_t epoca = __atomic_load_n(&epocas->epoca, __ATOMIC_SEQ_CST);
+	__atomic_store_n(&epocas->anuncios[lector].epoca, epoca,
+		__ATOMIC_SEQ_CST);
+
+	return __atomic_load_n(&epocas->vigente, __ATOMIC_SEQ_CST);
+}
+
+// Suelta la versión fijada por un lector.
+// PRE: 'epocas' es una referencia existente; 'lector' tiene una versión
+// fijada.
+// POST: el lector ya no puede utilizar la versión que había fijado.
+void epocas_soltar(epocas_t *epocas, size_t lector) {
+	__atomic_store_n(&epocas->anuncios[lector].epoca, EPOCAS_INACTIVO,
+		__ATOMIC_RELEASE);
+}
+
+// Publica una versión nueva.
+// PRE: 'epocas' es una referencia existente; 'dato' es la versión nueva,
+// que los lectores no deben modificar.
+// POST: devuelve true si los lectores que fijen a partir de ahora
+// obtienen 'dato', o false si no hubo memoria suficiente (en cuyo caso
+// no se publicó). La versión reemplazada se destruye en cuanto ningún
+// lector pueda utilizarla. Puede invocarse desde varios escritores a la
+// vez.
+bool epocas_publicar(epocas_t *epocas, void *dato) {
+	epocas_retirada_t *retirada = (epocas_retirada_t*) estadisticas_malloc(
+		SUBSISTEMA_EPOCAS, sizeof(epocas_retirada_t));
+	if(!retirada) return false;
+
+	pthread_mutex_lock(&epocas->mutex);
+
+	// Reemplazamos la versión y la retiramos con la época actual, que
+	// luego avanza para los lectores que fijen desde ahora
+	retirada->dato = __atomic_exchange_n(&epocas->vigente, dato,
+		__ATOMIC_SEQ_CST);
+	retirada->epoca = __atomic_fetch_add(&epocas->epoca, 1, __ATOMIC_SEQ_CST);
+	retirada->siguiente = epocas->retiradas;
+	epocas->retiradas = retirada;
+	epocas->cantidad_retiradas++;
+
+	pthread_mutex_unlock(&epocas->mutex);
+
+	epocas_reclamar(epocas);
+	return true;
+}
+
+// Destruye las versiones retiradas que ningún lector puede utilizar.
+// PRE: 'epocas' es una referencia existente.
+// POST: devuelve la cantidad de versiones retiradas que aún no pudieron
+// destruirse.
+size_t epocas_reclamar(epocas_t *epocas) {
+	uint64_t minima = EPOCAS_INACTIVO, epoca;
+	size_t i, pendientes;
+
+	pthread_mutex_lock(&epocas->mutex);
+
+	// Una versión retirada puede estar en uso sólo por los lectores que
+	// anunciaron una época anterior o igual a la de su retiro
+	for(i = 0; i < epocas->lectores; i++) {
+		epoca = __atomic_load_n(&epocas->anuncios[i].epoca, __ATOMIC_SEQ_CST);
+		if(epoca < minima) minima = epoca;
+	}
+
+	epocas_destruir_retiradas(epocas, minima);
+	pendientes = epocas->cantidad_retiradas;
+
+	pthread_mutex_unlock(&epocas->mutex);
+	return pendientes;
+}
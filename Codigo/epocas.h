@@ -0,0 +1,91 @@
+/* ****************************************************************************
+ * ****************************************************************************
+ * TAD VERSIONES POR ÉPOCAS
+ * ..................................................................
+ *
+ * Implementación de una referencia a la versión vigente de un dato
+ * inmutable, que los lectores consultan sin tomar bloqueos mientras un
+ * escritor publica versiones nuevas (esquema de lectura-copia-
+ * actualización con reclamación por épocas).
+ *
+ * Cada lector tiene un número de lector propio. Para leer, fija la
+ * versión vigente anunciando la época global en la que comenzó, y la
+ * suelta al terminar. El escritor arma la versión nueva por su cuenta y
+ * la publica reemplazando la referencia en forma atómica; la versión
+ * reemplazada se retira con la época de su reemplazo, y se destruye
+ * recién cuando ningún lector anuncia una época anterior o igual, es
+ * decir, cuando ningún lector puede seguir utilizándola.
+ *
+ * ****************************************************************************
+ * ***************************************************************************/
+
+
+#ifndef EPOCAS_H
+#define EPOCAS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+
+
+/* ****************************************************************************
+ * DECLARACIÓN DE LOS TIPOS DE DATOS
+ * ***************************************************************************/
+
+typedef struct _epocas_t epocas_t;
+
+// Tipo de las funciones que destruyen una versión retirada.
+typedef void (*epocas_destruir_dato_t)(void *dato);
+
+
+
+/* ****************************************************************************
+ * PRIMITIVAS DE LAS VERSIONES POR ÉPOCAS
+ * ***************************************************************************/
+
+// Crea una referencia versionada.
+// PRE: 'lectores' es la cantidad de lectores (al menos 1); 'dato' es la
+// versión inicial; 'destruir_dato' es la función que destruye las
+// versiones retiradas, o NULL si no se deben destruir.
+// POST: devuelve una nueva referencia cuya versión vigente es 'dato', o
+// NULL si no se ha podido llevar a cabo la creación de la misma.
+epocas_t* epocas_crear(size_t lectores, void *dato,
+	epocas_destruir_dato_t destruir_dato);
+
+// Destruye una referencia versionada junto con todas sus versiones.
+// PRE: 'epocas' es una referencia existente que ningún lector tiene
+// fijada.
+// POST: se destruyeron la versión vigente y las retiradas.
+void epocas_destruir(epocas_t *epocas);
+
+// Fija la versión vigente para un lector.
+// PRE: 'epocas' es una referencia existente; 'lector' es un número de
+// lector, de 0 a la cantidad de lectores menos uno, que no tiene una
+// versión fijada.
+// POST: devuelve la versión vigente, que no se destruirá hasta que el
+// lector la suelte. No toma bloqueos.
+void* epocas_fijar(epocas_t *epocas, size_t lector);
+
+// Suelta la versión fijada por un lector.
+// PRE: 'epocas' es una referencia existente; 'lector' tiene una versión
+// fijada.
+// POST: el lector ya no puede utilizar la versión que había fijado.
+void epocas_soltar(epocas_t *epocas, size_t lector);
+
+// Publica una versión nueva.
+// PRE: 'epocas' es una referencia existente; 'dato' es la versión nueva,
+// que los lectores no deben modificar.
+// POST: devuelve true si los lectores que fijen a partir de ahora
+// obtienen 'dato', o false si no hubo memoria suficiente (en cuyo caso
+// no se publicó). La versión reemplazada se destruye en cuanto ningún
+// lector pueda utilizarla. Puede invocarse desde varios escritores a la
+// vez.
+bool epocas_publicar(epocas_t *epocas, void *dato);
+
+// Destruye las versiones retiradas que ningún lector puede utilizar.
+// PRE: 'epocas' es una referencia existente.
+// POST: devuelve la cantidad de versiones retiradas que aún no pudieron
+// destruirse.
+size_t epocas_reclamar(epocas_t *epocas);
+
+#endif
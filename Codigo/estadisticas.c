@@ -0,0 +1,213 @@
+/* ****************************************************************************
+ * ****************************************************************************
+ * ESTADÍSTICAS DE EJECUCIÓN
+ * ****************************************************************************
+ * ****************************************************************************
+ *
+ * Librería de funciones que registra el tiempo insumido por cada etapa del
+ * procesamiento de una red y la cantidad de pedidos y liberaciones de
+ * memoria realizados por cada subsistema.
+ */
+
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/resource.h>
+#include "estadisticas.h"
+
+
+
+/* ****************************************************************************
+ * CONSTANTES
+ * ***************************************************************************/
+
+// Nombres de las etapas
+static const char *NOMBRES_ETAPAS[ETAPAS] = {
+	"parseo", "construccion", "caminos", "extraccion", "salida"
+};
+
+// Máxima cantidad de contadores adicionales
+#define MAX_CONTADORES 32
+
+// Nombres de los subsistemas
+static const char *NOMBRES_SUBSISTEMAS[SUBSISTEMAS] = {
+	"lista", "cola", "grafo", "dijkstra", "router", "cadenas",
+	"prefijos", "hilos", "epocas", "areas",
+	"persistencia", "fallas", "descompresor", "cache"
+};
+
+
+
+/* ****************************************************************************
+ * ESTADO DE LA LIBRERÍA
+ * ***************************************************************************/
+
+// Tiempos acumulados por etapa, en milisegundos
+static double pared_ms[ETAPAS];
+static double cpu_ms[ETAPAS];
+
+// Instantes de comienzo de las etapas en curso
+static double pared_inicio[ETAPAS];
+static double cpu_inicio[ETAPAS];
+
+// Pedidos y liberaciones de memoria por subsistema. Se incrementan en forma
+// atómica, ya que los subsistemas pueden pedir memoria desde varios hilos.
+static size_t mallocs[SUBSISTEMAS];
+static size_t frees[SUBSISTEMAS];
+
+// Contadores adicionales registrados
+static const char *nombres_contadores[MAX_CONTADORES];
+static size_t valores_contadores[MAX_CONTADORES];
+static int cantidad_contadores = 0;
+
+
+
+/* ****************************************************************************
+ * FUNCIONES AUXILIARES
+ * ***************************************************************************/
+
+// Devuelve el valor de un reloj en milisegundos.
+// PRE: 'reloj' es un reloj de clock_gettime().
+static double reloj_ms(clockid_t reloj) {
+	struct timespec t;
+	clock_gettime(reloj, &t);
+	return t.tv_sec * 1e3 + t.tv_nsec / 1e6;
+}
+
+// Devuelve el pico de memoria residente del proceso, en KiB.
+static long rss_pico_kb() {
+	struct rusage uso;
+	if(getrusage(RUSAGE_SELF, &uso)) return 0;
+	return uso.ru_maxrss;
+}
+
+
+
+/* ****************************************************************************
+ * FUNCIONES DE LA LIBRERIA
+ * ***************************************************************************/
+
+// Solicita memoria contabilizando el pedido en un subsistema.
+// PRE: 'subsistema' es el subsistema que realiza el pedido; 'tamanio' es
+// la cantidad de bytes solicitados.
+// POST: devuelve lo mismo que malloc().
+void* estadisticas_malloc(subsistema_t subsistema, size_t tamanio) {
+	__atomic_fetch_add(&mallocs[subsistema], 1, __ATOMIC_RELAXED);
+	return malloc(tamanio);
+}
+
+// Modifica el tamaño de un bloque de memoria contabilizando el pedido en
+// un subsistema. Si 'ptr' es NULL se contabiliza como un nuevo pedido;
+// en caso contrario el bloque sigue siendo el mismo pedido.
+// PRE: 'subsistema' es el subsistema que realiza el pedido; 'ptr' es un
+// puntero obtenido con estadisticas_malloc() o NULL; 'tamanio' es la
+// nueva cantidad de bytes.
+// POST: devuelve lo mismo que realloc().
+void* estadisticas_realloc(subsistema_t subsistema, void *ptr,
+	size_t tamanio) {
+	void *nuevo = realloc(ptr, tamanio);
+	if(nuevo && !ptr)
+		__atomic_fetch_add(&mallocs[subsistema], 1, __ATOMIC_RELAXED);
+	return nuevo;
+}
+
+// Libera memoria contabilizando la liberación en un subsistema.
+// PRE: 'subsistema' es el subsistema que realiza la liberación; 'ptr' es
+// un puntero obtenido con estadisticas_malloc() o NULL.
+void estadisticas_free(subsistema_t subsistema, void *ptr) {
+	if(!ptr) return;
+	__atomic_fetch_add(&frees[subsistema], 1, __ATOMIC_RELAXED);
+	free(ptr);
+}
+
+// Marca el comienzo de una etapa del procesamiento.
+// PRE: 'etapa' es la etapa que comienza.
+void estadisticas_iniciar_etapa(etapa_t etapa) {
+	pared_inicio[etapa] = reloj_ms(CLOCK_MONOTONIC);
+	cpu_inicio[etapa] = reloj_ms(CLOCK_PROCESS_CPUTIME_ID);
+}
+
+// Marca la finalización de una etapa del procesamiento, acumulando el
+// tiempo de reloj y de CPU transcurridos desde su comienzo.
+// PRE: 'etapa' es una etapa previamente iniciada.
+void estadisticas_finalizar_etapa(etapa_t etapa) {
+	pared_ms[etapa] += reloj_ms(CLOCK_MONOTONIC) - pared_inicio[etapa];
+	cpu_ms[etapa] += reloj_ms(CLOCK_PROCESS_CPUTIME_ID) - cpu_inicio[etapa];
+}
+
+// Registra un contador adicional para que sea informado junto con las
+// estadísticas. Si ya existía un contador con el mismo nombre, se
+// reemplaza su valor.
+// PRE: 'nombre' es una cadena que permanece válida hasta que se informan
+// las estadísticas; 'valor' es el valor del contador.
+void estadisticas_registrar_contador(const char *nombre, size_t valor) {
+	int i;
+
+	for(i = 0; i < cantidad_contadores; i++)
+		if(!strcmp(nombres_contadores[i], nombre)) break;
+
+	if(i == MAX_CONTADORES) return;
+	if(i == cantidad_contadores) cantidad_contadores++;
+
+	nombres_contadores[i] = nombre;
+	valores_contadores[i] = valor;
+}
+
+// Envía las estadísticas registradas a un stream.
+// PRE: 'fp' es el stream de salida; 'formato' es el formato deseado;
+// 'vertices', 'aristas' y 'hosts' son las dimensiones de la red procesada.
+// POST: se imprimieron los tiempos por etapa, las dimensiones de la red,
+// el pico de memoria residente del proceso, los pedidos y liberaciones
+// de memoria por subsistema y los contadores adicionales registrados.
+void estadisticas_informar(FILE *fp, estadisticas_formato_t formato,
+	size_t vertices, size_t aristas, size_t hosts) {
+	int i;
+
+	if(formato == ESTADISTICAS_JSON) {
+		fprintf(fp, "{\"etapas\":{");
+		for(i = 0; i < ETAPAS; i++)
+			fprintf(fp, "%s\"%s\":{\"pared_ms\":%.3f,\"cpu_ms\":%.3f}",
+				i ? "," : "", NOMBRES_ETAPAS[i], pared_ms[i], cpu_ms[i]);
+
+		fprintf(fp, "},\"vertices\":%zu,\"aristas\":%zu,\"hosts\":%zu,"
+			"\"rss_pico_kb\":%ld,\"memoria\":{", vertices, aristas, hosts,
+			rss_pico_kb());
+		for(i = 0; i < SUBSISTEMAS; i++)
+			fprintf(fp, "%s\"%s\":{\"malloc\":%zu,\"free\":%zu}",
+				i ? "," : "", NOMBRES_SUBSISTEMAS[i], mallocs[i], frees[i]);
+
+		fprintf(fp, "},\"contadores\":{");
+		for(i = 0; i < cantidad_contadores; i++)
+			fprintf(fp, "%s\"%s\":%zu", i ? "," : "", nombres_contadores[i],
+				valores_contadores[i]);
+
+		fprintf(fp, "}}\n");
+		return;
+	}
+
+	if(formato != ESTADISTICAS_TEXTO) return;
+
+	fprintf(fp, "%-14s %12s %12s\n", "etapa", "pared_ms", "cpu_ms");
+	for(i = 0; i < ETAPAS; i++)
+		fprintf(fp, "%-14s %12.3f %12.3f\n", NOMBRES_ETAPAS[i], pared_ms[i],
+			cpu_ms[i]);
+
+	fprintf(fp, "\nvertices: %zu\naristas: %zu\nhosts: %zu\n"
+		"rss_pico_kb: %ld\n\n", vertices, aristas, hosts, rss_pico_kb());
+
+	fprintf(fp, "%-14s %12s %12s\n", "subsistema", "malloc", "free");
+	for(i = 0; i < SUBSISTEMAS; i++)
+		fprintf(fp, "%-14s %12zu %12zu\n", NOMBRES_SUBSISTEMAS[i], mallocs[i],
+			frees[i]);
+
+	if(!cantidad_contadores) return;
+
+	fprintf(fp, "\n%-31s %12s\n", "contador", "valor");
+	for(i = 0; i < cantidad_contadores; i++)
+		fprintf(fp, "%-31s %12zu\n", nombres_contadores[i],
+			valores_contadores[i]);
+}
@@ -0,0 +1,113 @@
+/* ****************************************************************************
+ * ****************************************************************************
+ * ESTADÍSTICAS DE EJECUCIÓN
+ * ****************************************************************************
+ * ****************************************************************************
+ *
+ * Librería de funciones que registra el tiempo insumido por cada etapa del
+ * procesamiento de una red y la cantidad de pedidos y liberaciones de
+ * memoria realizados por cada subsistema.
+ */
+
+
+#ifndef ESTADISTICAS_H
+#define ESTADISTICAS_H
+
+#include <stdio.h>
+#include <stddef.h>
+
+
+
+/* ****************************************************************************
+ * DECLARACIÓN DE LOS TIPOS DE DATOS
+ * ***************************************************************************/
+
+// Etapas del procesamiento de una red
+typedef enum {
+	ETAPA_PARSEO,
+	ETAPA_CONSTRUCCION,
+	ETAPA_CAMINOS,
+	ETAPA_EXTRACCION,
+	ETAPA_SALIDA,
+	ETAPAS
+} etapa_t;
+
+// Subsistemas cuyos pedidos de memoria se contabilizan
+typedef enum {
+	SUBSISTEMA_LISTA,
+	SUBSISTEMA_COLA,
+	SUBSISTEMA_GRAFO,
+	SUBSISTEMA_DIJKSTRA,
+	SUBSISTEMA_ROUTER,
+	SUBSISTEMA_CADENAS,
+	SUBSISTEMA_PREFIJOS,
+	SUBSISTEMA_HILOS,
+	SUBSISTEMA_EPOCAS,
+	SUBSISTEMA_AREAS,
+	SUBSISTEMA_PERSISTENCIA,
+	SUBSISTEMA_FALLAS,
+	SUBSISTEMA_DESCOMPRESOR,
+	SUBSISTEMA_CACHE,
+	SUBSISTEMAS
+} subsistema_t;
+
+// Formatos en los que pueden informarse las estadísticas
+typedef enum {
+	ESTADISTICAS_NINGUNA,
+	ESTADISTICAS_TEXTO,
+	ESTADISTICAS_JSON
+} estadisticas_formato_t;
+
+
+
+/* ****************************************************************************
+ * FUNCIONES DE LA LIBRERIA
+ * ***************************************************************************/
+
+// Solicita memoria contabilizando el pedido en un subsistema.
+// PRE: 'subsistema' es el subsistema que realiza el pedido; 'tamanio' es
+// la cantidad de bytes solicitados.
+// POST: devuelve lo mismo que malloc().
+void* estadisticas_malloc(subsistema_t subsistema, size_t tamanio);
+
+// Modifica el tamaño de un bloque de memoria contabilizando el pedido en
+// un subsistema. Si 'ptr' es NULL se contabiliza como un nuevo pedido;
+// en caso contrario el bloque sigue siendo el mismo pedido.
+// PRE: 'subsistema' es el subsistema que realiza el pedido; 'ptr' es un
+// puntero obtenido con estadisticas_malloc() o NULL; 'tamanio' es la
+// nueva cantidad de bytes.
+// POST: devuelve lo mismo que realloc().
+void* estadisticas_realloc(subsistema_t subsistema, void *ptr,
+	size_t tamanio);
+
+// Libera memoria contabilizando la liberación en un subsistema.
+// PRE: 'subsistema' es el subsistema que realiza la liberación; 'ptr' es
+// un puntero obtenido con estadisticas_malloc() o NULL.
+void estadisticas_free(subsistema_t subsistema, void *ptr);
+
+// Marca el comienzo de una etapa del procesamiento.
+// PRE: 'etapa' es la etapa que comienza.
+void estadisticas_iniciar_etapa(etapa_t etapa);
+
+// Marca la finalización de una etapa del procesamiento, acumulando el
+// tiempo de reloj y de CPU transcurridos desde su comienzo.
+// PRE: 'etapa' es una etapa previamente iniciada.
+void estadisticas_finalizar_etapa(etapa_t etapa);
+
+// Registra un contador adicional para que sea informado junto con las
+// estadísticas. Si ya existía un contador con el mismo nombre, se
+// reemplaza su valor.
+// PRE: 'nombre' es una cadena que permanece válida hasta que se informan
+// las estadísticas; 'valor' es el valor del contador.
+void estadisticas_registrar_contador(const char *nombre, size_t valor);
+
+// Envía las estadísticas registradas a un stream.
+// PRE: 'fp' es el stream de salida; 'formato' es el formato deseado;
+// 'vertices', 'aristas' y 'hosts' son las dimensiones de la red procesada.
+// POST: se imprimieron los tiempos por etapa, las dimensiones de la red,
+// el pico de memoria residente del proceso, los pedidos y liberaciones
+// de memoria por subsistema y los contadores adicionales registrados.
+void estadisticas_informar(FILE *fp, estadisticas_formato_t formato,
+	size_t vertices, size_t aristas, size_t hosts);
+
+#endif
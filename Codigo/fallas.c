@@ -0,0 +1,569 @@
+/* ****************************************************************************
+ * ****************************************************************************
+ * TAD FALLAS DE CONEXIONES
+ * ..................................................................
+ *
+ * Implementación del análisis de caídas de conexiones. Al crearlo se
+ * arman las aristas que llegan a cada vértice y los hijos de cada vértice
+ * en el árbol de caminos mínimos, ambos en formato CSR, que comparten
+ * todos los hilos. Cada hilo guarda en su espacio de trabajo las
+ * distancias y previos reparados, válidos sólo para los vértices que
+ * marcó en su último análisis; los demás conservan los del árbol.
+ *
+ * ****************************************************************************
+ * ***************************************************************************/
+
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include "fallas.h"
+#include "estadisticas.h"
+
+
+
+/* ****************************************************************************
+ * CONSTANTES
+ * ***************************************************************************/
+
+// Distancia de los vértices que no son alcanzables desde el origen
+#define INFINITO UINT32_MAX
+
+
+
+/* ****************************************************************************
+ * DEFINICIÓN DE LOS TIPOS DE DATOS
+ * ***************************************************************************/
+
+// Tipo que representa un vértice encolado junto con su distancia.
+typedef struct {
+	uint32_t distancia;					// Distancia al encolarlo
+	uint32_t vertice;					// Vértice
+} fallas_elemento_t;
+
+// Tipo que representa un montículo de vértices por distancia. Un vértice
+// se encola cada vez que mejora su distancia, y al desencolarlo se
+// descartan los elementos con una distancia que ya no es la vigente.
+typedef struct {
+	fallas_elemento_t *elementos;		// Elementos del montículo
+	size_t cantidad;					// Cantidad de elementos
+	size_t capacidad;					// Capacidad del arreglo
+} fallas_monticulo_t;
+
+// Tipo que representa el espacio de trabajo de un hilo.
+typedef struct {
+	uint32_t *distancias;				// Distancias sin la conexión caída
+	uint32_t *previos;					// Previos sin la conexión caída
+	uint32_t *marca;					// Número del último análisis que
+										// marcó a cada vértice
+	uint32_t numero;					// Número del último análisis
+	bool completo;						// Indica si el último análisis
+										// recalculó todos los vértices
+	uint32_t *afectados;				// Vértices cuyo camino cambió
+	uint32_t *pila;						// Vértices pendientes de clasificar
+	fallas_monticulo_t m;				// Montículo de los recorridos
+} fallas_espacio_t;
+
+// Tipo que representa el análisis de caídas.
+struct _fallas_t {
+	grafo_compacto_t *grafo;			// Grafo analizado
+	uint32_t n;							// Cantidad de vértices
+	const uint32_t *inicio;				// Arreglos del grafo compacto
+	const uint32_t *destinos;
+	const uint16_t *pesos16;
+	const uint32_t *pesos32;
+	const uint32_t *distancias;			// Árbol de caminos mínimos
+	const uint32_t *previos;
+	uint32_t origen;					// Vértice origen
+	int (*criterio)(lista_dato_t, lista_dato_t);	// Criterio de selección
+	bool pesos_nulos;					// Indica si hay aristas de peso 0
+	uint32_t *origenes;					// Vértice del que parte cada arista
+	uint32_t *inicio_entrantes;			// Aristas que llegan a cada
+	uint32_t *entrantes;				// vértice, en formato CSR
+	uint32_t *inicio_hijos;				// Hijos de cada vértice en el
+	uint32_t *hijos;					// árbol, en formato CSR
+	size_t hilos;						// Cantidad de espacios de trabajo
+	fallas_espacio_t *espacios;			// Espacio de trabajo de cada hilo
+};
+
+
+
+/* ****************************************************************************
+ * FUNCIONES AUXILIARES
+ * ***************************************************************************/
+
+// Devuelve el peso de una arista.
+// PRE: 'fallas' es un análisis existente; 'e' es una arista del grafo.
+static inline uint32_t fallas_peso(const fallas_t *fallas, uint32_t e) {
+	return fallas->pesos16 ? fallas->pesos16[e] : fallas->pesos32[e];
+}
+
+// Indica si un vértice precede a otro en el orden en que los marcaría
+// Dijkstra.
+// PRE: 'fallas' es un análisis existente; 'u' es un vértice alcanzable a
+// distancia 'du'; 'p' es un vértice a distancia 'dp', o
+// GRAFO_COMPACTO_SIN_VERTICE.
+// POST: devuelve true si 'p' no es un vértice o si 'u' tiene menor
+// distancia, o igual distancia y lo elige el criterio (o, si este no
+// decide, tiene menor índice).
+static bool fallas_precede(const fallas_t *fallas, uint32_t du, uint32_t u,
+	uint32_t dp, uint32_t p) {
+	if(p == GRAFO_COMPACTO_SIN_VERTICE) return true;
+	if(du != dp) return du < dp;
+
+	int c = fallas->criterio(grafo_compacto_obtener_dato(fallas->grafo, u),
+		grafo_compacto_obtener_dato(fallas->grafo, p));
+	return c ? c < 0 : u < p;
+}
+
+// Encola un vértice en un montículo.
+// PRE: 'fallas' es un análisis existente; 'm' es un montículo;
+// 'distancia' es la distancia del vértice 'v'.
+// POST: devuelve false si no hubo memoria suficiente o true en caso
+// contrario.
+static bool fallas_encolar(const fallas_t *fallas, fallas_monticulo_t *m,
+	uint32_t distancia, uint32_t v) {
+	size_t i, padre;
+
+	if(m->cantidad == m->capacidad) {
+		size_t capacidad = m->capacidad ? 2 * m->capacidad : 64;
+		fallas_elemento_t *elementos = (fallas_elemento_t*)
+			estadisticas_realloc(SUBSISTEMA_FALLAS, m->elementos,
+			capacidad * sizeof(fallas_elemento_t));
+		if(!elementos) return false;
+
+		m->elementos = elementos;
+		m->capacidad = capacidad;
+	}
+
+	// Subimos el elemento mientras lo preceda su padre
+	for(i = m->cantidad++; i; i = padre) {
+		padre = (i - 1) / 2;
+		if(!fallas_precede(fallas, distancia, v, m->elementos[padre].distancia,
+			m->elementos[padre].vertice))
+			break;
+		m->elementos[i] = m->elementos[padre];
+	}
+
+	m->elementos[i].distancia = distancia;
+	m->elementos[i].vertice = v;
+	return true;
+}
+
+// Desencola el primer elemento de un montículo.
+// PRE: 'fallas' es un análisis existente; 'm' es un montículo no vacío.
+// POST: devuelve el elemento de menor distancia (desempatando como
+// Dijkstra), que se quitó del montículo.
+static fallas_elemento_t fallas_desencolar(const fallas_t *fallas,
+	fallas_monticulo_t *m) {
+	fallas_elemento_t minimo = m->elementos[0];
+	fallas_elemento_t ultimo = m->elementos[--m->cantidad];
+	fallas_elemento_t *hijo;
+	size_t i = 0, h;
+
+	// Bajamos el último elemento mientras lo preceda algún hijo
+	while((h = 2 * i + 1) < m->cantidad) {
+		if(h + 1 < m->cantidad && fallas_precede(fallas,
+			m->elementos[h + 1].distancia, m->elementos[h + 1].vertice,
+			m->elementos[h].distancia, m->elementos[h].vertice))
+			h++;
+
+		hijo = &m->elementos[h];
+		if(!fallas_precede(fallas, hijo->distancia, hijo->vertice,
+			ultimo.distancia, ultimo.vertice))
+			break;
+
+		m->elementos[i] = *hijo;
+		i = h;
+	}
+
+	if(m->cantidad) m->elementos[i] = ultimo;
+	return minimo;
+}
+
+// Devuelve la distancia a un vértice sin la última conexión analizada
+// por un hilo.
+// PRE: 'fallas' es un análisis existente; 'es' es el espacio del hilo;
+// 'v' es un vértice.
+static inline uint32_t fallas_distancia_actual(const fallas_t *fallas,
+	const fallas_espacio_t *es, uint32_t v) {
+	return es->completo || es->marca[v] == es->numero ? es->distancias[v] :
+		fallas->distancias[v];
+}
+
+// Repara los caminos hacia el subárbol que cuelga de una conexión del
+// árbol de caminos mínimos.
+// PRE: 'fallas' es un análisis sin aristas de peso nulo; 'es' es el
+// espacio de un hilo, con un número de análisis nuevo; 'arista' es la
+// conexión que lleva al vértice 'v' en el árbol.
+// POST: devuelve la cantidad de vértices del subárbol, que quedaron
+// marcados y cargados en los afectados con su distancia y previo sin la
+// conexión, o UINT32_MAX si no hubo memoria suficiente.
+static uint32_t fallas_reparar(const fallas_t *fallas, fallas_espacio_t *es,
+	uint32_t arista, uint32_t v) {
+	uint32_t i, cantidad = 1, x, y, e, f, p;
+	uint64_t distancia;
+	fallas_elemento_t elemento;
+
+	// Obtenemos el subárbol recorriendo en anchura los hijos del árbol
+	es->afectados[0] = v;
+	es->marca[v] = es->numero;
+
+	for(i = 0; i < cantidad; i++) {
+		x = es->afectados[i];
+
+		for(f = fallas->inicio_hijos[x]; f < fallas->inicio_hijos[x + 1]; f++) {
+			es->marca[fallas->hijos[f]] = es->numero;
+			es->afectados[cantidad++] = fallas->hijos[f];
+		}
+	}
+
+	// Cada vértice del subárbol parte de la mejor arista que le llega
+	// desde fuera de él, cuyo origen conserva su distancia
+	es->m.cantidad = 0;
+
+	for(i = 0; i < cantidad; i++) {
+		x = es->afectados[i];
+		es->distancias[x] = INFINITO;
+
+		for(f = fallas->inicio_entrantes[x];
+			f < fallas->inicio_entrantes[x + 1]; f++) {
+			e = fallas->entrantes[f];
+			y = fallas->origenes[e];
+			if(e == arista || es->marca[y] == es->numero ||
+				fallas->distancias[y] == INFINITO)
+				continue;
+
+			distancia = (uint64_t) fallas->distancias[y] +
+				fallas_peso(fallas, e);
+			if(distancia < es->distancias[x]) es->distancias[x] = distancia;
+		}
+
+		if(es->distancias[x] != INFINITO &&
+			!fallas_encolar(fallas, &es->m, es->distancias[x], x))
+			return UINT32_MAX;
+	}
+
+	// Recorremos el subárbol sin salir de él
+	while(es->m.cantidad) {
+		elemento = fallas_desencolar(fallas, &es->m);
+		x = elemento.vertice;
+		if(elemento.distancia != es->distancias[x]) continue;
+
+		for(e = fallas->inicio[x]; e < fallas->inicio[x + 1]; e++) {
+			y = fallas->destinos[e];
+			if(es->marca[y] != es->numero) continue;
+
+			distancia = (uint64_t) es->distancias[x] + fallas_peso(fallas, e);
+			if(distancia >= es->distancias[y]) continue;
+
+			es->distancias[y] = distancia;
+			if(!fallas_encolar(fallas, &es->m, es->distancias[y], y))
+				return UINT32_MAX;
+		}
+	}
+
+	// Elegimos el previo de cada vértice con las distancias definitivas
+	for(i = 0; i < cantidad; i++) {
+		x = es->afectados[i];
+		p = GRAFO_COMPACTO_SIN_VERTICE;
+
+		for(f = fallas->inicio_entrantes[x];
+			es->distancias[x] != INFINITO &&
+			f < fallas->inicio_entrantes[x + 1]; f++) {
+			e = fallas->entrantes[f];
+			y = fallas->origenes[e];
+			uint32_t dy = fallas_distancia_actual(fallas, es, y);
+
+			if(e != arista && dy != INFINITO &&
+				(uint64_t) dy + fallas_peso(fallas, e) == es->distancias[x] &&
+				fallas_precede(fallas, dy, y, p == GRAFO_COMPACTO_SIN_VERTICE ?
+				0 : fallas_distancia_actual(fallas, es, p), p))
+				p = y;
+		}
+
+		es->previos[x] = p;
+	}
+
+	return cantidad;
+}
+
+// Recalcula los caminos hacia todos los vértices sin una conexión, como
+// lo haría Dijkstra.
+// PRE: 'fallas' es un análisis existente; 'es' es el espacio de un hilo,
+// con un número de análisis nuevo; 'arista' es la conexión caída.
+// POST: devuelve la cantidad de vértices cuyo camino cambió, cargados en
+// los afectados, o UINT32_MAX si no hubo memoria suficiente.
+static uint32_t fallas_recalcular(const fallas_t *fallas,
+	fallas_espacio_t *es, uint32_t arista) {
+	uint32_t v, w, e, cantidad = 0, pendientes;
+	uint64_t distancia;
+	fallas_elemento_t elemento;
+	bool cambio;
+
+	for(v = 0; v < fallas->n; v++) {
+		es->distancias[v] = INFINITO;
+		es->previos[v] = GRAFO_COMPACTO_SIN_VERTICE;
+	}
+
+	es->completo = true;
+	es->distancias[fallas->origen] = 0;
+	es->m.cantidad = 0;
+	if(!fallas_encolar(fallas, &es->m, 0, fallas->origen)) return UINT32_MAX;
+
+	while(es->m.cantidad) {
+		elemento = fallas_desencolar(fallas, &es->m);
+		v = elemento.vertice;
+		if(elemento.distancia != es->distancias[v]) continue;
+
+		for(e = fallas->inicio[v]; e < fallas->inicio[v + 1]; e++) {
+			if(e == arista) continue;
+
+			w = fallas->destinos[e];
+			distancia = (uint64_t) es->distancias[v] + fallas_peso(fallas, e);
+			if(distancia >= es->distancias[w]) continue;
+
+			es->distancias[w] = distancia;
+			es->previos[w] = v;
+			if(!fallas_encolar(fallas, &es->m, es->distancias[w], w))
+				return UINT32_MAX;
+		}
+	}
+
+	// El camino hacia un vértice cambia si cambia su previo o el camino
+	// hacia este. Clasificamos cada vértice subiendo por sus previos hasta
+	// uno ya clasificado (marcado con el número del análisis si su camino
+	// no cambió, o con el siguiente si cambió)
+	for(v = 0; v < fallas->n; v++) {
+		pendientes = 0;
+		w = v;
+
+		while(es->marca[w] != es->numero && es->marca[w] != es->numero + 1) {
+			es->pila[pendientes++] = w;
+			if(es->previos[w] != fallas->previos[w]) break;
+			if(es->previos[w] == GRAFO_COMPACTO_SIN_VERTICE) break;
+			w = es->previos[w];
+		}
+
+		cambio = pendientes && es->marca[w] != es->numero &&
+			es->marca[w] != es->numero + 1 ?
+			es->previos[w] != fallas->previos[w] :
+			es->marca[w] == es->numero + 1;
+
+		while(pendientes)
+			es->marca[es->pila[--pendientes]] = es->numero + cambio;
+	}
+
+	for(v = 0; v < fallas->n; v++)
+		if(es->marca[v] == es->numero + 1) es->afectados[cantidad++] = v;
+
+	return cantidad;
+}
+
+
+
+/* ****************************************************************************
+ * PRIMITIVAS DE LAS FALLAS
+ * ***************************************************************************/
+
+// Prepara el análisis de las caídas de las conexiones de un grafo.
+// PRE: 'resultados' son los caminos mínimos desde el vértice de dato
+// 'origen' sobre 'grafo', válidos para todos los vértices y obtenidos con
+// el criterio 'criterio_seleccion()', que puede invocarse desde varios
+// hilos a la vez; 'hilos' es la cantidad de hilos que analizan caídas a
+// la vez (si es 0 se usa 1).
+// POST: devuelve el análisis, o NULL si 'origen' no es un vértice del
+// grafo o no hubo memoria suficiente. El grafo y los resultados deben
+// existir mientras se utilice el análisis.
+fallas_t* fallas_crear(grafo_compacto_t *grafo,
+	dijkstra_resultados_t *resultados, lista_dato_t origen,
+	int criterio_seleccion(lista_dato_t, lista_dato_t), size_t hilos) {
+	uint32_t n = grafo_compacto_cantidad_vertices(grafo);
+	uint32_t m = grafo_compacto_cantidad_aristas(grafo);
+	uint32_t v, e;
+	size_t h;
+	bool ok;
+
+	uint32_t o = grafo_compacto_buscar_vertice(grafo, origen);
+	if(o == GRAFO_COMPACTO_SIN_VERTICE) return NULL;
+
+	fallas_t *fallas = (fallas_t*) estadisticas_malloc(SUBSISTEMA_FALLAS,
+		sizeof(fallas_t));
+	if(!fallas) return NULL;
+
+	if(!hilos) hilos = 1;
+	fallas->grafo = grafo;
+	fallas->n = n;
+	fallas->origen = o;
+	fallas->criterio = criterio_seleccion;
+	fallas->hilos = hilos;
+	grafo_compacto_obtener_arreglos(grafo, &fallas->inicio, &fallas->destinos,
+		&fallas->pesos16, &fallas->pesos32);
+	dijkstra_obtener_arreglos(resultados, &fallas->distancias,
+		&fallas->previos);
+
+	fallas->origenes = (uint32_t*) estadisticas_malloc(SUBSISTEMA_FALLAS,
+		(m + 1) * sizeof(uint32_t));
+	fallas->inicio_entrantes = (uint32_t*) estadisticas_malloc(
+		SUBSISTEMA_FALLAS, (n + 2) * sizeof(uint32_t));
+	fallas->entrantes = (uint32_t*) estadisticas_malloc(SUBSISTEMA_FALLAS,
+		(m + 1) * sizeof(uint32_t));
+	fallas->inicio_hijos = (uint32_t*) estadisticas_malloc(SUBSISTEMA_FALLAS,
+		(n + 2) * sizeof(uint32_t));
+	fallas->hijos = (uint32_t*) estadisticas_malloc(SUBSISTEMA_FALLAS,
+		(n + 1) * sizeof(uint32_t));
+	fallas->espacios = (fallas_espacio_t*) estadisticas_malloc(
+		SUBSISTEMA_FALLAS, hilos * sizeof(fallas_espacio_t));
+
+	ok = fallas->origenes && fallas->inicio_entrantes && fallas->entrantes &&
+		fallas->inicio_hijos && fallas->hijos && fallas->espacios;
+
+	for(h = 0; fallas->espacios && h < hilos; h++) {
+		fallas_espacio_t *es = &fallas->espacios[h];
+
+		es->distancias = (uint32_t*) estadisticas_malloc(SUBSISTEMA_FALLAS,
+			(n + 1) * sizeof(uint32_t));
+		es->previos = (uint32_t*) estadisticas_malloc(SUBSISTEMA_FALLAS,
+			(n + 1) * sizeof(uint32_t));
+		es->marca = (uint32_t*) estadisticas_malloc(SUBSISTEMA_FALLAS,
+			(n + 1) * sizeof(uint32_t));
+		es->afectados = (uint32_t*) estadisticas_malloc(SUBSISTEMA_FALLAS,
+			(n + 1) * sizeof(uint32_t));
+		es->pila = (uint32_t*) estadisticas_malloc(SUBSISTEMA_FALLAS,
+			(n + 1) * sizeof(uint32_t));
+		es->numero = 0;
+		es->completo = false;
+		es->m.elementos = NULL;
+		es->m.cantidad = es->m.capacidad = 0;
+
+		ok = ok && es->distancias && es->previos && es->marca &&
+			es->afectados && es->pila;
+		if(es->marca) memset(es->marca, 0, (n + 1) * sizeof(uint32_t));
+	}
+
+	if(!ok) {
+		if(!fallas->espacios) fallas->hilos = 0;
+		fallas_destruir(fallas);
+		return NULL;
+	}
+
+	// Origen de cada arista, aristas que llegan a cada vértice y peso nulo
+	fallas->pesos_nulos = false;
+	memset(fallas->inicio_entrantes, 0, (n + 2) * sizeof(uint32_t));
+
+	for(v = 0; v < n; v++)
+		for(e = fallas->inicio[v]; e < fallas->inicio[v + 1]; e++) {
+			fallas->origenes[e] = v;
+			fallas->inicio_entrantes[fallas->destinos[e] + 2]++;
+			if(!fallas_peso(fallas, e)) fallas->pesos_nulos = true;
+		}
+
+	for(v = 0; v < n; v++)
+		fallas->inicio_entrantes[v + 2] += fallas->inicio_entrantes[v + 1];
+
+	for(e = 0; e < m; e++)
+		fallas->entrantes[fallas->inicio_entrantes[fallas->destinos[e] + 1]++]
+			= e;
+
+	// Hijos de cada vértice en el árbol
+	memset(fallas->inicio_hijos, 0, (n + 2) * sizeof(uint32_t));
+
+	for(v = 0; v < n; v++)
+		if(fallas->previos[v] != GRAFO_COMPACTO_SIN_VERTICE)
+			fallas->inicio_hijos[fallas->previos[v] + 2]++;
+
+	for(v = 0; v < n; v++)
+		fallas->inicio_hijos[v + 2] += fallas->inicio_hijos[v + 1];
+
+	for(v = 0; v < n; v++)
+		if(fallas->previos[v] != GRAFO_COMPACTO_SIN_VERTICE)
+			fallas->hijos[fallas->inicio_hijos[fallas->previos[v] + 1]++] = v;
+
+	return fallas;
+}
+
+// Destruye un análisis de caídas.
+// PRE: 'fallas' es un análisis existente.
+// POST: se liberó la memoria ocupada por el análisis, mas no así la del
+// grafo ni la de los resultados.
+void fallas_destruir(fallas_t *fallas) {
+	size_t h;
+
+	for(h = 0; h < fallas->hilos; h++) {
+		fallas_espacio_t *es = &fallas->espacios[h];
+
+		estadisticas_free(SUBSISTEMA_FALLAS, es->distancias);
+		estadisticas_free(SUBSISTEMA_FALLAS, es->previos);
+		estadisticas_free(SUBSISTEMA_FALLAS, es->marca);
+		estadisticas_free(SUBSISTEMA_FALLAS, es->afectados);
+		estadisticas_free(SUBSISTEMA_FALLAS, es->pila);
+		estadisticas_free(SUBSISTEMA_FALLAS, es->m.elementos);
+	}
+
+	estadisticas_free(SUBSISTEMA_FALLAS, fallas->origenes);
+	estadisticas_free(SUBSISTEMA_FALLAS, fallas->inicio_entrantes);
+	estadisticas_free(SUBSISTEMA_FALLAS, fallas->entrantes);
+	estadisticas_free(SUBSISTEMA_FALLAS, fallas->inicio_hijos);
+	estadisticas_free(SUBSISTEMA_FALLAS, fallas->hijos);
+	estadisticas_free(SUBSISTEMA_FALLAS, fallas->espacios);
+	estadisticas_free(SUBSISTEMA_FALLAS, fallas);
+}
+
+// Analiza la caída de una conexión.
+// PRE: 'fallas' es un análisis existente; 'hilo' es un número de hilo,
+// menor a la cantidad de hilos del análisis, que ningún otro hilo utiliza
+// a la vez; 'arista' es la posición de la conexión en los arreglos del
+// grafo compacto (ver grafo_compacto_obtener_arreglos()).
+// POST: devuelve la cantidad de vértices cuyo camino desde el origen
+// cambia al quitar la conexión, y carga en 'afectados' un arreglo con
+// ellos, o devuelve UINT32_MAX si no hubo memoria suficiente. Los nuevos
+// caminos se obtienen con fallas_previo(). El arreglo es válido hasta el
+// próximo análisis del mismo hilo. Si el grafo tiene aristas de peso
+// nulo, el orden en que se eligen los previos depende del orden de
+// marcado de Dijkstra, por lo que se recalculan los caminos hacia todos
+// los vértices.
+uint32_t fallas_analizar(fallas_t *fallas, size_t hilo, uint32_t arista,
+	const uint32_t **afectados) {
+	fallas_espacio_t *es = &fallas->espacios[hilo];
+	uint32_t v = fallas->destinos[arista];
+
+	// Cada análisis usa dos números nuevos para marcar vértices, por lo
+	// que al agotarlos se borran las marcas
+	if(es->numero >= UINT32_MAX - 3) {
+		memset(es->marca, 0, (fallas->n + 1) * sizeof(uint32_t));
+		es->numero = 0;
+	}
+
+	es->numero += 2;
+	es->completo = false;
+	*afectados = es->afectados;
+
+	// Si la conexión no es parte del árbol, ningún camino la utiliza
+	if(fallas->previos[v] != fallas->origenes[arista]) return 0;
+
+	if(fallas->pesos_nulos) return fallas_recalcular(fallas, es, arista);
+	return fallas_reparar(fallas, es, arista, v);
+}
+
+// Devuelve el previo de un vértice en los caminos mínimos sin la última
+// conexión analizada por un hilo.
+// PRE: 'fallas' es un análisis existente; 'hilo' es un número de hilo que
+// ya analizó alguna caída; 'v' es un vértice.
+// POST: devuelve el vértice previo a 'v', o GRAFO_COMPACTO_SIN_VERTICE si
+// 'v' es el origen o deja de ser alcanzable.
+uint32_t fallas_previo(const fallas_t *fallas, size_t hilo, uint32_t v) {
+	const fallas_espacio_t *es = &fallas->espacios[hilo];
+
+	return es->completo || es->marca[v] == es->numero ? es->previos[v] :
+		fallas->previos[v];
+}
+
+// Devuelve la distancia a un vértice en los caminos mínimos sin la última
+// conexión analizada por un hilo.
+// PRE: 'fallas' es un análisis existente; 'hilo' es un número de hilo que
+// ya analizó alguna caída; 'v' es un vértice.
+// POST: devuelve la distancia desde el origen, o UINT32_MAX si 'v' no es
+// alcanzable.
+uint32_t fallas_distancia(const fallas_t *fallas, size_t hilo, uint32_t v) {
+	return fallas_distancia_actual(fallas, &fallas->espacios[hilo], v);
+}
@@ -0,0 +1,98 @@
+/* ****************************************************************************
+ * ****************************************************************************
+ * TAD FALLAS DE CONEXIONES
+ * ..................................................................
+ *
+ * Análisis del efecto de la caída de cada conexión sobre un árbol de
+ * caminos mínimos, sin volver a calcular el árbol completo por cada una.
+ *
+ * Si la conexión caída no es la que lleva a su destino en el árbol,
+ * ningún camino cambia. Si lo es, sólo cambian los caminos hacia los
+ * vértices del subárbol que cuelga de ella: el resto conserva su
+ * distancia y su previo. Las distancias del subárbol se reparan con un
+ * recorrido de Dijkstra restringido a él, que parte de las aristas que
+ * llegan desde fuera del subárbol, y luego se elige el previo de cada
+ * vértice como lo haría Dijkstra (entre los vecinos que lo alcanzan por
+ * camino mínimo, el de menor distancia y, ante igual distancia, el
+ * elegido por el criterio de selección).
+ *
+ * Cada hilo que analiza caídas tiene su propio espacio de trabajo, por
+ * lo que las conexiones pueden repartirse entre varios hilos.
+ *
+ * ****************************************************************************
+ * ***************************************************************************/
+
+
+#ifndef FALLAS_H
+#define FALLAS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "dijkstra.h"
+
+
+
+/* ****************************************************************************
+ * DECLARACIÓN DE LOS TIPOS DE DATOS
+ * ***************************************************************************/
+
+typedef struct _fallas_t fallas_t;
+
+
+
+/* ****************************************************************************
+ * PRIMITIVAS DE LAS FALLAS
+ * ***************************************************************************/
+
+// Prepara el análisis de las caídas de las conexiones de un grafo.
+// PRE: 'resultados' son los caminos mínimos desde el vértice de dato
+// 'origen' sobre 'grafo', válidos para todos los vértices y obtenidos con
+// el criterio 'criterio_seleccion()', que puede invocarse desde varios
+// hilos a la vez; 'hilos' es la cantidad de hilos que analizan caídas a
+// la vez (si es 0 se usa 1).
+// POST: devuelve el análisis, o NULL si 'origen' no es un vértice del
+// grafo o no hubo memoria suficiente. El grafo y los resultados deben
+// existir mientras se utilice el análisis.
+fallas_t* fallas_crear(grafo_compacto_t *grafo,
+	dijkstra_resultados_t *resultados, lista_dato_t origen,
+	int criterio_seleccion(lista_dato_t, lista_dato_t), size_t hilos);
+
+// Destruye un análisis de caídas.
+// PRE: 'fallas' es un análisis existente.
+// POST: se liberó la memoria ocupada por el análisis, mas no así la del
+// grafo ni la de los resultados.
+void fallas_destruir(fallas_t *fallas);
+
+// Analiza la caída de una conexión.
+// PRE: 'fallas' es un análisis existente; 'hilo' es un número de hilo,
+// menor a la cantidad de hilos del análisis, que ningún otro hilo utiliza
+// a la vez; 'arista' es la posición de la conexión en los arreglos del
+// grafo compacto (ver grafo_compacto_obtener_arreglos()).
+// POST: devuelve la cantidad de vértices cuyo camino desde el origen
+// cambia al quitar la conexión, y carga en 'afectados' un arreglo con
+// ellos, o devuelve UINT32_MAX si no hubo memoria suficiente. Los nuevos
+// caminos se obtienen con fallas_previo(). El arreglo es válido hasta el
+// próximo análisis del mismo hilo. Si el grafo tiene aristas de peso
+// nulo, el orden en que se eligen los previos depende del orden de
+// marcado de Dijkstra, por lo que se recalculan los caminos hacia todos
+// los vértices.
+uint32_t fallas_analizar(fallas_t *fallas, size_t hilo, uint32_t arista,
+	const uint32_t **afectados);
+
+// Devuelve el previo de un vértice en los caminos mínimos sin la última
+// conexión analizada por un hilo.
+// PRE: 'fallas' es un análisis existente; 'hilo' es un número de hilo que
+// ya analizó alguna caída; 'v' es un vértice.
+// POST: devuelve el vértice previo a 'v', o GRAFO_COMPACTO_SIN_VERTICE si
+// 'v' es el origen o deja de ser alcanzable.
+uint32_t fallas_previo(const fallas_t *fallas, size_t hilo, uint32_t v);
+
+// Devuelve la distancia a un vértice en los caminos mínimos sin la última
+// conexión analizada por un hilo.
+// PRE: 'fallas' es un análisis existente; 'hilo' es un número de hilo que
+// ya analizó alguna caída; 'v' es un vértice.
+// POST: devuelve la distancia desde el origen, o UINT32_MAX si 'v' no es
+// alcanzable.
+uint32_t fallas_distancia(const fallas_t *fallas, size_t hilo, uint32_t v);
+
+#endif
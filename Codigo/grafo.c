@@ -7,6 +7,39 @@
  * las operaciones básicas de estos. Con múltiple nos referimos a que 
  * puede ser utilizado como grafo ponderado o como grafo no ponderado.
  *
+ * Cada vértice mantiene tanto la lista de las aristas que parten de él
+ * como la de las que llegan a él, y cada arista se enlaza en ambas, por
+ * lo que eliminar una arista o un vértice sólo recorre las aristas de los
+ * vértices involucrados. Los vértices se ubican a partir de su dato
+ * mediante una tabla de hash.
+ *
+ * Cada grafo mantiene una versión que identifica a sus vértices y sus
+ * aristas (con sus pesos): la suma de una huella de 64 bits de cada uno,
+ * que se actualiza en O(1) con cada modificación. Así toda modificación
+ * cambia la versión, y deshacerla devuelve al grafo a la versión
+ * anterior, sin importar el orden en que se crearon las aristas.
+ *
+ * Mientras un vértice tiene pocas aristas salientes, la arista hacia un
+ * vértice dado se busca recorriendo su lista. Cuando su grado de salida
+ * alcanza UMBRAL_TABLA, sus aristas se indexan además por vértice destino
+ * en una tabla de direccionamiento abierto (sondeo lineal), con lo que
+ * crear, buscar y eliminar una arista de un vértice de grado alto cuesta
+ * O(1) en promedio. La tabla se descarta si el grado vuelve a bajar a la
+ * mitad del umbral.
+ *
+ * Un grafo creado con grafo_crear_masivo() ubica todos sus vértices en un
+ * único bloque de memoria y todas sus aristas en otro, con las de cada
+ * vértice contiguas. Las aristas del bloque que se eliminan se reutilizan
+ * al crear aristas nuevas, y los bloques se liberan al destruir el grafo.
+ * La creación masiva ordena las aristas por vértice de partida (para
+ * elegir las que prevalecen y armar las listas de salida) y luego por
+ * vértice destino (para armar las listas de entrada) con un ordenamiento
+ * por conteo estable repartido entre varios hilos: cada hilo cuenta las
+ * aristas de su porción, se calcula para cada vértice la posición de las
+ * aristas de cada hilo y cada hilo ubica las suyas. Luego cada hilo arma
+ * las listas de un rango de vértices. Como cada paso respeta el orden de
+ * creación, el grafo es el mismo con cualquier cantidad de hilos.
+ *
  * ****************************************************************************
  * ***************************************************************************/
 
@@ -14,26 +47,32 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include "grafo.h"
+#include "hilos.h"
+#include "estadisticas.h"
 
 
 
 /* ****************************************************************************
- * DECLARACIÓN DE LOS TIPOS DE DATOS
+ * CONSTANTES
  * ***************************************************************************/
 
-typedef struct _arista_t arista_t;
-typedef struct _vertice_t vertice_t;
+// Cantidad inicial de baldes de la tabla de vértices
+#define BALDES_INICIALES 16
+
+// Grado de salida a partir del cual se indexan las aristas de un vértice
+#define UMBRAL_TABLA 16
+
+// Mínima cantidad de aristas por hilo al crear un grafo en forma masiva
+#define MIN_ARISTAS_POR_HILO 65536
 
 
 
 /* ****************************************************************************
- * INCLUSIÓN DE LIBRERIAS Y TADS EXTERNOS
+ * DECLARACIÓN DE LOS TIPOS DE DATOS
  * ***************************************************************************/
 
-// TAD Lista
-#define LISTA_DATO_T
-typedef arista_t* lista_dato_t;
-#include "lista.h"
+typedef struct _arista_t arista_t;
+typedef struct _vertice_t vertice_t;
 
 
 
@@ -45,20 +84,52 @@ typedef arista_t* lista_dato_t;
 struct _grafo_t {
 	vertice_t* primerVertice;			// Puntero al primer vértice del grafo
 	vertice_t* ultimoVertice;			// Puntero al último vértice del grafo
+	vertice_t** baldes;					// Tabla de hash de los vértices,
+										// según su dato
+	size_t cantidadBaldes;				// Cantidad de baldes (potencia de 2)
 	int cantidadVertices;				// Cantidad de vértices del grafo
+	int cantidadAristas;				// Cantidad de aristas del grafo
+	vertice_t* bloqueVertices;			// Vértices y aristas creados por
+	size_t verticesEnBloque;			// grafo_crear_masivo(), o NULL
+	arista_t* bloqueAristas;
+	size_t aristasEnBloque;
+	arista_t* aristasLibres;			// Aristas del bloque eliminadas,
+										// enlazadas por 'salidaSiguiente'
+	uint64_t version;					// Suma de las huellas de los
+										// vértices y las aristas
 };
 
-// Tipo que representa una arista.
+// Tipo que representa una arista. Cada arista pertenece a la vez a la
+// lista de salida de su vértice de partida y a la lista de entrada de su
+// vértice destino.
 struct _arista_t {
+	vertice_t* verticePartida;			// Puntero al vértice de partida
 	vertice_t* verticeAdyacente;		// Puntero al vértice adyacente
 	int peso;							// Peso de la arista
+	arista_t* salidaAnterior;			// Aristas vecinas en la lista de
+	arista_t* salidaSiguiente;			// salida del vértice de partida
+	arista_t* entradaAnterior;			// Aristas vecinas en la lista de
+	arista_t* entradaSiguiente;			// entrada del vértice adyacente
 };
 
 // Tipo que representa a un vértice del grafo.
 struct _vertice_t {
 	grafo_dato_t dato;					// Dato asociado al vértice
-	lista_t* listaDeAdyacencia;			// Lista de adyacencia del vértice
+	arista_t* primeraSalida;			// Lista de adyacencia del vértice,
+	arista_t* ultimaSalida;				// en orden de creación
+	arista_t* primeraEntrada;			// Lista de aristas que llegan al
+	arista_t* ultimaEntrada;			// vértice, en orden de creación
+	int gradoSalida;					// Largo de la lista de adyacencia
+	int gradoEntrada;					// Largo de la lista de entrada
+	arista_t** tablaSalida;				// Aristas de la lista de adyacencia
+										// según su destino, o NULL
+	size_t capacidadTabla;				// Posiciones de la tabla (potencia
+										// de 2, ocupada hasta la mitad)
+	vertice_t* verticeAnterior;			// Puntero al vértice anterior
 	vertice_t* verticeSiguiente;		// Puntero al vértice siguiente
+	vertice_t* siguienteBalde;			// Siguiente vértice del balde
+	int indice;							// Posición del vértice, válida sólo
+										// durante grafo_obtener_aristas()
 };
 
 
@@ -67,57 +138,313 @@ struct _vertice_t {
  * FUNCIONES AUXILIARES
  * ***************************************************************************/
 
+// Mezcla los bits de un número, como la función final de splitmix64.
+static uint64_t grafo_mezclar(uint64_t x) {
+	x ^= x >> 30;
+	x *= 0xBF58476D1CE4E5B9ull;
+	x ^= x >> 27;
+	x *= 0x94D049BB133111EBull;
+	return x ^ (x >> 31);
+}
+
+// Calcula la huella con la que un vértice aporta a la versión del grafo.
+// PRE: 'vertice' es un vértice existente.
+static uint64_t grafo_huella_vertice(const vertice_t *vertice) {
+	return grafo_mezclar((uint64_t) (uintptr_t) vertice->dato);
+}
+
+// Calcula la huella con la que una arista aporta a la versión del grafo,
+// según sus extremos y su peso.
+// PRE: 'arista' es una arista con sus vértices y su peso asignados.
+static uint64_t grafo_huella_arista(const arista_t *arista) {
+	uint64_t x = grafo_mezclar((uint64_t) (uintptr_t)
+		arista->verticePartida->dato + 0x9E3779B97F4A7C15ull);
+
+	x = grafo_mezclar(x ^ (uint64_t) (uintptr_t)
+		arista->verticeAdyacente->dato);
+	return grafo_mezclar(x + (uint32_t) arista->peso);
+}
+
+// Calcula el balde de la tabla de vértices que corresponde a un dato.
+// PRE: 'grafo' es un grafo existente.
+static size_t grafo_balde(const grafo_t *grafo, const grafo_dato_t dato) {
+	uint64_t x = (uint64_t) (uintptr_t) dato;
+
+	x ^= x >> 33;
+	x *= 0xFF51AFD7ED558CCDull;
+	x ^= x >> 33;
+	return x & (grafo->cantidadBaldes - 1);
+}
+
+// Duplica la cantidad de baldes de la tabla de vértices.
+// PRE: 'grafo' es un grafo existente.
+// POST: se redistribuyeron los vértices en la tabla nueva. Si no hubo
+// memoria suficiente, se conserva la tabla anterior.
+static void grafo_redimensionar(grafo_t *grafo) {
+	size_t i, cantidad = grafo->cantidadBaldes;
+	vertice_t *vertice;
+
+	vertice_t **baldes = (vertice_t**) estadisticas_malloc(SUBSISTEMA_GRAFO,
+		2 * cantidad * sizeof(vertice_t*));
+	if(!baldes) return;
+
+	for(i = 0; i < 2 * cantidad; i++) baldes[i] = NULL;
+
+	estadisticas_free(SUBSISTEMA_GRAFO, grafo->baldes);
+	grafo->baldes = baldes;
+	grafo->cantidadBaldes = 2 * cantidad;
+
+	// Basta con recorrer la lista de vértices para redistribuirlos
+	for(vertice = grafo->primerVertice; vertice;
+		vertice = vertice->verticeSiguiente) {
+		size_t b = grafo_balde(grafo, vertice->dato);
+		vertice->siguienteBalde = baldes[b];
+		baldes[b] = vertice;
+	}
+}
+
+// Calcula la posición inicial de un vértice destino en la tabla de
+// aristas de un vértice.
+// PRE: 'capacidad' es una potencia de 2.
+static size_t grafo_posicion_tabla(const vertice_t *destino,
+	size_t capacidad) {
+	uint64_t x = (uint64_t) (uintptr_t) destino;
+
+	x ^= x >> 29;
+	x *= 0xBF58476D1CE4E5B9ull;
+	x ^= x >> 32;
+	return x & (capacidad - 1);
+}
+
+// Agrega una arista a la tabla de aristas de su vértice de partida.
+// PRE: 'v' tiene tabla, con lugar para la arista; 'arista' parte de 'v' y
+// no está en la tabla.
+static void grafo_tabla_insertar(vertice_t *v, arista_t *arista) {
+	size_t m = v->capacidadTabla - 1;
+	size_t i = grafo_posicion_tabla(arista->verticeAdyacente, m + 1);
+
+	while(v->tablaSalida[i]) i = (i + 1) & m;
+	v->tablaSalida[i] = arista;
+}
+
+// Quita una arista de la tabla de aristas de su vértice de partida.
+// PRE: 'v' tiene tabla; 'arista' parte de 'v' y está en la tabla.
+// POST: se quitó la arista, desplazando hacia atrás las siguientes del
+// mismo grupo para no dejar huecos en sus secuencias de sondeo.
+static void grafo_tabla_quitar(vertice_t *v, arista_t *arista) {
+	arista_t **t = v->tablaSalida;
+	size_t m = v->capacidadTabla - 1;
+	size_t i = grafo_posicion_tabla(arista->verticeAdyacente, m + 1);
+	size_t j, k;
+
+	while(t[i] != arista) i = (i + 1) & m;
+
+	for(j = (i + 1) & m; t[j]; j = (j + 1) & m) {
+		// La arista en 'j' puede ocupar el hueco si su posición inicial
+		// no está entre el hueco (exclusive) y 'j' (inclusive)
+		k = grafo_posicion_tabla(t[j]->verticeAdyacente, m + 1);
+
+		if(i <= j ? (k <= i || k > j) : (k <= i && k > j)) {
+			t[i] = t[j];
+			i = j;
+		}
+	}
+
+	t[i] = NULL;
+}
+
+// Arma la tabla de aristas de un vértice a partir de su lista de
+// adyacencia, reemplazando la anterior si la había.
+// PRE: 'v' es un vértice; 'capacidad' es una potencia de 2 mayor al doble
+// del grado de salida de 'v'.
+// POST: 'v' tiene una tabla con todas sus aristas salientes. Si no hubo
+// memoria suficiente, 'v' queda sin tabla y sus aristas se buscan en la
+// lista.
+static void grafo_tabla_armar(vertice_t *v, size_t capacidad) {
+	arista_t *arista;
+	size_t i;
+
+	estadisticas_free(SUBSISTEMA_GRAFO, v->tablaSalida);
+	v->capacidadTabla = 0;
+
+	v->tablaSalida = (arista_t**) estadisticas_malloc(SUBSISTEMA_GRAFO,
+		capacidad * sizeof(arista_t*));
+	if(!v->tablaSalida) return;
+
+	for(i = 0; i < capacidad; i++) v->tablaSalida[i] = NULL;
+	v->capacidadTabla = capacidad;
+
+	for(arista = v->primeraSalida; arista; arista = arista->salidaSiguiente)
+		grafo_tabla_insertar(v, arista);
+}
+
 // Función que devuelve, de existir, el vértice asociado a un dato de
 // un grafo.
 // PRE: 'grafo' es un grafo existente; dato' es el dato que se 
 // encuentra vinculado al vértice a consultar.
 // POST: Se devuelve un puntero al vértice o NULL si no existe.
 vertice_t* grafo_obtener_vertice(grafo_t *grafo, const grafo_dato_t dato) {
-	// Buscamos el vértice en la lista interna del grafo
-	vertice_t *vertice = grafo->primerVertice;
+	// Buscamos el vértice en su balde de la tabla de vértices
+	vertice_t *vertice = grafo->baldes[grafo_balde(grafo, dato)];
 
 	while(vertice) {
 		if(vertice->dato == dato) return vertice;
-		vertice = vertice->verticeSiguiente;
+		vertice = vertice->siguienteBalde;
 	}
 
 	return NULL;
 }
 
+// Función que obtiene los vértices asociados a dos datos de un grafo.
+// PRE: 'grafo' es un grafo existente; 'di' y 'df' son los datos a buscar;
+// 'vi' y 'vf' reciben los vértices encontrados.
+// POST: se cargó en 'vi' y 'vf' un puntero a cada vértice, o NULL si no
+// existe.
+void grafo_obtener_vertices_par(grafo_t *grafo, const grafo_dato_t di,
+	const grafo_dato_t df, vertice_t **vi, vertice_t **vf) {
+	*vi = grafo_obtener_vertice(grafo, di);
+	*vf = grafo_obtener_vertice(grafo, df);
+}
+
 // Función que desvincula a un vértice del grafo al que pertenece.
 // PRE: 'grafo' es un grafo existente; 'vertice' es un vértice 
 // incluido en el grafo.
-// POST: El vértice ya no se encuentra vinculado al grafo. Si se
-// pasa un vértice que previamente no pertenecia al grafo, la función
-// no lanza error.
+// POST: El vértice ya no se encuentra vinculado al grafo.
 void grafo_desvincular_vertice(grafo_t* grafo, vertice_t *vertice) {
-	// Iteramos sobre todos los vértices asociados al grafo
-	vertice_t* vTmp = grafo->primerVertice;
-	vertice_t* vAnteriorTmp = NULL;
+	// Lo quitamos de la lista de vértices
+	if(vertice->verticeAnterior)
+		vertice->verticeAnterior->verticeSiguiente = vertice->verticeSiguiente;
+	else
+		grafo->primerVertice = vertice->verticeSiguiente;
 
-	while(vTmp) {
-		// Verificamos si encontramos el vértice a eliminar
-		if(vTmp == vertice) {
-			// Acción a realizar cuando el vértice es el primero
-			if(grafo->primerVertice == vertice)
-				grafo->primerVertice = vertice->verticeSiguiente;
+	if(vertice->verticeSiguiente)
+		vertice->verticeSiguiente->verticeAnterior = vertice->verticeAnterior;
+	else
+		grafo->ultimoVertice = vertice->verticeAnterior;
 
-			// Acción a realizar cuando el vértice es el último
-			if(grafo->ultimoVertice == vertice)
-				grafo->ultimoVertice = vAnteriorTmp;
+	// Lo quitamos de su balde
+	vertice_t **actual = &grafo->baldes[grafo_balde(grafo, vertice->dato)];
 
-			// Acción sobre el vértice anterior si existe
-			if(vAnteriorTmp)
-				vAnteriorTmp->verticeSiguiente = vTmp->verticeSiguiente;
+	while(*actual != vertice) actual = &(*actual)->siguienteBalde;
+	*actual = vertice->siguienteBalde;
 
-			grafo->cantidadVertices--;
+	grafo->cantidadVertices--;
+}
 
-			return;
-		}
+// Función que agrega una arista al final de la lista de salida de su
+// vértice de partida y de la lista de entrada de su vértice destino, sin
+// indexarla en la tabla de su vértice de partida.
+// PRE: 'arista' es una arista que no pertenece a ninguna lista, con sus
+// vértices ya asignados.
+// POST: la arista es la última de ambas listas.
+void grafo_enlazar_listas(arista_t *arista) {
+	vertice_t *vi = arista->verticePartida;
+	vertice_t *vf = arista->verticeAdyacente;
+
+	arista->salidaAnterior = vi->ultimaSalida;
+	arista->salidaSiguiente = NULL;
+	if(vi->ultimaSalida) vi->ultimaSalida->salidaSiguiente = arista;
+	else vi->primeraSalida = arista;
+	vi->ultimaSalida = arista;
+	vi->gradoSalida++;
+
+	arista->entradaAnterior = vf->ultimaEntrada;
+	arista->entradaSiguiente = NULL;
+	if(vf->ultimaEntrada) vf->ultimaEntrada->entradaSiguiente = arista;
+	else vf->primeraEntrada = arista;
+	vf->ultimaEntrada = arista;
+	vf->gradoEntrada++;
+}
+
+// Función que agrega una arista al final de la lista de salida de su
+// vértice de partida y de la lista de entrada de su vértice destino.
+// PRE: 'arista' es una arista que no pertenece a ninguna lista, con sus
+// vértices ya asignados.
+// POST: la arista es la última de ambas listas.
+void grafo_enlazar_arista(arista_t *arista) {
+	vertice_t *vi = arista->verticePartida;
+
+	grafo_enlazar_listas(arista);
+
+	// Indexamos la arista si el vértice tiene tabla o acaba de alcanzar el
+	// umbral, y duplicamos la tabla si supera la mitad de su capacidad
+	if(vi->tablaSalida && 2 * (size_t) vi->gradoSalida <= vi->capacidadTabla)
+		grafo_tabla_insertar(vi, arista);
+	else if(vi->tablaSalida)
+		grafo_tabla_armar(vi, 2 * vi->capacidadTabla);
+	else if(vi->gradoSalida >= UMBRAL_TABLA)
+		grafo_tabla_armar(vi, 4 * UMBRAL_TABLA);
+}
+
+// Función que quita una arista de la lista de salida de su vértice de
+// partida y de la lista de entrada de su vértice destino.
+// PRE: 'arista' es una arista enlazada con grafo_enlazar_arista().
+// POST: la arista ya no pertenece a ninguna de las dos listas.
+void grafo_desenlazar_arista(arista_t *arista) {
+	vertice_t *vi = arista->verticePartida;
+	vertice_t *vf = arista->verticeAdyacente;
 
-		vAnteriorTmp = vTmp;
-		vTmp = vTmp->verticeSiguiente;
+	if(arista->salidaAnterior)
+		arista->salidaAnterior->salidaSiguiente = arista->salidaSiguiente;
+	else
+		vi->primeraSalida = arista->salidaSiguiente;
+
+	if(arista->salidaSiguiente)
+		arista->salidaSiguiente->salidaAnterior = arista->salidaAnterior;
+	else
+		vi->ultimaSalida = arista->salidaAnterior;
+
+	vi->gradoSalida--;
+
+	if(vi->tablaSalida && vi->gradoSalida < UMBRAL_TABLA / 2) {
+		estadisticas_free(SUBSISTEMA_GRAFO, vi->tablaSalida);
+		vi->tablaSalida = NULL;
+		vi->capacidadTabla = 0;
 	}
+	else if(vi->tablaSalida)
+		grafo_tabla_quitar(vi, arista);
+
+	if(arista->entradaAnterior)
+		arista->entradaAnterior->entradaSiguiente = arista->entradaSiguiente;
+	else
+		vf->primeraEntrada = arista->entradaSiguiente;
+
+	if(arista->entradaSiguiente)
+		arista->entradaSiguiente->entradaAnterior = arista->entradaAnterior;
+	else
+		vf->ultimaEntrada = arista->entradaAnterior;
+
+	vf->gradoEntrada--;
+}
+
+// Función que devuelve la arista que une a dos vértices.
+// PRE: 'vi' es el vértice de partida de la arista; 'vf' es el vértice
+// destino de la arista.
+// POST: se devuelve un puntero a la arista en caso de existir, o NULL en
+// caso contrario. Si 'vi' no tiene tabla, se recorre la más corta entre
+// su lista de salida y la lista de entrada de 'vf'.
+arista_t* grafo_buscar_arista(vertice_t *vi, vertice_t *vf) {
+	arista_t *arista;
+
+	if(vi->tablaSalida) {
+		size_t m = vi->capacidadTabla - 1;
+		size_t i = grafo_posicion_tabla(vf, m + 1);
+
+		for(; (arista = vi->tablaSalida[i]); i = (i + 1) & m)
+			if(arista->verticeAdyacente == vf) return arista;
+	}
+	else if(vi->gradoSalida <= vf->gradoEntrada) {
+		for(arista = vi->primeraSalida; arista;
+			arista = arista->salidaSiguiente)
+			if(arista->verticeAdyacente == vf) return arista;
+	}
+	else {
+		for(arista = vf->primeraEntrada; arista;
+			arista = arista->entradaSiguiente)
+			if(arista->verticePartida == vi) return arista;
+	}
+
+	return NULL;
 }
 
 // Función que devuelve un puntero a la arista asociada a dos datos
@@ -131,64 +458,80 @@ void grafo_desvincular_vertice(grafo_t* grafo, vertice_t *vertice) {
 arista_t* grafo_obtener_arista(grafo_t *grafo, grafo_dato_t di, 
 	grafo_dato_t df) {
 	// Obtenemos los vértices asociados a los datos
-	vertice_t *vi = grafo_obtener_vertice(grafo, di);
-	vertice_t *vf = grafo_obtener_vertice(grafo, df);
+	vertice_t *vi, *vf;
+	grafo_obtener_vertices_par(grafo, di, df, &vi, &vf);
 	if((!vi) || (!vf) || (vi == vf)) return NULL;
 
-	// Iteramos sobre la lista de adyacencia del vértice de partida
-	// para buscar la arista que lo vincula con el vértice destino
-	lista_iter_t* iter = lista_iter_crear(vi->listaDeAdyacencia);
-	arista_t* arista;
-
-	while(!lista_iter_al_final(iter)) {
-		lista_iter_ver_actual(iter, &arista);
-		if(arista->verticeAdyacente == vf) {
-			lista_iter_destruir(iter);
-			return arista;
-		};
-		lista_iter_avanzar(iter);
-	}
-	
-	lista_iter_destruir(iter);
-	return NULL;
+	return grafo_buscar_arista(vi, vf);
+}
+
+// Función que verifica si un elemento se encuentra dentro de un bloque
+// de memoria.
+// PRE: 'bloque' es un bloque de 'tamano' bytes, o NULL.
+static bool grafo_en_bloque(const void *elemento, const void *bloque,
+	size_t tamano) {
+	uintptr_t e = (uintptr_t) elemento, b = (uintptr_t) bloque;
+	return bloque && e >= b && e - b < tamano;
+}
+
+// Función que obtiene el espacio para una arista nueva.
+// PRE: 'grafo' es un grafo existente.
+// POST: devuelve una arista del bloque que fue eliminada, si la hay, o
+// una nueva, o NULL si no hubo memoria suficiente.
+arista_t* grafo_reservar_arista(grafo_t *grafo) {
+	arista_t *arista = grafo->aristasLibres;
+
+	if(!arista)
+		return (arista_t*) estadisticas_malloc(SUBSISTEMA_GRAFO,
+			sizeof(arista_t));
+
+	grafo->aristasLibres = arista->salidaSiguiente;
+	return arista;
 }
 
 // Función de destrucción de una arista. 
-// Pre: 'arista' es una arista existente.
-// Post: Se liberó el espacio de memoria ocupado por la arista.
-void arista_funcion_de_destruccion(arista_t* arista) {
-	free(arista);
+// Pre: 'grafo' es el grafo al que pertenecía 'arista', una arista ya
+// quitada de sus listas.
+// Post: Se liberó el espacio de memoria ocupado por la arista, o se la
+// reservó para reutilizarla si pertenece al bloque del grafo.
+void arista_funcion_de_destruccion(grafo_t *grafo, arista_t* arista) {
+	if(grafo_en_bloque(arista, grafo->bloqueAristas,
+		grafo->aristasEnBloque * sizeof(arista_t))) {
+		arista->salidaSiguiente = grafo->aristasLibres;
+		grafo->aristasLibres = arista;
+	}
+	else
+		estadisticas_free(SUBSISTEMA_GRAFO, arista);
+}
+
+// Función de destrucción de un vértice.
+// Pre: 'grafo' es el grafo al que pertenecía 'vertice', un vértice ya
+// desvinculado y sin aristas.
+// Post: Se liberó el espacio de memoria ocupado por el vértice, salvo que
+// pertenezca al bloque del grafo, el cual se libera al destruirlo.
+void vertice_funcion_de_destruccion(grafo_t *grafo, vertice_t *vertice) {
+	estadisticas_free(SUBSISTEMA_GRAFO, vertice->tablaSalida);
+
+	if(!grafo_en_bloque(vertice, grafo->bloqueVertices,
+		grafo->verticesEnBloque * sizeof(vertice_t)))
+		estadisticas_free(SUBSISTEMA_GRAFO, vertice);
 }
 
 // Función que dados dos vértices, destruye la arista que los
 // asocia.
-// PRE: 'vi' es el vértice de partida de la arista; 'vf' es el
-// vértice destino de la arista.
+// PRE: 'grafo' es el grafo que contiene a los vértices; 'vi' es el
+// vértice de partida de la arista; 'vf' es el vértice destino de la
+// arista.
 // POST: devuelve true si se realizó la acción exitosamente o
 // false en su defecto, como así también, si no existe tal arista.
-bool grafo_destruir_arista(vertice_t *vi, vertice_t *vf) {
-	// Iteramos sobre la lista de adyacentes del vértice inicial
-	// hasta encontrar la arista, y la eliminamos.
-	lista_iter_t* iter = lista_iter_crear(vi->listaDeAdyacencia);
-	arista_t* arista;
-
-	while(!lista_iter_al_final(iter)) {
-		lista_iter_ver_actual(iter, &arista);
-		
-		if(arista->verticeAdyacente == vf) {
-			arista_funcion_de_destruccion(arista);
-			lista_borrar(vi->listaDeAdyacencia, iter, &arista);
-			lista_iter_destruir(iter);
-			return true;
-		};
-
-		lista_iter_avanzar(iter);
-	}
-	
-	lista_iter_destruir(iter);
+bool grafo_destruir_arista(grafo_t *grafo, vertice_t *vi, vertice_t *vf) {
+	arista_t *arista = grafo_buscar_arista(vi, vf);
+	if(!arista) return false;
 
-	// No se encontró la arista
-	return false;
+	grafo->version -= grafo_huella_arista(arista);
+	grafo_desenlazar_arista(arista);
+	arista_funcion_de_destruccion(grafo, arista);
+	return true;
 }
 
 
@@ -198,18 +541,407 @@ bool grafo_destruir_arista(vertice_t *vi, vertice_t *vf) {
 // POST: devuelve true si el vértice existe en el grafo o false en
 // en caso contrario.
 bool grafo_existe_vertice(grafo_t *grafo, const grafo_dato_t dato) {
-	// Iteramos sobre todos los vértices asociados al grafo
-	vertice_t *vertice = grafo->primerVertice;
+	return grafo_obtener_vertice(grafo, dato) != NULL;
+}
 
-	while(vertice) {
-		// Comprobamos si el vértice actual se encuentra
-		// asociado al dato
-		if(vertice->dato == dato) return true;
-		vertice = vertice->verticeSiguiente;
+
+
+// Tipo que representa el estado de una creación masiva, compartido por
+// los hilos que la realizan.
+typedef struct {
+	grafo_t *grafo;						// Grafo en creación
+	const grafo_dato_t *datos;			// Argumentos de
+	int vertices;						// grafo_crear_masivo()
+	const int *partidas;
+	const int *destinos;
+	const int *pesos;
+	int aristas;
+	size_t partes;						// Cantidad de hilos que trabajan
+	const int *claves;					// Vértice por el que se ordena
+										// cada arista
+	int *cuentas;						// Por cada hilo, 'vertices' + 1
+										// contadores o marcas
+	int *inicio;						// Primera posición de cada vértice
+										// en 'orden'
+	int *orden;							// Aristas ordenadas por vértice
+	int *ranura;						// Posición en el bloque de cada
+										// arista, o -1 si no prevalece
+	int *limites;						// Primer vértice de cada hilo
+	int *parciales;						// Acumulado de cada hilo
+	uint64_t *huellas;					// Suma de las huellas de los
+										// vértices y aristas de cada hilo
+} grafo_masivo_t;
+
+// Calcula la porción de un total que le corresponde a un hilo.
+// PRE: 'm' es el estado; 'hilo' es un número de hilo; 'total' es la
+// cantidad de elementos a repartir.
+// POST: se cargó en 'desde' y 'hasta' el rango de elementos del hilo, que
+// es vacío si el hilo no trabaja.
+static void grafo_masivo_porcion(const grafo_masivo_t *m, size_t hilo,
+	size_t total, size_t *desde, size_t *hasta) {
+	if(hilo >= m->partes) {
+		*desde = *hasta = 0;
+		return;
 	}
 
-	// No se encontró un vértice asociado
-	return false;
+	*desde = total * hilo / m->partes;
+	*hasta = total * (hilo + 1) / m->partes;
+}
+
+// Devuelve los contadores de un hilo.
+// PRE: 'm' es el estado; 'hilo' es un número de hilo que trabaja.
+static int* grafo_masivo_cuentas(const grafo_masivo_t *m, size_t hilo) {
+	return m->cuentas + hilo * ((size_t) m->vertices + 1);
+}
+
+// Tarea que descarta, en la porción de aristas de un hilo, las que van de
+// un vértice a sí mismo.
+// PRE: 'contexto' es el estado (grafo_masivo_t).
+// POST: 'ranura' vale -1 para estas aristas y 0 para las demás.
+static void grafo_masivo_preparar(size_t hilo, void *contexto) {
+	grafo_masivo_t *m = (grafo_masivo_t*) contexto;
+	size_t k, desde, hasta;
+
+	grafo_masivo_porcion(m, hilo, m->aristas, &desde, &hasta);
+
+	for(k = desde; k < hasta; k++)
+		m->ranura[k] = m->partidas[k] == m->destinos[k] ? -1 : 0;
+}
+
+// Tarea que cuenta, en la porción de aristas de un hilo, las aristas que
+// prevalecen de cada vértice clave.
+// PRE: 'contexto' es el estado (grafo_masivo_t).
+static void grafo_masivo_contar(size_t hilo, void *contexto) {
+	grafo_masivo_t *m = (grafo_masivo_t*) contexto;
+	size_t k, desde, hasta;
+	int u, *cuenta;
+
+	if(hilo >= m->partes) return;
+	grafo_masivo_porcion(m, hilo, m->aristas, &desde, &hasta);
+
+	cuenta = grafo_masivo_cuentas(m, hilo);
+	for(u = 0; u < m->vertices; u++) cuenta[u] = 0;
+
+	for(k = desde; k < hasta; k++)
+		if(m->ranura[k] >= 0) cuenta[m->claves[k]]++;
+}
+
+// Tarea que, para los vértices de la porción de un hilo, calcula su
+// grado y la posición relativa de la porción de aristas de cada hilo.
+// PRE: 'contexto' es el estado, con las aristas contadas.
+static void grafo_masivo_sumar(size_t hilo, void *contexto) {
+	grafo_masivo_t *m = (grafo_masivo_t*) contexto;
+	size_t u, t, desde, hasta;
+	int c, total, acumulado = 0;
+
+	if(hilo >= m->partes) return;
+	grafo_masivo_porcion(m, hilo, m->vertices, &desde, &hasta);
+
+	for(u = desde; u < hasta; u++) {
+		for(t = 0, total = 0; t < m->partes; t++) {
+			c = grafo_masivo_cuentas(m, t)[u];
+			grafo_masivo_cuentas(m, t)[u] = total;
+			total += c;
+		}
+
+		m->inicio[u] = total;
+		acumulado += total;
+	}
+
+	m->parciales[hilo] = acumulado;
+}
+
+// Tarea que, para los vértices de la porción de un hilo, calcula su
+// primera posición en el orden y la de la porción de aristas de cada hilo.
+// PRE: 'contexto' es el estado; 'parciales' tiene la cantidad de aristas
+// de los vértices de los hilos anteriores.
+static void grafo_masivo_desplazar(size_t hilo, void *contexto) {
+	grafo_masivo_t *m = (grafo_masivo_t*) contexto;
+	size_t u, t, desde, hasta;
+	int grado, acumulado;
+
+	if(hilo >= m->partes) return;
+	grafo_masivo_porcion(m, hilo, m->vertices, &desde, &hasta);
+	acumulado = m->parciales[hilo];
+
+	for(u = desde; u < hasta; u++) {
+		grado = m->inicio[u];
+		m->inicio[u] = acumulado;
+
+		for(t = 0; t < m->partes; t++)
+			grafo_masivo_cuentas(m, t)[u] += acumulado;
+
+		acumulado += grado;
+	}
+}
+
+// Tarea que ubica en el orden las aristas de la porción de un hilo.
+// PRE: 'contexto' es el estado, con las posiciones ya calculadas.
+static void grafo_masivo_distribuir(size_t hilo, void *contexto) {
+	grafo_masivo_t *m = (grafo_masivo_t*) contexto;
+	size_t k, desde, hasta;
+
+	grafo_masivo_porcion(m, hilo, m->aristas, &desde, &hasta);
+	if(desde == hasta) return;
+
+	int *cuenta = grafo_masivo_cuentas(m, hilo);
+
+	for(k = desde; k < hasta; k++)
+		if(m->ranura[k] >= 0) m->orden[cuenta[m->claves[k]]++] = k;
+}
+
+// Ejecuta una tarea de la creación masiva.
+// PRE: 'm' es el estado; 'hilos' es el conjunto de hilos, o NULL si
+// trabaja un único hilo.
+// POST: se ejecutó la tarea, repartida entre los hilos si corresponde.
+static void grafo_masivo_ejecutar(grafo_masivo_t *m, hilos_t *hilos,
+	hilos_tarea_t tarea) {
+	if(m->partes <= 1) tarea(0, m);
+	else hilos_ejecutar(hilos, tarea, m);
+}
+
+// Ordena por vértice clave las aristas que prevalecen, con un
+// ordenamiento por conteo repartido entre los hilos, y reparte los
+// vértices entre los hilos según sus aristas.
+// PRE: 'm' es el estado; 'claves' es el vértice clave de cada arista.
+// POST: 'orden' tiene las aristas con 'ranura' no negativa, agrupadas por
+// vértice clave a partir de 'inicio', y respetando su orden original
+// entre las de un mismo vértice. Los vértices desde 'limites[h]' hasta
+// 'limites[h + 1]' (sin incluirlo) le corresponden al hilo 'h', con
+// aproximadamente la misma cantidad de aristas para cada hilo.
+static void grafo_masivo_ordenar(grafo_masivo_t *m, hilos_t *hilos,
+	const int *claves) {
+	size_t t;
+	int total = 0, parcial;
+
+	m->claves = claves;
+	grafo_masivo_ejecutar(m, hilos, grafo_masivo_contar);
+	grafo_masivo_ejecutar(m, hilos, grafo_masivo_sumar);
+
+	for(t = 0; t < m->partes; t++) {
+		parcial = m->parciales[t];
+		m->parciales[t] = total;
+		total += parcial;
+	}
+
+	grafo_masivo_ejecutar(m, hilos, grafo_masivo_desplazar);
+	m->inicio[m->vertices] = total;
+	grafo_masivo_ejecutar(m, hilos, grafo_masivo_distribuir);
+
+	// Cada hilo comienza en el primer vértice cuyas aristas empiezan en su
+	// porción del orden
+	for(t = 0; t <= m->partes; t++) {
+		int bajo = 0, alto = m->vertices, medio;
+		size_t objetivo = (size_t) total * t / m->partes;
+
+		while(bajo < alto) {
+			medio = bajo + (alto - bajo) / 2;
+			if((size_t) m->inicio[medio] < objetivo) bajo = medio + 1;
+			else alto = medio;
+		}
+
+		m->limites[t] = t < m->partes ? bajo : m->vertices;
+	}
+}
+
+// Tarea que elige las aristas que prevalecen entre las que parten de los
+// vértices de un hilo. Recorriendo desde el final las aristas de cada
+// vértice, la primera que encontramos hacia cada destino es la que
+// prevalece.
+// PRE: 'contexto' es el estado, con las aristas ordenadas por vértice de
+// partida.
+// POST: 'ranura' vale 0 para las que prevalecen y -1 para las demás, y
+// 'parciales' tiene la cantidad de las que prevalecen en el hilo.
+static void grafo_masivo_depurar(size_t hilo, void *contexto) {
+	grafo_masivo_t *m = (grafo_masivo_t*) contexto;
+	int u, j, k, conservadas = 0;
+
+	if(hilo >= m->partes) return;
+
+	int *marca = grafo_masivo_cuentas(m, hilo);
+	for(u = 0; u < m->vertices; u++) marca[u] = -1;
+
+	for(u = m->limites[hilo]; u < m->limites[hilo + 1]; u++)
+		for(j = m->inicio[u + 1] - 1; j >= m->inicio[u]; j--) {
+			k = m->orden[j];
+
+			if(marca[m->destinos[k]] == u) m->ranura[k] = -1;
+			else {
+				marca[m->destinos[k]] = u;
+				conservadas++;
+			}
+		}
+
+	m->parciales[hilo] = conservadas;
+}
+
+// Tarea que inicializa los vértices de un hilo y les enlaza sus listas
+// de salida, asignando a sus aristas posiciones consecutivas en el
+// bloque en su orden de creación.
+// PRE: 'contexto' es el estado, con las aristas ordenadas por vértice de
+// partida y depuradas; 'parciales' tiene la cantidad de aristas que
+// prevalecen en los hilos anteriores.
+static void grafo_masivo_enlazar_salidas(size_t hilo, void *contexto) {
+	grafo_masivo_t *m = (grafo_masivo_t*) contexto;
+	grafo_t *grafo = m->grafo;
+	arista_t *arista, *anterior;
+	vertice_t *v;
+	int u, j, k, ranura;
+
+	if(hilo >= m->partes) return;
+	ranura = m->parciales[hilo];
+	m->huellas[hilo] = 0;
+
+	for(u = m->limites[hilo]; u < m->limites[hilo + 1]; u++) {
+		v = &grafo->bloqueVertices[u];
+		v->dato = m->datos[u];
+		v->primeraEntrada = v->ultimaEntrada = NULL;
+		v->gradoSalida = v->gradoEntrada = 0;
+		v->tablaSalida = NULL;
+		v->capacidadTabla = 0;
+		v->verticeAnterior = u ? v - 1 : NULL;
+		v->verticeSiguiente = u + 1 < m->vertices ? v + 1 : NULL;
+		anterior = NULL;
+
+		for(j = m->inicio[u]; j < m->inicio[u + 1]; j++) {
+			k = m->orden[j];
+			if(m->ranura[k] < 0) continue;
+
+			m->ranura[k] = ranura;
+			arista = &grafo->bloqueAristas[ranura++];
+			arista->verticePartida = v;
+			arista->verticeAdyacente = &grafo->bloqueVertices[m->destinos[k]];
+			arista->peso = m->pesos[k];
+			arista->salidaAnterior = anterior;
+			m->huellas[hilo] += grafo_huella_arista(arista);
+
+			if(anterior) anterior->salidaSiguiente = arista;
+			else v->primeraSalida = arista;
+
+			anterior = arista;
+			v->gradoSalida++;
+		}
+
+		if(anterior) anterior->salidaSiguiente = NULL;
+		else v->primeraSalida = NULL;
+		v->ultimaSalida = anterior;
+		m->huellas[hilo] += grafo_huella_vertice(v);
+	}
+}
+
+// Tarea que enlaza las listas de entrada de los vértices de un hilo, en
+// el orden de creación de las aristas, e indexa las aristas salientes de
+// los vértices de grado alto.
+// PRE: 'contexto' es el estado, con las aristas que prevalecen ordenadas
+// por vértice destino y ya enlazadas en sus listas de salida.
+static void grafo_masivo_enlazar_entradas(size_t hilo, void *contexto) {
+	grafo_masivo_t *m = (grafo_masivo_t*) contexto;
+	grafo_t *grafo = m->grafo;
+	arista_t *arista, *anterior;
+	vertice_t *v;
+	int u, j;
+
+	if(hilo >= m->partes) return;
+
+	for(u = m->limites[hilo]; u < m->limites[hilo + 1]; u++) {
+		v = &grafo->bloqueVertices[u];
+		anterior = NULL;
+
+		for(j = m->inicio[u]; j < m->inicio[u + 1]; j++) {
+			arista = &grafo->bloqueAristas[m->ranura[m->orden[j]]];
+			arista->entradaAnterior = anterior;
+
+			if(anterior) anterior->entradaSiguiente = arista;
+			else v->primeraEntrada = arista;
+
+			anterior = arista;
+			v->gradoEntrada++;
+		}
+
+		if(anterior) anterior->entradaSiguiente = NULL;
+		v->ultimaEntrada = anterior;
+
+		if(v->gradoSalida >= UMBRAL_TABLA) {
+			size_t capacidad = 4 * UMBRAL_TABLA;
+			while(2 * (size_t) v->gradoSalida > capacidad) capacidad *= 2;
+			grafo_tabla_armar(v, capacidad);
+		}
+	}
+}
+
+// Función que crea en bloque los vértices y las aristas de un grafo.
+// PRE: 'm' es el estado, con los argumentos de grafo_crear_masivo() y el
+// espacio de trabajo; 'hilos' es el conjunto de hilos, o NULL.
+// POST: devuelve true si se agregaron al grafo los vértices y las
+// aristas, o false si no hubo memoria suficiente (en cuyo caso el grafo
+// sólo puede destruirse).
+bool grafo_masivo_armar(grafo_masivo_t *m, hilos_t *hilos) {
+	grafo_t *grafo = m->grafo;
+	size_t b, cantidadBaldes = BALDES_INICIALES;
+	int i, conservadas = 0, parcial;
+	size_t t;
+
+	// Ordenamos las aristas por vértice de partida, ignorando las que van
+	// de un vértice a sí mismo, y elegimos las que prevalecen
+	grafo_masivo_ejecutar(m, hilos, grafo_masivo_preparar);
+	grafo_masivo_ordenar(m, hilos, m->partidas);
+	grafo_masivo_ejecutar(m, hilos, grafo_masivo_depurar);
+
+	for(t = 0; t < m->partes; t++) {
+		parcial = m->parciales[t];
+		m->parciales[t] = conservadas;
+		conservadas += parcial;
+	}
+
+	// Solicitamos el espacio del grafo
+	while(cantidadBaldes < (size_t) m->vertices) cantidadBaldes *= 2;
+
+	vertice_t **baldes = (vertice_t**) estadisticas_malloc(SUBSISTEMA_GRAFO,
+		cantidadBaldes * sizeof(vertice_t*));
+	grafo->bloqueVertices = (vertice_t*) estadisticas_malloc(
+		SUBSISTEMA_GRAFO, (m->vertices + 1) * sizeof(vertice_t));
+	grafo->bloqueAristas = (arista_t*) estadisticas_malloc(
+		SUBSISTEMA_GRAFO, (conservadas + 1) * sizeof(arista_t));
+
+	if(!baldes || !grafo->bloqueVertices || !grafo->bloqueAristas) {
+		estadisticas_free(SUBSISTEMA_GRAFO, baldes);
+		return false;
+	}
+
+	estadisticas_free(SUBSISTEMA_GRAFO, grafo->baldes);
+	grafo->baldes = baldes;
+	grafo->cantidadBaldes = cantidadBaldes;
+	grafo->verticesEnBloque = m->vertices;
+	grafo->aristasEnBloque = conservadas;
+
+	// Armamos los vértices con sus listas de salida y luego, ordenando las
+	// aristas por vértice destino, sus listas de entrada
+	grafo_masivo_ejecutar(m, hilos, grafo_masivo_enlazar_salidas);
+	grafo_masivo_ordenar(m, hilos, m->destinos);
+	grafo_masivo_ejecutar(m, hilos, grafo_masivo_enlazar_entradas);
+
+	// Ubicamos los vértices en sus baldes, en su orden
+	for(b = 0; b < cantidadBaldes; b++) baldes[b] = NULL;
+
+	for(i = 0; i < m->vertices; i++) {
+		vertice_t *v = &grafo->bloqueVertices[i];
+		b = grafo_balde(grafo, v->dato);
+		v->siguienteBalde = baldes[b];
+		baldes[b] = v;
+	}
+
+	if(m->vertices) {
+		grafo->primerVertice = grafo->bloqueVertices;
+		grafo->ultimoVertice = &grafo->bloqueVertices[m->vertices - 1];
+	}
+
+	grafo->cantidadVertices = m->vertices;
+	grafo->cantidadAristas = conservadas;
+
+	// La suma de las huellas no depende de cómo se repartieron
+	for(t = 0; t < m->partes; t++) grafo->version += m->huellas[t];
+
+	return true;
 }
 
 
@@ -222,14 +954,104 @@ bool grafo_existe_vertice(grafo_t *grafo, const grafo_dato_t dato) {
 // POST: devuelve un nuevo grafo vacío o NULL si no se ha podido
 // llevar a cabo la creación del mismo.
 grafo_t* grafo_crear() {
+	size_t i;
+
 	// Solicitamos espacio en memoria
-	grafo_t* grafo = (grafo_t*) malloc(sizeof(grafo_t));
+	grafo_t* grafo = (grafo_t*) estadisticas_malloc(SUBSISTEMA_GRAFO,
+		sizeof(grafo_t));
 	if(!grafo) return NULL;
 
+	grafo->baldes = (vertice_t**) estadisticas_malloc(SUBSISTEMA_GRAFO,
+		BALDES_INICIALES * sizeof(vertice_t*));
+	if(!grafo->baldes) {
+		estadisticas_free(SUBSISTEMA_GRAFO, grafo);
+		return NULL;
+	}
+
+	for(i = 0; i < BALDES_INICIALES; i++) grafo->baldes[i] = NULL;
+
 	// Seteamos parámetros iniciales del grafo
+	grafo->cantidadBaldes = BALDES_INICIALES;
 	grafo->primerVertice = NULL;
 	grafo->ultimoVertice = NULL;
 	grafo->cantidadVertices = 0;
+	grafo->cantidadAristas = 0;
+	grafo->bloqueVertices = NULL;
+	grafo->verticesEnBloque = 0;
+	grafo->bloqueAristas = NULL;
+	grafo->aristasEnBloque = 0;
+	grafo->aristasLibres = NULL;
+	grafo->version = 0;
+
+	return grafo;
+}
+
+// Crea un grafo a partir de sus vértices y sus aristas.
+// PRE: 'datos' es un arreglo de 'vertices' datos distintos entre sí, a
+// vincular con los vértices; 'partidas', 'destinos' y 'pesos' son arreglos
+// de 'aristas' elementos, donde cada arista se describe por la posición
+// en 'datos' de su vértice de partida y de su vértice destino, y su peso;
+// 'hilos' es el conjunto de hilos que realiza la creación, o NULL para
+// realizarla sólo en el hilo actual.
+// POST: devuelve un grafo igual al que se obtiene al crear un grafo
+// vacío, agregarle los vértices en el orden de 'datos' y luego crear las
+// aristas, en orden, con grafo_crear_arista(): entre dos vértices
+// prevalece la última arista, y se ignoran las que van de un vértice a sí
+// mismo. El resultado no depende de la cantidad de hilos. Devuelve NULL
+// si no se ha podido llevar a cabo la creación.
+grafo_t* grafo_crear_masivo(const grafo_dato_t *datos, int vertices,
+	const int *partidas, const int *destinos, const int *pesos, int aristas,
+	hilos_t *hilos) {
+	grafo_masivo_t m;
+
+	grafo_t *grafo = grafo_crear();
+	if(!grafo) return NULL;
+
+	// Repartimos el trabajo sólo si cada hilo recibe suficientes aristas
+	m.partes = hilos ? aristas / MIN_ARISTAS_POR_HILO : 1;
+	if(hilos && m.partes > hilos_cantidad(hilos))
+		m.partes = hilos_cantidad(hilos);
+	if(m.partes < 1) m.partes = 1;
+
+	m.grafo = grafo;
+	m.datos = datos;
+	m.vertices = vertices;
+	m.partidas = partidas;
+	m.destinos = destinos;
+	m.pesos = pesos;
+	m.aristas = aristas;
+
+	// Solicitamos el espacio de trabajo
+	m.cuentas = (int*) estadisticas_malloc(SUBSISTEMA_GRAFO,
+		m.partes * (vertices + 1) * sizeof(int));
+	m.inicio = (int*) estadisticas_malloc(SUBSISTEMA_GRAFO,
+		(vertices + 1) * sizeof(int));
+	m.orden = (int*) estadisticas_malloc(SUBSISTEMA_GRAFO,
+		(aristas + 1) * sizeof(int));
+	m.ranura = (int*) estadisticas_malloc(SUBSISTEMA_GRAFO,
+		(aristas + 1) * sizeof(int));
+	m.limites = (int*) estadisticas_malloc(SUBSISTEMA_GRAFO,
+		(m.partes + 1) * sizeof(int));
+	m.parciales = (int*) estadisticas_malloc(SUBSISTEMA_GRAFO,
+		m.partes * sizeof(int));
+	m.huellas = (uint64_t*) estadisticas_malloc(SUBSISTEMA_GRAFO,
+		m.partes * sizeof(uint64_t));
+
+	bool ok = m.cuentas && m.inicio && m.orden && m.ranura && m.limites &&
+		m.parciales && m.huellas && grafo_masivo_armar(&m, hilos);
+
+	estadisticas_free(SUBSISTEMA_GRAFO, m.cuentas);
+	estadisticas_free(SUBSISTEMA_GRAFO, m.inicio);
+	estadisticas_free(SUBSISTEMA_GRAFO, m.orden);
+	estadisticas_free(SUBSISTEMA_GRAFO, m.ranura);
+	estadisticas_free(SUBSISTEMA_GRAFO, m.limites);
+	estadisticas_free(SUBSISTEMA_GRAFO, m.parciales);
+	estadisticas_free(SUBSISTEMA_GRAFO, m.huellas);
+
+	if(!ok) {
+		grafo_destruir(grafo);
+		return NULL;
+	}
 
 	return grafo;
 }
@@ -242,21 +1064,29 @@ grafo_t* grafo_crear() {
 void grafo_destruir(grafo_t *grafo) {
 	vertice_t *vertice = grafo->primerVertice;
 	vertice_t *vertice_tmp;
+	arista_t *arista, *arista_tmp;
 
 	// Destruimos los vértices asociados al grafo
 	while(vertice) {
 		vertice_tmp = vertice->verticeSiguiente;
 		
-		// Destruimos aristas asociadas al vértice
-		lista_destruir(vertice->listaDeAdyacencia, 
-			arista_funcion_de_destruccion);
-		free(vertice);
+		// Destruimos aristas que parten del vértice, con lo que cada
+		// arista se destruye una única vez
+		for(arista = vertice->primeraSalida; arista; arista = arista_tmp) {
+			arista_tmp = arista->salidaSiguiente;
+			arista_funcion_de_destruccion(grafo, arista);
+		}
+
+		vertice_funcion_de_destruccion(grafo, vertice);
 
 		vertice = vertice_tmp;
 	}
 
 	// Liberamos el espacio del grafo
-	free(grafo);
+	estadisticas_free(SUBSISTEMA_GRAFO, grafo->bloqueVertices);
+	estadisticas_free(SUBSISTEMA_GRAFO, grafo->bloqueAristas);
+	estadisticas_free(SUBSISTEMA_GRAFO, grafo->baldes);
+	estadisticas_free(SUBSISTEMA_GRAFO, grafo);
 }
 
 // Crea un nuevo vértice en el grafo.
@@ -270,13 +1100,19 @@ bool grafo_nuevo_vertice(grafo_t *grafo, const grafo_dato_t dato) {
 		return false;
 
 	// Creamos un vértice
-	vertice_t* vertice = (vertice_t*) malloc(sizeof(vertice_t));
+	vertice_t* vertice = (vertice_t*) estadisticas_malloc(SUBSISTEMA_GRAFO,
+		sizeof(vertice_t));
 	if(!vertice) return false;
 
 	// Seteamos la información inicial del vértice
 	vertice->dato = dato;
-	vertice->listaDeAdyacencia = lista_crear();
+	vertice->primeraSalida = vertice->ultimaSalida = NULL;
+	vertice->primeraEntrada = vertice->ultimaEntrada = NULL;
+	vertice->gradoSalida = vertice->gradoEntrada = 0;
+	vertice->tablaSalida = NULL;
+	vertice->capacidadTabla = 0;
 	vertice->verticeSiguiente = NULL;
+	vertice->verticeAnterior = grafo->ultimoVertice;
 
 	// Vinculamos el vértice al grafo
 	if(!grafo->primerVertice)
@@ -286,6 +1122,17 @@ bool grafo_nuevo_vertice(grafo_t *grafo, const grafo_dato_t dato) {
 
 	grafo->ultimoVertice = vertice;
 	grafo->cantidadVertices++;
+	grafo->version += grafo_huella_vertice(vertice);
+
+	// Lo ubicamos en su balde, manteniendo a lo sumo un vértice por
+	// balde en promedio
+	size_t b = grafo_balde(grafo, dato);
+	vertice->siguienteBalde = grafo->baldes[b];
+	grafo->baldes[b] = vertice;
+
+	if((size_t) grafo->cantidadVertices > grafo->cantidadBaldes)
+		grafo_redimensionar(grafo);
+
 
 	return true;
 }
@@ -301,26 +1148,28 @@ bool grafo_eliminar_vertice(grafo_t *grafo, const grafo_dato_t dato) {
 	vertice_t* vertice = grafo_obtener_vertice(grafo, dato);
 	if(!vertice) return false;
 
-	// Destruimos aristas asociadas al vértice
-	lista_destruir(vertice->listaDeAdyacencia, arista_funcion_de_destruccion);
-
-	// Desvinculamos al vértice del grafo
-	grafo_desvincular_vertice(grafo, vertice);
-
-	// Destruimos aristas asociadas a otros vértices que
-	// incluyan al vértice
-	vertice_t *vertice_tmp = grafo->primerVertice;
+	// Destruimos las aristas que parten del vértice y las que llegan a
+	// él, quitándolas también de las listas de sus otros extremos
+	grafo->cantidadAristas -= vertice->gradoSalida + vertice->gradoEntrada;
 
-	while(vertice_tmp) {
-		// Verificamos si existen aristas salientes del vértice
-		if(!lista_esta_vacia(vertice_tmp->listaDeAdyacencia))
-			grafo_destruir_arista(vertice_tmp, vertice);
+	while(vertice->primeraSalida) {
+		arista_t *arista = vertice->primeraSalida;
+		grafo->version -= grafo_huella_arista(arista);
+		grafo_desenlazar_arista(arista);
+		arista_funcion_de_destruccion(grafo, arista);
+	}
 
-		vertice_tmp = vertice_tmp->verticeSiguiente;
+	while(vertice->primeraEntrada) {
+		arista_t *arista = vertice->primeraEntrada;
+		grafo->version -= grafo_huella_arista(arista);
+		grafo_desenlazar_arista(arista);
+		arista_funcion_de_destruccion(grafo, arista);
 	}
 
-	// Destruimos el vértice
-	free(vertice);
+	// Desvinculamos al vértice del grafo y lo destruimos
+	grafo->version -= grafo_huella_vertice(vertice);
+	grafo_desvincular_vertice(grafo, vertice);
+	vertice_funcion_de_destruccion(grafo, vertice);
 
 	return true;
 }
@@ -349,23 +1198,31 @@ bool grafo_es_vertice(grafo_t *grafo, const grafo_dato_t dato) {
 bool grafo_crear_arista(grafo_t *grafo, grafo_dato_t di, 
 	grafo_dato_t df, int peso) {
 	// Obtenemos los vértices que contienen los datos
-	vertice_t *vi = grafo_obtener_vertice(grafo, di);
-	vertice_t *vf = grafo_obtener_vertice(grafo, df);
+	vertice_t *vi, *vf;
+	grafo_obtener_vertices_par(grafo, di, df, &vi, &vf);
 	if((!vi) || (!vf) || (vi == vf)) return false;
 
-	// Creamos arista 
-	arista_t *arista = (arista_t*) malloc(sizeof(arista_t));
-	if(!arista) return false;
+	// Reutilizamos, si existe, la arista vieja, que pasa a ser la última
+	// de las listas de sus vértices como si se la creara de nuevo
+	arista_t *arista = grafo_buscar_arista(vi, vf);
 
-	// Insertamos info en arista
-	arista->verticeAdyacente = vf;
-	arista->peso = peso;
+	if(arista) {
+		grafo->version -= grafo_huella_arista(arista);
+		grafo_desenlazar_arista(arista);
+	}
+	else {
+		arista = grafo_reservar_arista(grafo);
+		if(!arista) return false;
 
-	// Eliminamos, si existe, la arista vieja
-	grafo_destruir_arista(vi, vf);
+		arista->verticePartida = vi;
+		arista->verticeAdyacente = vf;
+		grafo->cantidadAristas++;
+	}
 
-	// Agregamos arista a la lista de adyacencia del vértice inicial
-	lista_insertar_ultimo(vi->listaDeAdyacencia, arista);
+	// Insertamos info en arista y la agregamos a las listas
+	arista->peso = peso;
+	grafo_enlazar_arista(arista);
+	grafo->version += grafo_huella_arista(arista);
 
 	return true;
 }
@@ -379,11 +1236,14 @@ bool grafo_crear_arista(grafo_t *grafo, grafo_dato_t di,
 bool grafo_eliminar_arista(grafo_t *grafo, grafo_dato_t di, 
 	grafo_dato_t df) {
 	// Obtenemos los vértices que contienen los datos
-	vertice_t *vi = grafo_obtener_vertice(grafo, di);
-	vertice_t *vf = grafo_obtener_vertice(grafo, df);
+	vertice_t *vi, *vf;
+	grafo_obtener_vertices_par(grafo, di, df, &vi, &vf);
 	if((!vi) || (!vf) || (vi == vf)) return false;
 
-	return grafo_destruir_arista(vi, vf);
+	if(!grafo_destruir_arista(grafo, vi, vf)) return false;
+	grafo->cantidadAristas--;
+
+	return true;
 }
 
 // Devuelve el peso de la arista que une a dos vértices.
@@ -399,6 +1259,17 @@ int grafo_obtener_peso_arista(grafo_t *grafo, grafo_dato_t di,
 	return arista->peso;
 }
 
+// Devuelve la versión de un grafo.
+// PRE: 'grafo' es un grafo existente.
+// POST: devuelve un número que identifica a los vértices y las aristas
+// (con sus pesos) del grafo: cambia al modificarlos, y dos estados con
+// los mismos vértices y aristas tienen la misma versión, aunque se hayan
+// creado en otro orden. Como es una huella de 64 bits, que dos estados
+// distintos compartan la versión es despreciablemente improbable.
+uint64_t grafo_obtener_version(grafo_t *grafo) {
+	return grafo->version;
+}
+
 // Devuelve la cantidad de vértices contenidos en un grafo.
 // PRE: 'grafo' es un grafo existente.
 // POST: devuelve un entero que representa la cantidad de vértices 
@@ -407,6 +1278,14 @@ int grafo_cantidad_vertices(grafo_t *grafo) {
 	return grafo->cantidadVertices;
 }
 
+// Devuelve la cantidad de aristas contenidas en un grafo.
+// PRE: 'grafo' es un grafo existente.
+// POST: devuelve un entero que representa la cantidad de aristas 
+// del grafo. Devuelve 0 si no hay aristas.
+int grafo_cantidad_aristas(grafo_t *grafo) {
+	return grafo->cantidadAristas;
+}
+
 // Verifica si dos vértices de un grafo son adyacentes.
 // PRE: 'grafo' es un grafo existente; 'di' es el dato vinculado al 
 // vértice de partida; 'df' es el dato vinculado al vértice destino.
@@ -438,3 +1317,66 @@ void grafo_obtener_vertices(grafo_t *grafo, grafo_dato_t *listaDeVertices) {
 	for(v = grafo->primerVertice; v; v = v->verticeSiguiente)
 		listaDeVertices[i++] = v->dato;
 }
+
+// Carga las aristas de un grafo, agrupadas por vértice de partida.
+// PRE: 'grafo' es un grafo existente; 'grados' es un arreglo del tamaño
+// de la cantidad de vértices del grafo; 'destinos' y 'pesos' son arreglos
+// del tamaño de la cantidad de aristas del grafo.
+// POST: los vértices se identifican por su posición en el arreglo que
+// carga grafo_obtener_vertices(). En 'grados' se almacenó la cantidad de
+// aristas que parten de cada vértice, y en 'destinos' y 'pesos' el vértice
+// destino y el peso de cada arista, primero las que parten del vértice 0,
+// luego las del vértice 1, y así sucesivamente.
+void grafo_obtener_aristas(grafo_t *grafo, int *grados, int *destinos,
+	int *pesos) {
+	vertice_t *v;
+	arista_t *arista;
+	int i = 0, j = 0;
+
+	// Numeramos los vértices según su posición en el grafo
+	for(v = grafo->primerVertice; v; v = v->verticeSiguiente)
+		v->indice = i++;
+
+	// Recorremos la lista de adyacencia de cada vértice
+	for(v = grafo->primerVertice, i = 0; v; v = v->verticeSiguiente, i++) {
+		grados[i] = v->gradoSalida;
+
+		for(arista = v->primeraSalida; arista;
+			arista = arista->salidaSiguiente) {
+			destinos[j] = arista->verticeAdyacente->indice;
+			pesos[j++] = arista->peso;
+		}
+	}
+}
+
+// Carga las aristas de un grafo, agrupadas por vértice destino.
+// PRE: 'grafo' es un grafo existente; 'grados' es un arreglo del tamaño
+// de la cantidad de vértices del grafo; 'partidas' y 'pesos' son arreglos
+// del tamaño de la cantidad de aristas del grafo.
+// POST: los vértices se identifican por su posición en el arreglo que
+// carga grafo_obtener_vertices(). En 'grados' se almacenó la cantidad de
+// aristas que llegan a cada vértice, y en 'partidas' y 'pesos' el vértice
+// de partida y el peso de cada arista, primero las que llegan al vértice
+// 0, luego las del vértice 1, y así sucesivamente. Equivale a cargar con
+// grafo_obtener_aristas() las aristas del grafo invertido.
+void grafo_obtener_aristas_entrantes(grafo_t *grafo, int *grados,
+	int *partidas, int *pesos) {
+	vertice_t *v;
+	arista_t *arista;
+	int i = 0, j = 0;
+
+	// Numeramos los vértices según su posición en el grafo
+	for(v = grafo->primerVertice; v; v = v->verticeSiguiente)
+		v->indice = i++;
+
+	// Recorremos la lista de entrada de cada vértice
+	for(v = grafo->primerVertice, i = 0; v; v = v->verticeSiguiente, i++) {
+		grados[i] = v->gradoEntrada;
+
+		for(arista = v->primeraEntrada; arista;
+			arista = arista->entradaSiguiente) {
+			partidas[j] = arista->verticePartida->indice;
+			pesos[j++] = arista->peso;
+		}
+	}
+}
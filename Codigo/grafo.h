@@ -15,6 +15,8 @@
 #define GRAFO_H
 
 #include <stdbool.h>
+#include <stdint.h>
+#include "hilos.h"
 
 
 
@@ -44,6 +46,23 @@ typedef struct _grafo_t grafo_t;
 // llevar a cabo la creación del mismo.
 grafo_t* grafo_crear();
 
+// Crea un grafo a partir de sus vértices y sus aristas.
+// PRE: 'datos' es un arreglo de 'vertices' datos distintos entre sí, a
+// vincular con los vértices; 'partidas', 'destinos' y 'pesos' son arreglos
+// de 'aristas' elementos, donde cada arista se describe por la posición
+// en 'datos' de su vértice de partida y de su vértice destino, y su peso;
+// 'hilos' es el conjunto de hilos que realiza la creación, o NULL para
+// realizarla sólo en el hilo actual.
+// POST: devuelve un grafo igual al que se obtiene al crear un grafo
+// vacío, agregarle los vértices en el orden de 'datos' y luego crear las
+// aristas, en orden, con grafo_crear_arista(): entre dos vértices
+// prevalece la última arista, y se ignoran las que van de un vértice a sí
+// mismo. El resultado no depende de la cantidad de hilos. Devuelve NULL
+// si no se ha podido llevar a cabo la creación.
+grafo_t* grafo_crear_masivo(const grafo_dato_t *datos, int vertices,
+	const int *partidas, const int *destinos, const int *pesos, int aristas,
+	hilos_t *hilos);
+
 // Destruye un grafo.
 // PRE: 'grafo' es un grafo existente.
 // POST: se eliminaron todos los vértices y aristas del grafo mas no
@@ -101,12 +120,27 @@ bool grafo_eliminar_arista(grafo_t *grafo, grafo_dato_t di,
 int grafo_obtener_peso_arista(grafo_t *grafo, grafo_dato_t di, 
 	grafo_dato_t df);
 
+// Devuelve la versión de un grafo.
+// PRE: 'grafo' es un grafo existente.
+// POST: devuelve un número que identifica a los vértices y las aristas
+// (con sus pesos) del grafo: cambia al modificarlos, y dos estados con
+// los mismos vértices y aristas tienen la misma versión, aunque se hayan
+// creado en otro orden. Como es una huella de 64 bits, que dos estados
+// distintos compartan la versión es despreciablemente improbable.
+uint64_t grafo_obtener_version(grafo_t *grafo);
+
 // Devuelve la cantidad de vértices contenidos en un grafo.
 // PRE: 'grafo' es un grafo existente.
 // POST: devuelve un entero que representa la cantidad de vértices 
 // del grafo. Devuelve 0 si no hay vértices.
 int grafo_cantidad_vertices(grafo_t *grafo);
 
+// Devuelve la cantidad de aristas contenidas en un grafo.
+// PRE: 'grafo' es un grafo existente.
+// POST: devuelve un entero que representa la cantidad de aristas 
+// del grafo. Devuelve 0 si no hay aristas.
+int grafo_cantidad_aristas(grafo_t *grafo);
+
 // Verifica si dos vértices de un grafo son adyacentes.
 // PRE: 'grafo' es un grafo existente; 'di' es el dato vinculado al 
 // vértice de partida; 'df' es el dato vinculado al vértice destino.
@@ -124,4 +158,29 @@ bool grafo_son_adyacentes(grafo_t *grafo, grafo_dato_t di,
 // existentes. Si no hay vértices, la lista será igual a NULL.
 void grafo_obtener_vertices(grafo_t *grafo, grafo_dato_t *listaDeVertices);
 
+// Carga las aristas de un grafo, agrupadas por vértice de partida.
+// PRE: 'grafo' es un grafo existente; 'grados' es un arreglo del tamaño
+// de la cantidad de vértices del grafo; 'destinos' y 'pesos' son arreglos
+// del tamaño de la cantidad de aristas del grafo.
+// POST: los vértices se identifican por su posición en el arreglo que
+// carga grafo_obtener_vertices(). En 'grados' se almacenó la cantidad de
+// aristas que parten de cada vértice, y en 'destinos' y 'pesos' el vértice
+// destino y el peso de cada arista, primero las que parten del vértice 0,
+// luego las del vértice 1, y así sucesivamente.
+void grafo_obtener_aristas(grafo_t *grafo, int *grados, int *destinos,
+	int *pesos);
+
+// Carga las aristas de un grafo, agrupadas por vértice destino.
+// PRE: 'grafo' es un grafo existente; 'grados' es un arreglo del tamaño
+// de la cantidad de vértices del grafo; 'partidas' y 'pesos' son arreglos
+// del tamaño de la cantidad de aristas del grafo.
+// POST: los vértices se identifican por su posición en el arreglo que
+// carga grafo_obtener_vertices(). En 'grados' se almacenó la cantidad de
+// aristas que llegan a cada vértice, y en 'partidas' y 'pesos' el vértice
+// de partida y el peso de cada arista, primero las que llegan al vértice
+// 0, luego las del vértice 1, y así sucesivamente. Equivale a cargar con
+// grafo_obtener_aristas() las aristas del grafo invertido.
+void grafo_obtener_aristas_entrantes(grafo_t *grafo, int *grados,
+	int *partidas, int *pesos);
+
 #endif
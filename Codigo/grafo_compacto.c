@@ -0,0 +1,504 @@
+/* ****************************************************************************
+ * ****************************************************************************
+ * TAD GRAFO COMPACTO
+ * ..................................................................
+ *
+ * Representación inmutable y compacta de un grafo ponderado, pensada para
+ * recorrerlo eficientemente. Los vértices se identifican por índices de 32
+ * bits y las aristas que parten de cada vértice se almacenan en forma
+ * contigua (formato CSR). Los pesos se almacenan en 16 bits si todos
+ * entran en ese rango, o en 32 bits en caso contrario, por lo que cada
+ * arista ocupa 6 u 8 bytes.
+ *
+ * ****************************************************************************
+ * ***************************************************************************/
+
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "grafo_compacto.h"
+#include "estadisticas.h"
+
+
+
+/* ****************************************************************************
+ * DEFINICIÓN DE LOS TIPOS DE DATOS
+ * ***************************************************************************/
+
+// Tipo que representa a un grafo compacto.
+struct _grafo_compacto_t {
+	uint32_t cantidadVertices;			// Cantidad de vértices del grafo
+	uint32_t cantidadAristas;			// Cantidad de aristas del grafo
+	uint32_t *inicio;					// Posición de la primera arista de
+										// cada vértice (más una posición
+										// final)
+	uint32_t *destinos;					// Vértice destino de cada arista
+	uint16_t *pesos16;					// Pesos, si entran en 16 bits
+	uint32_t *pesos32;					// Pesos, si no entran en 16 bits
+	grafo_dato_t *datos;				// Dato vinculado a cada vértice
+	uint32_t *tabla;					// Tabla de hash de datos a índices
+										// (índice + 1; 0 si está libre)
+	uint32_t mascara;					// Tamaño de la tabla menos uno
+	uint32_t *originales;				// Índice original de cada vértice,
+										// o NULL si no se renumeraron
+};
+
+
+
+/* ****************************************************************************
+ * FUNCIONES AUXILIARES
+ * ***************************************************************************/
+
+// Función de hash de los datos vinculados a los vértices.
+// PRE: 'dato' es un dato; 'mascara' es el tamaño de la tabla menos uno.
+// POST: devuelve la posición inicial de búsqueda en la tabla.
+static uint32_t grafo_compacto_hash(const grafo_dato_t dato, uint32_t mascara) {
+	uint64_t h = (uint64_t) (uintptr_t) dato * UINT64_C(0x9E3779B97F4A7C15);
+	return (uint32_t) (h >> 32) & mascara;
+}
+
+// Arma la tabla de hash que vincula los datos con los índices de sus
+// vértices.
+// PRE: 'grafo' es un grafo compacto con sus datos cargados.
+// POST: devuelve true si se armó la tabla o false si no hubo memoria.
+static bool grafo_compacto_armar_tabla(grafo_compacto_t *grafo) {
+	uint32_t tamanio = 2, v, i;
+
+	// Mantenemos la tabla a lo sumo medio llena
+	while(tamanio < 2 * (uint64_t) grafo->cantidadVertices) tamanio <<= 1;
+
+	grafo->tabla = (uint32_t*) estadisticas_malloc(SUBSISTEMA_GRAFO,
+		tamanio * sizeof(uint32_t));
+	if(!grafo->tabla) return false;
+
+	grafo->mascara = tamanio - 1;
+	for(i = 0; i < tamanio; i++) grafo->tabla[i] = 0;
+
+	// Insertamos cada dato con sondeo lineal
+	for(v = 0; v < grafo->cantidadVertices; v++) {
+		i = grafo_compacto_hash(grafo->datos[v], grafo->mascara);
+		while(grafo->tabla[i]) i = (i + 1) & grafo->mascara;
+		grafo->tabla[i] = v + 1;
+	}
+
+	return true;
+}
+
+// Compara dos claves de 64 bits, para qsort().
+static int grafo_compacto_comparar_claves(const void *a, const void *b) {
+	uint64_t x = *(const uint64_t*) a, y = *(const uint64_t*) b;
+	return (x > y) - (x < y);
+}
+
+// Numera los vértices por recorridos en anchura.
+// PRE: 'grafo' es un grafo compacto; 'secuencia' y 'posicion' son arreglos
+// de un elemento por vértice, con 'posicion' en GRAFO_COMPACTO_SIN_VERTICE;
+// 'inicios' es el orden en que se prueban los vértices para comenzar cada
+// recorrido, o NULL para probarlos por índice; 'claves' es un arreglo de
+// un elemento por vértice para ordenar los vecinos por grado, o NULL para
+// visitarlos en el orden de las aristas.
+// POST: se cargó en 'secuencia' los vértices en el orden en que se los
+// visitó y en 'posicion' la posición de cada uno en 'secuencia'.
+static void grafo_compacto_numerar_anchura(const grafo_compacto_t *grafo,
+	uint32_t *secuencia, uint32_t *posicion, const uint32_t *inicios,
+	uint64_t *claves) {
+	uint32_t n = grafo->cantidadVertices, i, j, s, u, v, e, k = 0, cabeza = 0;
+
+	for(i = 0; i < n; i++) {
+		s = inicios ? inicios[i] : i;
+		if(posicion[s] != GRAFO_COMPACTO_SIN_VERTICE) continue;
+
+		posicion[s] = k;
+		secuencia[k++] = s;
+
+		// La secuencia hace también de cola del recorrido
+		for(; cabeza < k; cabeza++) {
+			uint32_t primero = k;
+			u = secuencia[cabeza];
+
+			for(e = grafo->inicio[u]; e < grafo->inicio[u + 1]; e++) {
+				v = grafo->destinos[e];
+				if(posicion[v] != GRAFO_COMPACTO_SIN_VERTICE) continue;
+				posicion[v] = k;
+				secuencia[k++] = v;
+			}
+
+			if(!claves || k - primero < 2) continue;
+
+			// Ordenamos los vecinos recién alcanzados por grado y luego por
+			// índice
+			for(j = primero; j < k; j++) {
+				v = secuencia[j];
+				claves[j - primero] = (uint64_t) (grafo->inicio[v + 1] -
+					grafo->inicio[v]) << 32 | v;
+			}
+
+			qsort(claves, k - primero, sizeof(uint64_t),
+				grafo_compacto_comparar_claves);
+
+			for(j = primero; j < k; j++) {
+				secuencia[j] = (uint32_t) claves[j - primero];
+				posicion[secuencia[j]] = j;
+			}
+		}
+	}
+}
+
+// Numera los vértices por grado de salida decreciente.
+// PRE: 'grafo' es un grafo compacto; 'secuencia' y 'posicion' son arreglos
+// de un elemento por vértice; 'contadores' es un arreglo de un elemento
+// más que el mayor grado del grafo, en cero.
+// POST: se cargó en 'secuencia' los vértices de mayor a menor grado (y
+// ante igual grado, por índice) y en 'posicion' la posición de cada uno.
+static void grafo_compacto_numerar_grado(const grafo_compacto_t *grafo,
+	uint32_t *secuencia, uint32_t *posicion, uint32_t *contadores,
+	uint32_t mayor) {
+	uint32_t n = grafo->cantidadVertices, v, g, acumulado = 0;
+
+	for(v = 0; v < n; v++)
+		contadores[grafo->inicio[v + 1] - grafo->inicio[v]]++;
+
+	// Cada grado comienza después de los grados mayores
+	for(g = mayor + 1; g-- > 0; ) {
+		uint32_t cantidad = contadores[g];
+		contadores[g] = acumulado;
+		acumulado += cantidad;
+	}
+
+	for(v = 0; v < n; v++) {
+		posicion[v] = contadores[grafo->inicio[v + 1] - grafo->inicio[v]]++;
+		secuencia[posicion[v]] = v;
+	}
+}
+
+
+
+/* ****************************************************************************
+ * PRIMITIVAS DEL GRAFO COMPACTO
+ * ***************************************************************************/
+
+// Crea la representación compacta de un grafo.
+// PRE: 'grafo' es un grafo existente.
+// POST: devuelve un grafo compacto con los mismos vértices (en el orden
+// de grafo_obtener_vertices()) y las mismas aristas, o NULL si alguna
+// arista tiene peso negativo o no se ha podido llevar a cabo la creación
+// del mismo. El grafo original no
+// se modifica y puede destruirse sin afectar al grafo compacto.
+grafo_compacto_t* grafo_compacto_crear(grafo_t *grafo) {
+	uint32_t v, e;
+
+	grafo_compacto_t *gc = (grafo_compacto_t*) estadisticas_malloc(
+		SUBSISTEMA_GRAFO, sizeof(grafo_compacto_t));
+	if(!gc) return NULL;
+
+	gc->cantidadVertices = grafo_cantidad_vertices(grafo);
+	gc->cantidadAristas = grafo_cantidad_aristas(grafo);
+	gc->pesos16 = NULL;
+	gc->pesos32 = NULL;
+	gc->tabla = NULL;
+	gc->originales = NULL;
+
+	// Arreglos definitivos y auxiliares (en el formato del grafo original)
+	gc->inicio = (uint32_t*) estadisticas_malloc(SUBSISTEMA_GRAFO,
+		(gc->cantidadVertices + 1) * sizeof(uint32_t));
+	gc->destinos = (uint32_t*) estadisticas_malloc(SUBSISTEMA_GRAFO,
+		gc->cantidadAristas * sizeof(uint32_t));
+	gc->datos = (grafo_dato_t*) estadisticas_malloc(SUBSISTEMA_GRAFO,
+		gc->cantidadVertices * sizeof(grafo_dato_t));
+	int *grados = (int*) estadisticas_malloc(SUBSISTEMA_GRAFO,
+		gc->cantidadVertices * sizeof(int));
+	int *destinos = (int*) estadisticas_malloc(SUBSISTEMA_GRAFO,
+		gc->cantidadAristas * sizeof(int));
+	int *pesos = (int*) estadisticas_malloc(SUBSISTEMA_GRAFO,
+		gc->cantidadAristas * sizeof(int));
+
+	if(!gc->inicio || (gc->cantidadAristas && (!gc->destinos || !destinos
+		|| !pesos)) || (gc->cantidadVertices && (!gc->datos || !grados))) {
+		estadisticas_free(SUBSISTEMA_GRAFO, grados);
+		estadisticas_free(SUBSISTEMA_GRAFO, destinos);
+		estadisticas_free(SUBSISTEMA_GRAFO, pesos);
+		grafo_compacto_destruir(gc);
+		return NULL;
+	}
+
+	grafo_obtener_vertices(grafo, gc->datos);
+	grafo_obtener_aristas(grafo, grados, destinos, pesos);
+
+	// Acumulamos los grados para obtener el inicio de cada vértice
+	gc->inicio[0] = 0;
+	for(v = 0; v < gc->cantidadVertices; v++)
+		gc->inicio[v + 1] = gc->inicio[v] + grados[v];
+
+	// Elegimos el ancho de los pesos según el mayor de ellos. Los pesos
+	// negativos no pueden representarse
+	bool cortos = true, negativos = false;
+
+	for(e = 0; e < gc->cantidadAristas; e++) {
+		gc->destinos[e] = destinos[e];
+		if(pesos[e] > UINT16_MAX) cortos = false;
+		if(pesos[e] < 0) negativos = true;
+	}
+
+	if(negativos) {
+		estadisticas_free(SUBSISTEMA_GRAFO, grados);
+		estadisticas_free(SUBSISTEMA_GRAFO, destinos);
+		estadisticas_free(SUBSISTEMA_GRAFO, pesos);
+		grafo_compacto_destruir(gc);
+		return NULL;
+	}
+
+	if(cortos)
+		gc->pesos16 = (uint16_t*) estadisticas_malloc(SUBSISTEMA_GRAFO,
+			gc->cantidadAristas * sizeof(uint16_t));
+	else
+		gc->pesos32 = (uint32_t*) estadisticas_malloc(SUBSISTEMA_GRAFO,
+			gc->cantidadAristas * sizeof(uint32_t));
+
+	if(gc->pesos16)
+		for(e = 0; e < gc->cantidadAristas; e++)
+			gc->pesos16[e] = (uint16_t) pesos[e];
+	else if(gc->pesos32)
+		for(e = 0; e < gc->cantidadAristas; e++)
+			gc->pesos32[e] = (uint32_t) pesos[e];
+
+	estadisticas_free(SUBSISTEMA_GRAFO, grados);
+	estadisticas_free(SUBSISTEMA_GRAFO, destinos);
+	estadisticas_free(SUBSISTEMA_GRAFO, pesos);
+
+	if((gc->cantidadAristas && !gc->pesos16 && !gc->pesos32) ||
+		!grafo_compacto_armar_tabla(gc)) {
+		grafo_compacto_destruir(gc);
+		return NULL;
+	}
+
+	return gc;
+}
+
+// Destruye un grafo compacto.
+// PRE: 'grafo' es un grafo compacto existente.
+// POST: se liberó la memoria ocupada por el grafo, mas no así la de los
+// datos vinculados a sus vértices.
+void grafo_compacto_destruir(grafo_compacto_t *grafo) {
+	estadisticas_free(SUBSISTEMA_GRAFO, grafo->inicio);
+	estadisticas_free(SUBSISTEMA_GRAFO, grafo->destinos);
+	estadisticas_free(SUBSISTEMA_GRAFO, grafo->pesos16);
+	estadisticas_free(SUBSISTEMA_GRAFO, grafo->pesos32);
+	estadisticas_free(SUBSISTEMA_GRAFO, grafo->datos);
+	estadisticas_free(SUBSISTEMA_GRAFO, grafo->tabla);
+	estadisticas_free(SUBSISTEMA_GRAFO, grafo->originales);
+	estadisticas_free(SUBSISTEMA_GRAFO, grafo);
+}
+
+// Devuelve la cantidad de vértices de un grafo compacto.
+// PRE: 'grafo' es un grafo compacto existente.
+uint32_t grafo_compacto_cantidad_vertices(const grafo_compacto_t *grafo) {
+	return grafo->cantidadVertices;
+}
+
+// Devuelve la cantidad de aristas de un grafo compacto.
+// PRE: 'grafo' es un grafo compacto existente.
+uint32_t grafo_compacto_cantidad_aristas(const grafo_compacto_t *grafo) {
+	return grafo->cantidadAristas;
+}
+
+// Devuelve el dato vinculado a un vértice.
+// PRE: 'grafo' es un grafo compacto existente; 'v' es un índice menor a
+// la cantidad de vértices.
+grafo_dato_t grafo_compacto_obtener_dato(const grafo_compacto_t *grafo,
+	uint32_t v) {
+	return grafo->datos[v];
+}
+
+// Busca el índice del vértice vinculado a un dato.
+// PRE: 'grafo' es un grafo compacto existente; 'dato' es el dato a buscar.
+// POST: devuelve el índice del vértice o GRAFO_COMPACTO_SIN_VERTICE si
+// ningún vértice está vinculado a 'dato'.
+uint32_t grafo_compacto_buscar_vertice(const grafo_compacto_t *grafo,
+	const grafo_dato_t dato) {
+	uint32_t i = grafo_compacto_hash(dato, grafo->mascara);
+
+	while(grafo->tabla[i]) {
+		if(grafo->datos[grafo->tabla[i] - 1] == dato)
+			return grafo->tabla[i] - 1;
+		i = (i + 1) & grafo->mascara;
+	}
+
+	return GRAFO_COMPACTO_SIN_VERTICE;
+}
+
+// Renumera los vértices de un grafo compacto.
+// PRE: 'grafo' es un grafo compacto existente; 'orden' es el orden en el
+// que se numeran los vértices.
+// POST: devuelve true si se renumeraron los vértices, o false si no hubo
+// memoria suficiente (en cuyo caso el grafo no se modifica). Los datos,
+// las aristas y el orden de las aristas de cada vértice no cambian, sólo
+// los índices. Los recorridos parten del vértice 0 y de los que queden
+// sin alcanzar, siguiendo las aristas en su sentido; Cuthill-McKee
+// visita los vecinos de menor grado primero, comienza cada componente
+// por el vértice de menor grado y luego invierte el orden. La
+// renumeración depende sólo de la estructura del grafo y su numeración
+// anterior.
+bool grafo_compacto_reordenar(grafo_compacto_t *grafo,
+	grafo_compacto_orden_t orden) {
+	uint32_t n = grafo->cantidadVertices, m = grafo->cantidadAristas;
+	uint32_t v, k, e, u, mayor = 0, i;
+	bool ok;
+
+	if(orden == GRAFO_COMPACTO_ORDEN_ORIGINAL) return true;
+
+	for(v = 0; v < n; v++)
+		if(grafo->inicio[v + 1] - grafo->inicio[v] > mayor)
+			mayor = grafo->inicio[v + 1] - grafo->inicio[v];
+
+	// Arreglos de la numeración y del grafo renumerado
+	uint32_t *secuencia = (uint32_t*) estadisticas_malloc(SUBSISTEMA_GRAFO,
+		(n + 1) * sizeof(uint32_t));
+	uint32_t *posicion = (uint32_t*) estadisticas_malloc(SUBSISTEMA_GRAFO,
+		(n + 1) * sizeof(uint32_t));
+	uint32_t *auxiliar = (uint32_t*) estadisticas_malloc(SUBSISTEMA_GRAFO,
+		((orden == GRAFO_COMPACTO_ORDEN_GRADO ? mayor : n) + 1) *
+		sizeof(uint32_t));
+	uint64_t *claves = orden != GRAFO_COMPACTO_ORDEN_RCM ? NULL :
+		(uint64_t*) estadisticas_malloc(SUBSISTEMA_GRAFO,
+		(n + 1) * sizeof(uint64_t));
+	uint32_t *inicio = (uint32_t*) estadisticas_malloc(SUBSISTEMA_GRAFO,
+		(n + 1) * sizeof(uint32_t));
+	uint32_t *destinos = (uint32_t*) estadisticas_malloc(SUBSISTEMA_GRAFO,
+		(m + 1) * sizeof(uint32_t));
+	uint16_t *pesos16 = !grafo->pesos16 ? NULL :
+		(uint16_t*) estadisticas_malloc(SUBSISTEMA_GRAFO,
+		(m + 1) * sizeof(uint16_t));
+	uint32_t *pesos32 = !grafo->pesos32 ? NULL :
+		(uint32_t*) estadisticas_malloc(SUBSISTEMA_GRAFO,
+		(m + 1) * sizeof(uint32_t));
+	grafo_dato_t *datos = (grafo_dato_t*) estadisticas_malloc(
+		SUBSISTEMA_GRAFO, (n + 1) * sizeof(grafo_dato_t));
+	uint32_t *originales = (uint32_t*) estadisticas_malloc(SUBSISTEMA_GRAFO,
+		(n + 1) * sizeof(uint32_t));
+
+	ok = secuencia && posicion && auxiliar && inicio && destinos && datos &&
+		originales && (orden != GRAFO_COMPACTO_ORDEN_RCM || claves) &&
+		(!grafo->pesos16 || pesos16) && (!grafo->pesos32 || pesos32);
+
+	if(ok) {
+		if(orden == GRAFO_COMPACTO_ORDEN_GRADO) {
+			memset(auxiliar, 0, (mayor + 1) * sizeof(uint32_t));
+			grafo_compacto_numerar_grado(grafo, secuencia, posicion, auxiliar,
+				mayor);
+		}
+		else {
+			for(v = 0; v < n; v++) posicion[v] = GRAFO_COMPACTO_SIN_VERTICE;
+
+			// Cuthill-McKee comienza cada componente por el vértice de menor
+			// grado, por lo que se prueban en orden creciente de grado
+			if(orden == GRAFO_COMPACTO_ORDEN_RCM) {
+				for(v = 0; v < n; v++)
+					claves[v] = (uint64_t) (grafo->inicio[v + 1] -
+						grafo->inicio[v]) << 32 | v;
+				qsort(claves, n, sizeof(uint64_t),
+					grafo_compacto_comparar_claves);
+				for(v = 0; v < n; v++) auxiliar[v] = (uint32_t) claves[v];
+			}
+
+			grafo_compacto_numerar_anchura(grafo, secuencia, posicion,
+				orden == GRAFO_COMPACTO_ORDEN_RCM ? auxiliar : NULL, claves);
+
+			if(orden == GRAFO_COMPACTO_ORDEN_RCM)
+				for(k = 0; k < n; k++) {
+					v = secuencia[k];
+					posicion[v] = n - 1 - posicion[v];
+				}
+		}
+
+		// Copiamos cada vértice con sus aristas en su nueva posición,
+		// conservando el orden de sus aristas
+		inicio[0] = 0;
+
+		for(v = 0; v < n; v++) secuencia[posicion[v]] = v;
+
+		for(k = 0; k < n; k++) {
+			u = secuencia[k];
+			inicio[k + 1] = inicio[k];
+
+			for(e = grafo->inicio[u]; e < grafo->inicio[u + 1]; e++) {
+				destinos[inicio[k + 1]] = posicion[grafo->destinos[e]];
+				if(pesos16) pesos16[inicio[k + 1]] = grafo->pesos16[e];
+				else pesos32[inicio[k + 1]] = grafo->pesos32[e];
+				inicio[k + 1]++;
+			}
+
+			datos[k] = grafo->datos[u];
+			originales[k] = grafo->originales ? grafo->originales[u] : u;
+		}
+
+		// Los datos no cambian, por lo que la tabla de hash conserva sus
+		// posiciones y sólo se actualizan los índices
+		for(i = 0; i <= grafo->mascara; i++)
+			if(grafo->tabla[i])
+				grafo->tabla[i] = posicion[grafo->tabla[i] - 1] + 1;
+
+		estadisticas_free(SUBSISTEMA_GRAFO, grafo->inicio);
+		estadisticas_free(SUBSISTEMA_GRAFO, grafo->destinos);
+		estadisticas_free(SUBSISTEMA_GRAFO, grafo->pesos16);
+		estadisticas_free(SUBSISTEMA_GRAFO, grafo->pesos32);
+		estadisticas_free(SUBSISTEMA_GRAFO, grafo->datos);
+		estadisticas_free(SUBSISTEMA_GRAFO, grafo->originales);
+
+		grafo->inicio = inicio;
+		grafo->destinos = destinos;
+		grafo->pesos16 = pesos16;
+		grafo->pesos32 = pesos32;
+		grafo->datos = datos;
+		grafo->originales = originales;
+	}
+	else {
+		estadisticas_free(SUBSISTEMA_GRAFO, inicio);
+		estadisticas_free(SUBSISTEMA_GRAFO, destinos);
+		estadisticas_free(SUBSISTEMA_GRAFO, pesos16);
+		estadisticas_free(SUBSISTEMA_GRAFO, pesos32);
+		estadisticas_free(SUBSISTEMA_GRAFO, datos);
+		estadisticas_free(SUBSISTEMA_GRAFO, originales);
+	}
+
+	estadisticas_free(SUBSISTEMA_GRAFO, secuencia);
+	estadisticas_free(SUBSISTEMA_GRAFO, posicion);
+	estadisticas_free(SUBSISTEMA_GRAFO, auxiliar);
+	estadisticas_free(SUBSISTEMA_GRAFO, claves);
+
+	return ok;
+}
+
+// Devuelve el índice que tenía un vértice antes de renumerarlo.
+// PRE: 'grafo' es un grafo compacto existente; 'v' es un índice menor a
+// la cantidad de vértices.
+// POST: devuelve la posición del vértice en el orden de
+// grafo_obtener_vertices() del grafo original.
+uint32_t grafo_compacto_indice_original(const grafo_compacto_t *grafo,
+	uint32_t v) {
+	return grafo->originales ? grafo->originales[v] : v;
+}
+
+// Indica si los pesos de un grafo compacto se almacenan en 16 bits.
+// PRE: 'grafo' es un grafo compacto existente.
+// POST: devuelve true si los pesos ocupan 16 bits o false si ocupan 32.
+bool grafo_compacto_pesos_cortos(const grafo_compacto_t *grafo) {
+	return grafo->pesos32 == NULL;
+}
+
+// Devuelve los arreglos internos del grafo compacto, para que los
+// algoritmos puedan recorrerlo sin llamar a una función por arista.
+// PRE: 'grafo' es un grafo compacto existente.
+// POST: las aristas que parten del vértice v ocupan las posiciones
+// [inicio[v], inicio[v + 1]) de 'destinos' y de los pesos, donde
+// 'inicio' tiene un elemento más que la cantidad de vértices. Se cargó
+// en 'pesos16' el arreglo de pesos si estos ocupan 16 bits o en 'pesos32'
+// si ocupan 32, dejando el otro en NULL.
+void grafo_compacto_obtener_arreglos(const grafo_compacto_t *grafo,
+	const uint32_t **inicio, const uint32_t **destinos,
+	const uint16_t **pesos16, const uint32_t **pesos32) {
+	*inicio = grafo->inicio;
+	*destinos = grafo->destinos;
+	*pesos16 = grafo->pesos16;
+	*pesos32 = grafo->pesos32;
+}
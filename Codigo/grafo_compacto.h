@@ -0,0 +1,130 @@
+/* ****************************************************************************
+ * ****************************************************************************
+ * TAD GRAFO COMPACTO
+ * ..................................................................
+ *
+ * Representación inmutable y compacta de un grafo ponderado, pensada para
+ * recorrerlo eficientemente. Los vértices se identifican por índices de 32
+ * bits y las aristas que parten de cada vértice se almacenan en forma
+ * contigua (formato CSR). Los pesos se almacenan en 16 bits si todos
+ * entran en ese rango, o en 32 bits en caso contrario, por lo que cada
+ * arista ocupa 6 u 8 bytes.
+ *
+ * Los vértices pueden renumerarse para que los vecinos queden cerca en
+ * memoria (por recorrido en anchura, Cuthill-McKee inverso o grado), lo
+ * que reduce los fallos de caché y de TLB al recorrer grafos grandes.
+ *
+ * ****************************************************************************
+ * ***************************************************************************/
+
+
+#ifndef GRAFO_COMPACTO_H
+#define GRAFO_COMPACTO_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "grafo.h"
+
+
+
+/* ****************************************************************************
+ * DECLARACIÓN DE LOS TIPOS DE DATOS
+ * ***************************************************************************/
+
+typedef struct _grafo_compacto_t grafo_compacto_t;
+
+// Índice que indica la ausencia de un vértice
+#define GRAFO_COMPACTO_SIN_VERTICE UINT32_MAX
+
+// Órdenes en los que se pueden numerar los vértices.
+typedef enum {
+	GRAFO_COMPACTO_ORDEN_ORIGINAL,		// El de grafo_obtener_vertices()
+	GRAFO_COMPACTO_ORDEN_ANCHURA,		// Recorrido en anchura
+	GRAFO_COMPACTO_ORDEN_RCM,			// Cuthill-McKee inverso
+	GRAFO_COMPACTO_ORDEN_GRADO			// Grado de salida decreciente
+} grafo_compacto_orden_t;
+
+
+
+/* ****************************************************************************
+ * PRIMITIVAS DEL GRAFO COMPACTO
+ * ***************************************************************************/
+
+// Crea la representación compacta de un grafo.
+// PRE: 'grafo' es un grafo existente.
+// POST: devuelve un grafo compacto con los mismos vértices (en el orden
+// de grafo_obtener_vertices(), hasta que se los renumere con
+// grafo_compacto_reordenar()) y las mismas aristas, o NULL si alguna
+// arista tiene peso negativo o no se ha podido llevar a cabo la creación
+// del mismo. El grafo original no
+// se modifica y puede destruirse sin afectar al grafo compacto.
+grafo_compacto_t* grafo_compacto_crear(grafo_t *grafo);
+
+// Destruye un grafo compacto.
+// PRE: 'grafo' es un grafo compacto existente.
+// POST: se liberó la memoria ocupada por el grafo, mas no así la de los
+// datos vinculados a sus vértices.
+void grafo_compacto_destruir(grafo_compacto_t *grafo);
+
+// Devuelve la cantidad de vértices de un grafo compacto.
+// PRE: 'grafo' es un grafo compacto existente.
+uint32_t grafo_compacto_cantidad_vertices(const grafo_compacto_t *grafo);
+
+// Devuelve la cantidad de aristas de un grafo compacto.
+// PRE: 'grafo' es un grafo compacto existente.
+uint32_t grafo_compacto_cantidad_aristas(const grafo_compacto_t *grafo);
+
+// Devuelve el dato vinculado a un vértice.
+// PRE: 'grafo' es un grafo compacto existente; 'v' es un índice menor a
+// la cantidad de vértices.
+grafo_dato_t grafo_compacto_obtener_dato(const grafo_compacto_t *grafo,
+	uint32_t v);
+
+// Busca el índice del vértice vinculado a un dato.
+// PRE: 'grafo' es un grafo compacto existente; 'dato' es el dato a buscar.
+// POST: devuelve el índice del vértice o GRAFO_COMPACTO_SIN_VERTICE si
+// ningún vértice está vinculado a 'dato'.
+uint32_t grafo_compacto_buscar_vertice(const grafo_compacto_t *grafo,
+	const grafo_dato_t dato);
+
+// Renumera los vértices de un grafo compacto.
+// PRE: 'grafo' es un grafo compacto existente; 'orden' es el orden en el
+// que se numeran los vértices.
+// POST: devuelve true si se renumeraron los vértices, o false si no hubo
+// memoria suficiente (en cuyo caso el grafo no se modifica). Los datos,
+// las aristas y el orden de las aristas de cada vértice no cambian, sólo
+// los índices. Los recorridos parten del vértice 0 y de los que queden
+// sin alcanzar, siguiendo las aristas en su sentido; Cuthill-McKee
+// visita los vecinos de menor grado primero, comienza cada componente
+// por el vértice de menor grado y luego invierte el orden. La
+// renumeración depende sólo de la estructura del grafo y su numeración
+// anterior.
+bool grafo_compacto_reordenar(grafo_compacto_t *grafo,
+	grafo_compacto_orden_t orden);
+
+// Devuelve el índice que tenía un vértice antes de renumerarlo.
+// PRE: 'grafo' es un grafo compacto existente; 'v' es un índice menor a
+// la cantidad de vértices.
+// POST: devuelve la posición del vértice en el orden de
+// grafo_obtener_vertices() del grafo original.
+uint32_t grafo_compacto_indice_original(const grafo_compacto_t *grafo,
+	uint32_t v);
+
+// Indica si los pesos de un grafo compacto se almacenan en 16 bits.
+// PRE: 'grafo' es un grafo compacto existente.
+// POST: devuelve true si los pesos ocupan 16 bits o false si ocupan 32.
+bool grafo_compacto_pesos_cortos(const grafo_compacto_t *grafo);
+
+// Devuelve los arreglos internos del grafo compacto, para que los
+// algoritmos puedan recorrerlo sin llamar a una función por arista.
+// PRE: 'grafo' es un grafo compacto existente.
+// POST: las aristas que parten del vértice v ocupan las posiciones
+// [inicio[v], inicio[v + 1]) de 'destinos' y de los pesos, donde
+// 'inicio' tiene un elemento más que la cantidad de vértices. Se cargó
+// en 'pesos16' el arreglo de pesos si estos ocupan 16 bits o en 'pesos32'
+// si ocupan 32, dejando el otro en NULL.
+void grafo_compacto_obtener_arreglos(const grafo_compacto_t *grafo,
+	const uint32_t **inicio, const uint32_t **destinos,
+	const uint16_t **pesos16, const uint32_t **pesos32);
+
+#endif
@@ -0,0 +1,331 @@
+/* ****************************************************************************
+ * ****************************************************************************
+ * TAD CONJUNTO DE HILOS
+ * ..................................................................
+ *
+ * Implementación de un conjunto fijo de hilos de trabajo que ejecutan
+ * en paralelo una misma tarea, cada uno con su número de hilo. Los hilos
+ * se crean una única vez y esperan entre tarea y tarea, por lo que
+ * lanzar una tarea no tiene el costo de crear hilos. El hilo que lanza
+ * la tarea participa de ella como hilo número 0.
+ *
+ * Además, los hilos pueden repartirse un conjunto de elementos
+ * independientes por robo de trabajo: cada hilo comienza con una porción
+ * contigua de los elementos y, al agotarla, le quita la mitad de lo que
+ * le queda a otro hilo, de modo que los elementos costosos no dejen
+ * hilos ociosos.
+ *
+ * ****************************************************************************
+ * ***************************************************************************/
+
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include "hilos.h"
+#include "estadisticas.h"
+
+
+
+/* ****************************************************************************
+ * DEFINICIÓN DE LOS TIPOS DE DATOS
+ * ***************************************************************************/
+
+// Tipo que representa la porción de elementos pendientes de un hilo. El
+// dueño toma elementos del comienzo y los demás roban del final.
+typedef struct {
+	pthread_mutex_t mutex;				// Protege la porción
+	size_t inicio;						// Primer elemento pendiente
+	size_t fin;							// Elemento siguiente al último
+	char relleno[64];					// Separa las porciones en líneas
+										// de caché distintas
+} hilos_porcion_t;
+
+// Tipo que representa un conjunto de hilos.
+struct _hilos_t {
+	pthread_t *hilos;					// Hilos de trabajo (todos menos el
+										// número 0)
+	size_t cantidad;					// Cantidad de hilos por tarea
+	pthread_mutex_t mutex;				// Protege los campos siguientes
+	pthread_cond_t hay_tarea;			// Señala una tarea nueva
+	pthread_cond_t tarea_terminada;		// Señala el fin de una tarea
+	hilos_tarea_t tarea;				// Tarea en curso
+	void *contexto;						// Contexto de la tarea en curso
+	unsigned long generacion;			// Cantidad de tareas lanzadas
+	size_t pendientes;					// Hilos que no terminaron la tarea
+	bool terminar;						// Indica a los hilos que finalicen
+	hilos_porcion_t *porciones;			// Porción de cada hilo al repartir
+										// elementos
+};
+
+// Tipo que representa el contexto de un reparto de elementos.
+typedef struct {
+	hilos_t *hilos;						// Conjunto que reparte
+	hilos_elemento_t tarea;				// Tarea de cada elemento
+	void *contexto;						// Contexto de la tarea
+} hilos_reparto_t;
+
+// Tipo que representa los parámetros de un hilo de trabajo.
+typedef struct {
+	hilos_t *hilos;						// Conjunto al que pertenece
+	size_t numero;						// Número del hilo
+} hilos_trabajador_t;
+
+
+
+/* ****************************************************************************
+ * FUNCIONES AUXILIARES
+ * ***************************************************************************/
+
+// Función que ejecuta cada hilo de trabajo: espera una tarea, la ejecuta
+// y avisa que terminó, hasta que se le indique finalizar.
+// PRE: 'parametros' es un hilos_trabajador_t creado para este hilo.
+static void* hilos_trabajar(void *parametros) {
+	hilos_trabajador_t trabajador = *(hilos_trabajador_t*) parametros;
+	hilos_t *hilos = trabajador.hilos;
+	unsigned long vista = 0;
+
+	estadisticas_free(SUBSISTEMA_HILOS, parametros);
+
+	pthread_mutex_lock(&hilos->mutex);
+
+	while(true) {
+		while(!hilos->terminar && hilos->generacion == vista)
+			pthread_cond_wait(&hilos->hay_tarea, &hilos->mutex);
+		if(hilos->terminar) break;
+
+		vista = hilos->generacion;
+		hilos_tarea_t tarea = hilos->tarea;
+		void *contexto = hilos->contexto;
+		pthread_mutex_unlock(&hilos->mutex);
+
+		tarea(trabajador.numero, contexto);
+
+		pthread_mutex_lock(&hilos->mutex);
+		if(!--hilos->pendientes)
+			pthread_cond_signal(&hilos->tarea_terminada);
+	}
+
+	pthread_mutex_unlock(&hilos->mutex);
+	return NULL;
+}
+
+// Finaliza los primeros hilos de trabajo de un conjunto.
+// PRE: 'hilos' es un conjunto cuyos hilos 1 a 'creados' están en espera.
+// POST: los hilos finalizaron.
+static void hilos_finalizar(hilos_t *hilos, size_t creados) {
+	size_t i;
+
+	pthread_mutex_lock(&hilos->mutex);
+	hilos->terminar = true;
+	pthread_cond_broadcast(&hilos->hay_tarea);
+	pthread_mutex_unlock(&hilos->mutex);
+
+	for(i = 0; i < creados; i++) pthread_join(hilos->hilos[i], NULL);
+}
+
+// Toma el próximo elemento de la porción de un hilo.
+// PRE: 'porcion' es la porción del hilo; 'elemento' recibe el elemento.
+// POST: devuelve false si la porción estaba vacía.
+static bool hilos_tomar(hilos_porcion_t *porcion, size_t *elemento) {
+	bool tomado;
+
+	pthread_mutex_lock(&porcion->mutex);
+	tomado = porcion->inicio < porcion->fin;
+	if(tomado) *elemento = porcion->inicio++;
+	pthread_mutex_unlock(&porcion->mutex);
+
+	return tomado;
+}
+
+// Roba la mitad de los elementos pendientes de algún otro hilo y los
+// ubica en la porción de un hilo.
+// PRE: 'hilos' es un conjunto que está repartiendo elementos; 'hilo' es
+// el número del hilo que roba, cuya porción está vacía.
+// POST: devuelve false si ningún otro hilo tenía elementos pendientes.
+static bool hilos_robar(hilos_t *hilos, size_t hilo) {
+	size_t i, mitad, fin;
+
+	for(i = 1; i < hilos->cantidad; i++) {
+		hilos_porcion_t *victima = &hilos->porciones[(hilo + i) %
+			hilos->cantidad];
+
+		pthread_mutex_lock(&victima->mutex);
+		fin = victima->fin;
+		mitad = (fin - victima->inicio + 1) / 2;
+		victima->fin -= mitad;
+		pthread_mutex_unlock(&victima->mutex);
+
+		if(!mitad) continue;
+
+		hilos_porcion_t *propia = &hilos->porciones[hilo];
+		pthread_mutex_lock(&propia->mutex);
+		propia->inicio = fin - mitad;
+		propia->fin = fin;
+		pthread_mutex_unlock(&propia->mutex);
+		return true;
+	}
+
+	return false;
+}
+
+// Tarea que ejecuta cada hilo al repartir elementos: procesa los de su
+// porción y luego roba a los demás hasta que no quedan pendientes.
+// PRE: 'contexto' es el reparto (hilos_reparto_t).
+static void hilos_procesar_porciones(size_t hilo, void *contexto) {
+	hilos_reparto_t *reparto = (hilos_reparto_t*) contexto;
+	hilos_porcion_t *porcion = &reparto->hilos->porciones[hilo];
+	size_t elemento;
+
+	do {
+		while(hilos_tomar(porcion, &elemento))
+			reparto->tarea(hilo, elemento, reparto->contexto);
+	} while(hilos_robar(reparto->hilos, hilo));
+}
+
+
+
+/* ****************************************************************************
+ * PRIMITIVAS DEL CONJUNTO DE HILOS
+ * ***************************************************************************/
+
+// Crea un conjunto de hilos.
+// PRE: 'cantidad' es la cantidad de hilos que ejecutan cada tarea,
+// incluyendo al que la lanza (si es 0 se usa 1).
+// POST: devuelve un nuevo conjunto de hilos en espera o NULL si no se ha
+// podido llevar a cabo la creación del mismo.
+hilos_t* hilos_crear(size_t cantidad) {
+	size_t i;
+
+	hilos_t *hilos = (hilos_t*) estadisticas_malloc(SUBSISTEMA_HILOS,
+		sizeof(hilos_t));
+	if(!hilos) return NULL;
+
+	hilos->cantidad = cantidad ? cantidad : 1;
+	hilos->hilos = (pthread_t*) estadisticas_malloc(SUBSISTEMA_HILOS,
+		hilos->cantidad * sizeof(pthread_t));
+	hilos->porciones = (hilos_porcion_t*) estadisticas_malloc(
+		SUBSISTEMA_HILOS, hilos->cantidad * sizeof(hilos_porcion_t));
+	if(!hilos->hilos || !hilos->porciones) {
+		estadisticas_free(SUBSISTEMA_HILOS, hilos->hilos);
+		estadisticas_free(SUBSISTEMA_HILOS, hilos->porciones);
+		estadisticas_free(SUBSISTEMA_HILOS, hilos);
+		return NULL;
+	}
+
+	for(i = 0; i < hilos->cantidad; i++)
+		pthread_mutex_init(&hilos->porciones[i].mutex, NULL);
+
+	pthread_mutex_init(&hilos->mutex, NULL);
+	pthread_cond_init(&hilos->hay_tarea, NULL);
+	pthread_cond_init(&hilos->tarea_terminada, NULL);
+	hilos->generacion = 0;
+	hilos->pendientes = 0;
+	hilos->terminar = false;
+
+	// Creamos los hilos de trabajo; el número 0 es quien lanza las tareas
+	for(i = 1; i < hilos->cantidad; i++) {
+		hilos_trabajador_t *trabajador = (hilos_trabajador_t*)
+			estadisticas_malloc(SUBSISTEMA_HILOS, sizeof(hilos_trabajador_t));
+
+		if(trabajador) {
+			trabajador->hilos = hilos;
+			trabajador->numero = i;
+		}
+
+		if(!trabajador || pthread_create(&hilos->hilos[i - 1], NULL,
+			hilos_trabajar, trabajador)) {
+			estadisticas_free(SUBSISTEMA_HILOS, trabajador);
+			hilos_finalizar(hilos, i - 1);
+			while(hilos->cantidad > 1) {
+				hilos->cantidad--;
+				pthread_mutex_destroy(
+					&hilos->porciones[hilos->cantidad].mutex);
+			}
+			hilos_destruir(hilos);
+			return NULL;
+		}
+	}
+
+	return hilos;
+}
+
+// Destruye un conjunto de hilos.
+// PRE: 'hilos' es un conjunto existente que no está ejecutando una tarea.
+// POST: se finalizaron los hilos y se liberó la memoria utilizada.
+void hilos_destruir(hilos_t *hilos) {
+	size_t i;
+
+	hilos_finalizar(hilos, hilos->cantidad - 1);
+
+	for(i = 0; i < hilos->cantidad; i++)
+		pthread_mutex_destroy(&hilos->porciones[i].mutex);
+
+	pthread_mutex_destroy(&hilos->mutex);
+	pthread_cond_destroy(&hilos->hay_tarea);
+	pthread_cond_destroy(&hilos->tarea_terminada);
+	estadisticas_free(SUBSISTEMA_HILOS, hilos->hilos);
+	estadisticas_free(SUBSISTEMA_HILOS, hilos->porciones);
+	estadisticas_free(SUBSISTEMA_HILOS, hilos);
+}
+
+// Devuelve la cantidad de hilos que ejecutan cada tarea.
+// PRE: 'hilos' es un conjunto existente.
+size_t hilos_cantidad(const hilos_t *hilos) {
+	return hilos->cantidad;
+}
+
+// Ejecuta una tarea en todos los hilos y espera a que terminen.
+// PRE: 'hilos' es un conjunto existente; 'tarea' es la tarea a ejecutar
+// y 'contexto' el dato que recibe.
+// POST: cada hilo ejecutó tarea(hilo, contexto) una vez. Las escrituras
+// realizadas por la tarea son visibles al retornar.
+void hilos_ejecutar(hilos_t *hilos, hilos_tarea_t tarea, void *contexto) {
+	// Con un único hilo no hace falta sincronizar
+	if(hilos->cantidad == 1) {
+		tarea(0, contexto);
+		return;
+	}
+
+	pthread_mutex_lock(&hilos->mutex);
+	hilos->tarea = tarea;
+	hilos->contexto = contexto;
+	hilos->pendientes = hilos->cantidad - 1;
+	hilos->generacion++;
+	pthread_cond_broadcast(&hilos->hay_tarea);
+	pthread_mutex_unlock(&hilos->mutex);
+
+	// El hilo que lanza la tarea también la ejecuta
+	tarea(0, contexto);
+
+	pthread_mutex_lock(&hilos->mutex);
+	while(hilos->pendientes)
+		pthread_cond_wait(&hilos->tarea_terminada, &hilos->mutex);
+	pthread_mutex_unlock(&hilos->mutex);
+}
+
+// Procesa un conjunto de elementos repartiéndolos entre los hilos por robo
+// de trabajo, y espera a que terminen.
+// PRE: 'hilos' es un conjunto existente; 'cantidad' es la cantidad de
+// elementos; 'tarea' es la tarea que procesa cada elemento y 'contexto'
+// el dato que recibe.
+// POST: se ejecutó tarea(hilo, elemento, contexto) una vez por cada
+// elemento de 0 a 'cantidad' - 1. Cada hilo procesa sus elementos en
+// orden creciente dentro de cada porción que toma, pero no hay un orden
+// entre hilos. Las escrituras realizadas por la tarea son visibles al
+// retornar.
+void hilos_repartir(hilos_t *hilos, size_t cantidad, hilos_elemento_t tarea,
+	void *contexto) {
+	hilos_reparto_t reparto = { hilos, tarea, contexto };
+	size_t i;
+
+	// Cada hilo comienza con una porción contigua de igual tamaño
+	for(i = 0; i < hilos->cantidad; i++) {
+		hilos->porciones[i].inicio = cantidad * i / hilos->cantidad;
+		hilos->porciones[i].fin = cantidad * (i + 1) / hilos->cantidad;
+	}
+
+	hilos_ejecutar(hilos, hilos_procesar_porciones, &reparto);
+}
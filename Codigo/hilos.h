@@ -0,0 +1,86 @@
+/* ****************************************************************************
+ * ****************************************************************************
+ * TAD CONJUNTO DE HILOS
+ * ..................................................................
+ *
+ * Implementación de un conjunto fijo de hilos de trabajo que ejecutan
+ * en paralelo una misma tarea, cada uno con su número de hilo. Los hilos
+ * se crean una única vez y esperan entre tarea y tarea, por lo que
+ * lanzar una tarea no tiene el costo de crear hilos. El hilo que lanza
+ * la tarea participa de ella como hilo número 0.
+ *
+ * Además, los hilos pueden repartirse un conjunto de elementos
+ * independientes por robo de trabajo: cada hilo comienza con una porción
+ * contigua de los elementos y, al agotarla, le quita la mitad de lo que
+ * le queda a otro hilo, de modo que los elementos costosos no dejen
+ * hilos ociosos.
+ *
+ * ****************************************************************************
+ * ***************************************************************************/
+
+
+#ifndef HILOS_H
+#define HILOS_H
+
+#include <stddef.h>
+
+
+
+/* ****************************************************************************
+ * DECLARACIÓN DE LOS TIPOS DE DATOS
+ * ***************************************************************************/
+
+typedef struct _hilos_t hilos_t;
+
+// Tipo de las tareas que ejecutan los hilos. Reciben el número de hilo
+// (de 0 a la cantidad de hilos menos uno) y el contexto de la tarea.
+typedef void (*hilos_tarea_t)(size_t hilo, void *contexto);
+
+// Tipo de las tareas que se reparten por elementos. Reciben el número de
+// hilo, el número de elemento a procesar y el contexto de la tarea.
+typedef void (*hilos_elemento_t)(size_t hilo, size_t elemento,
+	void *contexto);
+
+
+
+/* ****************************************************************************
+ * PRIMITIVAS DEL CONJUNTO DE HILOS
+ * ***************************************************************************/
+
+// Crea un conjunto de hilos.
+// PRE: 'cantidad' es la cantidad de hilos que ejecutan cada tarea,
+// incluyendo al que la lanza (si es 0 se usa 1).
+// POST: devuelve un nuevo conjunto de hilos en espera o NULL si no se ha
+// podido llevar a cabo la creación del mismo.
+hilos_t* hilos_crear(size_t cantidad);
+
+// Destruye un conjunto de hilos.
+// PRE: 'hilos' es un conjunto existente que no está ejecutando una tarea.
+// POST: se finalizaron los hilos y se liberó la memoria utilizada.
+void hilos_destruir(hilos_t *hilos);
+
+// Devuelve la cantidad de hilos que ejecutan cada tarea.
+// PRE: 'hilos' es un conjunto existente.
+size_t hilos_cantidad(const hilos_t *hilos);
+
+// Ejecuta una tarea en todos los hilos y espera a que terminen.
+// PRE: 'hilos' es un conjunto existente; 'tarea' es la tarea a ejecutar
+// y 'contexto' el dato que recibe.
+// POST: cada hilo ejecutó tarea(hilo, contexto) una vez. Las escrituras
+// realizadas por la tarea son visibles al retornar.
+void hilos_ejecutar(hilos_t *hilos, hilos_tarea_t tarea, void *contexto);
+
+// Procesa un conjunto de elementos repartiéndolos entre los hilos por robo
+// de trabajo, y espera a que terminen.
+// PRE: 'hilos' es un conjunto existente; 'cantidad' es la cantidad de
+// elementos; 'tarea' es la tarea que procesa cada elemento y 'contexto'
+// el dato que recibe.
+// POST: se ejecutó tarea(hilo, elemento, contexto) una vez por cada
+// elemento de 0 a 'cantidad' - 1. Cada hilo procesa sus elementos en
+// orden creciente dentro de cada porción que toma, pero no hay un orden
+// entre hilos. Las escrituras realizadas por la tarea son visibles al
+// retornar.
+void hilos_repartir(hilos_t *hilos, size_t cantidad, hilos_elemento_t tarea,
+	void *contexto);
+
+#endif
@@ -0,0 +1,320 @@
+/* ****************************************************************************
+ * ****************************************************************************
+ * DIRECCIONES IP - LIBRERÍA DE FUNCIONES
+ * ****************************************************************************
+ * ****************************************************************************
+ *
+ * Librería de funciones para representar direcciones IPv4 e IPv6 en forma
+ * binaria: una dirección IPv4 ocupa un entero de 32 bits y una IPv6 un
+ * arreglo de 16 bytes. Incluye un parser que valida el texto de las
+ * direcciones y un formateador que las convierte nuevamente a texto en
+ * su forma canónica.
+ */
+
+
+#include <string.h>
+#include "ip.h"
+
+
+
+/* ****************************************************************************
+ * CONSTANTES
+ * ***************************************************************************/
+
+// Valor de cada dígito hexadecimal más uno (0 para los demás caracteres)
+static const uint8_t VALOR_HEX[256] = {
+	['0'] = 1, ['1'] = 2, ['2'] = 3, ['3'] = 4, ['4'] = 5,
+	['5'] = 6, ['6'] = 7, ['7'] = 8, ['8'] = 9, ['9'] = 10,
+	['a'] = 11, ['b'] = 12, ['c'] = 13, ['d'] = 14, ['e'] = 15, ['f'] = 16,
+	['A'] = 11, ['B'] = 12, ['C'] = 13, ['D'] = 14, ['E'] = 15, ['F'] = 16
+};
+
+// Dígitos hexadecimales
+static const char DIGITOS_HEX[] = "0123456789abcdef";
+
+// Texto de los números de 00 a 99, de a dos caracteres
+static const char PARES[] =
+	"00010203040506070809101112131415161718192021222324"
+	"25262728293031323334353637383940414243444546474849"
+	"50515253545556575859606162636465666768697071727374"
+	"75767778798081828384858687888990919293949596979899";
+
+
+
+/* ****************************************************************************
+ * FUNCIONES AUXILIARES
+ * ***************************************************************************/
+
+// Indica si un caracter es un dígito decimal.
+static bool ip_es_digito(char c) {
+	return c >= '0' && c <= '9';
+}
+
+// Interpreta el texto de una dirección IPv4.
+// PRE: 'texto' es un arreglo de 'largo' caracteres; 'valor' recibe el
+// resultado.
+// POST: devuelve true si el texto es una dirección IPv4 válida.
+static bool ip_parsear_v4(const char *texto, size_t largo, uint32_t *valor) {
+	uint32_t v = 0, octeto;
+	size_t i = 0, inicio;
+	int partes;
+
+	for(partes = 0; partes < 4; partes++) {
+		// Los octetos se separan por puntos
+		if(partes) {
+			if(i == largo || texto[i] != '.') return false;
+			i++;
+		}
+
+		// Leemos hasta tres dígitos
+		for(inicio = i, octeto = 0; i < largo && i - inicio < 3 &&
+			ip_es_digito(texto[i]); i++)
+			octeto = octeto * 10 + (texto[i] - '0');
+
+		// Rechazamos octetos vacíos, mayores a 255 o con ceros a la
+		// izquierda
+		if(i == inicio || octeto > 255 || (texto[inicio] == '0' &&
+			i - inicio > 1))
+			return false;
+
+		v = (v << 8) | octeto;
+	}
+
+	if(i != largo) return false;
+
+	*valor = v;
+	return true;
+}
+
+// Interpreta el texto de una dirección IPv6.
+// PRE: 'texto' es un arreglo de 'largo' caracteres; 'v6' es un arreglo de
+// 16 bytes que recibe el resultado.
+// POST: devuelve true si el texto es una dirección IPv6 válida.
+static bool ip_parsear_v6(const char *texto, size_t largo, uint8_t *v6) {
+	uint8_t r[16];
+	uint32_t grupo, v4;
+	size_t i = 0, inicio, k = 0;
+	int doble = -1;
+
+	// Sólo puede comenzar con ':' si se trata de '::'
+	if(largo >= 2 && texto[0] == ':' && texto[1] == ':') {
+		doble = 0;
+		i = 2;
+	}
+	else if(largo && texto[0] == ':')
+		return false;
+
+	while(i < largo) {
+		if(k == 16) return false;
+
+		// Leemos un grupo de hasta cuatro dígitos hexadecimales
+		for(inicio = i, grupo = 0; i < largo && i - inicio < 4 &&
+			VALOR_HEX[(uint8_t) texto[i]]; i++)
+			grupo = (grupo << 4) | (VALOR_HEX[(uint8_t) texto[i]] - 1);
+
+		if(i == inicio) return false;
+
+		// Los últimos 32 bits pueden escribirse como una dirección IPv4
+		if(i < largo && texto[i] == '.') {
+			if(k > 12 || !ip_parsear_v4(texto + inicio, largo - inicio, &v4))
+				return false;
+
+			r[k++] = v4 >> 24;
+			r[k++] = v4 >> 16;
+			r[k++] = v4 >> 8;
+			r[k++] = v4;
+			break;
+		}
+
+		r[k++] = grupo >> 8;
+		r[k++] = grupo;
+		if(i == largo) break;
+
+		// Los grupos se separan por ':', y a lo sumo una vez por '::'
+		if(texto[i++] != ':' || i == largo) return false;
+
+		if(texto[i] == ':') {
+			if(doble >= 0) return false;
+			doble = k;
+			i++;
+		}
+	}
+
+	// Expandimos el '::', que representa al menos un grupo de ceros
+	if(doble >= 0) {
+		if(k == 16) return false;
+		memmove(r + 16 - (k - doble), r + doble, k - doble);
+		memset(r + doble, 0, 16 - k);
+	}
+	else if(k != 16)
+		return false;
+
+	memcpy(v6, r, 16);
+	return true;
+}
+
+// Escribe un número entre 0 y 255 en decimal.
+// PRE: 'p' apunta al lugar donde escribir; 'octeto' es el número.
+// POST: devuelve un puntero al caracter siguiente al último escrito.
+static char* ip_escribir_octeto(char *p, uint32_t octeto) {
+	if(octeto >= 100) {
+		*p++ = '0' + octeto / 100;
+		octeto %= 100;
+	}
+	else if(octeto < 10) {
+		*p++ = '0' + octeto;
+		return p;
+	}
+
+	memcpy(p, PARES + 2 * octeto, 2);
+	return p + 2;
+}
+
+// Escribe una dirección IPv4 en decimal con puntos.
+// PRE: 'p' apunta al lugar donde escribir; 'v4' es la dirección.
+// POST: devuelve un puntero al caracter siguiente al último escrito.
+static char* ip_escribir_v4(char *p, uint32_t v4) {
+	p = ip_escribir_octeto(p, v4 >> 24);
+	*p++ = '.';
+	p = ip_escribir_octeto(p, (v4 >> 16) & 0xff);
+	*p++ = '.';
+	p = ip_escribir_octeto(p, (v4 >> 8) & 0xff);
+	*p++ = '.';
+	return ip_escribir_octeto(p, v4 & 0xff);
+}
+
+// Escribe un grupo de una dirección IPv6 en hexadecimal, sin ceros a la
+// izquierda.
+// PRE: 'p' apunta al lugar donde escribir; 'grupo' es el grupo.
+// POST: devuelve un puntero al caracter siguiente al último escrito.
+static char* ip_escribir_grupo(char *p, uint32_t grupo) {
+	int s;
+
+	for(s = 12; s > 0 && !(grupo >> s); s -= 4);
+	for(; s >= 0; s -= 4) *p++ = DIGITOS_HEX[(grupo >> s) & 0xf];
+
+	return p;
+}
+
+// Escribe una dirección IPv6 según la RFC 5952: hexadecimal en minúsculas,
+// sin ceros a la izquierda, reemplazando por '::' la secuencia más larga
+// (y la primera, ante igual largo) de al menos dos grupos nulos. Las
+// direcciones IPv4 mapeadas se escriben como ::ffff:a.b.c.d.
+// PRE: 'p' apunta al lugar donde escribir; 'v6' es la dirección.
+// POST: devuelve un puntero al caracter siguiente al último escrito.
+static char* ip_escribir_v6(char *p, const uint8_t *v6) {
+	static const uint8_t MAPEADA[12] = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0xff, 0xff };
+	uint32_t grupos[8];
+	int i, j, inicio = -1, largo = 0;
+
+	if(!memcmp(v6, MAPEADA, 12)) {
+		memcpy(p, "::ffff:", 7);
+		return ip_escribir_v4(p + 7, (uint32_t) v6[12] << 24 |
+			(uint32_t) v6[13] << 16 | (uint32_t) v6[14] << 8 | v6[15]);
+	}
+
+	for(i = 0; i < 8; i++)
+		grupos[i] = (uint32_t) v6[2 * i] << 8 | v6[2 * i + 1];
+
+	// Buscamos la secuencia más larga de grupos nulos
+	for(i = 0; i < 8; i = j + 1) {
+		for(j = i; j < 8 && !grupos[j]; j++);
+		if(j - i > largo && j - i >= 2) {
+			inicio = i;
+			largo = j - i;
+		}
+	}
+
+	for(i = 0; i < 8; i++) {
+		if(i == inicio) {
+			*p++ = ':';
+			*p++ = ':';
+			i += largo - 1;
+			continue;
+		}
+
+		if(i && i != inicio + largo) *p++ = ':';
+		p = ip_escribir_grupo(p, grupos[i]);
+	}
+
+	return p;
+}
+
+
+
+/* ****************************************************************************
+ * FUNCIONES DE LA LIBRERIA
+ * ***************************************************************************/
+
+// Interpreta el texto de una dirección IPv4 (cuatro números decimales entre
+// 0 y 255, sin ceros a la izquierda, separados por puntos) o IPv6 (ocho
+// grupos hexadecimales separados por ':', admitiendo '::' y una dirección
+// IPv4 en los últimos 32 bits).
+// PRE: 'texto' es un arreglo de 'largo' caracteres, no necesariamente
+// terminado en '\0'; 'ip' es la dirección que recibe el resultado.
+// POST: devuelve true si el texto es una dirección válida, cargándola en
+// 'ip', o false en caso contrario, sin modificar 'ip'.
+bool ip_parsear(const char *texto, size_t largo, ip_t *ip) {
+	uint32_t v4;
+	uint8_t v6[16];
+
+	// Las direcciones IPv6 son las únicas que contienen ':'
+	if(memchr(texto, ':', largo)) {
+		if(!ip_parsear_v6(texto, largo, v6)) return false;
+		ip->familia = IP_V6;
+		memcpy(ip->dir.v6, v6, 16);
+		return true;
+	}
+
+	if(!ip_parsear_v4(texto, largo, &v4)) return false;
+	ip->familia = IP_V4;
+	ip->dir.v4 = v4;
+	return true;
+}
+
+// Escribe una dirección en su forma canónica: decimal con puntos para IPv4
+// y la forma recomendada por la RFC 5952 para IPv6.
+// PRE: 'ip' es una dirección válida; 'texto' es un arreglo de al menos
+// IP_MAX_TEXTO caracteres.
+// POST: se escribió en 'texto' la dirección terminada en '\0' y se
+// devuelve su largo.
+size_t ip_formatear(const ip_t *ip, char *texto) {
+	char *fin;
+
+	if(ip->familia == IP_V4)
+		fin = ip_escribir_v4(texto, ip->dir.v4);
+	else
+		fin = ip_escribir_v6(texto, ip->dir.v6);
+
+	*fin = '\0';
+	return fin - texto;
+}
+
+// Compara dos direcciones. Las direcciones IPv4 preceden a las IPv6.
+// PRE: 'a' y 'b' son direcciones válidas.
+// POST: devuelve un entero < 0, 0 o > 0 si 'a' es menor, igual o mayor
+// que 'b' respectivamente.
+int ip_comparar(const ip_t *a, const ip_t *b) {
+	if(a->familia != b->familia) return a->familia - b->familia;
+	if(a->familia == IP_V4) return (a->dir.v4 > b->dir.v4) -
+		(a->dir.v4 < b->dir.v4);
+	return memcmp(a->dir.v6, b->dir.v6, 16);
+}
+
+// Devuelve el hash de una dirección, para indexarlas por dirección.
+// PRE: 'ip' es una dirección válida.
+uint32_t ip_hash(const ip_t *ip) {
+	uint32_t h = 2166136261u;
+	int i;
+
+	if(ip->familia == IP_V4)
+		return (uint32_t) ((ip->dir.v4 * UINT64_C(0x9E3779B97F4A7C15)) >> 32);
+
+	for(i = 0; i < 16; i++) {
+		h ^= ip->dir.v6[i];
+		h *= 16777619u;
+	}
+
+	return h;
+}
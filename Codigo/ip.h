@@ -0,0 +1,82 @@
+/* ****************************************************************************
+ * ****************************************************************************
+ * DIRECCIONES IP - LIBRERÍA DE FUNCIONES
+ * ****************************************************************************
+ * ****************************************************************************
+ *
+ * Librería de funciones para representar direcciones IPv4 e IPv6 en forma
+ * binaria: una dirección IPv4 ocupa un entero de 32 bits y una IPv6 un
+ * arreglo de 16 bytes. Incluye un parser que valida el texto de las
+ * direcciones y un formateador que las convierte nuevamente a texto en
+ * su forma canónica.
+ */
+
+
+#ifndef IP_H
+#define IP_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+
+
+/* ****************************************************************************
+ * DECLARACIÓN DE LOS TIPOS DE DATOS
+ * ***************************************************************************/
+
+// Familias de direcciones
+typedef enum {
+	IP_V4 = 4,
+	IP_V6 = 6
+} ip_familia_t;
+
+// Tipo que representa una dirección IP.
+typedef struct {
+	uint8_t familia;					// Familia de la dirección
+	union {
+		uint32_t v4;					// Dirección IPv4, siendo el bit más
+										// significativo el primero
+		uint8_t v6[16];					// Dirección IPv6, en el orden en que
+										// se escribe
+	} dir;
+} ip_t;
+
+// Máximo de caracteres del texto de una dirección, incluyendo el '\0'
+#define IP_MAX_TEXTO 46
+
+
+
+/* ****************************************************************************
+ * FUNCIONES DE LA LIBRERIA
+ * ***************************************************************************/
+
+// Interpreta el texto de una dirección IPv4 (cuatro números decimales entre
+// 0 y 255, sin ceros a la izquierda, separados por puntos) o IPv6 (ocho
+// grupos hexadecimales separados por ':', admitiendo '::' y una dirección
+// IPv4 en los últimos 32 bits).
+// PRE: 'texto' es un arreglo de 'largo' caracteres, no necesariamente
+// terminado en '\0'; 'ip' es la dirección que recibe el resultado.
+// POST: devuelve true si el texto es una dirección válida, cargándola en
+// 'ip', o false en caso contrario, sin modificar 'ip'.
+bool ip_parsear(const char *texto, size_t largo, ip_t *ip);
+
+// Escribe una dirección en su forma canónica: decimal con puntos para IPv4
+// y la forma recomendada por la RFC 5952 para IPv6.
+// PRE: 'ip' es una dirección válida; 'texto' es un arreglo de al menos
+// IP_MAX_TEXTO caracteres.
+// POST: se escribió en 'texto' la dirección terminada en '\0' y se
+// devuelve su largo.
+size_t ip_formatear(const ip_t *ip, char *texto);
+
+// Compara dos direcciones. Las direcciones IPv4 preceden a las IPv6.
+// PRE: 'a' y 'b' son direcciones válidas.
+// POST: devuelve un entero < 0, 0 o > 0 si 'a' es menor, igual o mayor
+// que 'b' respectivamente.
+int ip_comparar(const ip_t *a, const ip_t *b);
+
+// Devuelve el hash de una dirección, para indexarlas por dirección.
+// PRE: 'ip' es una dirección válida.
+uint32_t ip_hash(const ip_t *ip);
+
+#endif
@@ -13,6 +13,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include "lista.h"
+#include "estadisticas.h"
 
 
 
@@ -49,7 +50,8 @@ struct _lista_iter_t {
 // POST: se devuelve un puntero al nodo o NULL si no se ha podido 
 // llevar a cabo la creación del mismo.
 nodo_lista_t* lista_crear_nodo() {
-	nodo_lista_t* nodo = (nodo_lista_t*) malloc(sizeof(nodo_lista_t));
+	nodo_lista_t* nodo = (nodo_lista_t*) estadisticas_malloc(SUBSISTEMA_LISTA,
+		sizeof(nodo_lista_t));
 	if(!nodo) return NULL;
 	return nodo;
 }
@@ -65,7 +67,8 @@ nodo_lista_t* lista_crear_nodo() {
 // podido llevar a cabo la creación del mismo.
 lista_t* lista_crear() {
 	// Solicitamos espacio en memoria para la lista
-	lista_t* lista = (lista_t*) malloc(sizeof(lista_t));
+	lista_t* lista = (lista_t*) estadisticas_malloc(SUBSISTEMA_LISTA,
+		sizeof(lista_t));
 	if(!lista) return NULL;
 
 	// Seteamos parámetros iniciales de la lista
@@ -186,7 +189,7 @@ bool lista_borrar_primero(lista_t *lista, lista_dato_t *dato) {
 	lista->largo--;
 	
 	// Liberamos la memoria usada por el nodo.
-	free(nodo_borrar);
+	estadisticas_free(SUBSISTEMA_LISTA, nodo_borrar);
 	
 	// Verificamos si quedan mas elementos en la lista
 	if (lista->largo == 0) lista->ultimo = NULL;	
@@ -210,10 +213,10 @@ void lista_destruir(lista_t *lista, void destruir_dato(lista_dato_t)) {
 		// Si se especificó una función para destruir los datos, 
 		// la usamos
 		if(destruir_dato) destruir_dato(nodo->dato);
-		free(nodo);
+		estadisticas_free(SUBSISTEMA_LISTA, nodo);
 	}
 	
-	free(lista);
+	estadisticas_free(SUBSISTEMA_LISTA, lista);
 }
 
 
@@ -228,7 +231,8 @@ void lista_destruir(lista_t *lista, void destruir_dato(lista_dato_t)) {
 // llevar a cabo la creación del mismo.
 lista_iter_t* lista_iter_crear(const lista_t* lista) {
 	// Solicitamos espacio en memoria para el iterador
-	lista_iter_t* iter = (lista_iter_t*) malloc(sizeof(lista_iter_t));
+	lista_iter_t* iter = (lista_iter_t*) estadisticas_malloc(SUBSISTEMA_LISTA,
+		sizeof(lista_iter_t));
 	if(!iter) return NULL;
 
 	// Seteamos parámetros iniciales del iterador
@@ -276,7 +280,7 @@ bool lista_iter_al_final(const lista_iter_t *iter) {
 // Destruye el iterador.
 // PRE: 'iter' es un iterador existente.
 void lista_iter_destruir(lista_iter_t *iter) {
-	free(iter);
+	estadisticas_free(SUBSISTEMA_LISTA, iter);
 }
 
 
@@ -339,6 +343,6 @@ bool lista_borrar(lista_t *lista, lista_iter_t *iter, lista_dato_t *dato) {
 	if(iter->ant) iter->ant->sig = iter->act;
 	lista->largo--;
 	
-	free(nodo_act);
+	estadisticas_free(SUBSISTEMA_LISTA, nodo_act);
 	return true;
 }
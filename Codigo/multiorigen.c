@@ -0,0 +1,438 @@
+/* ****************************************************************************
+ * ****************************************************************************
+ * DISTANCIAS DESDE MÚLTIPLES ORÍGENES - LIBRERÍA DE FUNCIONES
+ * ****************************************************************************
+ * ****************************************************************************
+ *
+ * Librería de funciones que calcula las distancias mínimas desde un lote
+ * de hasta MULTIORIGEN_LOTE orígenes en un único recorrido del grafo.
+ * Cada vértice guarda un vector con su distancia a cada origen, y al
+ * relajar una arista se actualiza el vector completo con instrucciones
+ * vectoriales (AVX2 o SSE4.1 si el procesador las soporta), de modo que
+ * las listas de adyacencia se leen una vez por lote y no una vez por
+ * origen.
+ *
+ * Como cada componente del vector avanza a su propio ritmo, no existe un
+ * único orden de marcado válido para todos los orígenes. Los vértices
+ * pendientes se exploran en una cola de prioridad (un montículo de base
+ * 2) ordenada por la menor de las distancias que mejoraron desde su
+ * última exploración: como en Dijkstra, al extraer un vértice esa
+ * distancia ya es mínima, por lo que cada exploración fija al menos una
+ * componente y ningún vértice se explora más veces que orígenes tiene
+ * el lote. Un recorrido en orden de llegada
+ * volvía a explorar los vértices por cada mejora y, en mallas grandes,
+ * resultaba más lento que un Dijkstra por origen.
+ */
+
+
+#include <stdlib.h>
+#include "multiorigen.h"
+#include "estadisticas.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define MULTIORIGEN_X86
+#include <immintrin.h>
+#endif
+
+
+
+/* ****************************************************************************
+ * DEFINICIÓN DE LOS TIPOS DE DATOS
+ * ***************************************************************************/
+
+// Cantidad de baldes de la cola: uno por cada bit en que una clave puede
+// diferir de la última extraída, más uno para las iguales a ella
+#define MULTIORIGEN_BALDES 33
+
+// Capacidad inicial de cada balde
+#define MULTIORIGEN_CAPACIDAD_BALDE 64
+
+// Tipo que representa un vértice encolado con su clave.
+typedef struct {
+	uint32_t vertice;
+	uint32_t clave;
+} multiorigen_entrada_t;
+
+// Tipo que representa un balde de la cola.
+typedef struct {
+	multiorigen_entrada_t *entradas;	// Vértices del balde
+	size_t cantidad;					// Cantidad de vértices
+	size_t capacidad;					// Capacidad del arreglo
+} multiorigen_balde_t;
+
+// Tipo que representa la cola de vértices pendientes, ordenada por su
+// clave: la menor de las distancias que mejoraron desde que el vértice se
+// exploró por última vez. Es un montículo de base 2 (radix heap): como
+// las claves nunca son menores a la última extraída, cada vértice se
+// ubica en el balde del bit más alto en que su clave difiere de ella, y
+// sólo se reparte un balde cuando se vacían los anteriores. Al mejorar la
+// clave de un vértice se lo vuelve a encolar, y la entrada anterior se
+// descarta al encontrarla.
+typedef struct {
+	multiorigen_balde_t baldes[MULTIORIGEN_BALDES];
+	uint32_t ultima;					// Última clave extraída
+	uint32_t *claves;					// Clave de cada vértice
+										// (MULTIORIGEN_INFINITO si no está
+										// pendiente)
+	bool agotada;						// Indica si faltó memoria
+} multiorigen_cola_t;
+
+
+
+/* ****************************************************************************
+ * ESTADO DE LA LIBRERÍA
+ * ***************************************************************************/
+
+// Cantidad acumulada de exploraciones de vértices
+static size_t exploraciones_totales = 0;
+
+
+
+/* ****************************************************************************
+ * FUNCIONES AUXILIARES
+ * ***************************************************************************/
+
+// Devuelve el balde de una clave.
+// PRE: 'c' es una cola; 'clave' no es menor a la última extraída.
+static inline int multiorigen_balde(const multiorigen_cola_t *c,
+	uint32_t clave) {
+	return clave == c->ultima ? 0 : 32 - __builtin_clz(clave ^ c->ultima);
+}
+
+// Agrega un vértice a un balde.
+// PRE: 'c' es una cola; 'b' es uno de sus baldes.
+// POST: se agregó la entrada al balde, o se marcó la cola como agotada si
+// no hubo memoria suficiente.
+static inline void multiorigen_agregar(multiorigen_cola_t *c,
+	multiorigen_balde_t *b, uint32_t vertice, uint32_t clave) {
+	if(b->cantidad == b->capacidad) {
+		size_t capacidad = b->capacidad ? 2 * b->capacidad :
+			MULTIORIGEN_CAPACIDAD_BALDE;
+		multiorigen_entrada_t *entradas = (multiorigen_entrada_t*)
+			estadisticas_realloc(SUBSISTEMA_DIJKSTRA, b->entradas,
+			capacidad * sizeof(multiorigen_entrada_t));
+
+		if(!entradas) {
+			c->agotada = true;
+			return;
+		}
+
+		b->entradas = entradas;
+		b->capacidad = capacidad;
+	}
+
+	b->entradas[b->cantidad].vertice = vertice;
+	b->entradas[b->cantidad++].clave = clave;
+}
+
+// Asigna una clave menor a un vértice, encolándolo.
+// PRE: 'c' es una cola; 'v' es un vértice; 'clave' es menor a su clave
+// actual y no es menor a la última extraída.
+// POST: el vértice está pendiente con la nueva clave.
+static inline void multiorigen_mejorar(multiorigen_cola_t *c, uint32_t v,
+	uint32_t clave) {
+	c->claves[v] = clave;
+	multiorigen_agregar(c, &c->baldes[multiorigen_balde(c, clave)], v, clave);
+}
+
+// Reparte el primer balde no vacío entre los anteriores.
+// PRE: 'c' es una cola cuyo balde 0 está vacío.
+// POST: devuelve false si no quedan vértices pendientes. En caso
+// contrario, la menor clave pendiente pasa a ser la última extraída y sus
+// vértices quedan en el balde 0. Las entradas descartadas no se reparten.
+static bool multiorigen_repartir(multiorigen_cola_t *c) {
+	multiorigen_balde_t *b;
+	multiorigen_entrada_t e;
+	uint32_t minima;
+	size_t i;
+	int k;
+
+	for(k = 1; k < MULTIORIGEN_BALDES; k++) {
+		b = &c->baldes[k];
+		minima = MULTIORIGEN_INFINITO;
+
+		for(i = 0; i < b->cantidad; i++)
+			if(c->claves[b->entradas[i].vertice] == b->entradas[i].clave &&
+				b->entradas[i].clave < minima)
+				minima = b->entradas[i].clave;
+
+		// Un balde con sólo entradas descartadas se vacía
+		if(minima == MULTIORIGEN_INFINITO) {
+			b->cantidad = 0;
+			continue;
+		}
+
+		// Las entradas vigentes caen en baldes anteriores al repartido
+		c->ultima = minima;
+
+		for(i = 0; i < b->cantidad; i++) {
+			e = b->entradas[i];
+			if(c->claves[e.vertice] == e.clave)
+				multiorigen_agregar(c, &c->baldes[multiorigen_balde(c,
+					e.clave)], e.vertice, e.clave);
+		}
+
+		b->cantidad = 0;
+		return true;
+	}
+
+	return false;
+}
+
+// Extrae un vértice de menor clave de la cola.
+// PRE: 'c' es una cola.
+// POST: devuelve el vértice, que deja de estar pendiente, o
+// MULTIORIGEN_INFINITO si no quedan vértices pendientes.
+static inline uint32_t multiorigen_extraer(multiorigen_cola_t *c) {
+	multiorigen_balde_t *b = &c->baldes[0];
+	multiorigen_entrada_t e;
+
+	while(b->cantidad || multiorigen_repartir(c)) {
+		e = b->entradas[--b->cantidad];
+
+		if(c->claves[e.vertice] == e.clave) {
+			c->claves[e.vertice] = MULTIORIGEN_INFINITO;
+			return e.vertice;
+		}
+	}
+
+	return MULTIORIGEN_INFINITO;
+}
+
+// Las funciones de relajación reciben los vectores de distancias del
+// vértice destino ('dv') y del vértice origen ('du') de una arista de peso
+// 'peso', reemplazan cada componente de 'dv' por el mínimo entre ella y la
+// de 'du' más el peso (saturando en MULTIORIGEN_INFINITO), y devuelven
+// la menor de las componentes que mejoraron, o MULTIORIGEN_INFINITO si
+// ninguna mejoró.
+
+// Relajación sin instrucciones vectoriales.
+static uint32_t multiorigen_relajar_escalar(uint32_t *dv, const uint32_t *du,
+	uint32_t peso) {
+	uint32_t d, mejor = MULTIORIGEN_INFINITO;
+	int i;
+
+	for(i = 0; i < MULTIORIGEN_LOTE; i++) {
+		d = du[i] + peso;
+		if(d < du[i]) d = MULTIORIGEN_INFINITO;
+
+		if(d < dv[i]) {
+			dv[i] = d;
+			if(d < mejor) mejor = d;
+		}
+	}
+
+	return mejor;
+}
+
+#ifdef MULTIORIGEN_X86
+
+// Relajación con instrucciones AVX2, de a ocho componentes.
+__attribute__((target("avx2")))
+static inline uint32_t multiorigen_relajar_avx2(uint32_t *dv,
+	const uint32_t *du, uint32_t peso) {
+	const __m256i w = _mm256_set1_epi32(peso);
+	const __m256i unos = _mm256_set1_epi32(-1);
+	__m256i mejores = unos, u, v, d, m;
+	__m128i x;
+	int i;
+
+	for(i = 0; i < MULTIORIGEN_LOTE; i += 8) {
+		u = _mm256_loadu_si256((const __m256i*) (du + i));
+		v = _mm256_loadu_si256((const __m256i*) (dv + i));
+
+		// Si la suma desborda resulta menor al sumando: saturamos
+		d = _mm256_add_epi32(u, w);
+		d = _mm256_or_si256(d, _mm256_xor_si256(_mm256_cmpeq_epi32(
+			_mm256_max_epu32(d, u), d), unos));
+
+		// Las componentes que no mejoraron no cuentan para el mínimo
+		m = _mm256_min_epu32(v, d);
+		mejores = _mm256_min_epu32(mejores, _mm256_or_si256(m,
+			_mm256_cmpeq_epi32(m, v)));
+		_mm256_storeu_si256((__m256i*) (dv + i), m);
+	}
+
+	x = _mm_min_epu32(_mm256_castsi256_si128(mejores),
+		_mm256_extracti128_si256(mejores, 1));
+	x = _mm_min_epu32(x, _mm_shuffle_epi32(x, _MM_SHUFFLE(1, 0, 3, 2)));
+	x = _mm_min_epu32(x, _mm_shuffle_epi32(x, _MM_SHUFFLE(2, 3, 0, 1)));
+	return (uint32_t) _mm_cvtsi128_si32(x);
+}
+
+// Relajación con instrucciones SSE4.1, de a cuatro componentes.
+__attribute__((target("sse4.1")))
+static inline uint32_t multiorigen_relajar_sse41(uint32_t *dv,
+	const uint32_t *du, uint32_t peso) {
+	const __m128i w = _mm_set1_epi32(peso);
+	const __m128i unos = _mm_set1_epi32(-1);
+	__m128i mejores = unos, u, v, d, m;
+	int i;
+
+	for(i = 0; i < MULTIORIGEN_LOTE; i += 4) {
+		u = _mm_loadu_si128((const __m128i*) (du + i));
+		v = _mm_loadu_si128((const __m128i*) (dv + i));
+
+		// Si la suma desborda resulta menor al sumando: saturamos
+		d = _mm_add_epi32(u, w);
+		d = _mm_or_si128(d, _mm_xor_si128(_mm_cmpeq_epi32(
+			_mm_max_epu32(d, u), d), unos));
+
+		// Las componentes que no mejoraron no cuentan para el mínimo
+		m = _mm_min_epu32(v, d);
+		mejores = _mm_min_epu32(mejores, _mm_or_si128(m,
+			_mm_cmpeq_epi32(m, v)));
+		_mm_storeu_si128((__m128i*) (dv + i), m);
+	}
+
+	mejores = _mm_min_epu32(mejores, _mm_shuffle_epi32(mejores,
+		_MM_SHUFFLE(1, 0, 3, 2)));
+	mejores = _mm_min_epu32(mejores, _mm_shuffle_epi32(mejores,
+		_MM_SHUFFLE(2, 3, 0, 1)));
+	return (uint32_t) _mm_cvtsi128_si32(mejores);
+}
+
+#endif
+
+// Define la función que realiza el recorrido con una función de
+// relajación dada, compilada con los atributos dados para que la
+// relajación se expanda en línea.
+// La función definida recibe el grafo, los vectores de distancias ya
+// inicializados y la cola con los orígenes, y devuelve la cantidad de
+// vértices explorados.
+#define MULTIORIGEN_RECORRIDO(sufijo, atributos, relajar)					\
+atributos																	\
+static size_t multiorigen_recorrido_##sufijo(const grafo_compacto_t *grafo,	\
+	uint32_t *distancias, multiorigen_cola_t *c) {							\
+	const uint32_t *inicio, *destinos, *pesos32;							\
+	const uint16_t *pesos16;												\
+	uint32_t u, v, e, peso, mejor;											\
+	size_t exploraciones = 0;												\
+																			\
+	grafo_compacto_obtener_arreglos(grafo, &inicio, &destinos, &pesos16,	\
+		&pesos32);															\
+																			\
+	while((u = multiorigen_extraer(c)) != MULTIORIGEN_INFINITO) {			\
+		exploraciones++;													\
+																			\
+		for(e = inicio[u]; e < inicio[u + 1]; e++) {						\
+			v = destinos[e];												\
+			peso = pesos16 ? pesos16[e] : pesos32[e];						\
+			mejor = relajar(distancias + (size_t) v * MULTIORIGEN_LOTE,		\
+				distancias + (size_t) u * MULTIORIGEN_LOTE, peso);			\
+																			\
+			if(mejor < c->claves[v]) multiorigen_mejorar(c, v, mejor);		\
+		}																	\
+	}																		\
+																			\
+	return exploraciones;													\
+}
+
+MULTIORIGEN_RECORRIDO(escalar, , multiorigen_relajar_escalar)
+
+#ifdef MULTIORIGEN_X86
+MULTIORIGEN_RECORRIDO(avx2, __attribute__((target("avx2"))),
+	multiorigen_relajar_avx2)
+MULTIORIGEN_RECORRIDO(sse41, __attribute__((target("sse4.1"))),
+	multiorigen_relajar_sse41)
+#endif
+
+// Tipo de las funciones de recorrido
+typedef size_t (*multiorigen_recorrido_t)(const grafo_compacto_t*,
+	uint32_t*, multiorigen_cola_t*);
+
+// Elige el recorrido según las instrucciones que soporta el procesador.
+// PRE: 'nombre' recibe el nombre de las instrucciones, o es NULL.
+// POST: devuelve la función de recorrido más rápida disponible.
+static multiorigen_recorrido_t multiorigen_elegir(const char **nombre) {
+	const char *elegido = "escalar";
+	multiorigen_recorrido_t recorrido = multiorigen_recorrido_escalar;
+
+#ifdef MULTIORIGEN_X86
+	if(__builtin_cpu_supports("avx2")) {
+		elegido = "avx2";
+		recorrido = multiorigen_recorrido_avx2;
+	}
+	else if(__builtin_cpu_supports("sse4.1")) {
+		elegido = "sse4.1";
+		recorrido = multiorigen_recorrido_sse41;
+	}
+#endif
+
+	if(nombre) *nombre = elegido;
+	return recorrido;
+}
+
+
+
+/* ****************************************************************************
+ * FUNCIONES DE LA LIBRERIA
+ * ***************************************************************************/
+
+// Calcula las distancias mínimas desde un lote de orígenes hacia todos los
+// vértices de un grafo.
+// PRE: 'grafo' es un grafo compacto; 'origenes' es un arreglo de
+// 'cantidad' índices de vértices, con 'cantidad' a lo sumo
+// MULTIORIGEN_LOTE; 'distancias' es un arreglo de MULTIORIGEN_LOTE
+// elementos por vértice del grafo.
+// POST: devuelve true y se cargó en distancias[v * MULTIORIGEN_LOTE + i]
+// la distancia mínima desde origenes[i] hasta el vértice v
+// (MULTIORIGEN_INFINITO si no es alcanzable o si la distancia no entra en
+// 32 bits), o devuelve false si no hubo memoria suficiente. Las posiciones
+// de los orígenes no utilizados quedan en MULTIORIGEN_INFINITO.
+bool multiorigen_distancias(const grafo_compacto_t *grafo,
+	const uint32_t *origenes, size_t cantidad, uint32_t *distancias) {
+	uint32_t n = grafo_compacto_cantidad_vertices(grafo), v;
+	multiorigen_cola_t c;
+	size_t i, exploraciones;
+	int k;
+
+	for(i = 0; i < (size_t) n * MULTIORIGEN_LOTE; i++)
+		distancias[i] = MULTIORIGEN_INFINITO;
+	if(!n || !cantidad) return true;
+
+	c.claves = (uint32_t*) estadisticas_malloc(SUBSISTEMA_DIJKSTRA,
+		n * sizeof(uint32_t));
+	if(!c.claves) return false;
+
+	for(k = 0; k < MULTIORIGEN_BALDES; k++) {
+		c.baldes[k].entradas = NULL;
+		c.baldes[k].cantidad = c.baldes[k].capacidad = 0;
+	}
+
+	c.ultima = 0;
+	c.agotada = false;
+	for(v = 0; v < n; v++) c.claves[v] = MULTIORIGEN_INFINITO;
+
+	// Cada origen ingresa a la cola con distancia nula en su componente
+	for(i = 0; i < cantidad; i++) {
+		v = origenes[i];
+		distancias[(size_t) v * MULTIORIGEN_LOTE + i] = 0;
+		if(c.claves[v]) multiorigen_mejorar(&c, v, 0);
+	}
+
+	exploraciones = multiorigen_elegir(NULL)(grafo, distancias, &c);
+	exploraciones_totales += exploraciones;
+
+	for(k = 0; k < MULTIORIGEN_BALDES; k++)
+		estadisticas_free(SUBSISTEMA_DIJKSTRA, c.baldes[k].entradas);
+	estadisticas_free(SUBSISTEMA_DIJKSTRA, c.claves);
+	return !c.agotada;
+}
+
+// Devuelve el nombre de las instrucciones vectoriales utilizadas en este
+// procesador: "avx2", "sse4.1" o "escalar".
+const char* multiorigen_instrucciones() {
+	const char *nombre;
+
+	multiorigen_elegir(&nombre);
+	return nombre;
+}
+
+// Devuelve la cantidad de vértices explorados por los recorridos.
+// POST: devuelve la cantidad de exploraciones acumulada desde el comienzo
+// del programa, en todos los lotes (cada vértice se explora a lo sumo
+// una vez por origen del lote).
+size_t multiorigen_exploraciones() {
+	return exploraciones_totales;
+}
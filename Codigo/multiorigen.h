@@ -0,0 +1,67 @@
+/* ****************************************************************************
+ * ****************************************************************************
+ * DISTANCIAS DESDE MÚLTIPLES ORÍGENES - LIBRERÍA DE FUNCIONES
+ * ****************************************************************************
+ * ****************************************************************************
+ *
+ * Librería de funciones que calcula las distancias mínimas desde un lote
+ * de hasta MULTIORIGEN_LOTE orígenes en un único recorrido del grafo.
+ * Cada vértice guarda un vector con su distancia a cada origen, y al
+ * relajar una arista se actualiza el vector completo con instrucciones
+ * vectoriales (AVX2 o SSE4.1 si el procesador las soporta), de modo que
+ * las listas de adyacencia se leen una vez por lote y no una vez por
+ * origen.
+ */
+
+
+#ifndef MULTIORIGEN_H
+#define MULTIORIGEN_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "grafo_compacto.h"
+
+
+
+/* ****************************************************************************
+ * CONSTANTES
+ * ***************************************************************************/
+
+// Cantidad máxima de orígenes de un lote
+#define MULTIORIGEN_LOTE 16
+
+// Distancia hacia los vértices inalcanzables
+#define MULTIORIGEN_INFINITO UINT32_MAX
+
+
+
+/* ****************************************************************************
+ * FUNCIONES DE LA LIBRERIA
+ * ***************************************************************************/
+
+// Calcula las distancias mínimas desde un lote de orígenes hacia todos los
+// vértices de un grafo.
+// PRE: 'grafo' es un grafo compacto; 'origenes' es un arreglo de
+// 'cantidad' índices de vértices, con 'cantidad' a lo sumo
+// MULTIORIGEN_LOTE; 'distancias' es un arreglo de MULTIORIGEN_LOTE
+// elementos por vértice del grafo.
+// POST: devuelve true y se cargó en distancias[v * MULTIORIGEN_LOTE + i]
+// la distancia mínima desde origenes[i] hasta el vértice v
+// (MULTIORIGEN_INFINITO si no es alcanzable o si la distancia no entra en
+// 32 bits), o devuelve false si no hubo memoria suficiente. Las posiciones
+// de los orígenes no utilizados quedan en MULTIORIGEN_INFINITO.
+bool multiorigen_distancias(const grafo_compacto_t *grafo,
+	const uint32_t *origenes, size_t cantidad, uint32_t *distancias);
+
+// Devuelve el nombre de las instrucciones vectoriales utilizadas en este
+// procesador: "avx2", "sse4.1" o "escalar".
+const char* multiorigen_instrucciones();
+
+// Devuelve la cantidad de vértices explorados por los recorridos.
+// POST: devuelve la cantidad de exploraciones acumulada desde el comienzo
+// del programa, en todos los lotes (cada vértice se explora a lo sumo
+// una vez por origen del lote).
+size_t multiorigen_exploraciones();
+
+#endif
@@ -0,0 +1,285 @@
+/* ****************************************************************************
+ * ****************************************************************************
+ * TAD PERSISTENCIA DE RESULTADOS
+ * ..................................................................
+ *
+ * Implementación del almacenamiento en archivo de los resultados de
+ * procesar una red. El archivo tiene el siguiente formato, en el orden
+ * de bytes de la máquina que lo escribió:
+ *
+ *		cabecera (persistencia_cabecera_t)
+ *		distancias (un uint32_t por vértice)
+ *		previos (un uint32_t por vértice)
+ *		texto de salida
+ *
+ * La cabecera ocupa un múltiplo de 8 bytes, por lo que los arreglos
+ * quedan alineados en la proyección del archivo.
+ *
+ * ****************************************************************************
+ * ***************************************************************************/
+
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "persistencia.h"
+#include "estadisticas.h"
+
+
+
+/* ****************************************************************************
+ * CONSTANTES
+ * ***************************************************************************/
+
+// Identificación del archivo y versión de su formato
+static const char PERSISTENCIA_MAGIA[8] = "TP2RUTAS";
+#define PERSISTENCIA_FORMATO 1
+
+// Valor que se lee distinto en una máquina de otro orden de bytes
+#define PERSISTENCIA_ORDEN 0x01020304u
+
+// Bandera de la cabecera que indica resultados parciales
+#define PERSISTENCIA_PARCIAL 1u
+
+// Parámetros del hash FNV-1a de 64 bits
+#define FNV_BASE 0xCBF29CE484222325ull
+#define FNV_PRIMO 0x100000001B3ull
+
+
+
+/* ****************************************************************************
+ * DEFINICIÓN DE LOS TIPOS DE DATOS
+ * ***************************************************************************/
+
+// Tipo que representa la cabecera del archivo.
+typedef struct {
+	char magia[8];						// PERSISTENCIA_MAGIA
+	uint32_t formato;					// PERSISTENCIA_FORMATO
+	uint32_t orden;						// PERSISTENCIA_ORDEN
+	uint64_t hash;						// Huella de la entrada
+	uint64_t tamano;
+	uint64_t vertices;					// Dimensiones de la red
+	uint64_t aristas;
+	uint64_t hosts;
+	uint32_t banderas;					// PERSISTENCIA_PARCIAL, o 0
+	uint32_t reservado;
+	uint64_t distancias;				// Posición de cada sección en el
+	uint64_t previos;					// archivo
+	uint64_t salida;
+	uint64_t largo_salida;				// Largo del texto de salida
+} persistencia_cabecera_t;
+
+// Tipo que representa resultados abiertos.
+struct _persistencia_t {
+	void *mapa;							// Proyección del archivo
+	size_t tamano;						// Tamaño del archivo
+	persistencia_fragmento_t salida;	// Texto de salida
+};
+
+
+
+/* ****************************************************************************
+ * FUNCIONES AUXILIARES
+ * ***************************************************************************/
+
+// Proyecta en memoria un archivo para lectura.
+// PRE: 'ruta' es el nombre del archivo; 'tamano' es donde se almacena su
+// tamaño.
+// POST: devuelve la proyección del archivo, NULL si está vacío, o
+// MAP_FAILED si no es un archivo regular o no se pudo proyectar.
+static void* persistencia_proyectar(const char *ruta, size_t *tamano) {
+	struct stat estado;
+	void *mapa = MAP_FAILED;
+
+	int fd = open(ruta, O_RDONLY);
+	if(fd < 0) return MAP_FAILED;
+
+	if(!fstat(fd, &estado) && S_ISREG(estado.st_mode)) {
+		*tamano = estado.st_size;
+		mapa = *tamano ? mmap(NULL, *tamano, PROT_READ, MAP_SHARED, fd, 0)
+			: NULL;
+	}
+
+	close(fd);
+	return mapa;
+}
+
+
+
+/* ****************************************************************************
+ * PRIMITIVAS DE LA PERSISTENCIA
+ * ***************************************************************************/
+
+// Calcula la huella de un archivo.
+// PRE: 'ruta' es el nombre del archivo; 'huella' es donde se almacena.
+// POST: devuelve true si se pudo leer el archivo y se cargó su huella en
+// 'huella', o false en caso contrario.
+bool persistencia_huella_archivo(const char *ruta,
+	persistencia_huella_t *huella) {
+	size_t tamano = 0, i;
+	uint64_t hash = FNV_BASE;
+
+	const unsigned char *datos = (const unsigned char*)
+		persistencia_proyectar(ruta, &tamano);
+	if(datos == MAP_FAILED) return false;
+
+	if(datos) {
+		posix_madvise((void*) datos, tamano, POSIX_MADV_SEQUENTIAL);
+
+		for(i = 0; i < tamano; i++) {
+			hash ^= datos[i];
+			hash *= FNV_PRIMO;
+		}
+
+		munmap((void*) datos, tamano);
+	}
+
+	huella->hash = hash;
+	huella->tamano = tamano;
+	return true;
+}
+
+// Guarda resultados en un archivo.
+// PRE: 'ruta' es el nombre del archivo; 'huella' es la huella de la
+// entrada de la que se obtuvieron los resultados; 'contenido' son los
+// resultados, con 'vertices' elementos en 'distancias' y 'previos'.
+// POST: devuelve true si se reemplazó el archivo en forma atómica por uno
+// con los resultados, o false si no se pudo escribir (en cuyo caso el
+// archivo anterior, si existía, no se modifica).
+bool persistencia_guardar(const char *ruta, const persistencia_huella_t *huella,
+	const persistencia_contenido_t *contenido) {
+	persistencia_cabecera_t cabecera;
+	size_t i, v = contenido->vertices;
+	bool ok;
+
+	memset(&cabecera, 0, sizeof(cabecera));
+	memcpy(cabecera.magia, PERSISTENCIA_MAGIA, sizeof(cabecera.magia));
+	cabecera.formato = PERSISTENCIA_FORMATO;
+	cabecera.orden = PERSISTENCIA_ORDEN;
+	cabecera.hash = huella->hash;
+	cabecera.tamano = huella->tamano;
+	cabecera.vertices = v;
+	cabecera.aristas = contenido->aristas;
+	cabecera.hosts = contenido->hosts;
+	cabecera.banderas = contenido->parcial ? PERSISTENCIA_PARCIAL : 0;
+	cabecera.distancias = sizeof(cabecera);
+	cabecera.previos = cabecera.distancias + v * sizeof(uint32_t);
+	cabecera.salida = cabecera.previos + v * sizeof(uint32_t);
+
+	for(i = 0; i < contenido->fragmentos; i++)
+		cabecera.largo_salida += contenido->salida[i].largo;
+
+	// Escribimos un archivo temporal en el mismo directorio, para luego
+	// reemplazar el anterior de una sola vez
+	char *temporal = (char*) estadisticas_malloc(SUBSISTEMA_PERSISTENCIA,
+		strlen(ruta) + sizeof(".XXXXXX"));
+	if(!temporal) return false;
+
+	sprintf(temporal, "%s.XXXXXX", ruta);
+	int fd = mkstemp(temporal);
+	FILE *fp = fd < 0 ? NULL : fdopen(fd, "wb");
+
+	if(!fp) {
+		if(fd >= 0) {
+			close(fd);
+			unlink(temporal);
+		}
+		estadisticas_free(SUBSISTEMA_PERSISTENCIA, temporal);
+		return false;
+	}
+
+	// mkstemp() crea el archivo legible sólo por su dueño
+	fchmod(fd, 0644);
+
+	ok = fwrite(&cabecera, sizeof(cabecera), 1, fp) == 1 &&
+		fwrite(contenido->distancias, sizeof(uint32_t), v, fp) == v &&
+		fwrite(contenido->previos, sizeof(uint32_t), v, fp) == v;
+
+	for(i = 0; ok && i < contenido->fragmentos; i++)
+		ok = fwrite(contenido->salida[i].datos, 1, contenido->salida[i].largo,
+			fp) == contenido->salida[i].largo;
+
+	// El contenido debe llegar al disco antes que el nuevo nombre
+	ok = !fflush(fp) && !fsync(fd) && ok;
+	ok = !fclose(fp) && ok;
+	ok = ok && !rename(temporal, ruta);
+
+	if(!ok) unlink(temporal);
+	estadisticas_free(SUBSISTEMA_PERSISTENCIA, temporal);
+	return ok;
+}
+
+// Abre los resultados almacenados en un archivo.
+// PRE: 'ruta' es el nombre del archivo; 'huella' es la huella de la
+// entrada actual; 'contenido' es donde se cargan los resultados.
+// POST: si el archivo existe, tiene el formato actual y su huella es
+// 'huella', devuelve los resultados abiertos y los carga en 'contenido',
+// cuyos arreglos y texto (en un único fragmento) se leen directamente del
+// archivo y son válidos hasta cerrarlo. En caso contrario devuelve NULL.
+persistencia_t* persistencia_abrir(const char *ruta,
+	const persistencia_huella_t *huella, persistencia_contenido_t *contenido) {
+	size_t tamano = 0;
+	const persistencia_cabecera_t *cabecera;
+
+	char *mapa = (char*) persistencia_proyectar(ruta, &tamano);
+	if(mapa == MAP_FAILED || !mapa) return NULL;
+
+	// Verificamos el formato, la huella y que cada sección esté donde
+	// corresponde dentro del archivo
+	cabecera = (const persistencia_cabecera_t*) mapa;
+
+	if(tamano < sizeof(*cabecera) ||
+		memcmp(cabecera->magia, PERSISTENCIA_MAGIA, sizeof(cabecera->magia)) ||
+		cabecera->formato != PERSISTENCIA_FORMATO ||
+		cabecera->orden != PERSISTENCIA_ORDEN ||
+		cabecera->hash != huella->hash ||
+		cabecera->tamano != huella->tamano ||
+		cabecera->vertices > tamano / (2 * sizeof(uint32_t)) ||
+		cabecera->distancias != sizeof(*cabecera) ||
+		cabecera->previos != cabecera->distancias +
+			cabecera->vertices * sizeof(uint32_t) ||
+		cabecera->salida != cabecera->previos +
+			cabecera->vertices * sizeof(uint32_t) ||
+		cabecera->salida > tamano ||
+		cabecera->largo_salida != tamano - cabecera->salida) {
+		munmap(mapa, tamano);
+		return NULL;
+	}
+
+	persistencia_t *persistencia = (persistencia_t*) estadisticas_malloc(
+		SUBSISTEMA_PERSISTENCIA, sizeof(persistencia_t));
+	if(!persistencia) {
+		munmap(mapa, tamano);
+		return NULL;
+	}
+
+	persistencia->mapa = mapa;
+	persistencia->tamano = tamano;
+	persistencia->salida.datos = mapa + cabecera->salida;
+	persistencia->salida.largo = cabecera->largo_salida;
+
+	contenido->vertices = cabecera->vertices;
+	contenido->aristas = cabecera->aristas;
+	contenido->hosts = cabecera->hosts;
+	contenido->parcial = cabecera->banderas & PERSISTENCIA_PARCIAL;
+	contenido->distancias = (const uint32_t*) (mapa + cabecera->distancias);
+	contenido->previos = (const uint32_t*) (mapa + cabecera->previos);
+	contenido->salida = &persistencia->salida;
+	contenido->fragmentos = 1;
+
+	return persistencia;
+}
+
+// Cierra resultados abiertos.
+// PRE: 'persistencia' son resultados abiertos con persistencia_abrir().
+// POST: se liberaron los recursos de los resultados.
+void persistencia_cerrar(persistencia_t *persistencia) {
+	munmap(persistencia->mapa, persistencia->tamano);
+	estadisticas_free(SUBSISTEMA_PERSISTENCIA, persistencia);
+}
@@ -0,0 +1,104 @@
+/* ****************************************************************************
+ * ****************************************************************************
+ * TAD PERSISTENCIA DE RESULTADOS
+ * ..................................................................
+ *
+ * Almacenamiento en archivo de los resultados de procesar una red (las
+ * distancias y los vértices previos desde el origen, junto con el texto
+ * de salida), para reutilizarlos al volver a procesar la misma entrada
+ * sin interpretarla ni recorrer el grafo.
+ *
+ * El archivo comienza con una cabecera que indica el formato y la huella
+ * de la entrada (FNV-1a de 64 bits de su contenido, junto con su
+ * tamaño), seguida de los arreglos y del texto, alineados para poder
+ * utilizarlos directamente desde la proyección del archivo en memoria.
+ * Los procesos que abren un mismo archivo comparten así sus páginas a
+ * través de la caché de páginas del sistema. El archivo se escribe con
+ * otro nombre y se lo renombra al terminar, por lo que quien lo abre
+ * nunca encuentra uno escrito a medias.
+ *
+ * ****************************************************************************
+ * ***************************************************************************/
+
+
+#ifndef PERSISTENCIA_H
+#define PERSISTENCIA_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+
+
+/* ****************************************************************************
+ * DECLARACIÓN DE LOS TIPOS DE DATOS
+ * ***************************************************************************/
+
+typedef struct _persistencia_t persistencia_t;
+
+// Tipo que representa la huella de un archivo de entrada.
+typedef struct {
+	uint64_t hash;						// FNV-1a del contenido
+	uint64_t tamano;					// Tamaño en bytes
+} persistencia_huella_t;
+
+// Tipo que representa un fragmento del texto de salida.
+typedef struct {
+	const char *datos;					// Texto del fragmento
+	size_t largo;						// Largo del fragmento
+} persistencia_fragmento_t;
+
+// Tipo que representa los resultados almacenados.
+typedef struct {
+	size_t vertices;					// Vértices del grafo
+	size_t aristas;						// Aristas del grafo
+	size_t hosts;						// Hosts de la red
+	bool parcial;						// Indica si sólo son válidas las
+										// distancias y previos de los
+										// caminos hacia los hosts
+	const uint32_t *distancias;			// Distancia a cada vértice
+	const uint32_t *previos;			// Previo de cada vértice
+	const persistencia_fragmento_t *salida;	// Fragmentos del texto de
+										// salida, en orden
+	size_t fragmentos;					// Cantidad de fragmentos
+} persistencia_contenido_t;
+
+
+
+/* ****************************************************************************
+ * PRIMITIVAS DE LA PERSISTENCIA
+ * ***************************************************************************/
+
+// Calcula la huella de un archivo.
+// PRE: 'ruta' es el nombre del archivo; 'huella' es donde se almacena.
+// POST: devuelve true si se pudo leer el archivo y se cargó su huella en
+// 'huella', o false en caso contrario.
+bool persistencia_huella_archivo(const char *ruta,
+	persistencia_huella_t *huella);
+
+// Guarda resultados en un archivo.
+// PRE: 'ruta' es el nombre del archivo; 'huella' es la huella de la
+// entrada de la que se obtuvieron los resultados; 'contenido' son los
+// resultados, con 'vertices' elementos en 'distancias' y 'previos'.
+// POST: devuelve true si se reemplazó el archivo en forma atómica por uno
+// con los resultados, o false si no se pudo escribir (en cuyo caso el
+// archivo anterior, si existía, no se modifica).
+bool persistencia_guardar(const char *ruta, const persistencia_huella_t *huella,
+	const persistencia_contenido_t *contenido);
+
+// Abre los resultados almacenados en un archivo.
+// PRE: 'ruta' es el nombre del archivo; 'huella' es la huella de la
+// entrada actual; 'contenido' es donde se cargan los resultados.
+// POST: si el archivo existe, tiene el formato actual y su huella es
+// 'huella', devuelve los resultados abiertos y los carga en 'contenido',
+// cuyos arreglos y texto (en un único fragmento) se leen directamente del
+// archivo y son válidos hasta cerrarlo. En caso contrario devuelve NULL.
+persistencia_t* persistencia_abrir(const char *ruta,
+	const persistencia_huella_t *huella, persistencia_contenido_t *contenido);
+
+// Cierra resultados abiertos.
+// PRE: 'persistencia' son resultados abiertos con persistencia_abrir().
+// POST: se liberaron los recursos de los resultados.
+void persistencia_cerrar(persistencia_t *persistencia);
+
+#endif
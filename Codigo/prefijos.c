@@ -0,0 +1,340 @@
+/* ****************************************************************************
+ * ****************************************************************************
+ * TAD TABLA DE PREFIJOS
+ * ..................................................................
+ *
+ * Implementación de una tabla que vincula prefijos de direcciones IP
+ * (una dirección junto con la cantidad de bits significativos) con datos,
+ * y que permite buscar el prefijo más largo que contiene a una dirección.
+ * Los prefijos se almacenan en un árbol digital binario con compresión de
+ * caminos (árbol Patricia), por lo que una búsqueda visita a lo sumo un
+ * nodo por prefijo distinto que contiene a la dirección. Los prefijos
+ * IPv4 e IPv6 se almacenan en árboles separados, por lo que un prefijo de
+ * una familia nunca contiene direcciones de la otra.
+ *
+ * ****************************************************************************
+ * ***************************************************************************/
+
+
+#include <stdlib.h>
+#include <stdint.h>
+#include "prefijos.h"
+#include "estadisticas.h"
+
+
+
+/* ****************************************************************************
+ * CONSTANTES
+ * ***************************************************************************/
+
+// Capacidad inicial del arreglo de nodos
+#define CAPACIDAD_INICIAL 64
+
+// Cantidad de bits de las claves
+#define BITS_CLAVE 128
+
+
+
+/* ****************************************************************************
+ * DEFINICIÓN DE LOS TIPOS DE DATOS
+ * ***************************************************************************/
+
+// Tipo que representa un nodo del árbol. Cada nodo representa un prefijo;
+// los nodos que no están ocupados sólo existen para bifurcar el árbol.
+typedef struct {
+	uint64_t clave[2];					// Bits del prefijo (los posteriores
+										// a 'largo' valen 0)
+	uint32_t hijos[2];					// Índice del hijo según el bit
+										// siguiente al prefijo (0 si no
+										// tiene)
+	uint8_t largo;						// Cantidad de bits del prefijo
+	bool ocupado;						// Indica si hay un dato vinculado
+	prefijos_dato_t dato;				// Dato vinculado al prefijo
+} nodo_t;
+
+// Tipo que representa una tabla de prefijos. Los nodos se almacenan en un
+// arreglo y se referencian por su índice; las raíces de los árboles IPv6 e
+// IPv4 ocupan las posiciones 0 y 1 respectivamente, y representan al
+// prefijo de largo 0 de cada familia.
+struct _prefijos_t {
+	nodo_t *nodos;						// Nodos del árbol
+	uint32_t cantidadNodos;				// Cantidad de nodos utilizados
+	uint32_t capacidad;					// Capacidad del arreglo de nodos
+	size_t cantidad;					// Cantidad de prefijos
+};
+
+
+
+/* ****************************************************************************
+ * FUNCIONES AUXILIARES
+ * ***************************************************************************/
+
+// Anula los bits de una clave posteriores a un largo dado.
+// PRE: 'largo' es a lo sumo BITS_CLAVE.
+static void prefijos_anular(uint64_t *clave, unsigned int largo) {
+	if(largo < 64) {
+		clave[0] = largo ? clave[0] & ~(UINT64_MAX >> largo) : 0;
+		clave[1] = 0;
+	}
+	else if(largo == 64)
+		clave[1] = 0;
+	else if(largo < BITS_CLAVE)
+		clave[1] &= ~(UINT64_MAX >> (largo - 64));
+}
+
+// Obtiene la clave de 128 bits de un prefijo. Las direcciones IPv4 ocupan
+// los primeros 32 bits de la clave.
+// PRE: 'ip' es una dirección válida; 'largo' es la cantidad de bits
+// significativos de la dirección; 'clave' recibe la clave.
+// POST: devuelve el largo del prefijo en bits de la clave, habiendo
+// anulado los bits posteriores al mismo.
+static unsigned int prefijos_clave(const ip_t *ip, unsigned int largo,
+	uint64_t *clave) {
+	int i;
+
+	if(ip->familia == IP_V4) {
+		clave[0] = (uint64_t) ip->dir.v4 << 32;
+		clave[1] = 0;
+		if(largo > 32) largo = 32;
+	}
+	else {
+		clave[0] = clave[1] = 0;
+		for(i = 0; i < 8; i++) {
+			clave[0] = clave[0] << 8 | ip->dir.v6[i];
+			clave[1] = clave[1] << 8 | ip->dir.v6[i + 8];
+		}
+		if(largo > BITS_CLAVE) largo = BITS_CLAVE;
+	}
+
+	prefijos_anular(clave, largo);
+	return largo;
+}
+
+// Devuelve el índice de la raíz del árbol de la familia de una dirección.
+// PRE: 'ip' es una dirección válida.
+static uint32_t prefijos_raiz(const ip_t *ip) {
+	return ip->familia == IP_V4;
+}
+
+// Devuelve el bit de una clave en una posición, siendo 0 la del bit más
+// significativo.
+// PRE: 'posicion' es menor a BITS_CLAVE.
+static unsigned int prefijos_bit(const uint64_t *clave, unsigned int posicion) {
+	if(posicion < 64) return (clave[0] >> (63 - posicion)) & 1;
+	return (clave[1] >> (127 - posicion)) & 1;
+}
+
+// Devuelve la cantidad de bits iniciales que comparten dos claves.
+static unsigned int prefijos_comunes(const uint64_t *a, const uint64_t *b) {
+	uint64_t x = a[0] ^ b[0];
+
+	if(x) return __builtin_clzll(x);
+	x = a[1] ^ b[1];
+	if(x) return 64 + __builtin_clzll(x);
+	return BITS_CLAVE;
+}
+
+// Agrega un nodo al árbol.
+// PRE: 'tabla' es una tabla con lugar para al menos un nodo más (ver
+// prefijos_reservar()); 'clave' es una clave cuyos bits posteriores a
+// 'largo' valen 0.
+// POST: devuelve el índice del nuevo nodo, que no tiene hijos ni dato.
+static uint32_t prefijos_nuevo_nodo(prefijos_t *tabla, const uint64_t *clave,
+	unsigned int largo) {
+	nodo_t *nodo = &tabla->nodos[tabla->cantidadNodos];
+
+	nodo->clave[0] = clave[0];
+	nodo->clave[1] = clave[1];
+	nodo->hijos[0] = nodo->hijos[1] = 0;
+	nodo->largo = largo;
+	nodo->ocupado = false;
+
+	return tabla->cantidadNodos++;
+}
+
+// Asegura que haya lugar en el arreglo de nodos.
+// PRE: 'tabla' es una tabla existente; 'nodos' es la cantidad de nodos
+// que se desean agregar.
+// POST: devuelve true si hay lugar o false si no hubo memoria.
+static bool prefijos_reservar(prefijos_t *tabla, uint32_t nodos) {
+	uint32_t capacidad = tabla->capacidad;
+
+	if(tabla->cantidadNodos + nodos <= capacidad) return true;
+	while(capacidad < tabla->cantidadNodos + nodos) capacidad *= 2;
+
+	nodo_t *nuevos = (nodo_t*) estadisticas_realloc(SUBSISTEMA_PREFIJOS,
+		tabla->nodos, capacidad * sizeof(nodo_t));
+	if(!nuevos) return false;
+
+	tabla->nodos = nuevos;
+	tabla->capacidad = capacidad;
+	return true;
+}
+
+// Vincula un dato a un nodo, si este no tenía uno.
+// PRE: 'tabla' es una tabla existente; 'n' es el índice de un nodo.
+static void prefijos_ocupar(prefijos_t *tabla, uint32_t n,
+	prefijos_dato_t dato) {
+	if(tabla->nodos[n].ocupado) return;
+
+	tabla->nodos[n].ocupado = true;
+	tabla->nodos[n].dato = dato;
+	tabla->cantidad++;
+}
+
+
+
+/* ****************************************************************************
+ * PRIMITIVAS DE LA TABLA DE PREFIJOS
+ * ***************************************************************************/
+
+// Crea una tabla de prefijos.
+// POST: devuelve una nueva tabla vacía o NULL si no se ha podido llevar
+// a cabo la creación de la misma.
+prefijos_t* prefijos_crear() {
+	uint64_t raiz[2] = { 0, 0 };
+
+	prefijos_t *tabla = (prefijos_t*) estadisticas_malloc(SUBSISTEMA_PREFIJOS,
+		sizeof(prefijos_t));
+	if(!tabla) return NULL;
+
+	tabla->nodos = (nodo_t*) estadisticas_malloc(SUBSISTEMA_PREFIJOS,
+		CAPACIDAD_INICIAL * sizeof(nodo_t));
+	if(!tabla->nodos) {
+		estadisticas_free(SUBSISTEMA_PREFIJOS, tabla);
+		return NULL;
+	}
+
+	tabla->cantidadNodos = 0;
+	tabla->capacidad = CAPACIDAD_INICIAL;
+	tabla->cantidad = 0;
+	prefijos_nuevo_nodo(tabla, raiz, 0);
+	prefijos_nuevo_nodo(tabla, raiz, 0);
+
+	return tabla;
+}
+
+// Destruye una tabla de prefijos.
+// PRE: 'tabla' es una tabla existente.
+// POST: se liberó la memoria ocupada por la tabla, mas no así la de los
+// datos almacenados en ella.
+void prefijos_destruir(prefijos_t *tabla) {
+	estadisticas_free(SUBSISTEMA_PREFIJOS, tabla->nodos);
+	estadisticas_free(SUBSISTEMA_PREFIJOS, tabla);
+}
+
+// Inserta un prefijo en la tabla.
+// PRE: 'tabla' es una tabla existente; 'prefijo' es una dirección válida;
+// 'largo' es la cantidad de bits significativos del prefijo (un largo
+// mayor a 32 para IPv4 o a 128 para IPv6 equivale a la dirección
+// completa); 'dato' es el dato a vincular.
+// POST: se vinculó el prefijo con 'dato', ignorando los bits de 'prefijo'
+// posteriores a 'largo'. Si el prefijo ya estaba en la tabla se conserva
+// el dato vinculado en primer lugar. Devuelve false si no hubo memoria
+// suficiente o true en caso contrario.
+bool prefijos_insertar(prefijos_t *tabla, const ip_t *prefijo,
+	unsigned int largo, prefijos_dato_t dato) {
+	uint64_t clave[2];
+	uint32_t n = prefijos_raiz(prefijo), h, nuevo, hoja;
+	unsigned int b, comunes;
+
+	largo = prefijos_clave(prefijo, largo, clave);
+
+	// Una inserción agrega a lo sumo dos nodos; los reservamos de antemano
+	// para no dejar el árbol a medio modificar
+	if(!prefijos_reservar(tabla, 2)) return false;
+
+	// Descendemos mientras el prefijo del nodo sea prefijo de la clave
+	while(true) {
+		nodo_t *nodo = &tabla->nodos[n];
+
+		if(nodo->largo == largo) {
+			prefijos_ocupar(tabla, n, dato);
+			return true;
+		}
+
+		b = prefijos_bit(clave, nodo->largo);
+		h = nodo->hijos[b];
+
+		// Si no hay hijo en esa dirección, el prefijo queda como hoja
+		if(!h) {
+			nuevo = prefijos_nuevo_nodo(tabla, clave, largo);
+			tabla->nodos[n].hijos[b] = nuevo;
+			prefijos_ocupar(tabla, nuevo, dato);
+			return true;
+		}
+
+		nodo_t *hijo = &tabla->nodos[h];
+		comunes = prefijos_comunes(hijo->clave, clave);
+		if(comunes > largo) comunes = largo;
+
+		if(comunes >= hijo->largo) {
+			n = h;
+			continue;
+		}
+
+		// El hijo no está contenido en la clave: lo colgamos de un nodo
+		// con el prefijo común, que es el nuevo prefijo si este lo contiene
+		// o un nodo de bifurcación en caso contrario
+		b = prefijos_bit(hijo->clave, comunes);
+
+		if(comunes == largo) {
+			nuevo = prefijos_nuevo_nodo(tabla, clave, largo);
+			prefijos_ocupar(tabla, nuevo, dato);
+		}
+		else {
+			uint64_t bifurcacion[2] = { clave[0], clave[1] };
+
+			prefijos_anular(bifurcacion, comunes);
+			nuevo = prefijos_nuevo_nodo(tabla, bifurcacion, comunes);
+			hoja = prefijos_nuevo_nodo(tabla, clave, largo);
+			prefijos_ocupar(tabla, hoja, dato);
+			tabla->nodos[nuevo].hijos[!b] = hoja;
+		}
+
+		tabla->nodos[nuevo].hijos[b] = h;
+		tabla->nodos[n].hijos[prefijos_bit(clave, tabla->nodos[n].largo)] =
+			nuevo;
+		return true;
+	}
+}
+
+// Busca el prefijo más largo de la tabla que contiene a una dirección.
+// PRE: 'tabla' es una tabla existente; 'ip' es una dirección válida;
+// 'dato' recibe el resultado.
+// POST: devuelve true y carga en 'dato' el dato vinculado al prefijo más
+// largo que contiene a 'ip', o devuelve false si ningún prefijo la
+// contiene.
+bool prefijos_buscar(const prefijos_t *tabla, const ip_t *ip,
+	prefijos_dato_t *dato) {
+	const nodo_t *nodo = &tabla->nodos[prefijos_raiz(ip)];
+	uint64_t clave[2];
+	bool encontrado = false;
+	uint32_t h;
+
+	prefijos_clave(ip, BITS_CLAVE, clave);
+
+	// Descendemos recordando el último prefijo ocupado que contiene a la
+	// dirección
+	while(true) {
+		if(nodo->ocupado) {
+			*dato = nodo->dato;
+			encontrado = true;
+		}
+
+		if(nodo->largo == BITS_CLAVE) break;
+		h = nodo->hijos[prefijos_bit(clave, nodo->largo)];
+		if(!h) break;
+
+		nodo = &tabla->nodos[h];
+		if(prefijos_comunes(nodo->clave, clave) < nodo->largo) break;
+	}
+
+	return encontrado;
+}
+
+// Devuelve la cantidad de prefijos de la tabla.
+// PRE: 'tabla' es una tabla existente.
+size_t prefijos_cantidad(const prefijos_t *tabla) {
+	return tabla->cantidad;
+}
@@ -0,0 +1,85 @@
+/* ****************************************************************************
+ * ****************************************************************************
+ * TAD TABLA DE PREFIJOS
+ * ..................................................................
+ *
+ * Implementación de una tabla que vincula prefijos de direcciones IP
+ * (una dirección junto con la cantidad de bits significativos) con datos,
+ * y que permite buscar el prefijo más largo que contiene a una dirección.
+ * Los prefijos se almacenan en un árbol digital binario con compresión de
+ * caminos (árbol Patricia), por lo que una búsqueda visita a lo sumo un
+ * nodo por prefijo distinto que contiene a la dirección. Los prefijos
+ * IPv4 e IPv6 se almacenan en árboles separados, por lo que un prefijo de
+ * una familia nunca contiene direcciones de la otra.
+ *
+ * ****************************************************************************
+ * ***************************************************************************/
+
+
+#ifndef PREFIJOS_H
+#define PREFIJOS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "ip.h"
+
+
+
+/* ****************************************************************************
+ * DECLARACIÓN DE LOS TIPOS DE DATOS
+ * ***************************************************************************/
+
+#ifndef PREFIJOS_DATO_T
+// Para especificar el tipo de datos que manejará la tabla, copie
+// las siguientes dos líneas en su código, justo antes de incluir
+// el presente header. Reemplace void* por el tipo que usted prefiera.
+#define PREFIJOS_DATO_T
+typedef void* prefijos_dato_t;
+#endif
+
+
+typedef struct _prefijos_t prefijos_t;
+
+
+
+/* ****************************************************************************
+ * PRIMITIVAS DE LA TABLA DE PREFIJOS
+ * ***************************************************************************/
+
+// Crea una tabla de prefijos.
+// POST: devuelve una nueva tabla vacía o NULL si no se ha podido llevar
+// a cabo la creación de la misma.
+prefijos_t* prefijos_crear();
+
+// Destruye una tabla de prefijos.
+// PRE: 'tabla' es una tabla existente.
+// POST: se liberó la memoria ocupada por la tabla, mas no así la de los
+// datos almacenados en ella.
+void prefijos_destruir(prefijos_t *tabla);
+
+// Inserta un prefijo en la tabla.
+// PRE: 'tabla' es una tabla existente; 'prefijo' es una dirección válida;
+// 'largo' es la cantidad de bits significativos del prefijo (un largo
+// mayor a 32 para IPv4 o a 128 para IPv6 equivale a la dirección
+// completa); 'dato' es el dato a vincular.
+// POST: se vinculó el prefijo con 'dato', ignorando los bits de 'prefijo'
+// posteriores a 'largo'. Si el prefijo ya estaba en la tabla se conserva
+// el dato vinculado en primer lugar. Devuelve false si no hubo memoria
+// suficiente o true en caso contrario.
+bool prefijos_insertar(prefijos_t *tabla, const ip_t *prefijo,
+	unsigned int largo, prefijos_dato_t dato);
+
+// Busca el prefijo más largo de la tabla que contiene a una dirección.
+// PRE: 'tabla' es una tabla existente; 'ip' es una dirección válida;
+// 'dato' recibe el resultado.
+// POST: devuelve true y carga en 'dato' el dato vinculado al prefijo más
+// largo que contiene a 'ip', o devuelve false si ningún prefijo la
+// contiene.
+bool prefijos_buscar(const prefijos_t *tabla, const ip_t *ip,
+	prefijos_dato_t *dato);
+
+// Devuelve la cantidad de prefijos de la tabla.
+// PRE: 'tabla' es una tabla existente.
+size_t prefijos_cantidad(const prefijos_t *tabla);
+
+#endif
@@ -0,0 +1,105 @@
+/* ****************************************************************************
+ * ****************************************************************************
+ * BENCHMARK DE ETAPAS DEL PROCESAMIENTO DE UNA RED
+ * ****************************************************************************
+ * ****************************************************************************
+ *
+ * Programa que procesa una especificación de ruteo del mismo modo que 'tp',
+ * midiendo por separado el tiempo de cada etapa: parseo, construcción del
+ * grafo, cálculo de caminos mínimos, extracción de caminos y salida.
+ *
+ *
+ * FORMA DE USO
+ * ============
+ *
+ *		# ./benchmark ARCHIVO
+ *
+ * Los caminos se descartan (se envían a /dev/null) y se imprime en la
+ * salida de errores estandar una única línea con los campos, separados
+ * por tabulaciones:
+ *
+ *		DISPOSITIVOS CONEXIONES HOSTS PARSEO CONSTRUCCION CAMINOS
+ *		EXTRACCION SALIDA TOTAL
+ *
+ * donde los tiempos se expresan en milisegundos. Si se compiló con los
+ * contadores de Dijkstra (DIJKSTRA_CONTADORES), se imprime además una
+ * segunda línea con el perfil de la búsqueda:
+ *
+ *		MARCADOS RELAJACIONES EXITOSAS ENCOLADOS DESENCOLADOS DESEMPATES
+ *		PASOS_EXTRACCION
+ *
+ */
+
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <time.h>
+#include "../router.h"
+#include "../dijkstra.h"
+
+
+
+/* ****************************************************************************
+ * FUNCIONES AUXILIARES
+ * ***************************************************************************/
+
+// Devuelve el tiempo transcurrido, en milisegundos, desde un instante
+// fijo y arbitrario.
+static double reloj_ms() {
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return t.tv_sec * 1e3 + t.tv_nsec / 1e6;
+}
+
+
+
+/* ****************************************************************************
+ * PROGRAMA PRINCIPAL
+ * ***************************************************************************/
+
+int main(int argc, char **argv) {
+	double t[6];
+	size_t conexiones;
+
+	if(argc < 2) {
+		fprintf(stderr, "Uso: %s ARCHIVO\n", argv[0]);
+		return 1;
+	}
+
+	// Los caminos no interesan, sólo el costo de generarlos
+	if(!freopen("/dev/null", "w", stdout)) return 1;
+
+	red_t *red = red_crear();
+
+	t[0] = reloj_ms();
+	red_cargar(red, argv[1]);
+	conexiones = red_cantidad_routes(red);
+	t[1] = reloj_ms();
+	red_armar_grafo(red);
+	t[2] = reloj_ms();
+	red_calcular_caminos_minimos(red);
+	t[3] = reloj_ms();
+	red_obtener_caminos(red);
+	t[4] = reloj_ms();
+	red_enviar_caminos(red);
+	fflush(stdout);
+	t[5] = reloj_ms();
+
+	fprintf(stderr, "%zu\t%zu\t%zu\t%.3f\t%.3f\t%.3f\t%.3f\t%.3f\t%.3f\n",
+		red_cantidad_devices(red), conexiones, red_cantidad_hosts(red),
+		t[1] - t[0], t[2] - t[1], t[3] - t[2], t[4] - t[3], t[5] - t[4],
+		t[5] - t[0]);
+
+	// Perfil de la búsqueda, si se compilaron los contadores
+	dijkstra_contadores_t c;
+
+	if(dijkstra_obtener_contadores(&c))
+		fprintf(stderr, "%zu\t%zu\t%zu\t%zu\t%zu\t%zu\t%zu\n",
+			c.vertices_marcados, c.relajaciones, c.relajaciones_exitosas,
+			c.encolados, c.desencolados, c.desempates, c.pasos_extraccion);
+
+	red_destruir(red);
+
+	return 0;
+}
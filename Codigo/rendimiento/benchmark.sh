@@ -0,0 +1,60 @@
+#!/bin/sh
+# ****************************************************************************
+# BENCHMARK DE ESCALABILIDAD
+# ****************************************************************************
+#
+# Genera redes sintéticas de distintas topologías y tamaños y mide el tiempo
+# de cada etapa del procesamiento. Se configura mediante las siguientes
+# variables de entorno:
+#
+#	TOPOLOGIAS: topologías a generar (ver generador.c).
+#	TAMANOS: cantidades aproximadas de conexiones de cada red.
+#	HOSTS: cantidad de hosts conectados a cada red.
+#	SEMILLA: semilla del generador pseudoaleatorio.
+#	LIMITE: tiempo máximo, en segundos, de cada corrida. Las corridas que
+#			lo exceden se informan como tales y no se prueban los tamaños
+#			mayores de esa topología.
+#
+# Los tiempos se expresan en milisegundos. Si el benchmark se compiló con
+# los contadores de Dijkstra ('contadores = si' en el Makefile), debajo de
+# cada corrida se imprime el perfil de la búsqueda.
+#
+
+DIR=$(dirname "$0")
+REDES="$DIR/redes"
+
+TOPOLOGIAS=${TOPOLOGIAS:-"grilla aleatoria libre_escala completa fat_tree"}
+TAMANOS=${TAMANOS:-"1000 10000 100000"}
+HOSTS=${HOSTS:-100}
+SEMILLA=${SEMILLA:-1}
+LIMITE=${LIMITE:-60}
+
+mkdir -p "$REDES"
+
+printf "%-13s %9s %9s %9s %7s %11s %11s %11s %11s %11s %11s\n" \
+	TOPOLOGIA ARISTAS DISPOSIT CONEXIONES HOSTS PARSEO CONSTRUCC \
+	CAMINOS EXTRACCION SALIDA TOTAL
+
+for topologia in $TOPOLOGIAS; do
+	for tamano in $TAMANOS; do
+		red="$REDES/$topologia-$tamano-$HOSTS-$SEMILLA"
+
+		# Las redes se generan una única vez por configuración
+		[ -f "$red" ] || "$DIR/generador" $topologia $tamano $HOSTS \
+			$SEMILLA > "$red" || exit 1
+
+		if salida=$(timeout $LIMITE "$DIR/benchmark" "$red" 2>&1); then
+			printf "%-13s %9s %9s %9s %7s %11s %11s %11s %11s %11s %11s\n" \
+				$topologia $tamano $(echo "$salida" | sed -n 1p)
+
+			perfil=$(echo "$salida" | sed -n 2p)
+			[ -z "$perfil" ] || printf "%23s marcados=%s relajaciones=%s \
+exitosas=%s encolados=%s desencolados=%s desempates=%s extraccion=%s\n" \
+				"" $perfil
+		else
+			printf "%-13s %9s  excedió el límite de %s s\n" \
+				$topologia $tamano $LIMITE
+			break
+		fi
+	done
+done
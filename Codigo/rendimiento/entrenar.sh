@@ -0,0 +1,35 @@
+#!/bin/sh
+# ****************************************************************************
+# ENTRENAMIENTO PARA LA OPTIMIZACIÓN GUIADA POR PERFILES
+# ****************************************************************************
+#
+# Ejecuta 'tp' (compilado con 'pgo_generar=si') sobre los casos de prueba y
+# sobre redes generadas de cada topología, para recolectar el perfil de
+# ejecución que luego utiliza el compilador. Las salidas se descartan.
+#
+
+DIR=$(dirname "$0")
+TP="$DIR/../tp"
+CASOS="$DIR/../../Casos de prueba"
+REDES="$DIR/redes"
+
+# Redes generadas: TOPOLOGIA ARISTAS HOSTS
+ENTRENAMIENTO="grilla 1000 100
+aleatoria 1000 100
+libre_escala 1000 500
+completa 10000 100
+fat_tree 10000 1000"
+
+for caso in "$CASOS"/*/; do
+	[ -f "$caso/input" ] && "$TP" "$caso/input" > /dev/null
+done
+
+mkdir -p "$REDES"
+while read topologia aristas hosts; do
+	red="$REDES/$topologia-$aristas-$hosts-1"
+	[ -f "$red" ] || "$DIR/generador" $topologia $aristas $hosts 1 > "$red" \
+		|| exit 1
+	"$TP" "$red" > /dev/null || exit 1
+done <<FIN
+$ENTRENAMIENTO
+FIN
@@ -0,0 +1,303 @@
+/* ****************************************************************************
+ * ****************************************************************************
+ * GENERADOR DE TOPOLOGÍAS SINTÉTICAS
+ * ****************************************************************************
+ * ****************************************************************************
+ *
+ * Programa que genera redes deterministas en el formato de especificación
+ * de ruteo aceptado por 'tp' (secciones '[host]', '[device]' y '[route]'),
+ * con el fin de medir el comportamiento del programa a distintas escalas.
+ *
+ *
+ * FORMA DE USO
+ * ============
+ *
+ *		# ./generador TOPOLOGIA ARISTAS [HOSTS] [SEMILLA]
+ *
+ * donde,
+ *
+ *		TOPOLOGIA: 'grilla', 'aleatoria', 'libre_escala', 'completa' o
+ *				   'fat_tree'.
+ *		ARISTAS: cantidad aproximada de conexiones a generar. La cantidad
+ *				 exacta depende de la forma de la topología.
+ *		HOSTS: cantidad de hosts a conectar a la red (por defecto 100).
+ *		SEMILLA: semilla del generador pseudoaleatorio (por defecto 1).
+ *
+ * La red se envía a la salida estandar. El primer host se conecta siempre
+ * al primer dispositivo, el cual es el dispositivo origen.
+ *
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+
+
+
+/* ****************************************************************************
+ * CONSTANTES
+ * ***************************************************************************/
+
+// Cantidad de hosts por defecto
+#define HOSTS_POR_DEFECTO 100
+// Peso máximo de una conexión
+#define PESO_MAXIMO 100
+// Grado medio de salida de la topología aleatoria
+#define GRADO_ALEATORIA 4
+// Conexiones que aporta cada nuevo dispositivo en la topología libre
+// de escala
+#define ENLACES_LIBRE_ESCALA 3
+
+
+
+/* ****************************************************************************
+ * GENERADOR PSEUDOALEATORIO
+ * ***************************************************************************/
+
+// Estado del generador (splitmix64)
+static uint64_t estado = 1;
+
+// Devuelve el siguiente número pseudoaleatorio de 64 bits.
+static uint64_t aleatorio() {
+	uint64_t z = (estado += 0x9E3779B97F4A7C15ULL);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return z ^ (z >> 31);
+}
+
+// Devuelve un número pseudoaleatorio en el rango [0, n).
+static uint32_t aleatorio_rango(uint32_t n) {
+	return (uint32_t) (aleatorio() % n);
+}
+
+// Devuelve un peso pseudoaleatorio en el rango [1, PESO_MAXIMO].
+static int aleatorio_peso() {
+	return 1 + (int) aleatorio_rango(PESO_MAXIMO);
+}
+
+
+
+/* ****************************************************************************
+ * FUNCIONES DE SALIDA
+ * ***************************************************************************/
+
+// Imprime la sección [host], conectando los hosts a dispositivos tomados
+// al azar. El primer host se conecta al dispositivo origen.
+// PRE: 'hosts' es la cantidad de hosts; 'dispositivos' es la cantidad de
+// dispositivos de la red.
+static void imprimir_hosts(uint32_t hosts, uint32_t dispositivos) {
+	uint32_t i;
+
+	printf("[host]\n");
+
+	for(i = 0; i < hosts; i++)
+		printf("h%u,172.%u.%u.%u,r%u\n", i, 16 + ((i >> 16) & 15),
+			(i >> 8) & 255, i & 255, i ? aleatorio_rango(dispositivos) : 0);
+}
+
+// Imprime la sección [device].
+// PRE: 'dispositivos' es la cantidad de dispositivos de la red.
+static void imprimir_devices(uint32_t dispositivos) {
+	uint32_t i;
+
+	printf("[device]\n");
+
+	for(i = 0; i < dispositivos; i++)
+		printf("r%u,10.%u.%u.%u\n", i, (i >> 16) & 255, (i >> 8) & 255,
+			i & 255);
+}
+
+// Imprime una conexión de la sección [route].
+static void imprimir_route(uint32_t d1, uint32_t d2, int peso) {
+	printf("r%u->r%u,%d\n", d1, d2, peso);
+}
+
+// Imprime una conexión en ambos sentidos, con el mismo peso.
+static void imprimir_route_doble(uint32_t d1, uint32_t d2) {
+	int peso = aleatorio_peso();
+	imprimir_route(d1, d2, peso);
+	imprimir_route(d2, d1, peso);
+}
+
+
+
+/* ****************************************************************************
+ * TOPOLOGÍAS
+ * ***************************************************************************/
+
+// Grilla cuadrada de lado 'lado', con conexiones en ambos sentidos entre
+// dispositivos vecinos.
+static void generar_grilla(uint32_t aristas, uint32_t hosts) {
+	uint32_t lado = (uint32_t) sqrt(aristas / 4.0) + 1;
+	uint32_t f, c;
+
+	if(lado < 2) lado = 2;
+
+	imprimir_hosts(hosts, lado * lado);
+	imprimir_devices(lado * lado);
+	printf("[route]\n");
+
+	for(f = 0; f < lado; f++)
+		for(c = 0; c < lado; c++) {
+			if(c + 1 < lado) imprimir_route_doble(f * lado + c, f * lado + c + 1);
+			if(f + 1 < lado) imprimir_route_doble(f * lado + c, (f + 1) * lado + c);
+		}
+}
+
+// Grafo aleatorio disperso. Se genera primero un árbol aleatorio que
+// garantiza que todos los dispositivos sean alcanzables desde el origen, y
+// luego se completan las conexiones restantes entre pares al azar.
+static void generar_aleatoria(uint32_t aristas, uint32_t hosts) {
+	uint32_t n = aristas / GRADO_ALEATORIA;
+	uint32_t i, d1, d2;
+
+	if(n < 2) n = 2;
+
+	imprimir_hosts(hosts, n);
+	imprimir_devices(n);
+	printf("[route]\n");
+
+	// Árbol de alcance
+	for(i = 1; i < n; i++)
+		imprimir_route(aleatorio_rango(i), i, aleatorio_peso());
+
+	// Conexiones restantes
+	for(i = n - 1; i < aristas; i++) {
+		d1 = aleatorio_rango(n);
+		d2 = aleatorio_rango(n - 1);
+		if(d2 >= d1) d2++;
+		imprimir_route(d1, d2, aleatorio_peso());
+	}
+}
+
+// Grafo libre de escala (modelo de Barabási-Albert). Cada nuevo dispositivo
+// se conecta en ambos sentidos a ENLACES_LIBRE_ESCALA dispositivos elegidos
+// con probabilidad proporcional a su grado.
+static void generar_libre_escala(uint32_t aristas, uint32_t hosts) {
+	uint32_t m = ENLACES_LIBRE_ESCALA;
+	uint32_t n = aristas / (2 * m) + m;
+	uint32_t i, j, k, largo = 0;
+
+	// Extremos de las conexiones ya creadas, para el muestreo preferencial
+	uint32_t *extremos = (uint32_t*) malloc(2 * (size_t) n * m *
+		sizeof(uint32_t));
+	if(!extremos) exit(1);
+
+	imprimir_hosts(hosts, n);
+	imprimir_devices(n);
+	printf("[route]\n");
+
+	// Núcleo inicial completamente conectado
+	for(i = 0; i <= m; i++)
+		for(j = i + 1; j <= m; j++) {
+			imprimir_route_doble(i, j);
+			extremos[largo++] = i;
+			extremos[largo++] = j;
+		}
+
+	for(i = m + 1; i < n; i++) {
+		uint32_t base = largo;
+
+		for(k = 0; k < m; k++) {
+			uint32_t d = extremos[aleatorio_rango(base)];
+			imprimir_route_doble(i, d);
+			extremos[largo++] = i;
+			extremos[largo++] = d;
+		}
+	}
+
+	free(extremos);
+}
+
+// Grafo completo con conexiones en ambos sentidos entre todo par de
+// dispositivos.
+static void generar_completa(uint32_t aristas, uint32_t hosts) {
+	uint32_t n = (uint32_t) ((1 + sqrt(1 + 4.0 * aristas)) / 2);
+	uint32_t i, j;
+
+	if(n < 2) n = 2;
+
+	imprimir_hosts(hosts, n);
+	imprimir_devices(n);
+	printf("[route]\n");
+
+	for(i = 0; i < n; i++)
+		for(j = 0; j < n; j++)
+			if(i != j) imprimir_route(i, j, aleatorio_peso());
+}
+
+// Fat-tree de k puertos: k pods con k/2 switches de borde y k/2 de
+// agregación cada uno, y (k/2)^2 switches de núcleo. Los switches de borde
+// se numeran primero, de modo que los hosts (incluido el origen) queden
+// conectados a ellos.
+static void generar_fat_tree(uint32_t aristas, uint32_t hosts) {
+	uint32_t k = (uint32_t) cbrt((double) aristas);
+	uint32_t p, i, j, mitad;
+
+	if(k < 2) k = 2;
+	if(k % 2) k++;
+	mitad = k / 2;
+
+	// Numeración: bordes [0, k*mitad), agregación [k*mitad, 2*k*mitad),
+	// núcleo [2*k*mitad, 2*k*mitad + mitad^2)
+	uint32_t bordes = k * mitad;
+	uint32_t n = 2 * bordes + mitad * mitad;
+
+	// Los hosts se conectan sólo a switches de borde
+	imprimir_hosts(hosts, bordes);
+	imprimir_devices(n);
+	printf("[route]\n");
+
+	for(p = 0; p < k; p++)
+		for(i = 0; i < mitad; i++) {
+			uint32_t agregacion = bordes + p * mitad + i;
+
+			// Borde <-> agregación dentro del pod
+			for(j = 0; j < mitad; j++)
+				imprimir_route_doble(p * mitad + j, agregacion);
+
+			// Agregación <-> núcleo
+			for(j = 0; j < mitad; j++)
+				imprimir_route_doble(agregacion, 2 * bordes + i * mitad + j);
+		}
+}
+
+
+
+/* ****************************************************************************
+ * PROGRAMA PRINCIPAL
+ * ***************************************************************************/
+
+int main(int argc, char **argv) {
+	if(argc < 3) {
+		fprintf(stderr, "Uso: %s TOPOLOGIA ARISTAS [HOSTS] [SEMILLA]\n",
+			argv[0]);
+		return 1;
+	}
+
+	uint32_t aristas = (uint32_t) strtoul(argv[2], NULL, 10);
+	uint32_t hosts = argc > 3 ? (uint32_t) strtoul(argv[3], NULL, 10) :
+		HOSTS_POR_DEFECTO;
+	if(argc > 4) estado = strtoull(argv[4], NULL, 10);
+	if(hosts < 2) hosts = 2;
+
+	if(!strcmp(argv[1], "grilla"))
+		generar_grilla(aristas, hosts);
+	else if(!strcmp(argv[1], "aleatoria"))
+		generar_aleatoria(aristas, hosts);
+	else if(!strcmp(argv[1], "libre_escala"))
+		generar_libre_escala(aristas, hosts);
+	else if(!strcmp(argv[1], "completa"))
+		generar_completa(aristas, hosts);
+	else if(!strcmp(argv[1], "fat_tree"))
+		generar_fat_tree(aristas, hosts);
+	else {
+		fprintf(stderr, "Topología desconocida: %s\n", argv[1]);
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,158 @@
+#!/bin/sh
+# ****************************************************************************
+# PRUEBAS DE REGRESIÓN DE RENDIMIENTO
+# ****************************************************************************
+#
+# Ejecuta 'tp' sobre cada uno de los casos de prueba y sobre un conjunto de
+# redes generadas de mayor tamaño. Para cada caso verifica que la salida
+# coincida con la esperada (archivo '__stdout__', si existe) y registra la
+# mediana del tiempo de ejecución y del pico de memoria residente sobre
+# varias repeticiones. Falla si algún caso es más lento, o consume más
+# memoria, que la línea base almacenada por encima del margen permitido.
+#
+# Un caso de prueba puede incluir un archivo 'opciones' con las opciones
+# con que se ejecuta 'tp' (por ejemplo '--consultas=consultas'). El caso
+# se ejecuta desde su directorio, por lo que los archivos que nombran sus
+# opciones se buscan en él.
+#
+# Se configura mediante las siguientes variables de entorno:
+#
+#	REPETICIONES: cantidad de corridas de cada caso (por defecto 5).
+#	MARGEN: porcentaje tolerado por sobre la línea base (por defecto 25).
+#	TOLERANCIA_MS: milisegundos tolerados además del margen, para que los
+#				   casos muy breves no fallen por ruido (por defecto 5).
+#	LINEA_BASE: archivo de la línea base (por defecto linea_base.txt en
+#				este directorio).
+#	ACTUALIZAR: si vale 'si', en lugar de comparar se reescribe la línea
+#				base con las mediciones obtenidas.
+#
+# La línea base tiene una línea por caso con el formato:
+#
+#	CASO MEDIANA_MS RSS_KB
+#
+
+DIR=$(dirname "$0")
+TP="$(cd "$DIR/.." && pwd)/tp"
+CASOS="$DIR/../../Casos de prueba"
+REDES="$DIR/redes"
+
+REPETICIONES=${REPETICIONES:-5}
+MARGEN=${MARGEN:-25}
+TOLERANCIA_MS=${TOLERANCIA_MS:-5}
+LINEA_BASE=${LINEA_BASE:-"$DIR/linea_base.txt"}
+ACTUALIZAR=${ACTUALIZAR:-no}
+
+# Redes generadas: TOPOLOGIA ARISTAS HOSTS
+GENERADAS="grilla 1000 100
+aleatoria 1000 100
+libre_escala 10000 100
+completa 10000 100
+fat_tree 10000 100"
+
+SALIDA=$(mktemp)
+MEDICIONES=$(mktemp)
+NUEVA_BASE=$(mktemp)
+trap 'rm -f "$SALIDA" "$MEDICIONES" "$NUEVA_BASE"' EXIT
+
+fallas=0
+
+
+# Devuelve la mediana de los números recibidos por la entrada estandar.
+mediana() {
+	sort -n | awk '{ v[NR] = $1 } END { print v[int((NR + 1) / 2)] }'
+}
+
+# Mide un caso y lo compara contra la línea base.
+# Parámetros: NOMBRE DIRECTORIO ENTRADA [SALIDA_ESPERADA [OPCIONES]]
+medir() {
+	nombre=$1
+	directorio=$2
+	entrada=$3
+	esperada=$4
+	opciones=$5
+	estado="ok"
+
+	: > "$MEDICIONES"
+	i=0
+	while [ $i -lt $REPETICIONES ]; do
+		inicio=$(date +%s%N)
+		(cd "$directorio" && "$TP" --stats=json $opciones "$entrada") \
+			> "$SALIDA" 2> "$SALIDA.stats"
+		fin=$(date +%s%N)
+
+		rss=$(sed -n 's/.*"rss_pico_kb":\([0-9]*\).*/\1/p' "$SALIDA.stats")
+		echo "$(( (fin - inicio) / 1000 )) $rss" >> "$MEDICIONES"
+		i=$((i + 1))
+	done
+	rm -f "$SALIDA.stats"
+
+	# Verificamos la salida de la última corrida
+	if [ -n "$esperada" ] && ! cmp -s "$SALIDA" "$esperada"; then
+		estado="SALIDA INCORRECTA"
+		fallas=$((fallas + 1))
+	fi
+
+	us=$(cut -d' ' -f1 "$MEDICIONES" | mediana)
+	ms=$(awk -v us=$us 'BEGIN { printf "%.3f", us / 1000 }')
+	kb=$(cut -d' ' -f2 "$MEDICIONES" | mediana)
+	echo "$nombre $ms $kb" >> "$NUEVA_BASE"
+
+	# Comparamos contra la línea base
+	base=$(awk -v n="$nombre" '$1 == n { print $2, $3 }' "$LINEA_BASE" \
+		2>/dev/null)
+
+	if [ "$ACTUALIZAR" != "si" ] && [ -n "$base" ]; then
+		set -- $base
+		if awk -v ms=$ms -v b=$1 -v m=$MARGEN -v t=$TOLERANCIA_MS \
+			'BEGIN { exit !(ms > b * (1 + m / 100) + t) }'; then
+			estado="MAS LENTO (base $1 ms)"
+			fallas=$((fallas + 1))
+		elif awk -v kb=$kb -v b=$2 -v m=$MARGEN \
+			'BEGIN { exit !(kb > b * (1 + m / 100)) }'; then
+			estado="MAS MEMORIA (base $2 KiB)"
+			fallas=$((fallas + 1))
+		fi
+	elif [ "$ACTUALIZAR" != "si" ]; then
+		estado="$estado (sin línea base)"
+	fi
+
+	printf "%-34s %12s ms %10s KiB   %s\n" "$nombre" $ms $kb "$estado"
+}
+
+
+printf "%-34s %15s %14s   %s\n" CASO MEDIANA RSS ESTADO
+
+# Casos de prueba con su salida esperada
+for caso in "$CASOS"/*/; do
+	[ -f "$caso/input" ] || continue
+	nombre=$(basename "$caso" | tr ' ' '_')
+	esperada=""
+	opciones=""
+	[ -f "$caso/__stdout__" ] && esperada="$caso/__stdout__"
+	[ -f "$caso/opciones" ] && opciones=$(cat "$caso/opciones")
+	medir "$nombre" "$caso" input "$esperada" "$opciones"
+done
+
+# Redes generadas
+mkdir -p "$REDES"
+while read topologia aristas hosts; do
+	red="$REDES/$topologia-$aristas-$hosts-1"
+	[ -f "$red" ] || "$DIR/generador" $topologia $aristas $hosts 1 > "$red" \
+		|| exit 1
+	medir "$topologia-$aristas" . "$red"
+done <<FIN
+$GENERADAS
+FIN
+
+if [ "$ACTUALIZAR" = "si" ]; then
+	cp "$NUEVA_BASE" "$LINEA_BASE"
+	echo "Línea base actualizada en $LINEA_BASE."
+	exit 0
+fi
+
+if [ $fallas -gt 0 ]; then
+	echo "$fallas caso(s) con regresiones."
+	exit 1
+fi
+
+echo "Sin regresiones (margen $MARGEN%, $REPETICIONES repeticiones)."
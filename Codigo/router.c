@@ -9,9 +9,14 @@
  */
 
 
+#define _POSIX_C_SOURCE 200809L
+
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
+#include <limits.h>
 #include <string.h>
+#include <sys/types.h>
 
 
 
@@ -24,12 +29,16 @@
 const char S_HOST[] = "[host]";
 const char S_DEVICE[] = "[device]";
 const char S_ROUTE[] = "[route]";
-enum seccion {NONE, HOST, DEVICE, ROUTE};
+const char S_SUBNET[] = "[subnet]";
+const char S_AREA[] = "[area]";
+enum seccion {NONE, HOST, DEVICE, ROUTE, SUBNET, AREA};
 
-// Máximo de caracteres permitidos por cadena
-#define MAX_CHARS 20
-// Máximo de caracteres del buffer
-#define MAX_BUFFER 100
+// Máximo de caracteres de cada dato ingresado por la entrada estandar, y
+// formato de scanf() que lo respeta
+#define MAX_ENTRADA 255
+#define TEXTO(x) #x
+#define FORMATO_CAMPO(largo) "%" TEXTO(largo) "s"
+#define CAMPO FORMATO_CAMPO(MAX_ENTRADA)
 
 
 
@@ -40,6 +49,8 @@ enum seccion {NONE, HOST, DEVICE, ROUTE};
 typedef struct _host_t host_t;
 typedef struct _device_t device_t;
 typedef struct _route_t route_t;
+typedef struct _subnet_t subnet_t;
+typedef struct _area_t area_t;
 
 
 
@@ -57,7 +68,22 @@ typedef device_t* grafo_dato_t;
 
 #include "lista.h"
 #include "grafo.h"
+#include "grafo_compacto.h"
 #include "dijkstra.h"
+#include "delta.h"
+#include "hilos.h"
+#include "epocas.h"
+#include "areas.h"
+#include "cache.h"
+#include "persistencia.h"
+#include "fallas.h"
+#include "descompresor.h"
+#include "multiorigen.h"
+#include "cadenas.h"
+#include "ip.h"
+#include "prefijos.h"
+#include "router.h"
+#include "estadisticas.h"
 
 
 
@@ -65,27 +91,119 @@ typedef device_t* grafo_dato_t;
  * DEFINICIÓN DE LOS TIPOS DE DATOS
  * ***************************************************************************/
 
+// Los nombres se almacenan en el conjunto de cadenas de la red, y los
+// registros guardan sólo sus identificadores. Las IPs se almacenan en
+// forma binaria.
+
 // Tipo que representa a un host de una red.
 struct _host_t {
-	char nombre[MAX_CHARS];						// Nombre del host
-	char ip[MAX_CHARS];							// IP del host
-	char dispositivo_nombre[MAX_CHARS];			// Nombre del dispositivo al 
+	uint32_t nombre;							// Nombre del host
+	ip_t ip;									// IP del host
+	uint32_t dispositivo_nombre;				// Nombre del dispositivo al 
 												// cual está conectado el host
 };
 
 // Tipo que representa a un dispositivo de una red.
 struct _device_t {
-	char nombre[MAX_CHARS];						// Nombre del dispositivo
-	char ip[MAX_CHARS];							// IP del dispositivo
+	uint32_t nombre;							// Nombre del dispositivo
+	ip_t ip;									// IP del dispositivo
+	uint32_t orden;								// Posición del nombre en el
+												// orden alfabético de los
+												// dispositivos
 };
 
 // Tipo que representa una ruta o conexión entre dispositivos
 struct _route_t {
-	char ini[MAX_CHARS];						// Nombre del device de partida
-	char fin[MAX_CHARS];						// Nombre del device destino
+	uint32_t ini;								// Nombre del device de partida
+	uint32_t fin;								// Nombre del device destino
 	int peso;									// Peso asociado a la conexión
 };
 
+// Tipo que representa una subred alcanzable a través de un dispositivo
+struct _subnet_t {
+	ip_t prefijo;								// Dirección de la subred
+	unsigned int largo;							// Bits del prefijo
+	uint32_t dispositivo_nombre;				// Nombre del dispositivo al
+												// cual está conectada
+};
+
+// Tipo que representa la asignación de un dispositivo a un área
+struct _area_t {
+	uint32_t dispositivo_nombre;				// Nombre del dispositivo
+	uint32_t nombre;							// Nombre del área
+};
+
+// Tipo que representa un buffer de texto de salida en memoria.
+typedef struct {
+	char *datos;								// Texto acumulado
+	size_t largo;								// Largo del texto
+	size_t capacidad;							// Capacidad del buffer
+} salida_t;
+
+// Tipo que representa la porción de un buffer de salida que corresponde
+// a la sección de un host destino.
+typedef struct {
+	size_t buffer;								// Buffer que la contiene
+	size_t inicio;								// Posición en el buffer
+	size_t largo;								// Largo de la sección
+} seccion_t;
+
+// Tipo que representa una versión inmutable del grafo de la red junto con
+// sus caminos mínimos, que las consultas fijan mientras la utilizan. Sólo
+// se modifica la tabla de caminos ya extraídos, en forma atómica.
+typedef struct {
+	grafo_compacto_t *grafo;					// Grafo de dispositivos
+	dijkstra_resultados_t *resultados;			// Resultados de Dijkstra
+	lista_t **caminos_por_vertice;				// Caminos hacia cada
+												// dispositivo consultado,
+												// indexados por vértice
+} version_t;
+
+// Tipo que representa a una red junto con los resultados de cada etapa
+// de su procesamiento.
+struct _red_t {
+	lista_t *hosts;								// Hosts de la red
+	lista_t *devices;							// Dispositivos de la red
+	lista_t *routes;							// Conexiones entre dispositivos
+	lista_t *subnets;							// Subredes de la red
+	lista_t *areas;								// Áreas de los dispositivos
+	cadenas_t *cadenas;							// Nombres e IPs de la red
+	device_t **devices_por_nombre;				// Dispositivo de cada nombre,
+												// indexado por identificador
+	grafo_compacto_t *grafo;					// Grafo de dispositivos
+	dijkstra_resultados_t *resultados;			// Resultados de Dijkstra
+	areas_t *particion;							// División del grafo en
+												// áreas, o NULL
+	hilos_t *hilos;								// Hilos de procesamiento
+	salida_t *salidas;							// Buffer de salida de cada
+												// hilo
+	seccion_t *secciones;						// Sección [route_path] de
+												// cada host destino, en el
+												// orden de la lista de hosts
+	size_t cantidad_secciones;					// Cantidad de secciones
+	prefijos_t *prefijos;						// Dispositivo responsable de
+												// cada IP y subred
+	bool admite_cambios;						// Indica si se conserva el
+												// grafo de listas para
+												// modificar la topología
+	grafo_t *topologia;							// Grafo de listas que
+												// modifica el escritor
+	cache_t *cache;								// Árboles de caminos mínimos
+												// ya calculados, por origen
+												// y versión de la
+												// topología, o NULL
+	red_orden_t orden;							// Orden de numeración de los
+												// dispositivos del grafo
+	size_t k_caminos;							// Caminos mínimos que se
+												// informan hacia cada host
+	epocas_t *versiones;						// Versión vigente del grafo
+												// y sus caminos, para las
+												// consultas
+	uint32_t *distancias;						// Distancia entre cada par
+												// de hosts, por filas en el
+												// orden de la lista de hosts
+};
+
 
 
 /* ****************************************************************************
@@ -96,7 +214,8 @@ struct _route_t {
 // POST: devuelve un host o NULL si no ha sido posible llevar a cabo
 // la creación del mismo.
 host_t* host_crear() {
-	host_t *host = (host_t*) malloc(sizeof(host_t));
+	host_t *host = (host_t*) estadisticas_malloc(SUBSISTEMA_ROUTER,
+		sizeof(host_t));
 	if(!host) exit(0);
 	return host;
 }
@@ -105,14 +224,15 @@ host_t* host_crear() {
 // PRE: 'host' es un host existente.
 // POST: se eliminó el host.
 void host_destruir(host_t *host) {
-	free(host);
+	estadisticas_free(SUBSISTEMA_ROUTER, host);
 }
 
 // Crea un dispositivo.
 // POST: devuelve un dispositivo o NULL si no ha sido posible llevar a cabo
 // la creación del mismo.
 device_t* device_crear() {
-	device_t *device = (device_t*) malloc(sizeof(device_t));
+	device_t *device = (device_t*) estadisticas_malloc(SUBSISTEMA_ROUTER,
+		sizeof(device_t));
 	if(!device) exit(0);
 	return device;
 }
@@ -121,14 +241,15 @@ device_t* device_crear() {
 // PRE: 'dispositivo' es un dispositivo existente.
 // POST: se eliminó el dispositivo.
 void device_destruir(device_t *device) {
-	free(device);
+	estadisticas_free(SUBSISTEMA_ROUTER, device);
 }
 
 // Crea una ruta o conexión.
 // POST: devuelve una ruta o NULL si no ha sido posible llevar a cabo
 // la creación del mismo.
 route_t* route_crear() {
-	route_t *route = (route_t*) malloc(sizeof(route_t));
+	route_t *route = (route_t*) estadisticas_malloc(SUBSISTEMA_ROUTER,
+		sizeof(route_t));
 	if(!route) exit(0);
 	return route;
 }
@@ -137,7 +258,35 @@ route_t* route_crear() {
 // PRE: 'device' es una ruta existente.
 // POST: se eliminó la ruta.
 void route_destruir(route_t *route) {
-	free(route);
+	estadisticas_free(SUBSISTEMA_ROUTER, route);
+}
+
+// Crea una subred.
+// POST: devuelve una subred o NULL si no ha sido posible llevar a cabo
+// la creación de la misma.
+subnet_t* subnet_crear() {
+	subnet_t *subnet = (subnet_t*) estadisticas_malloc(SUBSISTEMA_ROUTER,
+		sizeof(subnet_t));
+	if(!subnet) exit(0);
+	return subnet;
+}
+
+// Crea una asignación de un dispositivo a un área.
+// POST: devuelve una asignación o NULL si no ha sido posible llevar a cabo
+// la creación de la misma.
+area_t* area_crear() {
+	area_t *area = (area_t*) estadisticas_malloc(SUBSISTEMA_ROUTER,
+		sizeof(area_t));
+	if(!area) exit(0);
+	return area;
+}
+
+// Función de destrucción de los registros (hosts, dispositivos, rutas,
+// subredes y áreas) almacenados en las listas de la red.
+// PRE: 'registro' es un registro existente.
+// POST: se eliminó el registro.
+void registro_destruir(lista_dato_t registro) {
+	estadisticas_free(SUBSISTEMA_ROUTER, registro);
 }
 
 // Función que realiza la apertura de un archivo.
@@ -202,31 +351,85 @@ bool esPrefijo(const char *d, const char *q) {
 	return true;
 }
 
+// Función que interna una cadena en el conjunto de cadenas de una red.
+// PRE: 'red' es una red existente; 'cadena' es un arreglo de 'largo'
+// caracteres.
+// POST: devuelve el identificador de la cadena.
+uint32_t red_internar(red_t *red, const char *cadena, size_t largo) {
+	uint32_t id = cadenas_internar(red->cadenas, cadena, largo);
+	if(id == CADENAS_SIN_ID) exit(0);
+	return id;
+}
+
+// Función que interpreta una IP del archivo de especificación de ruteo.
+// PRE: 'texto' es un arreglo de 'largo' caracteres; 'ip' recibe la IP.
+// POST: devuelve true si la IP es válida. En caso contrario se informa en
+// la salida de errores estandar y se devuelve false.
+bool parser_ip(const char *texto, size_t largo, ip_t *ip) {
+	if(ip_parsear(texto, largo, ip)) return true;
+
+	fprintf(stderr, "ERROR: IP inválida '%.*s', se ignora el registro.\n",
+		(int) largo, texto);
+	return false;
+}
+
+// Función que interpreta el peso de una conexión.
+// PRE: 'texto' es el peso, terminado en '\0'; 'peso' recibe su valor.
+// POST: devuelve true si el peso es un entero no negativo representable
+// como int (se ignora lo que siga a sus dígitos, como lo hace atoi()). En
+// caso contrario devuelve false.
+bool peso_parsear(const char *texto, int *peso) {
+	char *fin;
+	long valor = strtol(texto, &fin, 10);
+
+	if(fin == texto || valor < 0 || valor > INT_MAX) return false;
+
+	*peso = (int) valor;
+	return true;
+}
+
+// Función que interpreta el peso de una conexión del archivo de
+// especificación de ruteo.
+// PRE: 'texto' es el peso, terminado en '\0'; 'peso' recibe su valor.
+// POST: devuelve true si el peso es válido (ver peso_parsear()). En caso
+// contrario se informa en la salida de errores estandar y se devuelve
+// false.
+bool parser_peso(const char *texto, int *peso) {
+	if(peso_parsear(texto, peso)) return true;
+
+	fprintf(stderr, "ERROR: Peso inválido '%s', se ignora el registro.\n",
+		texto);
+	return false;
+}
+
 // Función que dada una línea de la sección [host] del archivo de 
 // especificación de ruteo, se encarga de parsear la información que en ella 
 // está contenida.
-// PRE: 'buffer' es un string con el formato '[nombre],[IP],[nombre_router]'.
-// POST: devuelve un puntero a un host que contiene la información parseada.
-host_t* parser_host(char *buffer) {
+// PRE: 'red' es la red en cuyo conjunto de cadenas se almacenan los datos;
+// 'buffer' es un string con el formato '[nombre],[IP],[nombre_router]', sin
+// el fin de línea.
+// POST: devuelve un puntero a un host que contiene la información parseada,
+// o NULL si la línea no respeta el formato o la IP no es válida.
+host_t* parser_host(red_t *red, char *buffer) {
+	ip_t ip;
+
+	// Ubicamos los separadores de los campos y validamos la IP
+	char* segmento_1 = strchr(buffer, ',');
+	if(!segmento_1) return NULL;
+	char* segmento_2 = strchr(segmento_1 + 1, ',');
+	if(!segmento_2) return NULL;
+	if(!parser_ip(segmento_1 + 1, segmento_2 - segmento_1 - 1, &ip))
+		return NULL;
+
 	// Creamos un host nuevo
 	host_t *host = host_crear();
 
-	// Parseamos el nombre del host
-	char* segmento_1 = strstr(buffer, ",");
-	int n = strlen(buffer) - strlen(segmento_1);
-	strncpy(host->nombre, buffer, n);
-	host->nombre[n] = '\0';
-
-	// Parseamos la IP del host
-	char* segmento_2 = strstr(++segmento_1, ",");
-	n = strlen(segmento_1) - strlen(segmento_2);
-	strncpy(host->ip, segmento_1, n);
-	host->ip[n] = '\0';
-
-	// Parseamos el nombre del dispositivo al cual esta conectado
-	++segmento_2;
-	strncpy(host->dispositivo_nombre, segmento_2, strlen(segmento_2) - 1);
-	host->dispositivo_nombre[strlen(segmento_2) - 1] = '\0';
+	// Parseamos el nombre del host y el nombre del dispositivo al cual
+	// esta conectado
+	host->nombre = red_internar(red, buffer, segmento_1 - buffer);
+	host->ip = ip;
+	host->dispositivo_nombre = red_internar(red, segmento_2 + 1,
+		strlen(segmento_2 + 1));
 
 	return host;
 }
@@ -234,23 +437,25 @@ host_t* parser_host(char *buffer) {
 // Función que dada una línea de la sección [device] del archivo de 
 // especificación de ruteo, se encarga de parsear la información que en ella 
 // está contenida.
-// PRE: 'buffer' es un string con el formato '[nombre_router],[IP]'.
-// POST: devuelve un puntero a un device que contiene la información parseada.
-device_t* parser_device(char *buffer) {
+// PRE: 'red' es la red en cuyo conjunto de cadenas se almacenan los datos;
+// 'buffer' es un string con el formato '[nombre_router],[IP]', sin el fin
+// de línea.
+// POST: devuelve un puntero a un device que contiene la información
+// parseada, o NULL si la línea no respeta el formato o la IP no es válida.
+device_t* parser_device(red_t *red, char *buffer) {
+	ip_t ip;
+
+	// Ubicamos el separador de los campos y validamos la IP
+	char* segmento_1 = strchr(buffer, ',');
+	if(!segmento_1) return NULL;
+	if(!parser_ip(segmento_1 + 1, strlen(segmento_1 + 1), &ip)) return NULL;
+
 	// Creamos un device nuevo
 	device_t *device = device_crear();
 
 	// Parseamos el nombre del dispositivo
-	char* segmento_1 = strstr(buffer, ",");
-	int n = strlen(buffer) - strlen(segmento_1);
-	strncpy(device->nombre, buffer, n);
-	device->nombre[n] = '\0';
-
-	// Parseamos la IP del dispositivo
-	++segmento_1;
-	n = strlen(segmento_1) - 1;
-	strncpy(device->ip, segmento_1, n);
-	device->ip[n] = '\0';
+	device->nombre = red_internar(red, buffer, segmento_1 - buffer);
+	device->ip = ip;
 
 	return device;
 }
@@ -258,91 +463,277 @@ device_t* parser_device(char *buffer) {
 // Función que dada una línea de la sección [route] del archivo de 
 // especificación de ruteo, se encarga de parsear la información que en ella 
 // está contenida.
-// PRE: 'buffer' es un string con el formato '[router_ini]->[router_fin],peso'.
-// POST: devuelve un puntero a un route que contiene la información parseada.
-route_t* parser_route(char *buffer) {
+// PRE: 'red' es la red en cuyo conjunto de cadenas se almacenan los datos;
+// 'buffer' es un string con el formato '[router_ini]->[router_fin],peso',
+// sin el fin de línea.
+// POST: devuelve un puntero a un route que contiene la información
+// parseada, o NULL si la línea no respeta el formato o el peso no es
+// válido.
+route_t* parser_route(red_t *red, char *buffer) {
+	int peso;
+
+	// Ubicamos los separadores de los campos y validamos el peso
+	char* segmento_1 = strstr(buffer, "->");
+	if(!segmento_1) return NULL;
+	char* segmento_2 = strchr(segmento_1 + 2, ',');
+	if(!segmento_2) return NULL;
+	if(!parser_peso(segmento_2 + 1, &peso)) return NULL;
+
 	// Creamos una conexión nueva
 	route_t *route = route_crear();
 
-	// Parseamos el dispositivo de partida
-	char* segmento_1 = strstr(buffer, "->");
-	int n = strlen(buffer) - strlen(segmento_1);
-	strncpy(route->ini, buffer, n);
-	route->ini[n] = '\0';
-
-	// Parseamos el dispositivo destino
-	++segmento_1;
-	char* segmento_2 = strstr(++segmento_1, ",");
-	n = strlen(segmento_1) - strlen(segmento_2);
-	strncpy(route->fin, segmento_1, n);
-	route->fin[n] = '\0';
-
-	// Parseamos el peso de la conexión
-	char s_peso[MAX_CHARS] = "";
-	++segmento_2;
-	strncpy(s_peso, segmento_2, strlen(segmento_2) - 1);
-	route->peso = atoi(s_peso);
+	// Parseamos los dispositivos de partida y destino, y el peso de la
+	// conexión
+	route->ini = red_internar(red, buffer, segmento_1 - buffer);
+	route->fin = red_internar(red, segmento_1 + 2, segmento_2 - segmento_1 - 2);
+	route->peso = peso;
 
 	return route;
 }
 
-// Función que busca dispositivo en una lista de dispositivos.
-// PRE: 'devices' es una lista que contiene dispositivos; 'nombre'
-// es el nombre del dispositivo que se desea buscar.
+// Función que dada una línea de la sección [subnet] del archivo de 
+// especificación de ruteo, se encarga de parsear la información que en ella 
+// está contenida.
+// PRE: 'red' es la red en cuyo conjunto de cadenas se almacenan los datos;
+// 'buffer' es un string con el formato '[IP]/[largo],[nombre_router]', sin
+// el fin de línea.
+// POST: devuelve un puntero a una subred que contiene la información
+// parseada, o NULL si la línea no respeta el formato o el prefijo no es
+// válido.
+subnet_t* parser_subnet(red_t *red, char *buffer) {
+	ip_t ip;
+	char *fin;
+
+	// Ubicamos los separadores de los campos y validamos el prefijo
+	char* segmento_1 = strchr(buffer, '/');
+	if(!segmento_1) return NULL;
+	char* segmento_2 = strchr(segmento_1 + 1, ',');
+	if(!segmento_2) return NULL;
+	if(!parser_ip(buffer, segmento_1 - buffer, &ip)) return NULL;
+
+	unsigned long largo = strtoul(segmento_1 + 1, &fin, 10);
+
+	if(fin != segmento_2 || fin == segmento_1 + 1 ||
+		largo > (ip.familia == IP_V4 ? 32u : 128u)) {
+		fprintf(stderr, "ERROR: Prefijo inválido '%.*s', se ignora el "
+			"registro.\n", (int) (segmento_2 - buffer), buffer);
+		return NULL;
+	}
+
+	// Creamos una subred nueva
+	subnet_t *subnet = subnet_crear();
+	subnet->prefijo = ip;
+	subnet->largo = largo;
+	subnet->dispositivo_nombre = red_internar(red, segmento_2 + 1,
+		strlen(segmento_2 + 1));
+
+	return subnet;
+}
+
+// Función que dada una línea de la sección [area] del archivo de
+// especificación de ruteo, se encarga de parsear la información que en ella
+// está contenida.
+// PRE: 'red' es la red en cuyo conjunto de cadenas se almacenan los datos;
+// 'buffer' es un string con el formato '[nombre_router],[area]', sin el fin
+// de línea.
+// POST: devuelve un puntero a una asignación que contiene la información
+// parseada, o NULL si la línea no respeta el formato.
+area_t* parser_area(red_t *red, char *buffer) {
+	// Ubicamos el separador de los campos
+	char* segmento_1 = strchr(buffer, ',');
+	if(!segmento_1 || !segmento_1[1]) return NULL;
+
+	// Creamos una asignación nueva
+	area_t *area = area_crear();
+	area->dispositivo_nombre = red_internar(red, buffer, segmento_1 - buffer);
+	area->nombre = red_internar(red, segmento_1 + 1, strlen(segmento_1 + 1));
+
+	return area;
+}
+
+// Función que descarta los hosts conectados a un dispositivo que no figura
+// en la especificación. Como la sección [host] precede a la sección
+// [device], la verificación se realiza una vez leída la especificación.
+// PRE: 'red' es una red cargada.
+// POST: se eliminaron de la lista 'hosts' de la red los hosts cuyo
+// dispositivo no está en la lista 'devices', informando cada uno en la
+// salida de errores estandar.
+void parser_validar_hosts(red_t *red) {
+	uint32_t j, cantidad = cadenas_cantidad(red->cadenas);
+	lista_dato_t dato;
+
+	bool *existe = (bool*) estadisticas_malloc(SUBSISTEMA_ROUTER,
+		(cantidad + 1) * sizeof(bool));
+	if(!existe) exit(0);
+
+	for(j = 0; j < cantidad; j++) existe[j] = false;
+
+	// Marcamos los nombres de los dispositivos cargados
+	lista_iter_t* iter = lista_iter_crear(red->devices);
+
+	while(!lista_iter_al_final(iter)) {
+		lista_iter_ver_actual(iter, &dato);
+		existe[((device_t*) dato)->nombre] = true;
+		lista_iter_avanzar(iter);
+	}
+
+	lista_iter_destruir(iter);
+
+	// Eliminamos los hosts cuyo dispositivo no fue marcado
+	iter = lista_iter_crear(red->hosts);
+
+	while(!lista_iter_al_final(iter)) {
+		lista_iter_ver_actual(iter, &dato);
+		host_t *host = (host_t*) dato;
+
+		if(existe[host->dispositivo_nombre]) {
+			lista_iter_avanzar(iter);
+			continue;
+		}
+
+		fprintf(stderr, "ERROR: Dispositivo inexistente '%s' del host '%s', "
+			"se ignora el registro.\n",
+			cadenas_obtener(red->cadenas, host->dispositivo_nombre),
+			cadenas_obtener(red->cadenas, host->nombre));
+		lista_borrar(red->hosts, iter, &dato);
+		host_destruir(host);
+	}
+
+	lista_iter_destruir(iter);
+	estadisticas_free(SUBSISTEMA_ROUTER, existe);
+}
+
+// Función que busca un dispositivo de la red por su nombre.
+// PRE: 'red' es una red cuyos dispositivos ya fueron indexados por nombre
+// (ver red_indexar_devices()); 'nombre' es el identificador del nombre
+// del dispositivo que se desea buscar.
 // POST: si se lo encuentra, se devuelve un puntero al dispositivo.
 // En caso contrario, se devuelve NULL;
-device_t* buscar_device(lista_t *devices, char *nombre) {
-	// Iteramos sobre la lista de dispositivos hasta encontrar
-	// el que buscamos
-	lista_iter_t* iter = lista_iter_crear(devices);
+device_t* buscar_device(red_t *red, uint32_t nombre) {
+	return red->devices_por_nombre[nombre];
+}
+
+// Función que parsea un cambio de topología, con el formato
+// '[D1]->[D2],[PESO]' para crear o modificar una conexión, o
+// '[D1]->[D2],-' para eliminarla.
+// PRE: 'red' es una red cuyos dispositivos ya fueron indexados por nombre;
+// 'buffer' es la línea a parsear; 'ini', 'fin' y 'peso' reciben los
+// dispositivos de partida y destino y el peso de la conexión (negativo si
+// se la elimina).
+// POST: devuelve false si la línea no tiene el formato indicado, si el
+// peso no es válido (ver peso_parsear()) o si alguno de los dispositivos
+// no existe. No agrega nombres al conjunto de cadenas de la red, por lo
+// que no interfiere con las consultas.
+bool parser_cambio(red_t *red, char *buffer, device_t **ini,
+	device_t **fin, int *peso) {
+	uint32_t nombre;
+
+	// Ubicamos los separadores de los campos
+	char* segmento_1 = strstr(buffer, "->");
+	if(!segmento_1) return false;
+	char* segmento_2 = strchr(segmento_1 + 2, ',');
+	if(!segmento_2) return false;
+
+	// Buscamos los dispositivos de partida y destino
+	nombre = cadenas_buscar(red->cadenas, buffer, segmento_1 - buffer);
+	if(nombre == CADENAS_SIN_ID || !(*ini = buscar_device(red, nombre)))
+		return false;
+
+	nombre = cadenas_buscar(red->cadenas, segmento_1 + 2,
+		segmento_2 - segmento_1 - 2);
+	if(nombre == CADENAS_SIN_ID || !(*fin = buscar_device(red, nombre)))
+		return false;
+
+	if(!strcmp(segmento_2 + 1, "-")) {
+		*peso = -1;
+		return true;
+	}
+
+	return peso_parsear(segmento_2 + 1, peso);
+}
+
+// Tipo auxiliar para ordenar los dispositivos por nombre
+typedef struct {
+	const char *nombre;							// Nombre del dispositivo
+	device_t *device;							// Dispositivo
+} device_nombre_t;
+
+// Función de comparación de dispositivos por nombre, para qsort().
+// PRE: 'a' y 'b' son punteros a device_nombre_t.
+int comparar_devices_por_nombre(const void *a, const void *b) {
+	return strcmp(((const device_nombre_t*) a)->nombre,
+		((const device_nombre_t*) b)->nombre);
+}
+
+// Función que indexa los dispositivos de una red por el identificador de
+// su nombre y calcula la posición de cada uno en el orden alfabético.
+// PRE: 'red' es una red cargada.
+// POST: buscar_device() devuelve, para cada nombre, el primer dispositivo
+// cargado con ese nombre; el campo 'orden' de dos dispositivos compara
+// igual que sus nombres.
+void red_indexar_devices(red_t *red) {
+	size_t i, n = lista_largo(red->devices);
+	uint32_t j, cantidad = cadenas_cantidad(red->cadenas);
 	lista_dato_t device;
 
-	while(!lista_iter_al_final(iter)) {
+	red->devices_por_nombre = (device_t**) estadisticas_malloc(
+		SUBSISTEMA_ROUTER, (cantidad + 1) * sizeof(device_t*));
+	device_nombre_t *orden = (device_nombre_t*) estadisticas_malloc(
+		SUBSISTEMA_ROUTER, (n + 1) * sizeof(device_nombre_t));
+	if(!red->devices_por_nombre || !orden) exit(0);
+
+	for(j = 0; j < cantidad; j++) red->devices_por_nombre[j] = NULL;
+
+	// Recorremos los dispositivos en el orden en que fueron cargados
+	lista_iter_t* iter = lista_iter_crear(red->devices);
+
+	for(i = 0; !lista_iter_al_final(iter); i++) {
 		lista_iter_ver_actual(iter, &device);
-		
-		if(!strcmp(((device_t*) device)->nombre, nombre)) {
-			lista_iter_destruir(iter);
-			return (device_t*) device;
-		}
+		device_t *d = (device_t*) device;
 
+		if(!red->devices_por_nombre[d->nombre])
+			red->devices_por_nombre[d->nombre] = d;
+
+		orden[i].nombre = cadenas_obtener(red->cadenas, d->nombre);
+		orden[i].device = d;
 		lista_iter_avanzar(iter);
 	}
-	
+
 	lista_iter_destruir(iter);
 
-	return NULL;
+	// Numeramos los nombres en orden alfabético. Los nombres repetidos
+	// reciben el mismo número.
+	qsort(orden, n, sizeof(device_nombre_t), comparar_devices_por_nombre);
+
+	for(i = 0, j = 0; i < n; i++) {
+		if(i && orden[i].device->nombre != orden[i - 1].device->nombre) j++;
+		orden[i].device->orden = j;
+	}
+
+	estadisticas_free(SUBSISTEMA_ROUTER, orden);
 }
 
-// Función que procesa el archivo de especificación de ruteo.
-// PRE: 'archivo' es el nombre de archivo (incluyendo su extensión) donde
-// se encuentran especificadas las reglas de routeo, los dispositivos y
-// hosts existentes en la red; 'devices' es una lista de dispositivos 
-// (device_t); 'hosts' es una lista de hosts (host_t). 
-// POST: se devuelve un grafo cuyos vértices son los dispositivos procesados
-// (de tipo 'device_t') y cuyas aristas son las rutas o conexiones procesadas. 
-// Se almacenan además los dispositivos y hosts procesados en las listas
-// 'devices' y 'hosts' respectivamete.
-// NOTA: Al ser extraídos de las listas deben ser casteados a sus respectivos
-// tipos para poder ser utilizados debidamente.
-grafo_t* armar_red_archivo_de_entrada(char* archivo, lista_t *devices, 
-	lista_t *hosts) {
-	// Variables para el tratamiento del archivo
-	FILE *fp;
-	char buffer[MAX_BUFFER];
+// Función que procesa una especificación de ruteo leída de un flujo.
+// PRE: 'fp' es un flujo abierto para lectura que contiene la
+// especificación, en el formato del archivo de entrada; 'red' es una red
+// existente.
+// POST: se leyó el flujo hasta su fin y se almacenan los hosts,
+// dispositivos, conexiones y subredes procesados en las listas 'hosts',
+// 'devices', 'routes' y 'subnets' de la red respectivamente. El flujo no
+// se cierra.
+void armar_red_flujo(FILE *fp, red_t *red) {
+	char *buffer = NULL;
+	size_t capacidad = 0;
+	ssize_t largo;
 	int seccion = NONE;
-	host_t* host;
-	device_t* device;
-	route_t* route;
-
-	
-	// Apertura del archivo para lectura
-	fp = archivo_abrir(archivo);
+	lista_dato_t registro;
 
-	// Creamos el grafo de la red
-	grafo_t* grafo_red = grafo_crear();
+	// Procesamos linea por linea del flujo, sin límite de largo
+	while((largo = getline(&buffer, &capacidad, fp)) != -1) {
+		// Quitamos el fin de línea e ignoramos las líneas vacías
+		if(largo && buffer[largo - 1] == '\n') buffer[--largo] = '\0';
+		if(!largo) continue;
 
-	// Procesamos linea por linea del archivo
-	while(fgets(buffer, MAX_BUFFER, fp)) {
 		// Verificamos si ha cambiado la sección
 		if(esPrefijo(buffer, S_HOST)) {
 			seccion = HOST;
@@ -356,73 +747,140 @@ grafo_t* armar_red_archivo_de_entrada(char* archivo, lista_t *devices,
 			seccion = ROUTE;
 			continue;
 		}
+		else if (esPrefijo(buffer, S_SUBNET)) {
+			seccion = SUBNET;
+			continue;
+		}
+		else if (esPrefijo(buffer, S_AREA)) {
+			seccion = AREA;
+			continue;
+		}
 
 		// Si no ha cambiado la sección, procesamos de acuerdo
-		// a la sección en la que nos encontremos
+		// a la sección en la que nos encontremos. Las líneas que no
+		// respetan el formato se ignoran.
 		switch(seccion) {
 			// Procesamos host
-			case HOST:		host = parser_host(buffer);
-							// Agregamos el host a la lista de hosts
-							lista_insertar_ultimo(hosts, (lista_dato_t) host);
+			case HOST:		if((registro = parser_host(red, buffer)))
+								lista_insertar_ultimo(red->hosts, registro);
 							break;
 
 			// Procesamos device
-			case DEVICE:	device = parser_device(buffer);
-							// Agregamos el device como vértice en el grafo
-							grafo_nuevo_vertice(grafo_red, device);
-							// Agregamos el device a la lista de devices
-							lista_insertar_ultimo(devices, 
-								(lista_dato_t) device);
+			case DEVICE:	if((registro = parser_device(red, buffer)))
+								lista_insertar_ultimo(red->devices, registro);
 							break;
 
 			// Procesamos route
-			case ROUTE:		route = parser_route(buffer);
-							// Creamos la arista de la conexión en el grafo
-							grafo_crear_arista(grafo_red, 
-								buscar_device(devices, route->ini), 
-								buscar_device(devices, route->fin),
-								route->peso);
-							route_destruir(route);
+			case ROUTE:		if((registro = parser_route(red, buffer)))
+								lista_insertar_ultimo(red->routes, registro);
+							break;
+
+			// Procesamos subnet
+			case SUBNET:	if((registro = parser_subnet(red, buffer)))
+								lista_insertar_ultimo(red->subnets, registro);
+							break;
+
+			// Procesamos área
+			case AREA:		if((registro = parser_area(red, buffer)))
+								lista_insertar_ultimo(red->areas, registro);
 							break;
 		}
 	}
 
+	free(buffer);
+}
+
+// Función que procesa una especificación de ruteo leída de un flujo que
+// puede estar comprimido (ver descompresor.h).
+// PRE: 'fp' es un flujo abierto para lectura del que aún no se leyó nada;
+// 'nombre' es el nombre con el que se lo menciona en los mensajes de
+// error; 'red' es una red existente.
+// POST: se procesó el contenido descomprimido del flujo como en
+// armar_red_flujo(). Si el formato no fue incluido al compilar, no puede
+// leerse o el contenido está dañado, se informa el error y se finaliza el
+// programa. El flujo no se
+// cierra.
+void armar_red_flujo_comprimido(FILE *fp, const char *nombre, red_t *red) {
+	descompresor_formato_t formato;
+	descompresor_t *descompresor = descompresor_abrir(fp, &formato);
+
+	if(!descompresor && !descompresor_incluido(formato)) {
+		printf("ERROR: El formato %s de %s no fue incluido al compilar "
+			"(ver 'make %s=si').\n", descompresor_nombre(formato), nombre,
+			descompresor_nombre(formato));
+		// Se retorna 0 en todos los casos, a pesar de existir error.
+		exit(0);
+	}
+
+	if(!descompresor) {
+		printf("ERROR: No ha sido posible descomprimir %s (formato %s).\n",
+			nombre, descompresor_nombre(formato));
+		// Se retorna 0 en todos los casos, a pesar de existir error.
+		exit(0);
+	}
+
+	armar_red_flujo(descompresor_flujo(descompresor), red);
+
+	if(!descompresor_cerrar(descompresor)) {
+		printf("ERROR: El contenido de %s está dañado o incompleto.\n",
+			nombre);
+		exit(0);
+	}
+}
+
+// Función que procesa el archivo de especificación de ruteo.
+// PRE: 'archivo' es el nombre de archivo (incluyendo su extensión) donde
+// se encuentran especificadas las reglas de routeo, los dispositivos y
+// hosts existentes en la red, en texto o comprimido; 'red' es una red
+// existente.
+// POST: se almacenan los hosts, dispositivos, conexiones y subredes
+// procesados en las listas 'hosts', 'devices', 'routes' y 'subnets' de la
+// red respectivamente.
+// NOTA: Al ser extraídos de las listas deben ser casteados a sus respectivos
+// tipos para poder ser utilizados debidamente.
+void armar_red_archivo_de_entrada(char* archivo, red_t *red) {
+	// Apertura del archivo para lectura
+	FILE *fp = archivo_abrir(archivo);
+
+	armar_red_flujo_comprimido(fp, archivo, red);
+
 	// Cerramos el archivo
 	archivo_cerrar(fp);
-
-	return grafo_red;
 }
 
 // Función que solicita y procesa las especificaciones de routeo al usuario.
-// PRE: 'devices' es una lista de dispositivos (device_t); 'hosts' es una 
-// lista de hosts (host_t). 
-// POST: se devuelve un grafo cuyos vértices son los dispositivos procesados
-// (de tipo 'device_t') y cuyas aristas son las rutas o conexiones procesadas. 
-// Se almacenan además los dispositivos y hosts procesados en las listas
-// 'devices' y 'hosts' respectivamete.
+// PRE: 'red' es una red existente.
+// POST: se almacenan los hosts, dispositivos y conexiones ingresados en
+// las listas 'hosts', 'devices' y 'routes' de la red respectivamente.
 // NOTA: Al ser extraídos de las listas deben ser casteados a sus respectivos
 // tipos para poder ser utilizados debidamente.
-grafo_t* armar_red_entrada_estandar(lista_t *devices, lista_t *hosts) {
-	// Creamos el grafo de la red
-	grafo_t* grafo_red = grafo_crear();
-
-	char nombre[MAX_CHARS], ip[MAX_CHARS], nombre_router[MAX_CHARS];
-	char d1[MAX_CHARS], d2[MAX_CHARS], peso[MAX_CHARS];
+void armar_red_entrada_estandar(red_t *red) {
+	char nombre[MAX_ENTRADA + 1], ip[MAX_ENTRADA + 1];
+	char nombre_router[MAX_ENTRADA + 1], peso[MAX_ENTRADA + 1];
+	ip_t direccion;
+	int valor;
 
 	// Leer hosts
 	printf("\nEspecificación de HOSTS\n");
 
 	while(true) {
 		printf("\n\nIngrese un host (NOMBRE IP NOMBRE_ROUTER): ");
-		scanf("%s %s %s", nombre, ip, nombre_router);
+		scanf(CAMPO " " CAMPO " " CAMPO, nombre, ip, nombre_router);
+
+		// Volvemos a solicitar el host si la IP no es válida
+		if(!ip_parsear(ip, strlen(ip), &direccion)) {
+			printf("IP inválida. ");
+			continue;
+		}
 
 		host_t *host = host_crear();
-		strcpy(host->nombre, nombre);
-		strcpy(host->ip, ip);
-		strcpy(host->dispositivo_nombre, nombre_router);
+		host->nombre = red_internar(red, nombre, strlen(nombre));
+		host->ip = direccion;
+		host->dispositivo_nombre = red_internar(red, nombre_router,
+			strlen(nombre_router));
 
 		// Agregamos el host a la lista de hosts
-		lista_insertar_ultimo(hosts, (lista_dato_t) host);
+		lista_insertar_ultimo(red->hosts, (lista_dato_t) host);
 
 		printf("Host agregado. ");
 
@@ -435,16 +893,20 @@ grafo_t* armar_red_entrada_estandar(lista_t *devices, lista_t *hosts) {
 
 	while(true) {
 		printf("\nIngrese un dispositivo (NOMBRE_ROUTER IP): ");
-		scanf("%s %s", nombre, ip);
+		scanf(CAMPO " " CAMPO, nombre, ip);
+
+		// Volvemos a solicitar el dispositivo si la IP no es válida
+		if(!ip_parsear(ip, strlen(ip), &direccion)) {
+			printf("IP inválida. ");
+			continue;
+		}
 
 		device_t *device = device_crear();
-		strcpy(device->nombre, nombre);
-		strcpy(device->ip, ip);
+		device->nombre = red_internar(red, nombre, strlen(nombre));
+		device->ip = direccion;
 		
-		// Agregamos el device como vértice en el grafo
-		grafo_nuevo_vertice(grafo_red, device);
 		// Agregamos el device a la lista de devices
-		lista_insertar_ultimo(devices, (lista_dato_t) device);
+		lista_insertar_ultimo(red->devices, (lista_dato_t) device);
 
 		printf("Dispositivo agregado. ");
 
@@ -457,18 +919,21 @@ grafo_t* armar_red_entrada_estandar(lista_t *devices, lista_t *hosts) {
 
 	while(true) {
 		printf("\nIngrese una ruta (DISPOSITIVO_1 DISPOSITIVO_2 PESO): ");
-		scanf("%s %s %s", d1, d2, peso);
+		scanf(CAMPO " " CAMPO " " CAMPO, nombre, nombre_router, peso);
+
+		// Volvemos a solicitar la ruta si el peso no es válido
+		if(!peso_parsear(peso, &valor)) {
+			printf("Peso inválido. ");
+			continue;
+		}
 
 		route_t *route = route_crear();
-		strcpy(route->ini, d1);
-		strcpy(route->fin, d2);
-		route->peso = atoi(peso);
-
-		// Creamos la arista de la conexión en el grafo
-		grafo_crear_arista(grafo_red, buscar_device(devices, route->ini),
-									  buscar_device(devices, route->fin),
-									  route->peso);
-		route_destruir(route);
+		route->ini = red_internar(red, nombre, strlen(nombre));
+		route->fin = red_internar(red, nombre_router, strlen(nombre_router));
+		route->peso = valor;
+
+		// Agregamos la ruta a la lista de routes
+		lista_insertar_ultimo(red->routes, (lista_dato_t) route);
 
 		printf("Ruta agregada. ");
 
@@ -477,31 +942,17 @@ grafo_t* armar_red_entrada_estandar(lista_t *devices, lista_t *hosts) {
 	}
 	
 	printf("\n");
-
-	return grafo_red;
 }
 
-// Función que se encarga de envíar a la salida estandar el camino
-// de datos desde un host origen hacia uno destino a través de los
-// dispositivos de la red.
-// PRE: 'origen' es el host origen desde el que se parte; 'destino' es
-// el host destino hasta el que se desea llegar; 'camino' es una lista
-// donde los elementos son los dispositivos que conforman el camino.
-// POST: Se envia a la salida estandar con una etiqueta de sección
-// definida como [route_path:NOMBRE_HOST_ORIGEN->NOMBRE_HOST_DESTINO]
-// y debajo de esta una serie de líneas que indican el dispositivo
-// por el que se debe pasar en cada paso del recorrido, cuyo formato es
-// [NUMERO_PASO:IP].
-void enviar_camino_salida_estandar(host_t* origen, host_t* destino,
-	lista_t *camino) {
-	int i = 1;
-
-	// Imprimimos sección
-	printf("[route_path:%s->%s]\n", origen->nombre, destino->nombre);
-	
-	// Imprimimos el host origen
-	printf("%d:%s\n", i, origen->ip);
-
+// Función que envía a la salida estandar los dispositivos de un camino,
+// uno por línea con el formato [NUMERO_PASO:IP].
+// PRE: 'camino' es una lista de dispositivos; 'paso' es el número del
+// último paso enviado; 'ultimo' recibe el último dispositivo enviado.
+// POST: devuelve el número del último paso enviado. Si el camino está
+// vacío no se modifica 'ultimo'.
+int enviar_pasos_salida_estandar(lista_t *camino, int paso,
+	device_t **ultimo) {
+	char ip[IP_MAX_TEXTO];
 	lista_iter_t* iter = lista_iter_crear(camino);
 	lista_dato_t device;
 	
@@ -510,25 +961,210 @@ void enviar_camino_salida_estandar(host_t* origen, host_t* destino,
 		lista_iter_ver_actual(iter, &device);
 		
 		// Imprimimos el device
-		printf("%d:%s\n", ++i, ((device_t*)device)->ip);
+		ip_formatear(&((device_t*)device)->ip, ip);
+		printf("%d:%s\n", ++paso, ip);
+		*ultimo = (device_t*) device;
 
 		lista_iter_avanzar(iter);
 	}
 	
 	lista_iter_destruir(iter);
+	return paso;
+}
 
-	// Imprimimos el host destino
-	printf("%d:%s\n", ++i, destino->ip);
+// Agrega texto al final de un buffer de salida.
+// PRE: 'salida' es un buffer; 'texto' es un texto de 'largo' caracteres.
+// POST: se agregó el texto al buffer.
+void salida_agregar(salida_t *salida, const char *texto, size_t largo) {
+	if(salida->largo + largo > salida->capacidad) {
+		size_t capacidad = salida->capacidad ? salida->capacidad : 4096;
+		while(salida->largo + largo > capacidad) capacidad *= 2;
+
+		salida->datos = (char*) estadisticas_realloc(SUBSISTEMA_ROUTER,
+			salida->datos, capacidad);
+		if(!salida->datos) exit(0);
+		salida->capacidad = capacidad;
+	}
 
-	return;
+	memcpy(salida->datos + salida->largo, texto, largo);
+	salida->largo += largo;
+}
+
+// Agrega al final de un buffer de salida la línea de un paso de un
+// recorrido, con el formato [NUMERO_PASO:IP].
+// PRE: 'salida' es un buffer; 'paso' es el número de paso (positivo);
+// 'ip' es la IP del paso.
+// POST: se agregó la línea al buffer.
+void salida_agregar_paso(salida_t *salida, int paso, const ip_t *ip) {
+	char linea[16 + IP_MAX_TEXTO], numero[16];
+	size_t largo = 0, digitos = 0;
+
+	// Escribimos el número al revés y luego lo invertimos
+	do {
+		numero[digitos++] = '0' + paso % 10;
+		paso /= 10;
+	} while(paso);
+
+	while(digitos) linea[largo++] = numero[--digitos];
+	linea[largo++] = ':';
+
+	ip_formatear(ip, linea + largo);
+	largo += strlen(linea + largo);
+	linea[largo++] = '\n';
+
+	salida_agregar(salida, linea, largo);
+}
+
+// Función que se encarga de escribir en un buffer de salida el camino
+// de datos desde un host origen hacia uno destino a través de los
+// dispositivos de la red.
+// PRE: 'salida' es un buffer; 'cadenas' es el conjunto de cadenas de la
+// red; 'origen' es el host origen desde el que se parte; 'destino' es el
+// host destino hasta el que se desea llegar; 'camino' es una lista donde
+// los elementos son los dispositivos que conforman el camino, o NULL si
+// el destino no es alcanzable; 'alternativa' es la posición del camino
+// entre los k caminos mínimos hacia el destino, o 0 si sólo se informa
+// el mejor; 'costo' es el costo del camino.
+// POST: Se agregó al buffer una etiqueta de sección definida como
+// [route_path:NOMBRE_HOST_ORIGEN->NOMBRE_HOST_DESTINO] (o, con una
+// alternativa, [route_path:NOMBRE_HOST_ORIGEN->NOMBRE_HOST_DESTINO#
+// ALTERNATIVA:COSTO]) y debajo de esta una serie de líneas que indican el
+// dispositivo por el que se debe pasar en cada paso del recorrido, cuyo
+// formato es [NUMERO_PASO:IP]. Sin camino, la etiqueta no lleva
+// alternativa y debajo se agrega la línea 'sin ruta'.
+void formatear_camino(salida_t *salida, const cadenas_t *cadenas,
+	host_t* origen, host_t* destino, lista_t *camino, size_t alternativa,
+	uint64_t costo) {
+	int i = 1;
+	const char *nombre;
+	lista_dato_t device;
+	char numeros[48];
+
+	// Escribimos la sección
+	salida_agregar(salida, "[route_path:", 12);
+	nombre = cadenas_obtener(cadenas, origen->nombre);
+	salida_agregar(salida, nombre, strlen(nombre));
+	salida_agregar(salida, "->", 2);
+	nombre = cadenas_obtener(cadenas, destino->nombre);
+	salida_agregar(salida, nombre, strlen(nombre));
+
+	if(!camino) {
+		salida_agregar(salida, "]\nsin ruta\n", 11);
+		return;
+	}
+
+	if(alternativa)
+		salida_agregar(salida, numeros, sprintf(numeros, "#%zu:%llu",
+			alternativa, (unsigned long long) costo));
+
+	salida_agregar(salida, "]\n", 2);
+
+	// Escribimos el host origen
+	salida_agregar_paso(salida, i, &origen->ip);
+
+	// Escribimos los dispositivos del camino
+	lista_iter_t* iter = lista_iter_crear(camino);
+	if(!iter) exit(0);
+
+	while(!lista_iter_al_final(iter)) {
+		lista_iter_ver_actual(iter, &device);
+		salida_agregar_paso(salida, ++i, &((device_t*) device)->ip);
+		lista_iter_avanzar(iter);
+	}
+
+	lista_iter_destruir(iter);
+
+	// Escribimos el host destino
+	salida_agregar_paso(salida, ++i, &destino->ip);
+}
+
+// Función que envía a la salida estandar la respuesta a la consulta por
+// el camino hacia una IP.
+// PRE: 'cadenas' es el conjunto de cadenas de la red; 'origen' es el host
+// origen desde el que se parte; 'consulta' es la IP consultada; 'camino'
+// es la lista de dispositivos que conforman el camino hacia el dispositivo
+// responsable de la IP, o NULL si ninguno lo es o no es alcanzable.
+// POST: Se envia a la salida estandar una etiqueta de sección definida
+// como [route_query:NOMBRE_HOST_ORIGEN->IP] y debajo de esta los pasos
+// del recorrido con el formato [NUMERO_PASO:IP], terminando en la IP
+// consultada, o la línea 'sin ruta' si no hay camino.
+void enviar_consulta_salida_estandar(const cadenas_t *cadenas,
+	host_t* origen, const ip_t *consulta, lista_t *camino) {
+	int i = 1;
+	char ip[IP_MAX_TEXTO], destino[IP_MAX_TEXTO];
+	device_t *ultimo = NULL;
+
+	// Imprimimos sección
+	ip_formatear(consulta, destino);
+	printf("[route_query:%s->%s]\n", cadenas_obtener(cadenas,
+		origen->nombre), destino);
+
+	if(!camino) {
+		printf("sin ruta\n");
+		return;
+	}
+
+	// Imprimimos el host origen y los dispositivos del camino
+	ip_formatear(&origen->ip, ip);
+	printf("%d:%s\n", i, ip);
+	i = enviar_pasos_salida_estandar(camino, i, &ultimo);
+
+	// Imprimimos la IP consultada, salvo que sea la del último dispositivo
+	if(!ultimo || ip_comparar(&ultimo->ip, consulta))
+		printf("%d:%s\n", ++i, destino);
 }
 
 // Función que establece el criterio de selección de caminos para
 // el caso de poseer dos caminos de igual longitud.
 // PRE: 'c1' y 'c2' son parámetros que deben haber sido creados como
-// tipo 'device_t' (se los pasa como void por ser tratado por listas)
+// tipo 'device_t' (se los pasa como void por ser tratado por listas), y
+// sus posiciones en el orden alfabético ya calculadas.
+// POST: compara los nombres de los dispositivos como lo haría strcmp().
 int criterio_de_seleccion_de_camino(lista_dato_t c1, lista_dato_t c2) {
-	return strcmp(((device_t*) c1)->nombre, ((device_t*) c2)->nombre);
+	uint32_t o1 = ((device_t*) c1)->orden, o2 = ((device_t*) c2)->orden;
+	return (o1 > o2) - (o1 < o2);
+}
+
+// Crea una versión del grafo de la red y sus caminos mínimos.
+// PRE: 'grafo' es un grafo compacto; 'resultados' son los resultados de
+// calcular sus caminos mínimos, o NULL si no se calcularon.
+// POST: devuelve una versión que toma posesión del grafo y los resultados,
+// sin caminos extraídos.
+version_t* version_crear(grafo_compacto_t *grafo,
+	dijkstra_resultados_t *resultados) {
+	uint32_t v, n = grafo_compacto_cantidad_vertices(grafo);
+
+	version_t *version = (version_t*) estadisticas_malloc(SUBSISTEMA_ROUTER,
+		sizeof(version_t));
+	if(!version) exit(0);
+
+	version->caminos_por_vertice = (lista_t**) estadisticas_malloc(
+		SUBSISTEMA_ROUTER, (n + 1) * sizeof(lista_t*));
+	if(!version->caminos_por_vertice) exit(0);
+
+	for(v = 0; v < n; v++) version->caminos_por_vertice[v] = NULL;
+	version->grafo = grafo;
+	version->resultados = resultados;
+
+	return version;
+}
+
+// Destruye una versión del grafo de la red.
+// PRE: 'dato' es una versión (version_t) que nadie está utilizando.
+// POST: se liberó la versión junto con su grafo, sus resultados y los
+// caminos extraídos.
+void version_destruir(void *dato) {
+	version_t *version = (version_t*) dato;
+	uint32_t v, n = grafo_compacto_cantidad_vertices(version->grafo);
+
+	for(v = 0; v < n; v++)
+		if(version->caminos_por_vertice[v])
+			lista_destruir(version->caminos_por_vertice[v], NULL);
+
+	estadisticas_free(SUBSISTEMA_ROUTER, version->caminos_por_vertice);
+	if(version->resultados) dijkstra_destruir_resultados(version->resultados);
+	grafo_compacto_destruir(version->grafo);
+	estadisticas_free(SUBSISTEMA_ROUTER, version);
 }
 
 
@@ -537,6 +1173,1402 @@ int criterio_de_seleccion_de_camino(lista_dato_t c1, lista_dato_t c2) {
  * FUNCIONES DE LA LIBRERIA
  * ***************************************************************************/
 
+// Crea una red vacía.
+// POST: devuelve una red sin hosts, dispositivos ni conexiones.
+red_t* red_crear() {
+	red_t *red = (red_t*) estadisticas_malloc(SUBSISTEMA_ROUTER, sizeof(red_t));
+	if(!red) exit(0);
+
+	// Seteamos parámetros iniciales de la red
+	red->hosts = lista_crear();
+	red->devices = lista_crear();
+	red->routes = lista_crear();
+	red->subnets = lista_crear();
+	red->areas = lista_crear();
+	red->cadenas = cadenas_crear();
+	if(!red->cadenas) exit(0);
+	red->devices_por_nombre = NULL;
+	red->grafo = NULL;
+	red->resultados = NULL;
+	red->particion = NULL;
+	red->hilos = hilos_crear(1);
+	if(!red->hilos) exit(0);
+	red->salidas = NULL;
+	red->secciones = NULL;
+	red->cantidad_secciones = 0;
+	red->prefijos = NULL;
+	red->admite_cambios = false;
+	red->orden = ORDEN_ARCHIVO;
+	red->k_caminos = 1;
+	red->topologia = NULL;
+	red->cache = NULL;
+	red->versiones = NULL;
+	red->distancias = NULL;
+
+	return red;
+}
+
+// Destruye una red junto con todos los resultados de su procesamiento.
+// PRE: 'red' es una red existente.
+// POST: se liberó la memoria utilizada por la red.
+void red_destruir(red_t *red) {
+	// Destruimos los caminos obtenidos
+	if(red->salidas) {
+		size_t i;
+
+		for(i = 0; i < hilos_cantidad(red->hilos); i++)
+			estadisticas_free(SUBSISTEMA_ROUTER, red->salidas[i].datos);
+
+		estadisticas_free(SUBSISTEMA_ROUTER, red->salidas);
+	}
+
+	estadisticas_free(SUBSISTEMA_ROUTER, red->secciones);
+	hilos_destruir(red->hilos);
+
+	// Destruimos las versiones publicadas para las consultas
+	if(red->versiones) epocas_destruir(red->versiones);
+	if(red->topologia) grafo_destruir(red->topologia);
+	if(red->cache) cache_destruir(red->cache);
+
+	if(red->prefijos) prefijos_destruir(red->prefijos);
+	estadisticas_free(SUBSISTEMA_ROUTER, red->distancias);
+
+	// Destruimos los resultados obtenidos por Dijkstra
+	if(red->resultados) dijkstra_destruir_resultados(red->resultados);
+	if(red->particion) areas_destruir(red->particion);
+	if(red->grafo) grafo_compacto_destruir(red->grafo);
+
+	// Liberamos memoria utilizada
+	lista_destruir(red->areas, registro_destruir);
+	lista_destruir(red->subnets, registro_destruir);
+	lista_destruir(red->routes, registro_destruir);
+	lista_destruir(red->devices, registro_destruir);
+	lista_destruir(red->hosts, registro_destruir);
+	estadisticas_free(SUBSISTEMA_ROUTER, red->devices_por_nombre);
+	cadenas_destruir(red->cadenas);
+	estadisticas_free(SUBSISTEMA_ROUTER, red);
+}
+
+// Establece el orden en que se numeran los dispositivos en el grafo de la
+// red.
+// PRE: 'red' es una red existente cuyo grafo aún no ha sido armado;
+// 'orden' es el orden de numeración.
+// POST: el grafo de la red (y el de cada versión publicada luego de
+// aplicar cambios) numera sus dispositivos en 'orden', de modo que los
+// dispositivos conectados queden cerca en memoria. Los resultados no
+// cambian. Por defecto se utiliza ORDEN_ARCHIVO.
+void red_establecer_orden(red_t *red, red_orden_t orden) {
+	red->orden = orden;
+}
+
+// Establece la cantidad de caminos mínimos que se informan hacia cada host
+// destino.
+// PRE: 'red' es una red existente cuyos caminos aún no se obtuvieron; 'k'
+// es la cantidad de caminos (si es 0 se usa 1).
+// POST: con 'k' mayor a 1, se informan hasta 'k' caminos sin ciclos hacia
+// cada host, de menor a mayor costo, calculados con el algoritmo de Yen
+// a partir del árbol de caminos mínimos. Por defecto se informa sólo el
+// mejor.
+void red_establecer_k_caminos(red_t *red, size_t k) {
+	red->k_caminos = k ? k : 1;
+}
+
+// Establece la cantidad de hilos con los que se procesa la red.
+// PRE: 'red' es una red existente cuyos caminos aún no se calcularon;
+// 'cantidad' es la cantidad de hilos (si es 0 se usa 1).
+// POST: los algoritmos paralelos de la red utilizan 'cantidad' hilos. Por
+// defecto la red se procesa con un único hilo.
+void red_establecer_hilos(red_t *red, unsigned int cantidad) {
+	hilos_t *hilos = hilos_crear(cantidad);
+	if(!hilos) exit(0);
+
+	hilos_destruir(red->hilos);
+	red->hilos = hilos;
+}
+
+// Carga en la red las especificaciones de ruteo.
+// PRE: 'red' es una red existente; 'archivo' es el nombre de archivo 
+// (incluyendo su extensión si es que posee) en el que se encuentra la
+// especificación de ruteo, RED_ENTRADA_ESTANDAR si se la lee con el mismo
+// formato de la entrada estandar (por ejemplo, desde una tubería), o NULL
+// si se desea que el sistema la solicite al usuario a través de la
+// entrada estandar. El archivo y la entrada estandar pueden estar
+// comprimidos con gzip o, si se lo incluyó al compilar, con zstd.
+// POST: se almacenaron en la red los hosts, dispositivos y conexiones
+// especificados, sin armar aún el grafo de dispositivos. Los hosts
+// conectados a un dispositivo inexistente se ignoran.
+void red_cargar(red_t *red, char *archivo) {
+	if(archivo && !strcmp(archivo, RED_ENTRADA_ESTANDAR))
+		// Procesamos la especificación desde entrada estandar
+		armar_red_flujo_comprimido(stdin, "la entrada estandar", red);
+	else if(archivo)
+		// Procesamos hosts y devices desde archivo de entrada.
+		armar_red_archivo_de_entrada(archivo, red);
+	else
+		// Solicitamos hosts y devices al usuario
+		armar_red_entrada_estandar(red);
+
+	parser_validar_hosts(red);
+}
+
+// Obtiene la representación compacta de un grafo de dispositivos de la
+// red, numerando los dispositivos en el orden de la red.
+// PRE: 'red' es una red existente; 'grafo' es un grafo de dispositivos.
+// POST: devuelve el grafo compacto. La numeración depende sólo de la
+// estructura del grafo.
+grafo_compacto_t* red_compactar(red_t *red, grafo_t *grafo) {
+	static const grafo_compacto_orden_t ORDENES[] = {
+		GRAFO_COMPACTO_ORDEN_ORIGINAL, GRAFO_COMPACTO_ORDEN_ANCHURA,
+		GRAFO_COMPACTO_ORDEN_RCM, GRAFO_COMPACTO_ORDEN_GRADO
+	};
+
+	grafo_compacto_t *compacto = grafo_compacto_crear(grafo);
+	if(!compacto || !grafo_compacto_reordenar(compacto, ORDENES[red->orden]))
+		exit(0);
+
+	return compacto;
+}
+
+// Arma el grafo de dispositivos de la red a partir de los dispositivos y
+// conexiones cargados.
+// PRE: 'red' es una red cargada.
+// POST: los vértices del grafo son los dispositivos (de tipo 'device_t') y
+// sus aristas las conexiones. El grafo se almacena en su representación
+// compacta. Las conexiones ya no se mantienen en la red.
+void red_armar_grafo(red_t *red) {
+	size_t n = lista_largo(red->devices), m = lista_largo(red->routes);
+	uint32_t j, cantidad = cadenas_cantidad(red->cadenas);
+	lista_dato_t device;
+	route_t *route;
+	int i, k;
+
+	// Indexamos los dispositivos por nombre
+	red_indexar_devices(red);
+
+	grafo_dato_t *datos = (grafo_dato_t*) estadisticas_malloc(
+		SUBSISTEMA_ROUTER, (n + 1) * sizeof(grafo_dato_t));
+	int *vertices = (int*) estadisticas_malloc(SUBSISTEMA_ROUTER,
+		(cantidad + 1) * sizeof(int));
+	int *partidas = (int*) estadisticas_malloc(SUBSISTEMA_ROUTER,
+		(m + 1) * sizeof(int));
+	int *destinos = (int*) estadisticas_malloc(SUBSISTEMA_ROUTER,
+		(m + 1) * sizeof(int));
+	int *pesos = (int*) estadisticas_malloc(SUBSISTEMA_ROUTER,
+		(m + 1) * sizeof(int));
+	if(!datos || !vertices || !partidas || !destinos || !pesos) exit(0);
+
+	// Cada device es un vértice del grafo, y cada nombre corresponde al
+	// vértice de su dispositivo (ver buscar_device())
+	for(j = 0; j < cantidad; j++) vertices[j] = -1;
+
+	lista_iter_t* iter = lista_iter_crear(red->devices);
+
+	for(i = 0; !lista_iter_al_final(iter); i++) {
+		lista_iter_ver_actual(iter, &device);
+		datos[i] = (device_t*) device;
+
+		if(buscar_device(red, datos[i]->nombre) == datos[i])
+			vertices[datos[i]->nombre] = i;
+
+		lista_iter_avanzar(iter);
+	}
+
+	lista_iter_destruir(iter);
+
+	// Cada conexión entre dispositivos existentes es una arista
+	for(k = 0; lista_borrar_primero(red->routes, (lista_dato_t*) &route); ) {
+		if(vertices[route->ini] >= 0 && vertices[route->fin] >= 0) {
+			partidas[k] = vertices[route->ini];
+			destinos[k] = vertices[route->fin];
+			pesos[k++] = route->peso;
+		}
+
+		route_destruir(route);
+	}
+
+	// Creamos el grafo de la red de una sola vez
+	grafo_t *grafo = grafo_crear_masivo(datos, (int) n, partidas, destinos,
+		pesos, k, red->hilos);
+	if(!grafo) exit(0);
+
+	estadisticas_free(SUBSISTEMA_ROUTER, datos);
+	estadisticas_free(SUBSISTEMA_ROUTER, vertices);
+	estadisticas_free(SUBSISTEMA_ROUTER, partidas);
+	estadisticas_free(SUBSISTEMA_ROUTER, destinos);
+	estadisticas_free(SUBSISTEMA_ROUTER, pesos);
+
+	// Los caminos se calculan sobre la representación compacta, por lo que
+	// el grafo de listas se libera apenas se la obtiene, salvo que se lo
+	// conserve para modificar la topología
+	red->grafo = red_compactar(red, grafo);
+	if(red->admite_cambios) red->topologia = grafo;
+	else grafo_destruir(grafo);
+}
+
+// Función que indica si los caminos mínimos de la red pueden tomarse de
+// su caché y guardarse en ella.
+// PRE: 'red' es una red cuyo grafo ya ha sido armado.
+// POST: devuelve true si la red tiene caché y ninguna conexión del grafo
+// tiene peso 0. Con conexiones de peso 0 el desempate depende del orden
+// de marcado, que puede variar entre dos versiones con las mismas
+// conexiones, por lo que esos árboles no se reutilizan.
+bool red_usa_cache(red_t *red) {
+	const uint32_t *inicio, *destinos, *pesos32;
+	const uint16_t *pesos16;
+	uint32_t e, m = grafo_compacto_cantidad_aristas(red->grafo);
+
+	if(!red->cache) return false;
+
+	grafo_compacto_obtener_arreglos(red->grafo, &inicio, &destinos,
+		&pesos16, &pesos32);
+
+	for(e = 0; e < m; e++)
+		if(pesos16 ? !pesos16[e] : !pesos32[e]) return false;
+
+	return true;
+}
+
+// Función que busca en la caché de la red el árbol de caminos mínimos
+// desde un origen sobre la topología actual.
+// PRE: 'red' es una red que admite cambios, cuyo grafo se armó a partir
+// de su topología actual; 'origen' es el dispositivo origen.
+// POST: si la caché tiene el árbol, se almacenó en la red una copia como
+// resultados y se devuelve true. En caso contrario se devuelve false.
+bool red_buscar_arbol(red_t *red, lista_dato_t origen) {
+	const uint32_t *distancias, *previos;
+	uint32_t v, o, n = grafo_compacto_cantidad_vertices(red->grafo);
+
+	// La caché guarda los árboles en el orden de la sección [device], que
+	// no depende del orden de numeración ni del de las conexiones
+	o = grafo_compacto_indice_original(red->grafo,
+		grafo_compacto_buscar_vertice(red->grafo, origen));
+
+	if(!cache_buscar(red->cache, o, grafo_obtener_version(red->topologia),
+		&distancias, &previos))
+		return false;
+
+	uint32_t *copia_distancias = (uint32_t*) estadisticas_malloc(
+		SUBSISTEMA_DIJKSTRA, (n + 1) * sizeof(uint32_t));
+	uint32_t *copia_previos = (uint32_t*) estadisticas_malloc(
+		SUBSISTEMA_DIJKSTRA, (n + 1) * sizeof(uint32_t));
+	uint32_t *numeracion = (uint32_t*) estadisticas_malloc(
+		SUBSISTEMA_ROUTER, (n + 1) * sizeof(uint32_t));
+	if(!copia_distancias || !copia_previos || !numeracion) exit(0);
+
+	for(v = 0; v < n; v++)
+		numeracion[grafo_compacto_indice_original(red->grafo, v)] = v;
+
+	for(v = 0; v < n; v++) {
+		o = grafo_compacto_indice_original(red->grafo, v);
+		copia_distancias[v] = distancias[o];
+		copia_previos[v] = previos[o] == GRAFO_COMPACTO_SIN_VERTICE ?
+			GRAFO_COMPACTO_SIN_VERTICE : numeracion[previos[o]];
+	}
+
+	estadisticas_free(SUBSISTEMA_ROUTER, numeracion);
+
+	red->resultados = dijkstra_crear_resultados(red->grafo, copia_distancias,
+		copia_previos);
+	if(!red->resultados) exit(0);
+
+	return true;
+}
+
+// Función que guarda en la caché de la red el árbol de caminos mínimos
+// recién calculado.
+// PRE: 'red' es una red que admite cambios, cuyos caminos mínimos desde
+// 'origen' ya han sido calculados sobre su topología actual.
+// POST: se guardó una copia del árbol, si entra en el presupuesto de la
+// caché.
+void red_guardar_arbol(red_t *red, lista_dato_t origen) {
+	const uint32_t *distancias, *previos;
+	uint32_t v, o, n = grafo_compacto_cantidad_vertices(red->grafo);
+
+	if(!red->resultados) return;
+
+	dijkstra_obtener_arreglos(red->resultados, &distancias, &previos);
+
+	uint32_t *arbol_distancias = (uint32_t*) estadisticas_malloc(
+		SUBSISTEMA_ROUTER, (n + 1) * sizeof(uint32_t));
+	uint32_t *arbol_previos = (uint32_t*) estadisticas_malloc(
+		SUBSISTEMA_ROUTER, (n + 1) * sizeof(uint32_t));
+	if(!arbol_distancias || !arbol_previos) exit(0);
+
+	for(v = 0; v < n; v++) {
+		o = grafo_compacto_indice_original(red->grafo, v);
+		arbol_distancias[o] = distancias[v];
+		arbol_previos[o] = previos[v] == GRAFO_COMPACTO_SIN_VERTICE ?
+			GRAFO_COMPACTO_SIN_VERTICE :
+			grafo_compacto_indice_original(red->grafo, previos[v]);
+	}
+
+	o = grafo_compacto_indice_original(red->grafo,
+		grafo_compacto_buscar_vertice(red->grafo, origen));
+	cache_guardar(red->cache, o, grafo_obtener_version(red->topologia), n,
+		arbol_distancias, arbol_previos);
+
+	estadisticas_free(SUBSISTEMA_ROUTER, arbol_distancias);
+	estadisticas_free(SUBSISTEMA_ROUTER, arbol_previos);
+}
+
+// Calcula los caminos mínimos desde el dispositivo origen de la red hacia
+// los demás dispositivos.
+// PRE: 'red' es una red cuyo grafo ya ha sido armado.
+// POST: se almacenaron en la red los resultados de aplicar el algoritmo de
+// Dijkstra sobre el grafo. Si la red admite cambios y su caché tiene el
+// árbol del origen sobre la misma topología, se lo toma de ella sin
+// recorrer el grafo.
+void red_calcular_caminos_minimos(red_t *red) {
+	lista_dato_t device_origen;
+
+	// En el primer elemento de la lista se encuentra el origen de los
+	// dispositivos
+	if(!lista_ver_primero(red->devices, &device_origen)) return;
+
+	// Si ya se calcularon los caminos desde el origen sobre una topología
+	// igual, los tomamos de la caché
+	bool cache = red_usa_cache(red);
+	if(cache && red_buscar_arbol(red, device_origen)) return;
+
+	// Procesamos el grafo y obtenemos los resultados de aplicar
+	// el algoritmo de Dijkstra
+	red->resultados = dijkstra_caminos_minimos(red->grafo, device_origen, 
+		criterio_de_seleccion_de_camino);
+	if(cache) red_guardar_arbol(red, device_origen);
+}
+
+// Calcula los caminos mínimos desde el dispositivo origen de la red hacia
+// los demás dispositivos, repartiendo el trabajo entre los hilos de la red.
+// PRE: 'red' es una red cuyo grafo ya ha sido armado; 'ancho' es el ancho
+// de los baldes del algoritmo delta-stepping o DELTA_ANCHO_AUTOMATICO.
+// POST: se almacenaron en la red los mismos resultados que con
+// red_calcular_caminos_minimos(), obtenidos con el algoritmo
+// delta-stepping (o tomados de la caché de la red).
+void red_calcular_caminos_minimos_paralelo(red_t *red, uint32_t ancho) {
+	lista_dato_t device_origen;
+
+	if(!lista_ver_primero(red->devices, &device_origen)) return;
+
+	bool cache = red_usa_cache(red);
+	if(cache && red_buscar_arbol(red, device_origen)) return;
+
+	// El criterio de selección sólo lee el orden de los dispositivos, por
+	// lo que puede invocarse desde varios hilos a la vez
+	red->resultados = delta_caminos_minimos(red->grafo, device_origen,
+		criterio_de_seleccion_de_camino, red->hilos, ancho);
+	if(cache) red_guardar_arbol(red, device_origen);
+}
+
+// Divide el grafo de la red en áreas, para calcular sus caminos en forma
+// jerárquica (ver red_calcular_caminos_minimos_por_areas()).
+// PRE: 'red' es una red cuyo grafo ya ha sido armado; 'cantidad' es la
+// cantidad de áreas en que se divide el grafo automáticamente, o
+// RED_AREAS_ETIQUETAS para utilizar las áreas de la sección [area].
+// POST: se almacenaron en la red las áreas del grafo, cuyas distancias
+// entre bordes se calculan al utilizarlas. Con RED_AREAS_ETIQUETAS, los
+// dispositivos sin área asignada forman un área más, y ante un
+// dispositivo asignado varias veces prevalece la primera asignación.
+void red_dividir_en_areas(red_t *red, uint32_t cantidad) {
+	uint32_t v, j, n = grafo_compacto_cantidad_vertices(red->grafo);
+	uint32_t nombres = cadenas_cantidad(red->cadenas);
+	uint32_t sin_area = CADENAS_SIN_ID, *area = NULL;
+	lista_dato_t registro;
+
+	if(cantidad == RED_AREAS_ETIQUETAS) {
+		// Vinculamos cada nombre de dispositivo con el nombre de su área, y
+		// numeramos las áreas en el orden en que aparecen sus dispositivos
+		uint32_t *etiqueta = (uint32_t*) estadisticas_malloc(
+			SUBSISTEMA_ROUTER, (nombres + 1) * sizeof(uint32_t));
+		uint32_t *numero = (uint32_t*) estadisticas_malloc(SUBSISTEMA_ROUTER,
+			(nombres + 1) * sizeof(uint32_t));
+		area = (uint32_t*) estadisticas_malloc(SUBSISTEMA_ROUTER,
+			(n + 1) * sizeof(uint32_t));
+		if(!etiqueta || !numero || !area) exit(0);
+
+		for(j = 0; j < nombres; j++)
+			etiqueta[j] = numero[j] = CADENAS_SIN_ID;
+
+		lista_iter_t* iter = lista_iter_crear(red->areas);
+		if(!iter) exit(0);
+
+		while(!lista_iter_al_final(iter)) {
+			lista_iter_ver_actual(iter, &registro);
+			area_t *a = (area_t*) registro;
+
+			if(etiqueta[a->dispositivo_nombre] == CADENAS_SIN_ID)
+				etiqueta[a->dispositivo_nombre] = a->nombre;
+			lista_iter_avanzar(iter);
+		}
+
+		lista_iter_destruir(iter);
+
+		for(v = 0, cantidad = 0; v < n; v++) {
+			j = etiqueta[grafo_compacto_obtener_dato(red->grafo, v)->nombre];
+			uint32_t *numero_area = j == CADENAS_SIN_ID ? &sin_area :
+				&numero[j];
+
+			if(*numero_area == CADENAS_SIN_ID) *numero_area = cantidad++;
+			area[v] = *numero_area;
+		}
+
+		estadisticas_free(SUBSISTEMA_ROUTER, etiqueta);
+		estadisticas_free(SUBSISTEMA_ROUTER, numero);
+	}
+
+	red->particion = areas_crear(red->grafo, area, cantidad);
+	estadisticas_free(SUBSISTEMA_ROUTER, area);
+	if(!red->particion) exit(0);
+}
+
+// Calcula los caminos mínimos desde el dispositivo origen de la red hacia
+// los dispositivos de los hosts, utilizando las áreas de la red.
+// PRE: 'red' es una red cuyo grafo ya ha sido dividido en áreas (ver
+// red_dividir_en_areas()).
+// POST: se almacenaron en la red resultados cuyos caminos hacia los
+// dispositivos de los hosts son los mismos que con
+// red_calcular_caminos_minimos(). Sólo se recorren el área del origen,
+// las distancias entre bordes de las áreas cercanas a esos caminos y las
+// áreas por las que pasan.
+void red_calcular_caminos_minimos_por_areas(red_t *red) {
+	lista_dato_t device_origen, host;
+	size_t i, cantidad = lista_largo(red->hosts);
+
+	if(!lista_ver_primero(red->devices, &device_origen)) return;
+
+	lista_dato_t *destinos = (lista_dato_t*) estadisticas_malloc(
+		SUBSISTEMA_ROUTER, (cantidad + 1) * sizeof(lista_dato_t));
+	if(!destinos) exit(0);
+
+	lista_iter_t* iter = lista_iter_crear(red->hosts);
+	if(!iter) exit(0);
+
+	for(i = 0; !lista_iter_al_final(iter); i++) {
+		lista_iter_ver_actual(iter, &host);
+		destinos[i] = (lista_dato_t) buscar_device(red,
+			((host_t*) host)->dispositivo_nombre);
+		lista_iter_avanzar(iter);
+	}
+
+	lista_iter_destruir(iter);
+
+	red->resultados = areas_caminos_minimos(red->particion, device_origen,
+		criterio_de_seleccion_de_camino, destinos, cantidad);
+	estadisticas_free(SUBSISTEMA_ROUTER, destinos);
+
+	estadisticas_registrar_contador("areas",
+		areas_cantidad(red->particion));
+	estadisticas_registrar_contador("areas_bordes",
+		areas_cantidad_bordes(red->particion));
+	estadisticas_registrar_contador("areas_expandidas",
+		areas_cantidad_expandidas(red->particion));
+	estadisticas_registrar_contador("areas_con_atajos",
+		areas_cantidad_con_atajos(red->particion));
+}
+
+// Indica que la topología de la red podrá modificarse luego de calcular
+// sus caminos (ver red_aplicar_cambios()).
+// PRE: 'red' es una red cuyo grafo aún no ha sido armado; 'presupuesto'
+// es la máxima cantidad de bytes que pueden ocupar los árboles de caminos
+// mínimos guardados en la caché de la red.
+// POST: al armar el grafo se conserva, además de su representación
+// compacta, el grafo de listas que modifica el escritor. Los árboles que
+// se calculan se guardan en la caché, identificados por el origen y la
+// versión de la topología, y al volver la topología a una versión ya
+// calculada (por ejemplo, al restablecerse una conexión que había caído)
+// se toman de ella; al superar el presupuesto se descartan los usados
+// hace más tiempo.
+void red_admitir_cambios(red_t *red, size_t presupuesto) {
+	red->admite_cambios = true;
+
+	// Los dispositivos no cambian entre versiones, por lo que la posición
+	// de cada uno en la topología identifica su vértice en todas ellas
+	red->cache = cache_crear(presupuesto);
+	if(!red->cache) exit(0);
+}
+
+// Publica el grafo de la red y sus caminos mínimos como la versión que
+// utilizan las consultas.
+// PRE: 'red' es una red cuyos caminos mínimos ya han sido calculados.
+// POST: las consultas que comiencen a partir de ahora utilizan la versión
+// publicada, que toma posesión del grafo y de los caminos de la red (la
+// red queda sin ellos). La versión anterior se destruye cuando ya no la
+// utiliza ninguna consulta.
+void red_publicar_version(red_t *red) {
+	version_t *version = version_crear(red->grafo, red->resultados);
+	red->grafo = NULL;
+	red->resultados = NULL;
+
+	// Cada hilo de la red puede fijar versiones como lector
+	if(!red->versiones) {
+		red->versiones = epocas_crear(hilos_cantidad(red->hilos), version,
+			version_destruir);
+		if(!red->versiones) exit(0);
+	}
+	else if(!epocas_publicar(red->versiones, version))
+		exit(0);
+}
+
+// Aplica a la red los cambios de topología de un archivo, publicando una
+// versión nueva por cada lote de cambios.
+// PRE: 'red' es una red que admite cambios y cuya primera versión ya ha
+// sido publicada; 'archivo' es el nombre del archivo de cambios, con un
+// cambio por línea con el formato '[D1]->[D2],[PESO]' para crear o
+// modificar una conexión o '[D1]->[D2],-' para eliminarla. Una línea
+// vacía cierra un lote.
+// POST: se aplicaron los cambios válidos en orden, y cada lote se publicó
+// como una versión nueva en forma atómica: las consultas que se
+// responden mientras tanto utilizan la versión anterior completa, sin
+// esperar al escritor. Los cambios inválidos se informan en la salida de
+// errores y se ignoran.
+void red_aplicar_cambios(red_t *red, char *archivo) {
+	char *buffer = NULL;
+	size_t capacidad = 0;
+	ssize_t largo;
+	device_t *ini, *fin;
+	int peso;
+	bool pendientes = false;
+
+	FILE *fp = archivo_abrir(archivo);
+
+	while(true) {
+		largo = getline(&buffer, &capacidad, fp);
+		if(largo > 0 && buffer[largo - 1] == '\n') buffer[--largo] = '\0';
+
+		// Al cerrarse un lote armamos la versión nueva por fuera de la
+		// vigente y la publicamos
+		if(largo <= 0) {
+			if(pendientes) {
+				red->grafo = red_compactar(red, red->topologia);
+				red_calcular_caminos_minimos(red);
+				red_publicar_version(red);
+				pendientes = false;
+			}
+
+			if(largo == -1) break;
+			continue;
+		}
+
+		if(!parser_cambio(red, buffer, &ini, &fin, &peso)) {
+			fprintf(stderr, "ERROR: Cambio inválido '%s', se ignora.\n",
+				buffer);
+			continue;
+		}
+
+		if(peso < 0) grafo_eliminar_arista(red->topologia, ini, fin);
+		else grafo_crear_arista(red->topologia, ini, fin, peso);
+		pendientes = true;
+	}
+
+	free(buffer);
+	archivo_cerrar(fp);
+
+	// Las versiones que seguían en uso se destruyen al destruir la red
+	epocas_reclamar(red->versiones);
+}
+
+// Tipo auxiliar con los datos que comparten los hilos al extraer los
+// caminos hacia los hosts
+typedef struct {
+	red_t *red;									// Red procesada
+	host_t **hosts;								// Hosts en orden de carga
+} extraccion_t;
+
+// Tarea que extrae el camino hacia un host destino y lo escribe en el
+// buffer de salida del hilo que la ejecuta.
+// PRE: 'contexto' es un extraccion_t; 'elemento' es la posición del
+// destino en la lista de hosts, sin contar al origen.
+// POST: se registró en la red la sección del destino.
+void extraer_camino_host(size_t hilo, size_t elemento, void *contexto) {
+	extraccion_t *extraccion = (extraccion_t*) contexto;
+	red_t *red = extraccion->red;
+	host_t *destino = extraccion->hosts[elemento + 1];
+	salida_t *salida = &red->salidas[hilo];
+	seccion_t *seccion = &red->secciones[elemento];
+
+	lista_dato_t device = (lista_dato_t) buscar_device(red,
+		destino->dispositivo_nombre);
+	size_t i, cantidad = 0;
+
+	seccion->buffer = hilo;
+	seccion->inicio = salida->largo;
+
+	// Con alternativas, informamos los k caminos mínimos hacia el destino
+	if(red->k_caminos > 1) {
+		lista_t **caminos = (lista_t**) estadisticas_malloc(
+			SUBSISTEMA_ROUTER, red->k_caminos * sizeof(lista_t*));
+		uint64_t *costos = (uint64_t*) estadisticas_malloc(
+			SUBSISTEMA_ROUTER, red->k_caminos * sizeof(uint64_t));
+		if(!caminos || !costos) exit(0);
+
+		cantidad = dijkstra_k_caminos_minimos(red->resultados, device,
+			criterio_de_seleccion_de_camino, red->k_caminos, caminos, costos);
+
+		for(i = 0; i < cantidad; i++) {
+			formatear_camino(salida, red->cadenas, extraccion->hosts[0],
+				destino, caminos[i], i + 1, costos[i]);
+			lista_destruir(caminos[i], NULL);
+		}
+
+		// Un destino no alcanzable no tiene ninguna alternativa
+		if(!cantidad)
+			formatear_camino(salida, red->cadenas, extraccion->hosts[0],
+				destino, NULL, 0, 0);
+
+		estadisticas_free(SUBSISTEMA_ROUTER, caminos);
+		estadisticas_free(SUBSISTEMA_ROUTER, costos);
+	}
+	else {
+		const uint32_t *distancias, *previos;
+		uint32_t v = grafo_compacto_buscar_vertice(red->grafo, device);
+		dijkstra_obtener_arreglos(red->resultados, &distancias, &previos);
+
+		// Solicitamos el camino hacia el destino, salvo que no sea
+		// alcanzable, en cuyo caso no tiene camino
+		lista_t *camino = NULL;
+		if(distancias[v] != UINT32_MAX &&
+			!(camino = dijkstra_obtener_camino(red->resultados, device)))
+			exit(0);
+
+		formatear_camino(salida, red->cadenas, extraccion->hosts[0], destino,
+			camino, 0, 0);
+		if(camino) lista_destruir(camino, NULL);
+	}
+
+	seccion->largo = salida->largo - seccion->inicio;
+}
+
+// Obtiene los caminos desde el host origen hacia los demás hosts de la red.
+// PRE: 'red' es una red cuyos caminos mínimos ya han sido calculados.
+// POST: se almacenó en la red la sección [route_path] de cada host
+// destino, lista para enviar a la salida estandar. Los destinos se
+// reparten entre los hilos de la red, y cada hilo escribe sus secciones
+// en su propio buffer.
+void red_obtener_caminos(red_t *red) {
+	size_t i, hilos = hilos_cantidad(red->hilos);
+	size_t cantidad = lista_largo(red->hosts);
+	lista_dato_t host;
+	extraccion_t extraccion;
+
+	if(!red->resultados || cantidad < 2) return;
+
+	// Accedemos a los hosts por posición
+	extraccion.red = red;
+	extraccion.hosts = (host_t**) estadisticas_malloc(SUBSISTEMA_ROUTER,
+		cantidad * sizeof(host_t*));
+	red->salidas = (salida_t*) estadisticas_malloc(SUBSISTEMA_ROUTER,
+		hilos * sizeof(salida_t));
+	red->secciones = (seccion_t*) estadisticas_malloc(SUBSISTEMA_ROUTER,
+		(cantidad - 1) * sizeof(seccion_t));
+	if(!extraccion.hosts || !red->salidas || !red->secciones) exit(0);
+
+	lista_iter_t* iter = lista_iter_crear(red->hosts);
+	if(!iter) exit(0);
+
+	for(i = 0; !lista_iter_al_final(iter); i++) {
+		lista_iter_ver_actual(iter, &host);
+		extraccion.hosts[i] = (host_t*) host;
+		lista_iter_avanzar(iter);
+	}
+
+	lista_iter_destruir(iter);
+
+	for(i = 0; i < hilos; i++) {
+		red->salidas[i].datos = NULL;
+		red->salidas[i].largo = red->salidas[i].capacidad = 0;
+	}
+
+	// Procesamos los caminos hacia los demás hosts
+	red->cantidad_secciones = cantidad - 1;
+	hilos_repartir(red->hilos, red->cantidad_secciones, extraer_camino_host,
+		&extraccion);
+
+	estadisticas_free(SUBSISTEMA_ROUTER, extraccion.hosts);
+}
+
+// Envía a la salida estandar los caminos obtenidos desde el host origen
+// hacia los demás hosts de la red.
+// PRE: 'red' es una red cuyos caminos ya han sido obtenidos.
+// POST: se imprimió una sección [route_path] por cada host destino, en el
+// orden de la lista de hosts (o, si se analizaron las caídas de las
+// conexiones, el informe de cada conexión).
+void red_enviar_caminos(red_t *red) {
+	size_t i;
+
+	for(i = 0; i < red->cantidad_secciones; i++) {
+		const seccion_t *seccion = &red->secciones[i];
+		fwrite(red->salidas[seccion->buffer].datos + seccion->inicio, 1,
+			seccion->largo, stdout);
+	}
+}
+
+// Tipo auxiliar con los datos que comparten los hilos al analizar las
+// caídas de las conexiones
+typedef struct {
+	red_t *red;									// Red procesada
+	host_t **hosts;								// Hosts en orden de carga
+	fallas_t *fallas;							// Análisis de caídas
+	const uint32_t *destinos;					// Destino de cada conexión
+	uint32_t *aristas;							// Conexiones en el orden del
+	uint32_t *partidas;							// informe, y el dispositivo
+												// del que parte cada una
+	uint32_t *inicio_hosts;						// Hosts destino conectados a
+	uint32_t *hosts_por_vertice;				// cada vértice, en formato
+												// CSR
+	uint32_t **afectados;						// Hosts afectados, por hilo
+	size_t *conexiones_afectadas;				// Conexiones que afectan a
+												// algún host, por hilo
+} analisis_fallas_t;
+
+// Función de comparación de posiciones de hosts, para qsort().
+// PRE: 'a' y 'b' son punteros a uint32_t.
+int comparar_posiciones(const void *a, const void *b) {
+	uint32_t x = *(const uint32_t*) a, y = *(const uint32_t*) b;
+	return (x > y) - (x < y);
+}
+
+// Tarea que analiza la caída de una conexión y escribe su informe en el
+// buffer de salida del hilo que la ejecuta.
+// PRE: 'contexto' es un analisis_fallas_t; 'elemento' es la posición de
+// la conexión en el informe.
+// POST: se registró en la red la sección de la conexión.
+void analizar_falla_conexion(size_t hilo, size_t elemento, void *contexto) {
+	analisis_fallas_t *analisis = (analisis_fallas_t*) contexto;
+	red_t *red = analisis->red;
+	salida_t *salida = &red->salidas[hilo];
+	seccion_t *seccion = &red->secciones[elemento];
+	uint32_t *seleccion = analisis->afectados[hilo];
+	uint32_t i, j, v, e = analisis->aristas[elemento];
+	const uint32_t *vertices;
+	size_t cantidad = 0;
+	const char *nombre;
+	char numero[32];
+
+	uint32_t afectados = fallas_analizar(analisis->fallas, hilo, e, &vertices);
+	if(afectados == UINT32_MAX) exit(0);
+
+	// Tomamos los hosts de los dispositivos afectados, en orden de carga
+	for(i = 0; i < afectados; i++)
+		for(j = analisis->inicio_hosts[vertices[i]];
+			j < analisis->inicio_hosts[vertices[i] + 1]; j++)
+			seleccion[cantidad++] = analisis->hosts_por_vertice[j];
+
+	qsort(seleccion, cantidad, sizeof(uint32_t), comparar_posiciones);
+	if(cantidad) analisis->conexiones_afectadas[hilo]++;
+
+	seccion->buffer = hilo;
+	seccion->inicio = salida->largo;
+
+	// Escribimos la sección de la conexión
+	salida_agregar(salida, "[link_failure:", 14);
+	nombre = cadenas_obtener(red->cadenas, ((device_t*)
+		grafo_compacto_obtener_dato(red->grafo,
+		analisis->partidas[elemento]))->nombre);
+	salida_agregar(salida, nombre, strlen(nombre));
+	salida_agregar(salida, "->", 2);
+	nombre = cadenas_obtener(red->cadenas, ((device_t*)
+		grafo_compacto_obtener_dato(red->grafo,
+		analisis->destinos[e]))->nombre);
+	salida_agregar(salida, nombre, strlen(nombre));
+	salida_agregar(salida, numero, sprintf(numero, ":%zu]\n", cantidad));
+
+	// Y debajo, el nuevo camino hacia cada host afectado
+	for(i = 0; i < cantidad; i++) {
+		host_t *destino = analisis->hosts[seleccion[i]];
+		v = grafo_compacto_buscar_vertice(red->grafo, (lista_dato_t)
+			buscar_device(red, destino->dispositivo_nombre));
+
+		if(fallas_distancia(analisis->fallas, hilo, v) == UINT32_MAX) {
+			formatear_camino(salida, red->cadenas, analisis->hosts[0],
+				destino, NULL, 0, 0);
+			continue;
+		}
+
+		lista_t *camino = lista_crear();
+		if(!camino) exit(0);
+
+		for(; v != GRAFO_COMPACTO_SIN_VERTICE;
+			v = fallas_previo(analisis->fallas, hilo, v))
+			if(!lista_insertar_primero(camino, (lista_dato_t)
+				grafo_compacto_obtener_dato(red->grafo, v)))
+				exit(0);
+
+		formatear_camino(salida, red->cadenas, analisis->hosts[0], destino,
+			camino, 0, 0);
+		lista_destruir(camino, NULL);
+	}
+
+	seccion->largo = salida->largo - seccion->inicio;
+}
+
+// Analiza la caída de cada conexión de la red.
+// PRE: 'red' es una red cuyos caminos mínimos ya han sido calculados para
+// todos los dispositivos.
+// POST: se almacenó en la red, lista para enviar a la salida estandar con
+// red_enviar_caminos(), una sección [link_failure:D1->D2:CANTIDAD] por
+// cada conexión, seguida de la sección [route_path] con el nuevo camino
+// hacia cada uno de los CANTIDAD hosts destino cuyo camino cambia si la
+// conexión cae ('sin ruta' si deja de ser alcanzable). Las conexiones se
+// informan en el orden de sus dispositivos de partida en la sección
+// [device] y, para cada uno, en el de la sección [route]. Sólo se
+// recalculan los caminos hacia el subárbol que cuelga de cada conexión,
+// y las conexiones se reparten entre los hilos de la red.
+void red_analizar_fallas(red_t *red) {
+	size_t i, hilos = hilos_cantidad(red->hilos);
+	size_t cantidad = lista_largo(red->hosts), conexiones = 0;
+	uint32_t u, v, e, n, m;
+	const uint32_t *inicio;
+	const uint16_t *pesos16;
+	const uint32_t *pesos32;
+	lista_dato_t dato, device_origen;
+	analisis_fallas_t analisis;
+
+	if(!red->resultados || !cantidad ||
+		!lista_ver_primero(red->devices, &device_origen))
+		return;
+
+	n = grafo_compacto_cantidad_vertices(red->grafo);
+	m = grafo_compacto_cantidad_aristas(red->grafo);
+	grafo_compacto_obtener_arreglos(red->grafo, &inicio, &analisis.destinos,
+		&pesos16, &pesos32);
+
+	analisis.red = red;
+	analisis.fallas = fallas_crear(red->grafo, red->resultados,
+		device_origen, criterio_de_seleccion_de_camino, hilos);
+	analisis.hosts = (host_t**) estadisticas_malloc(SUBSISTEMA_ROUTER,
+		cantidad * sizeof(host_t*));
+	analisis.aristas = (uint32_t*) estadisticas_malloc(SUBSISTEMA_ROUTER,
+		(m + 1) * sizeof(uint32_t));
+	analisis.partidas = (uint32_t*) estadisticas_malloc(SUBSISTEMA_ROUTER,
+		(m + 1) * sizeof(uint32_t));
+	analisis.inicio_hosts = (uint32_t*) estadisticas_malloc(SUBSISTEMA_ROUTER,
+		(n + 2) * sizeof(uint32_t));
+	analisis.hosts_por_vertice = (uint32_t*) estadisticas_malloc(
+		SUBSISTEMA_ROUTER, cantidad * sizeof(uint32_t));
+	analisis.afectados = (uint32_t**) estadisticas_malloc(SUBSISTEMA_ROUTER,
+		hilos * sizeof(uint32_t*));
+	analisis.conexiones_afectadas = (size_t*) estadisticas_malloc(
+		SUBSISTEMA_ROUTER, hilos * sizeof(size_t));
+	red->salidas = (salida_t*) estadisticas_malloc(SUBSISTEMA_ROUTER,
+		hilos * sizeof(salida_t));
+	red->secciones = (seccion_t*) estadisticas_malloc(SUBSISTEMA_ROUTER,
+		(m + 1) * sizeof(seccion_t));
+	if(!analisis.fallas || !analisis.hosts || !analisis.aristas ||
+		!analisis.partidas || !analisis.inicio_hosts ||
+		!analisis.hosts_por_vertice || !analisis.afectados ||
+		!analisis.conexiones_afectadas || !red->salidas || !red->secciones)
+		exit(0);
+
+	for(i = 0; i < hilos; i++) {
+		analisis.afectados[i] = (uint32_t*) estadisticas_malloc(
+			SUBSISTEMA_ROUTER, cantidad * sizeof(uint32_t));
+		if(!analisis.afectados[i]) exit(0);
+
+		analisis.conexiones_afectadas[i] = 0;
+		red->salidas[i].datos = NULL;
+		red->salidas[i].largo = red->salidas[i].capacidad = 0;
+	}
+
+	// Agrupamos los hosts destino por el vértice de su dispositivo
+	lista_iter_t* iter = lista_iter_crear(red->hosts);
+	if(!iter) exit(0);
+
+	for(i = 0; !lista_iter_al_final(iter); i++) {
+		lista_iter_ver_actual(iter, &dato);
+		analisis.hosts[i] = (host_t*) dato;
+		lista_iter_avanzar(iter);
+	}
+
+	lista_iter_destruir(iter);
+	memset(analisis.inicio_hosts, 0, (n + 2) * sizeof(uint32_t));
+
+	for(i = 1; i < cantidad; i++) {
+		v = grafo_compacto_buscar_vertice(red->grafo, (lista_dato_t)
+			buscar_device(red, analisis.hosts[i]->dispositivo_nombre));
+		if(v != GRAFO_COMPACTO_SIN_VERTICE) analisis.inicio_hosts[v + 2]++;
+	}
+
+	for(v = 0; v < n; v++)
+		analisis.inicio_hosts[v + 2] += analisis.inicio_hosts[v + 1];
+
+	for(i = 1; i < cantidad; i++) {
+		v = grafo_compacto_buscar_vertice(red->grafo, (lista_dato_t)
+			buscar_device(red, analisis.hosts[i]->dispositivo_nombre));
+		if(v != GRAFO_COMPACTO_SIN_VERTICE)
+			analisis.hosts_por_vertice[analisis.inicio_hosts[v + 1]++] = i;
+	}
+
+	// Las conexiones se informan en el orden de sus dispositivos de partida
+	iter = lista_iter_crear(red->devices);
+	if(!iter) exit(0);
+
+	while(!lista_iter_al_final(iter)) {
+		lista_iter_ver_actual(iter, &dato);
+		u = grafo_compacto_buscar_vertice(red->grafo, dato);
+
+		if(u != GRAFO_COMPACTO_SIN_VERTICE)
+			for(e = inicio[u]; e < inicio[u + 1]; e++) {
+				analisis.aristas[conexiones] = e;
+				analisis.partidas[conexiones++] = u;
+			}
+
+		lista_iter_avanzar(iter);
+	}
+
+	lista_iter_destruir(iter);
+
+	// Analizamos las conexiones
+	red->cantidad_secciones = conexiones;
+	hilos_repartir(red->hilos, conexiones, analizar_falla_conexion,
+		&analisis);
+
+	size_t afectadas = 0;
+	for(i = 0; i < hilos; i++) afectadas += analisis.conexiones_afectadas[i];
+	estadisticas_registrar_contador("fallas_conexiones", conexiones);
+	estadisticas_registrar_contador("fallas_conexiones_afectadas", afectadas);
+
+	for(i = 0; i < hilos; i++)
+		estadisticas_free(SUBSISTEMA_ROUTER, analisis.afectados[i]);
+
+	fallas_destruir(analisis.fallas);
+	estadisticas_free(SUBSISTEMA_ROUTER, analisis.hosts);
+	estadisticas_free(SUBSISTEMA_ROUTER, analisis.aristas);
+	estadisticas_free(SUBSISTEMA_ROUTER, analisis.partidas);
+	estadisticas_free(SUBSISTEMA_ROUTER, analisis.inicio_hosts);
+	estadisticas_free(SUBSISTEMA_ROUTER, analisis.hosts_por_vertice);
+	estadisticas_free(SUBSISTEMA_ROUTER, analisis.afectados);
+	estadisticas_free(SUBSISTEMA_ROUTER, analisis.conexiones_afectadas);
+}
+
+// Guarda en un archivo los resultados de la red, para reutilizarlos al
+// volver a procesar la misma especificación de ruteo.
+// PRE: 'red' es una red cuyos caminos ya han sido obtenidos; 'ruta' es el
+// nombre del archivo; 'huella' es la huella de la especificación.
+// POST: se reemplazó el archivo por uno con las distancias y los previos
+// desde el origen y las secciones [route_path] de la red. Si no se pudo
+// escribir, se informa en la salida de errores.
+void red_persistir_caminos(red_t *red, const char *ruta,
+	const persistencia_huella_t *huella) {
+	persistencia_contenido_t contenido;
+	size_t i;
+
+	if(!red->resultados) return;
+
+	persistencia_fragmento_t *fragmentos = (persistencia_fragmento_t*)
+		estadisticas_malloc(SUBSISTEMA_ROUTER,
+		(red->cantidad_secciones + 1) * sizeof(persistencia_fragmento_t));
+	if(!fragmentos) exit(0);
+
+	for(i = 0; i < red->cantidad_secciones; i++) {
+		const seccion_t *seccion = &red->secciones[i];
+		fragmentos[i].datos = red->salidas[seccion->buffer].datos +
+			seccion->inicio;
+		fragmentos[i].largo = seccion->largo;
+	}
+
+	// Las áreas sólo calculan los caminos hacia los hosts
+	contenido.vertices = grafo_compacto_cantidad_vertices(red->grafo);
+	contenido.aristas = grafo_compacto_cantidad_aristas(red->grafo);
+	contenido.hosts = lista_largo(red->hosts);
+	contenido.parcial = red->particion != NULL;
+	dijkstra_obtener_arreglos(red->resultados, &contenido.distancias,
+		&contenido.previos);
+	contenido.salida = fragmentos;
+	contenido.fragmentos = red->cantidad_secciones;
+
+	// Los arreglos se guardan en el orden de la sección [device], que no
+	// depende del orden de numeración elegido
+	uint32_t *distancias = NULL, *previos = NULL;
+
+	if(red->orden != ORDEN_ARCHIVO) {
+		uint32_t v, o, n = contenido.vertices;
+
+		distancias = (uint32_t*) estadisticas_malloc(SUBSISTEMA_ROUTER,
+			(n + 1) * sizeof(uint32_t));
+		previos = (uint32_t*) estadisticas_malloc(SUBSISTEMA_ROUTER,
+			(n + 1) * sizeof(uint32_t));
+		if(!distancias || !previos) exit(0);
+
+		for(v = 0; v < n; v++) {
+			o = grafo_compacto_indice_original(red->grafo, v);
+			distancias[o] = contenido.distancias[v];
+			previos[o] = contenido.previos[v] == GRAFO_COMPACTO_SIN_VERTICE ?
+				GRAFO_COMPACTO_SIN_VERTICE :
+				grafo_compacto_indice_original(red->grafo,
+				contenido.previos[v]);
+		}
+
+		contenido.distancias = distancias;
+		contenido.previos = previos;
+	}
+
+	if(!persistencia_guardar(ruta, huella, &contenido))
+		fprintf(stderr, "ERROR: No se pudieron guardar los resultados en "
+			"'%s'.\n", ruta);
+
+	estadisticas_free(SUBSISTEMA_ROUTER, distancias);
+	estadisticas_free(SUBSISTEMA_ROUTER, previos);
+	estadisticas_free(SUBSISTEMA_ROUTER, fragmentos);
+}
+
+// Envía a la salida estandar los caminos guardados en un archivo de
+// resultados, sin cargar la red.
+// PRE: 'ruta' es el nombre del archivo de resultados; 'huella' es la
+// huella de la especificación de ruteo; 'contenido' es donde se cargan
+// los resultados guardados.
+// POST: devuelve true si el archivo tenía los resultados de la misma
+// especificación y se enviaron sus caminos, o false en caso contrario (sin
+// enviar nada). Al terminar, de 'contenido' sólo siguen siendo válidas
+// las dimensiones de la red.
+bool enviar_caminos_persistidos(const char *ruta,
+	const persistencia_huella_t *huella, persistencia_contenido_t *contenido) {
+	persistencia_t *persistencia = persistencia_abrir(ruta, huella,
+		contenido);
+	if(!persistencia) return false;
+
+	// El texto se envía directamente desde las páginas del archivo
+	fwrite(contenido->salida->datos, 1, contenido->salida->largo, stdout);
+	fflush(stdout);
+
+	persistencia_cerrar(persistencia);
+	return true;
+}
+
+// Indexa los hosts, dispositivos y subredes de la red por IP, para
+// responder consultas por el camino hacia una IP cualquiera.
+// PRE: 'red' es una red cuyo grafo ya ha sido armado.
+// POST: cada IP de un host queda vinculada al dispositivo al cual está
+// conectado, cada IP de un dispositivo a él mismo y cada subred a su
+// dispositivo. Ante un mismo prefijo repetido prevalece el primero.
+void red_indexar_prefijos(red_t *red) {
+	lista_iter_t* iter;
+	lista_dato_t registro;
+	device_t *device;
+
+	red->prefijos = prefijos_crear();
+	if(!red->prefijos) exit(0);
+
+	// Hosts
+	iter = lista_iter_crear(red->hosts);
+
+	while(!lista_iter_al_final(iter)) {
+		lista_iter_ver_actual(iter, &registro);
+		host_t *host = (host_t*) registro;
+
+		if((device = buscar_device(red, host->dispositivo_nombre)) &&
+			!prefijos_insertar(red->prefijos, &host->ip, 128, device))
+			exit(0);
+		lista_iter_avanzar(iter);
+	}
+
+	lista_iter_destruir(iter);
+
+	// Dispositivos
+	iter = lista_iter_crear(red->devices);
+
+	while(!lista_iter_al_final(iter)) {
+		lista_iter_ver_actual(iter, &registro);
+		device = (device_t*) registro;
+
+		if(!prefijos_insertar(red->prefijos, &device->ip, 128, device))
+			exit(0);
+		lista_iter_avanzar(iter);
+	}
+
+	lista_iter_destruir(iter);
+
+	// Subredes
+	iter = lista_iter_crear(red->subnets);
+
+	while(!lista_iter_al_final(iter)) {
+		lista_iter_ver_actual(iter, &registro);
+		subnet_t *subnet = (subnet_t*) registro;
+
+		if((device = buscar_device(red, subnet->dispositivo_nombre)) &&
+			!prefijos_insertar(red->prefijos, &subnet->prefijo,
+				subnet->largo, device))
+			exit(0);
+		lista_iter_avanzar(iter);
+	}
+
+	lista_iter_destruir(iter);
+}
+
+// Devuelve el camino desde el dispositivo origen hacia el dispositivo
+// responsable de una IP, en una versión del grafo de la red.
+// PRE: 'red' es una red cuyos prefijos ya han sido indexados; 'version'
+// es una versión fijada por el llamador; 'ip' es una IP válida.
+// POST: devuelve la lista de dispositivos del camino, válida mientras la
+// versión esté fijada, o NULL si ningún dispositivo es responsable de la
+// IP o si el responsable no es alcanzable desde el origen. El camino
+// hacia cada dispositivo se extrae una única vez por versión y se
+// reutiliza en las consultas siguientes, aunque varios lectores consulten
+// la versión a la vez.
+lista_t* red_consultar_camino(red_t *red, version_t *version,
+	const ip_t *ip) {
+	prefijos_dato_t device;
+	lista_t *camino, *previo = NULL;
+	const uint32_t *distancias, *previos;
+
+	if(!version->resultados || !prefijos_buscar(red->prefijos, ip, &device))
+		return NULL;
+
+	uint32_t v = grafo_compacto_buscar_vertice(version->grafo, device);
+
+	// Un dispositivo inalcanzable no tiene camino
+	dijkstra_obtener_arreglos(version->resultados, &distancias, &previos);
+	if(distancias[v] == UINT32_MAX) return NULL;
+
+	camino = __atomic_load_n(&version->caminos_por_vertice[v],
+		__ATOMIC_ACQUIRE);
+	if(camino) return camino;
+
+	camino = dijkstra_obtener_camino(version->resultados,
+		(lista_dato_t) device);
+	if(!camino) exit(0);
+
+	// Si otro lector extrajo el camino antes, utilizamos el suyo
+	if(!__atomic_compare_exchange_n(&version->caminos_por_vertice[v],
+		&previo, camino, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+		lista_destruir(camino, NULL);
+		camino = previo;
+	}
+
+	return camino;
+}
+
+// Responde las consultas por el camino desde el host origen hacia las IPs
+// de un archivo.
+// PRE: 'red' es una red cuyos prefijos ya han sido indexados y cuya
+// versión ya ha sido publicada (ver red_publicar_version()); 'archivo' es
+// el nombre del archivo de consultas, con una IP por línea.
+// POST: se imprimió una sección [route_query] por cada IP válida del
+// archivo, en el orden en que aparecen, respondida con la versión vigente
+// al comenzar a responderla. Las IPs inválidas se informan en la salida
+// de errores y se ignoran.
+void red_responder_consultas(red_t *red, char *archivo) {
+	lista_dato_t host_origen;
+	char *buffer = NULL;
+	size_t capacidad = 0;
+	ssize_t largo;
+	ip_t ip;
+
+	if(!lista_ver_primero(red->hosts, &host_origen)) return;
+
+	FILE *fp = archivo_abrir(archivo);
+
+	while((largo = getline(&buffer, &capacidad, fp)) != -1) {
+		// Quitamos el fin de línea e ignoramos las líneas vacías
+		if(largo && buffer[largo - 1] == '\n') buffer[--largo] = '\0';
+		if(!largo || !parser_ip(buffer, largo, &ip)) continue;
+
+		// Cada consulta fija la versión vigente mientras la responde
+		version_t *version = (version_t*) epocas_fijar(red->versiones, 0);
+		enviar_consulta_salida_estandar(red->cadenas, (host_t*) host_origen,
+			&ip, red_consultar_camino(red, version, &ip));
+		epocas_soltar(red->versiones, 0);
+	}
+
+	free(buffer);
+	archivo_cerrar(fp);
+}
+
+// Tipo auxiliar con los archivos que procesan el lector y el escritor
+typedef struct {
+	red_t *red;									// Red procesada
+	char *consultas;							// Archivo de consultas
+	char *cambios;								// Archivo de cambios
+} consultas_cambios_t;
+
+// Tarea que responde las consultas (hilo 0) o aplica los cambios (hilo 1).
+// PRE: 'contexto' es un consultas_cambios_t.
+void atender_consultas_cambios(size_t hilo, void *contexto) {
+	consultas_cambios_t *archivos = (consultas_cambios_t*) contexto;
+
+	if(hilo == 0) red_responder_consultas(archivos->red, archivos->consultas);
+	else red_aplicar_cambios(archivos->red, archivos->cambios);
+}
+
+// Responde las consultas de un archivo mientras se aplican los cambios de
+// topología de otro.
+// PRE: 'red' cumple las condiciones de red_responder_consultas() y de
+// red_aplicar_cambios(); 'consultas' y 'cambios' son los nombres de los
+// archivos de consultas y de cambios.
+// POST: las consultas se respondieron en un hilo y los cambios se
+// aplicaron en otro, a la vez. Cada consulta se responde con la última
+// versión publicada al comenzar a responderla.
+void red_responder_consultas_con_cambios(red_t *red, char *consultas,
+	char *cambios) {
+	consultas_cambios_t archivos = { red, consultas, cambios };
+
+	hilos_t *hilos = hilos_crear(2);
+	if(!hilos) exit(0);
+
+	hilos_ejecutar(hilos, atender_consultas_cambios, &archivos);
+	hilos_destruir(hilos);
+}
+
+// Función que carga la fila de distancias de un host origen a partir de
+// las distancias desde su dispositivo.
+// PRE: 'red' es una red cuyas distancias se están calculando; 'vertices'
+// es el vértice del dispositivo de cada uno de los 'h' hosts; 'fila' es
+// la posición del host origen; 'distancias' es la distancia desde su
+// dispositivo hacia el dispositivo de índice 'v', almacenada en la
+// posición 'v * paso'.
+// POST: se cargó la distancia del host origen hacia cada host.
+void red_cargar_distancias(red_t *red, const uint32_t *vertices, size_t h,
+	size_t fila, const uint32_t *distancias, size_t paso) {
+	size_t j;
+
+	for(j = 0; j < h; j++)
+		red->distancias[fila * h + j] =
+			vertices[j] == GRAFO_COMPACTO_SIN_VERTICE ?
+			MULTIORIGEN_INFINITO : distancias[(size_t) vertices[j] * paso];
+}
+
+// Calcula la distancia mínima entre cada par de hosts de la red, como la
+// distancia entre los dispositivos a los cuales están conectados.
+// PRE: 'red' es una red cuyo grafo ya ha sido armado.
+// POST: se almacenaron en la red las distancias. Los dispositivos
+// origen, sin repetir, se procesan de a MULTIORIGEN_LOTE por recorrido
+// del grafo.
+void red_calcular_distancias(red_t *red) {
+	size_t h = lista_largo(red->hosts), i, j, k, cantidad, pendientes = 0;
+	uint32_t v, n = grafo_compacto_cantidad_vertices(red->grafo);
+	uint32_t origenes[MULTIORIGEN_LOTE];
+	lista_dato_t host;
+	device_t *device;
+
+	uint32_t *vertices = (uint32_t*) estadisticas_malloc(SUBSISTEMA_ROUTER,
+		(h + 1) * sizeof(uint32_t));
+	uint32_t *lote = (uint32_t*) estadisticas_malloc(SUBSISTEMA_ROUTER,
+		((size_t) n * MULTIORIGEN_LOTE + 1) * sizeof(uint32_t));
+	uint32_t *posicion = (uint32_t*) estadisticas_malloc(SUBSISTEMA_ROUTER,
+		(n + 1) * sizeof(uint32_t));
+	uint32_t *pendiente = (uint32_t*) estadisticas_malloc(SUBSISTEMA_ROUTER,
+		(h + 1) * sizeof(uint32_t));
+	red->distancias = (uint32_t*) estadisticas_malloc(SUBSISTEMA_ROUTER,
+		(h * h + 1) * sizeof(uint32_t));
+	if(!vertices || !lote || !posicion || !pendiente || !red->distancias)
+		exit(0);
+
+	// Obtenemos el vértice del dispositivo de cada host
+	lista_iter_t* iter = lista_iter_crear(red->hosts);
+
+	for(i = 0; !lista_iter_al_final(iter); i++) {
+		lista_iter_ver_actual(iter, &host);
+		device = buscar_device(red, ((host_t*) host)->dispositivo_nombre);
+		vertices[i] = device ? grafo_compacto_buscar_vertice(red->grafo,
+			device) : GRAFO_COMPACTO_SIN_VERTICE;
+		lista_iter_avanzar(iter);
+	}
+
+	lista_iter_destruir(iter);
+
+	// Anotamos una única vez cada origen, con su posición entre ellos
+	for(v = 0; v < n; v++) posicion[v] = GRAFO_COMPACTO_SIN_VERTICE;
+
+	for(i = 0; i < h; i++) {
+		v = vertices[i];
+
+		if(v == GRAFO_COMPACTO_SIN_VERTICE)
+			for(j = 0; j < h; j++)
+				red->distancias[i * h + j] = MULTIORIGEN_INFINITO;
+		else if(posicion[v] == GRAFO_COMPACTO_SIN_VERTICE) {
+			posicion[v] = pendientes;
+			pendiente[pendientes++] = v;
+		}
+	}
+
+	// Procesamos los orígenes pendientes por lotes
+	for(i = 0; i < pendientes; i += cantidad) {
+		cantidad = pendientes - i < MULTIORIGEN_LOTE ? pendientes - i :
+			MULTIORIGEN_LOTE;
+
+		for(k = 0; k < cantidad; k++) origenes[k] = pendiente[i + k];
+
+		if(!multiorigen_distancias(red->grafo, origenes, cantidad, lote))
+			exit(0);
+
+		// Cargamos la fila de cada host cuyo origen es parte del lote
+		for(j = 0; j < h; j++) {
+			v = vertices[j];
+			if(v == GRAFO_COMPACTO_SIN_VERTICE || posicion[v] < i ||
+				posicion[v] >= i + cantidad)
+				continue;
+
+			red_cargar_distancias(red, vertices, h, j,
+				lote + (posicion[v] - i), MULTIORIGEN_LOTE);
+		}
+	}
+
+	estadisticas_free(SUBSISTEMA_ROUTER, vertices);
+	estadisticas_free(SUBSISTEMA_ROUTER, lote);
+	estadisticas_free(SUBSISTEMA_ROUTER, posicion);
+	estadisticas_free(SUBSISTEMA_ROUTER, pendiente);
+}
+
+// Envía a la salida estandar las distancias entre cada par de hosts.
+// PRE: 'red' es una red cuyas distancias ya han sido calculadas.
+// POST: se imprimió una sección [distances:NOMBRE_HOST_ORIGEN] por cada
+// host, y debajo de esta una línea [NOMBRE_HOST_DESTINO:DISTANCIA] por
+// cada uno de los demás hosts, con '-' como distancia si no hay camino.
+void red_enviar_distancias(red_t *red) {
+	size_t h = lista_largo(red->hosts), i, j;
+	lista_dato_t host;
+
+	if(!red->distancias) return;
+
+	// Tomamos los nombres de los hosts en el orden de la lista
+	const char **nombres = (const char**) estadisticas_malloc(
+		SUBSISTEMA_ROUTER, (h + 1) * sizeof(char*));
+	if(!nombres) exit(0);
+
+	lista_iter_t* iter = lista_iter_crear(red->hosts);
+
+	for(i = 0; !lista_iter_al_final(iter); i++) {
+		lista_iter_ver_actual(iter, &host);
+		nombres[i] = cadenas_obtener(red->cadenas, ((host_t*) host)->nombre);
+		lista_iter_avanzar(iter);
+	}
+
+	lista_iter_destruir(iter);
+
+	for(i = 0; i < h; i++) {
+		printf("[distances:%s]\n", nombres[i]);
+
+		for(j = 0; j < h; j++) {
+			if(j == i) continue;
+
+			if(red->distancias[i * h + j] == MULTIORIGEN_INFINITO)
+				printf("%s:-\n", nombres[j]);
+			else
+				printf("%s:%u\n", nombres[j],
+					(unsigned int) red->distancias[i * h + j]);
+		}
+	}
+
+	estadisticas_free(SUBSISTEMA_ROUTER, nombres);
+}
+
+// Devuelve la cantidad de hosts de la red.
+// PRE: 'red' es una red existente.
+size_t red_cantidad_hosts(red_t *red) {
+	return lista_largo(red->hosts);
+}
+
+// Devuelve la cantidad de dispositivos de la red.
+// PRE: 'red' es una red existente.
+size_t red_cantidad_devices(red_t *red) {
+	return lista_largo(red->devices);
+}
+
+// Devuelve la cantidad de conexiones cargadas que aún no fueron volcadas
+// al grafo de dispositivos.
+// PRE: 'red' es una red existente.
+size_t red_cantidad_routes(red_t *red) {
+	return lista_largo(red->routes);
+}
+
 // Función que procesa una red compuesta de hosts y dispositivos, tales
 // como routers, con el fin del encontrar el camino minimo para el envío
 // de datos desde un host origen hacia los demas hosts existentes en la
@@ -557,68 +2589,151 @@ int criterio_de_seleccion_de_camino(lista_dato_t c1, lista_dato_t c2) {
 // Si no se especifica ningún archivo de entrada, el sistema solicitará
 // que se ingresen los datos a través de la entrada estandar, siendo
 // estrictamente necesario ingresarlos correctamente sin errores, con el
-// formato que se indicará por pantalla.
-// POST: Los resultados se envían a la salida estandar.
-void procesar_red_caminos_minimos(char *archivo) {
-	// Variables y punteros utilizados
-	grafo_t *grafo_devices = NULL;
-	lista_t *devices = lista_crear();
-	lista_t *hosts = lista_crear();
-	lista_t *camino;
-	lista_dato_t device_origen, host_origen, host_destino;
-
-
-	// Armamos el grafo de routers
-	if(archivo)
-		// Procesamos hosts y devices desde archivo de entrada.
-		grafo_devices = armar_red_archivo_de_entrada(archivo, devices, hosts);
-	else
-		// Procesamos hosts y devices desde entrada estandar
-		grafo_devices = armar_red_entrada_estandar(devices, hosts);
-
-	// En el primer elemento de la lista se encuentra el origen de los
-	// dispositivos
-	lista_ver_primero(devices, &device_origen);
+// formato que se indicará por pantalla. Opcionalmente, la sección
+// [subnet] asocia subredes a dispositivos, con el formato
+// '[IP]/[LARGO],[NOMBRE_ROUTER]', y la sección [area] asigna dispositivos
+// a áreas, con el formato '[NOMBRE_ROUTER],[AREA]'. 'opciones' son las
+// opciones de procesamiento.
+// POST: Los resultados se envían a la salida estandar. Si se indicó un
+// archivo de persistencia, los caminos se toman de él cuando guarda los
+// de la misma especificación, y si no se los guarda en él.
+void procesar_red_caminos_minimos(char *archivo, 
+	const red_opciones_t *opciones) {
+	persistencia_huella_t huella;
+	persistencia_contenido_t guardado;
+	bool persistir = opciones->persistencia && archivo &&
+		strcmp(archivo, RED_ENTRADA_ESTANDAR) &&
+		!opciones->consultas && !opciones->distancias && !opciones->fallas;
+
+	// Si la especificación no cambió desde que se guardaron sus resultados,
+	// los enviamos sin cargar la red ni calcular sus caminos
+	if(persistir) {
+		estadisticas_iniciar_etapa(ETAPA_PARSEO);
+		persistir = persistencia_huella_archivo(archivo, &huella);
+		estadisticas_finalizar_etapa(ETAPA_PARSEO);
+	}
 
-	// Procesamos el grafo y obtenemos los resultados de aplicar
-	// el algoritmo de Dijkstra
-	lista_t* resultados = dijkstra_caminos_minimos(grafo_devices,
-		device_origen, criterio_de_seleccion_de_camino);
+	if(persistir) {
+		estadisticas_iniciar_etapa(ETAPA_SALIDA);
+		bool reutilizado = enviar_caminos_persistidos(opciones->persistencia,
+			&huella, &guardado);
+		estadisticas_finalizar_etapa(ETAPA_SALIDA);
+
+		if(reutilizado) {
+			estadisticas_registrar_contador("persistencia_reutilizada", 1);
+			estadisticas_informar(stderr, opciones->estadisticas,
+				guardado.vertices, guardado.aristas, guardado.hosts);
+			return;
+		}
 
+		estadisticas_registrar_contador("persistencia_reutilizada", 0);
+	}
 
-	// Creamos un iterador para la lista de hosts
-	lista_iter_t* iter = lista_iter_crear(hosts);
-	
-	// Tomamos el host origen
-	lista_iter_ver_actual(iter, &host_origen);
-	lista_iter_avanzar(iter);
+	red_t *red = red_crear();
+	red_establecer_hilos(red, opciones->hilos);
+	red_establecer_orden(red, opciones->orden);
+	red_establecer_k_caminos(red, opciones->k_caminos);
+
+	// Procesamos la red etapa por etapa
+	estadisticas_iniciar_etapa(ETAPA_PARSEO);
+	red_cargar(red, archivo);
+	estadisticas_finalizar_etapa(ETAPA_PARSEO);
+
+	estadisticas_iniciar_etapa(ETAPA_CONSTRUCCION);
+	if(opciones->cambios) red_admitir_cambios(red, opciones->cache);
+	red_armar_grafo(red);
+	if(opciones->consultas) red_indexar_prefijos(red);
+	if(opciones->areas) red_dividir_en_areas(red, opciones->areas);
+	estadisticas_finalizar_etapa(ETAPA_CONSTRUCCION);
+
+	// Tomamos las dimensiones de la red antes de que las consultas tomen
+	// posesión del grafo
+	size_t vertices = grafo_compacto_cantidad_vertices(red->grafo);
+	size_t aristas = grafo_compacto_cantidad_aristas(red->grafo);
+	size_t hosts = lista_largo(red->hosts);
+
+	estadisticas_iniciar_etapa(ETAPA_CAMINOS);
+	if(opciones->distancias)
+		red_calcular_distancias(red);
+	else if(opciones->areas)
+		red_calcular_caminos_minimos_por_areas(red);
+	else if(opciones->motor == MOTOR_DELTA)
+		red_calcular_caminos_minimos_paralelo(red, opciones->delta);
+	else
+		red_calcular_caminos_minimos(red);
+	if(opciones->consultas) red_publicar_version(red);
+	estadisticas_finalizar_etapa(ETAPA_CAMINOS);
+
+	// En modo consultas los caminos se extraen a medida que se responden,
+	// y en modo distancias no se extraen
+	estadisticas_iniciar_etapa(ETAPA_EXTRACCION);
+	if(opciones->fallas)
+		red_analizar_fallas(red);
+	else if(!opciones->consultas && !opciones->distancias)
+		red_obtener_caminos(red);
+	estadisticas_finalizar_etapa(ETAPA_EXTRACCION);
+
+	estadisticas_iniciar_etapa(ETAPA_SALIDA);
+	if(opciones->consultas && opciones->cambios)
+		red_responder_consultas_con_cambios(red, opciones->consultas,
+			opciones->cambios);
+	else if(opciones->consultas)
+		red_responder_consultas(red, opciones->consultas);
+	else if(opciones->distancias)
+		red_enviar_distancias(red);
+	else
+		red_enviar_caminos(red);
+	fflush(stdout);
+	if(persistir) red_persistir_caminos(red, opciones->persistencia, &huella);
+	estadisticas_finalizar_etapa(ETAPA_SALIDA);
+
+	// Registramos los contadores del algoritmo, si fueron compilados
+	dijkstra_contadores_t contadores;
+
+	if(dijkstra_obtener_contadores(&contadores)) {
+		estadisticas_registrar_contador("dijkstra_vertices_marcados",
+			contadores.vertices_marcados);
+		estadisticas_registrar_contador("dijkstra_relajaciones",
+			contadores.relajaciones);
+		estadisticas_registrar_contador("dijkstra_relajaciones_exitosas",
+			contadores.relajaciones_exitosas);
+		estadisticas_registrar_contador("dijkstra_encolados",
+			contadores.encolados);
+		estadisticas_registrar_contador("dijkstra_desencolados",
+			contadores.desencolados);
+		estadisticas_registrar_contador("dijkstra_desempates",
+			contadores.desempates);
+		estadisticas_registrar_contador("dijkstra_pasos_extraccion",
+			contadores.pasos_extraccion);
+	}
 
-	// Procesamos los caminos hacia los demás hosts
-	while(!lista_iter_al_final(iter)) {
-		lista_iter_ver_actual(iter, &host_destino);
-		
-		// Solicitamos el camino hacia el destino
-		camino = dijkstra_obtener_camino(resultados, 
-			(lista_dato_t) buscar_device(devices, 
-				((host_t*)host_destino)->dispositivo_nombre));
+	// Registramos los vértices explorados por el recorrido de múltiples
+	// orígenes y las instrucciones vectoriales con que se relajó
+	if(opciones->distancias) {
+		static char instrucciones[32];
 
-		// Enviamos a la salida estandar
-		enviar_camino_salida_estandar((host_t*) host_origen, 
-			(host_t*) host_destino, camino);
+		snprintf(instrucciones, sizeof(instrucciones), "multiorigen_%s",
+			multiorigen_instrucciones());
+		estadisticas_registrar_contador(instrucciones, 1);
+		estadisticas_registrar_contador("multiorigen_exploraciones",
+			multiorigen_exploraciones());
+	}
 
-		// Destruimos la lista de caminos
-		lista_destruir(camino, NULL);
+	// Registramos el uso de la caché de caminos de las versiones
+	if(red->cache) {
+		cache_contadores_t cache;
 
-		lista_iter_avanzar(iter);
+		cache_obtener_contadores(red->cache, &cache);
+		estadisticas_registrar_contador("cache_aciertos", cache.aciertos);
+		estadisticas_registrar_contador("cache_fallos", cache.fallos);
+		estadisticas_registrar_contador("cache_desalojos", cache.desalojos);
 	}
-	
-	lista_iter_destruir(iter);
 
-	// Destruimos los resultados obtenidos por Dijkstra
-	dijkstra_destruir_resultados(resultados);
 
 	// Liberamos memoria utilizada
-	lista_destruir(devices, free);
-	lista_destruir(hosts, free);
-	grafo_destruir(grafo_devices);
+	red_destruir(red);
+
+	// Informamos las estadísticas de ejecución
+	estadisticas_informar(stderr, opciones->estadisticas, vertices, aristas,
+		hosts);
 }
@@ -13,12 +13,314 @@
 #ifndef ROUTER_H
 #define ROUTER_H
 
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "estadisticas.h"
+
+
+
+/* ****************************************************************************
+ * DECLARACIÓN DE LOS TIPOS DE DATOS
+ * ***************************************************************************/
+
+typedef struct _red_t red_t;
+
+// Algoritmos con los que se pueden calcular los caminos mínimos.
+typedef enum {
+	MOTOR_DIJKSTRA,						// Dijkstra secuencial
+	MOTOR_DELTA							// Delta-stepping en paralelo
+} red_motor_t;
+
+// Órdenes en los que se pueden numerar los dispositivos del grafo.
+typedef enum {
+	ORDEN_ARCHIVO,						// Orden de la sección [device]
+	ORDEN_ANCHURA,						// Recorrido en anchura
+	ORDEN_RCM,							// Cuthill-McKee inverso
+	ORDEN_GRADO							// Cantidad de conexiones
+} red_orden_t;
+
+// Valor de la opción 'areas' que indica dividir la red según las áreas de
+// la sección [area] del archivo de entrada
+#define RED_AREAS_ETIQUETAS UINT32_MAX
+
+// Presupuesto de memoria predeterminado de la caché de caminos, en bytes
+#define RED_CACHE_PREDETERMINADA ((size_t) 64 << 20)
+
+// Nombre de archivo de entrada que indica leer la especificación de ruteo,
+// con el formato del archivo, desde la entrada estandar
+#define RED_ENTRADA_ESTANDAR "-"
+
+// Tipo que representa las opciones de procesamiento de una red.
+typedef struct {
+	estadisticas_formato_t estadisticas;	// Formato con el que se informan
+											// las estadísticas de ejecución
+											// en la salida de errores
+	char *consultas;						// Archivo de IPs a consultar, o
+											// NULL para informar los caminos
+											// hacia cada host
+	char *cambios;							// Archivo de cambios de
+											// topología a aplicar mientras
+											// se responden las consultas,
+											// o NULL
+	bool distancias;						// Informar las distancias entre
+											// cada par de hosts en lugar de
+											// los caminos
+	red_motor_t motor;						// Algoritmo de caminos mínimos
+	unsigned int hilos;						// Hilos de procesamiento
+	uint32_t delta;							// Ancho de los baldes del motor
+											// delta-stepping, o 0 para
+											// elegirlo automáticamente
+	uint32_t areas;							// Cantidad de áreas en que se
+											// divide la red para calcular
+											// los caminos en forma
+											// jerárquica,
+											// RED_AREAS_ETIQUETAS, o 0
+											// para no dividirla
+	char *persistencia;						// Archivo donde se guardan los
+											// caminos para reutilizarlos
+											// con la misma especificación,
+											// o NULL
+	red_orden_t orden;						// Orden en que se numeran los
+											// dispositivos del grafo
+	size_t k_caminos;						// Caminos mínimos que se
+											// informan hacia cada host
+	bool fallas;							// Informar el efecto de la
+											// caída de cada conexión en
+											// lugar de los caminos
+	size_t cache;							// Presupuesto de memoria de la
+											// caché de caminos de las
+											// versiones, en bytes
+} red_opciones_t;
+
 
 
 /* ****************************************************************************
  * FUNCIONES DE LA LIBRERIA
  * ***************************************************************************/
 
+// Crea una red vacía.
+// POST: devuelve una red sin hosts, dispositivos ni conexiones.
+red_t* red_crear();
+
+// Destruye una red junto con todos los resultados de su procesamiento.
+// PRE: 'red' es una red existente.
+// POST: se liberó la memoria utilizada por la red.
+void red_destruir(red_t *red);
+
+// Establece la cantidad de hilos con los que se procesa la red.
+// PRE: 'red' es una red existente cuyos caminos aún no se calcularon;
+// 'cantidad' es la cantidad de hilos (si es 0 se usa 1).
+// POST: los algoritmos paralelos de la red utilizan 'cantidad' hilos. Por
+// defecto la red se procesa con un único hilo.
+void red_establecer_hilos(red_t *red, unsigned int cantidad);
+
+// Establece el orden en que se numeran los dispositivos en el grafo de la
+// red.
+// PRE: 'red' es una red existente cuyo grafo aún no ha sido armado;
+// 'orden' es el orden de numeración.
+// POST: el grafo de la red (y el de cada versión publicada luego de
+// aplicar cambios) numera sus dispositivos en 'orden', de modo que los
+// dispositivos conectados queden cerca en memoria. Los resultados no
+// cambian. Por defecto se utiliza ORDEN_ARCHIVO.
+void red_establecer_orden(red_t *red, red_orden_t orden);
+
+// Establece la cantidad de caminos mínimos que se informan hacia cada host
+// destino.
+// PRE: 'red' es una red existente cuyos caminos aún no se obtuvieron; 'k'
+// es la cantidad de caminos (si es 0 se usa 1).
+// POST: con 'k' mayor a 1, se informan hasta 'k' caminos sin ciclos hacia
+// cada host, de menor a mayor costo, calculados con el algoritmo de Yen
+// a partir del árbol de caminos mínimos. Por defecto se informa sólo el
+// mejor.
+void red_establecer_k_caminos(red_t *red, size_t k);
+
+// Carga en la red las especificaciones de ruteo (etapa de parseo).
+// PRE: 'red' es una red existente; 'archivo' es el nombre de archivo 
+// (incluyendo su extensión si es que posee) en el que se encuentra la
+// especificación de ruteo, RED_ENTRADA_ESTANDAR si se la lee con el mismo
+// formato de la entrada estandar (por ejemplo, desde una tubería), o NULL
+// si se desea que el sistema la solicite al usuario a través de la
+// entrada estandar. El archivo y la entrada estandar pueden estar
+// comprimidos con gzip o, si se lo incluyó al compilar, con zstd.
+// POST: se almacenaron en la red los hosts, dispositivos y conexiones
+// especificados, sin armar aún el grafo de dispositivos. Los hosts
+// conectados a un dispositivo inexistente se ignoran.
+void red_cargar(red_t *red, char *archivo);
+
+// Arma el grafo de dispositivos de la red a partir de los dispositivos y
+// conexiones cargados (etapa de construcción).
+// PRE: 'red' es una red cargada.
+// POST: los vértices del grafo son los dispositivos y sus aristas las 
+// conexiones. Las conexiones ya no se mantienen en la red.
+void red_armar_grafo(red_t *red);
+
+// Calcula los caminos mínimos desde el dispositivo origen de la red hacia
+// los demás dispositivos.
+// PRE: 'red' es una red cuyo grafo ya ha sido armado.
+// POST: se almacenaron en la red los resultados de aplicar el algoritmo de
+// Dijkstra sobre el grafo. Si la red admite cambios y su caché tiene el
+// árbol del origen sobre la misma topología, se lo toma de ella sin
+// recorrer el grafo.
+void red_calcular_caminos_minimos(red_t *red);
+
+// Calcula los caminos mínimos desde el dispositivo origen de la red hacia
+// los demás dispositivos, repartiendo el trabajo entre los hilos de la red.
+// PRE: 'red' es una red cuyo grafo ya ha sido armado; 'ancho' es el ancho
+// de los baldes del algoritmo delta-stepping o DELTA_ANCHO_AUTOMATICO.
+// POST: se almacenaron en la red los mismos resultados que con
+// red_calcular_caminos_minimos(), obtenidos con el algoritmo
+// delta-stepping (o tomados de la caché de la red).
+void red_calcular_caminos_minimos_paralelo(red_t *red, uint32_t ancho);
+
+// Divide el grafo de la red en áreas, para calcular sus caminos en forma
+// jerárquica (ver red_calcular_caminos_minimos_por_areas()).
+// PRE: 'red' es una red cuyo grafo ya ha sido armado; 'cantidad' es la
+// cantidad de áreas en que se divide el grafo automáticamente, o
+// RED_AREAS_ETIQUETAS para utilizar las áreas de la sección [area].
+// POST: se almacenaron en la red las áreas del grafo, cuyas distancias
+// entre bordes se calculan al utilizarlas. Con RED_AREAS_ETIQUETAS, los
+// dispositivos sin área asignada forman un área más, y ante un
+// dispositivo asignado varias veces prevalece la primera asignación.
+void red_dividir_en_areas(red_t *red, uint32_t cantidad);
+
+// Calcula los caminos mínimos desde el dispositivo origen de la red hacia
+// los dispositivos de los hosts, utilizando las áreas de la red.
+// PRE: 'red' es una red cuyo grafo ya ha sido dividido en áreas (ver
+// red_dividir_en_areas()).
+// POST: se almacenaron en la red resultados cuyos caminos hacia los
+// dispositivos de los hosts son los mismos que con
+// red_calcular_caminos_minimos(). Sólo se recorren el área del origen,
+// las distancias entre bordes de las áreas cercanas a esos caminos y las
+// áreas por las que pasan.
+void red_calcular_caminos_minimos_por_areas(red_t *red);
+
+// Indica que la topología de la red podrá modificarse luego de calcular
+// sus caminos (ver red_aplicar_cambios()).
+// PRE: 'red' es una red cuyo grafo aún no ha sido armado; 'presupuesto'
+// es la máxima cantidad de bytes que pueden ocupar los árboles de caminos
+// mínimos guardados en la caché de la red.
+// POST: al armar el grafo se conserva, además de su representación
+// compacta, el grafo de listas que modifica el escritor. Los árboles que
+// se calculan se guardan en la caché, identificados por el origen y la
+// versión de la topología, y al volver la topología a una versión ya
+// calculada (por ejemplo, al restablecerse una conexión que había caído)
+// se toman de ella; al superar el presupuesto se descartan los usados
+// hace más tiempo.
+void red_admitir_cambios(red_t *red, size_t presupuesto);
+
+// Publica el grafo de la red y sus caminos mínimos como la versión que
+// utilizan las consultas.
+// PRE: 'red' es una red cuyos caminos mínimos ya han sido calculados.
+// POST: las consultas que comiencen a partir de ahora utilizan la versión
+// publicada, que toma posesión del grafo y de los caminos de la red (la
+// red queda sin ellos). La versión anterior se destruye cuando ya no la
+// utiliza ninguna consulta.
+void red_publicar_version(red_t *red);
+
+// Aplica a la red los cambios de topología de un archivo, publicando una
+// versión nueva por cada lote de cambios.
+// PRE: 'red' es una red que admite cambios y cuya primera versión ya ha
+// sido publicada; 'archivo' es el nombre del archivo de cambios, con un
+// cambio por línea con el formato '[D1]->[D2],[PESO]' para crear o
+// modificar una conexión o '[D1]->[D2],-' para eliminarla. Una línea
+// vacía cierra un lote.
+// POST: se aplicaron los cambios válidos en orden, y cada lote se publicó
+// como una versión nueva en forma atómica: las consultas que se
+// responden mientras tanto utilizan la versión anterior completa, sin
+// esperar al escritor. Los cambios inválidos se informan en la salida de
+// errores y se ignoran.
+void red_aplicar_cambios(red_t *red, char *archivo);
+
+// Obtiene los caminos desde el host origen hacia los demás hosts de la red
+// (etapa de extracción).
+// PRE: 'red' es una red cuyos caminos mínimos ya han sido calculados.
+// POST: se almacenó en la red la sección [route_path] de cada host
+// destino, lista para enviar a la salida estandar. Los destinos se
+// reparten entre los hilos de la red, y cada hilo escribe sus secciones
+// en su propio buffer.
+void red_obtener_caminos(red_t *red);
+
+// Envía a la salida estandar los caminos obtenidos desde el host origen
+// hacia los demás hosts de la red.
+// PRE: 'red' es una red cuyos caminos ya han sido obtenidos.
+// POST: se imprimió una sección [route_path] por cada host destino, en el
+// orden de la lista de hosts (o, si se analizaron las caídas de las
+// conexiones, el informe de cada conexión).
+void red_enviar_caminos(red_t *red);
+
+// Analiza la caída de cada conexión de la red.
+// PRE: 'red' es una red cuyos caminos mínimos ya han sido calculados para
+// todos los dispositivos.
+// POST: se almacenó en la red, lista para enviar a la salida estandar con
+// red_enviar_caminos(), una sección [link_failure:D1->D2:CANTIDAD] por
+// cada conexión, seguida de la sección [route_path] con el nuevo camino
+// hacia cada uno de los CANTIDAD hosts destino cuyo camino cambia si la
+// conexión cae ('sin ruta' si deja de ser alcanzable). Las conexiones se
+// informan en el orden de sus dispositivos de partida en la sección
+// [device] y, para cada uno, en el de la sección [route]. Sólo se
+// recalculan los caminos hacia el subárbol que cuelga de cada conexión,
+// y las conexiones se reparten entre los hilos de la red.
+void red_analizar_fallas(red_t *red);
+
+// Indexa los hosts, dispositivos y subredes de la red por IP, para
+// responder consultas por el camino hacia una IP cualquiera.
+// PRE: 'red' es una red cuyo grafo ya ha sido armado.
+// POST: cada IP de un host queda vinculada al dispositivo al cual está
+// conectado, cada IP de un dispositivo a él mismo y cada subred a su
+// dispositivo. Ante un mismo prefijo repetido prevalece el primero.
+void red_indexar_prefijos(red_t *red);
+
+// Responde las consultas por el camino desde el host origen hacia las IPs
+// de un archivo.
+// PRE: 'red' es una red cuyos prefijos ya han sido indexados y cuya
+// versión ya ha sido publicada (ver red_publicar_version()); 'archivo' es
+// el nombre del archivo de consultas, con una IP por línea.
+// POST: se imprimió una sección [route_query] por cada IP válida del
+// archivo, en el orden en que aparecen, respondida con la versión vigente
+// al comenzar a responderla. Las IPs inválidas se informan en la salida
+// de errores y se ignoran.
+void red_responder_consultas(red_t *red, char *archivo);
+
+// Responde las consultas de un archivo mientras se aplican los cambios de
+// topología de otro.
+// PRE: 'red' cumple las condiciones de red_responder_consultas() y de
+// red_aplicar_cambios(); 'consultas' y 'cambios' son los nombres de los
+// archivos de consultas y de cambios.
+// POST: las consultas se respondieron en un hilo y los cambios se
+// aplicaron en otro, a la vez. Cada consulta se responde con la última
+// versión publicada al comenzar a responderla.
+void red_responder_consultas_con_cambios(red_t *red, char *consultas,
+	char *cambios);
+
+// Calcula la distancia mínima entre cada par de hosts de la red, como la
+// distancia entre los dispositivos a los cuales están conectados.
+// PRE: 'red' es una red cuyo grafo ya ha sido armado.
+// POST: se almacenaron en la red las distancias. Los dispositivos
+// origen, sin repetir, se procesan de a MULTIORIGEN_LOTE por recorrido
+// del grafo.
+void red_calcular_distancias(red_t *red);
+
+// Envía a la salida estandar las distancias entre cada par de hosts.
+// PRE: 'red' es una red cuyas distancias ya han sido calculadas.
+// POST: se imprimió una sección [distances:NOMBRE_HOST_ORIGEN] por cada
+// host, y debajo de esta una línea [NOMBRE_HOST_DESTINO:DISTANCIA] por
+// cada uno de los demás hosts, con '-' como distancia si no hay camino.
+void red_enviar_distancias(red_t *red);
+
+// Devuelve la cantidad de hosts de la red.
+// PRE: 'red' es una red existente.
+size_t red_cantidad_hosts(red_t *red);
+
+// Devuelve la cantidad de dispositivos de la red.
+// PRE: 'red' es una red existente.
+size_t red_cantidad_devices(red_t *red);
+
+// Devuelve la cantidad de conexiones cargadas que aún no fueron volcadas
+// al grafo de dispositivos.
+// PRE: 'red' es una red existente.
+size_t red_cantidad_routes(red_t *red);
+
 
 // Función que procesa una red compuesta de hosts y dispositivos, tales
 // como routers, con el fin del encontrar el camino minimo para el envío
@@ -37,11 +339,19 @@
 // entre los dispositivos, siendo su formato '[D1]->[D2],[PESO]', donde
 // D1 es el dispositivo de partida y D2 el dispositivo de llegada para 
 // ese tramo del recorrido.
-// Si no se especifica ningún archivo de entrada, el sistema solicitará
+// Si 'archivo' es RED_ENTRADA_ESTANDAR, la especificación se lee con el
+// mismo formato de la entrada estandar. Si es NULL, el sistema solicitará
 // que se ingresen los datos a través de la entrada estandar, siendo
 // estrictamente necesario ingresarlos correctamente sin errores, con el
-// formato que se indicará por pantalla.
-// POST: Los resultados se envían a la salida estandar.
-void procesar_red_caminos_minimos(char *archivo);
+// formato que se indicará por pantalla. Opcionalmente, la sección
+// [subnet] asocia subredes a dispositivos, con el formato
+// '[IP]/[LARGO],[NOMBRE_ROUTER]', y la sección [area] asigna dispositivos
+// a áreas, con el formato '[NOMBRE_ROUTER],[AREA]'. 'opciones' son las
+// opciones de procesamiento.
+// POST: Los resultados se envían a la salida estandar. Si se indicó un
+// archivo de persistencia, los caminos se toman de él cuando guarda los
+// de la misma especificación, y si no se los guarda en él.
+void procesar_red_caminos_minimos(char *archivo, 
+	const red_opciones_t *opciones);
 
 #endif
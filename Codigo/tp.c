@@ -25,11 +25,67 @@
  * Para el caso de utilizar un archivo de especificación de routeo, 
  * el programa se debe ejecutar del siguiente modo:
  *
- *		# ./tp [archivo]
+ *		# ./tp [--stats[=json]] [--consultas=CONSULTAS [--cambios=CAMBIOS
+ *			   [--cache=MIB]] | --distancias] [--motor=dijkstra|delta]
+ *			   [--hilos=N] [--delta=ANCHO] [--areas=N|etiquetas]
+ *			   [--persistencia=RUTA] [--orden=archivo|anchura|rcm|grado]
+ *			   [--k-caminos=K | --fallas] [archivo | - | --interactivo]
  *
  * donde,
  *
- *		archivo: nombre del archivo (incluyendo su extensión)
+ *		archivo: nombre del archivo (incluyendo su extensión). Si se
+ *				 omite, o si es '-', la especificación se lee con el mismo
+ *				 formato desde la entrada estandar (por ejemplo, desde
+ *				 una tubería). El archivo y la entrada estandar pueden
+ *				 estar comprimidos con gzip o, si se lo incluyó al
+ *				 compilar (make zstd=si), con zstd.
+ *		--interactivo: solicita la especificación al usuario a través de
+ *				 la entrada estandar (ver más abajo).
+ *		--stats: informa en la salida de errores el tiempo de reloj y de
+ *				 CPU de cada etapa, las dimensiones de la red, el pico de
+ *				 memoria residente y los pedidos de memoria por subsistema.
+ *				 Con '--stats=json' se informan en formato JSON.
+ *		--consultas: en lugar de los caminos hacia cada host, informa el
+ *				 camino hacia cada IP del archivo CONSULTAS (una por
+ *				 línea), a través del dispositivo responsable de la IP.
+ *		--cambios: mientras se responden las consultas, aplica en otro
+ *				 hilo los cambios de conexiones del archivo CAMBIOS (una
+ *				 por línea, '[D1]->[D2],[PESO]' o '[D1]->[D2],-' para
+ *				 eliminarla; una línea vacía cierra un lote). Cada
+ *				 consulta utiliza la última versión publicada.
+ *		--cache: memoria máxima, en MiB, de la caché de caminos de las
+ *				 versiones publicadas con '--cambios' (por defecto 64).
+ *		--distancias: en lugar de los caminos, informa la distancia
+ *				 mínima entre cada par de hosts.
+ *		--motor: algoritmo con el que se calculan los caminos mínimos
+ *				 desde el origen: 'dijkstra' (por defecto, secuencial) o
+ *				 'delta' (delta-stepping repartido entre varios hilos).
+ *				 Ambos producen los mismos caminos.
+ *		--hilos: cantidad de hilos del motor delta y de la extracción
+ *				 de los caminos hacia cada host (por defecto, la cantidad
+ *				 de procesadores disponibles).
+ *		--delta: ancho de los baldes del motor delta (por defecto se
+ *				 elige a partir de los pesos y el grado medio de la red).
+ *		--areas: calcula los caminos en forma jerárquica, dividiendo la
+ *				 red en N áreas de dispositivos cercanos o, con
+ *				 '--areas=etiquetas', en las áreas de la sección [area].
+ *				 Produce los mismos caminos que Dijkstra.
+ *		--persistencia: guarda los caminos en el archivo RUTA junto con
+ *				 la huella del archivo de entrada. Si al volver a
+ *				 ejecutarse la entrada no cambió, los caminos se envían
+ *				 desde RUTA sin procesar la red.
+ *		--orden: orden en que se numeran los dispositivos en el grafo:
+ *				 el del archivo (por defecto), por recorrido en anchura,
+ *				 por Cuthill-McKee inverso o por cantidad de conexiones.
+ *				 Los órdenes que acercan a los dispositivos conectados
+ *				 reducen los fallos de caché en redes grandes, sin
+ *				 cambiar los resultados.
+ *		--k-caminos: informa hasta K caminos sin ciclos hacia cada host,
+ *				 de menor a mayor costo, en secciones
+ *				 [route_path:ORIGEN->DESTINO#N:COSTO].
+ *		--fallas: en lugar de los caminos, informa para cada conexión
+ *				 los hosts cuyo camino cambia si la conexión cae, junto
+ *				 con su nuevo camino.
  * 
  *
  * Respecto al formato, el archivo debe estar dividido en secciones, 
@@ -53,13 +109,23 @@
  *
  * donde, D1 es el dispositivo de partida y D2 el dispositivo de llegada 
  * para ese tramo del recorrido, y PESO es el peso correspondiente a esa
- * conexión.
+ * conexión, un entero no negativo (las conexiones con otro peso se
+ * informan y se ignoran).
  *
- * Para el caso de utilizar la entrada estandar para el ingreso de las
- * especificaciones de routeo, el programa se debe ejecutar del siguiente
- * modo:
+ * Opcionalmente, la sección '[subnet]' asocia subredes a los 
+ * dispositivos a través de los cuales se las alcanza, con el formato:
  *
- *		# ./tp
+ *		[IP]/[LARGO],[NOMBRE_ROUTER]
+ *
+ * y la sección '[area]' asigna los dispositivos a áreas, con el formato:
+ *
+ *		[NOMBRE_ROUTER],[AREA]
+ *
+ * Para el caso de ingresar las especificaciones de routeo en forma
+ * interactiva a través de la entrada estandar, el programa se debe
+ * ejecutar del siguiente modo:
+ *
+ *		# ./tp --interactivo
  *
  * De esta manera, el sistema solicitará que se ingresen los datos a 
  * través de la entrada estandar, siendo estrictamente necesario 
@@ -69,11 +135,34 @@
  */
 
 
+#define _POSIX_C_SOURCE 200809L
+
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
 #include "router.h"
 
 
 
+/* ****************************************************************************
+ * FUNCIONES AUXILIARES
+ * ***************************************************************************/
+
+// Interpreta el valor numérico de una opción.
+// PRE: 'valor' es el texto del valor; 'resultado' es donde se almacena.
+// POST: devuelve true si 'valor' es un número entero positivo que entra en
+// 32 bits, o false en caso contrario.
+static bool leer_numero(const char *valor, unsigned long *resultado) {
+	char *fin;
+
+	if(*valor < '0' || *valor > '9') return false;
+	*resultado = strtoul(valor, &fin, 10);
+	return !*fin && *resultado && *resultado <= UINT32_MAX;
+}
+
+
+
 /* ****************************************************************************
  * PROGRAMA PRINCIPAL
  * ***************************************************************************/
@@ -81,10 +170,148 @@
 int main(int argc, char **argv) {
 	// Toma de parámetros
 	char *archivo = NULL;
-	if(argv[1]) archivo = argv[1];
+	bool interactivo = false;
+	red_opciones_t opciones = { ESTADISTICAS_NINGUNA, NULL, NULL, false,
+		MOTOR_DIJKSTRA, 1, 0, 0, NULL,
+		ORDEN_ARCHIVO, 1, false, RED_CACHE_PREDETERMINADA };
+	bool cache = false;
+	unsigned long numero;
+	long procesadores = sysconf(_SC_NPROCESSORS_ONLN);
+	int i;
+
+	if(procesadores > 1) opciones.hilos = procesadores;
+
+	for(i = 1; i < argc; i++) {
+		if(!strcmp(argv[i], "--stats"))
+			opciones.estadisticas = ESTADISTICAS_TEXTO;
+		else if(!strcmp(argv[i], "--stats=json"))
+			opciones.estadisticas = ESTADISTICAS_JSON;
+		else if(!strncmp(argv[i], "--consultas=", 12))
+			opciones.consultas = argv[i] + 12;
+		else if(!strncmp(argv[i], "--cambios=", 10))
+			opciones.cambios = argv[i] + 10;
+		else if(!strcmp(argv[i], "--distancias"))
+			opciones.distancias = true;
+		else if(!strcmp(argv[i], "--fallas"))
+			opciones.fallas = true;
+		else if(!strcmp(argv[i], "--interactivo"))
+			interactivo = true;
+		else if(!strcmp(argv[i], "--motor=dijkstra"))
+			opciones.motor = MOTOR_DIJKSTRA;
+		else if(!strcmp(argv[i], "--motor=delta"))
+			opciones.motor = MOTOR_DELTA;
+		else if(!strncmp(argv[i], "--hilos=", 8) ||
+			!strncmp(argv[i], "--delta=", 8)) {
+			if(!leer_numero(argv[i] + 8, &numero)) {
+				fprintf(stderr, "ERROR: Valor inválido en %s.\n", argv[i]);
+				return 1;
+			}
+
+			if(argv[i][2] == 'h') opciones.hilos = numero;
+			else opciones.delta = numero;
+		}
+		else if(!strcmp(argv[i], "--areas=etiquetas"))
+			opciones.areas = RED_AREAS_ETIQUETAS;
+		else if(!strncmp(argv[i], "--areas=", 8)) {
+			if(!leer_numero(argv[i] + 8, &numero) ||
+				numero >= RED_AREAS_ETIQUETAS) {
+				fprintf(stderr, "ERROR: Valor inválido en %s.\n", argv[i]);
+				return 1;
+			}
+
+			opciones.areas = numero;
+		}
+		else if(!strncmp(argv[i], "--k-caminos=", 12)) {
+			if(!leer_numero(argv[i] + 12, &numero)) {
+				fprintf(stderr, "ERROR: Valor inválido en %s.\n", argv[i]);
+				return 1;
+			}
+
+			opciones.k_caminos = numero;
+		}
+		else if(!strncmp(argv[i], "--cache=", 8)) {
+			if(!leer_numero(argv[i] + 8, &numero)) {
+				fprintf(stderr, "ERROR: Valor inválido en %s.\n", argv[i]);
+				return 1;
+			}
+
+			opciones.cache = (size_t) numero << 20;
+			cache = true;
+		}
+		else if(!strncmp(argv[i], "--persistencia=", 15) && argv[i][15])
+			opciones.persistencia = argv[i] + 15;
+		else if(!strcmp(argv[i], "--orden=archivo"))
+			opciones.orden = ORDEN_ARCHIVO;
+		else if(!strcmp(argv[i], "--orden=anchura"))
+			opciones.orden = ORDEN_ANCHURA;
+		else if(!strcmp(argv[i], "--orden=rcm"))
+			opciones.orden = ORDEN_RCM;
+		else if(!strcmp(argv[i], "--orden=grado"))
+			opciones.orden = ORDEN_GRADO;
+		else if(!strncmp(argv[i], "--", 2)) {
+			fprintf(stderr, "ERROR: Opción desconocida %s.\n", argv[i]);
+			return 1;
+		}
+		else
+			archivo = argv[i];
+	}
 	
+	// Sin archivo, la especificación se lee desde la entrada estandar con
+	// el formato del archivo, salvo que se la pida en forma interactiva
+	if(interactivo && archivo) {
+		fprintf(stderr, "ERROR: --interactivo es incompatible con un "
+			"archivo de entrada.\n");
+		return 1;
+	}
+
+	if(!interactivo && !archivo) archivo = RED_ENTRADA_ESTANDAR;
+
+	if(opciones.consultas && opciones.distancias) {
+		fprintf(stderr, "ERROR: --consultas y --distancias son "
+			"incompatibles.\n");
+		return 1;
+	}
+
+	if(opciones.areas && (opciones.consultas || opciones.distancias ||
+		opciones.motor == MOTOR_DELTA)) {
+		fprintf(stderr, "ERROR: --areas es incompatible con --consultas, "
+			"--distancias y --motor=delta.\n");
+		return 1;
+	}
+
+	if(opciones.persistencia && (opciones.consultas || opciones.distancias
+		|| !archivo || !strcmp(archivo, RED_ENTRADA_ESTANDAR))) {
+		fprintf(stderr, "ERROR: --persistencia requiere un archivo de "
+			"entrada y es incompatible con --consultas y --distancias.\n");
+		return 1;
+	}
+
+	if(opciones.k_caminos > 1 && (opciones.consultas || opciones.distancias
+		|| opciones.persistencia)) {
+		fprintf(stderr, "ERROR: --k-caminos es incompatible con "
+			"--consultas, --distancias y --persistencia.\n");
+		return 1;
+	}
+
+	if(opciones.fallas && (opciones.consultas || opciones.distancias ||
+		opciones.areas || opciones.persistencia || opciones.k_caminos > 1)) {
+		fprintf(stderr, "ERROR: --fallas es incompatible con --consultas, "
+			"--distancias, --areas, --persistencia y --k-caminos.\n");
+		return 1;
+	}
+
+	if(opciones.cambios && !opciones.consultas) {
+		fprintf(stderr, "ERROR: --cambios requiere --consultas.\n");
+		return 1;
+	}
+
+	if(cache && !opciones.cambios) {
+		fprintf(stderr, "ERROR: --cache requiere --cambios.\n");
+		return 1;
+	}
+
 	// Enviamos a procesamiento
-	procesar_red_caminos_minimos(archivo);
+	procesar_red_caminos_minimos(archivo, &opciones);
 
 	return 0;
 }